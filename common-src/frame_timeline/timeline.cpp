@@ -2,7 +2,25 @@
 #include "../helpers.h"
 
 #include <math.h>
+#include <algorithm>
 #include <QDebug>
+#include <QStyleOptionGraphicsItem>
+
+// width of a cached ruler tile
+const int RULER_TILE_WIDTH = 512;
+// room for a tick label starting left of a tile
+const int RULER_LABEL_MAX_WIDTH = 160;
+
+const int RULER_HEIGHT = 40;
+// strip lanes under the ruler
+const int THUMBNAILS_TOP = 42;
+const int THUMBNAILS_HEIGHT = 40;
+const int METRICS_TOP = 84;
+const int METRICS_HEIGHT = 16;
+const int STRIP_BOTTOM = 102;
+// curves keep clear of the ruler edges
+const int CURVES_TOP = 4;
+const int CURVES_HEIGHT = 32;
 
 TimeLine::TimeLine(QWidget * a_pParent)
 {
@@ -11,9 +29,18 @@ TimeLine::TimeLine(QWidget * a_pParent)
     m_zoomFactor = 1;
     m_accuScaleMultiplier = 1.0;
     m_widthPerSegment = 192;
+    m_maxFrame = 0;
+    m_fps = 0.0;
+    m_currentFrame = 0;
+    m_displayMode = Time;
+    m_stripVisible = false;
+    m_rulerTilesPixelRatio = 1.0;
 
     setPos(mapToParent(0,0));
 
+    // only the exposed part of the ruler is painted
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+
 //    connect(this, &TimeLine::signalZoomFactorChanged, this, &TimeLine::slotZoomFactorToWidth);
 }
 // END OF TimeLine::TimeLine(QWidget * a_pParent)
@@ -29,7 +56,8 @@ TimeLine::~TimeLine()
 
 QRectF TimeLine::boundingRect() const
 {    
-    return QRectF(0, 0, m_viewWidth - 2, 40); // -2 to remove border
+    int height = m_stripVisible ? STRIP_BOTTOM : RULER_HEIGHT;
+    return QRectF(0, 0, m_viewWidth - 2, height); // -2 to remove border
 }
 
 // END OF QRectF TimeLine::boundingRect() const
@@ -37,66 +65,256 @@ QRectF TimeLine::boundingRect() const
 
 void TimeLine::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
-    QBrush rulerBrush(QColor("#abcdd7"));
+    Q_UNUSED(widget);
+
+    QRectF rec = boundingRect();
+    QRectF exposedRect = rec;
+    if (option)
+        exposedRect = option->exposedRect.intersected(rec);
+    if (exposedRect.isEmpty())
+        return;
+
+    // don't run on initial paint when max frame has not been set yet
+    if (m_maxFrame <= 0) {
+        painter->fillRect(exposedRect, QColor("#abcdd7"));
+        return;
+    }
+
+    qreal pixelRatio = painter->device()->devicePixelRatioF();
+    if (!qFuzzyCompare(pixelRatio, m_rulerTilesPixelRatio)) {
+        m_rulerTiles.clear();
+        m_rulerTilesPixelRatio = pixelRatio;
+    }
+
+    int firstTile = std::max(int(floor(exposedRect.left())), 0) / RULER_TILE_WIDTH;
+    int lastTile = int(ceil(exposedRect.right())) / RULER_TILE_WIDTH;
+
+    painter->save();
+    painter->setClipRect(exposedRect);
+    for (int tile = firstTile; tile <= lastTile; tile++) {
+        painter->drawPixmap(tile * RULER_TILE_WIDTH, 0,
+            rulerTile(tile, pixelRatio));
+    }
+    painter->restore();
+}
+// END OF void TimeLine::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+//==============================================================================
+
+void TimeLine::invalidateRuler()
+{
+    m_rulerTiles.clear();
+    update();
+}
+
+// END OF void TimeLine::invalidateRuler()
+//==============================================================================
+
+QPixmap TimeLine::rulerTile(int a_tileIndex, qreal a_devicePixelRatio)
+{
+    std::map<int, QPixmap>::iterator it = m_rulerTiles.find(a_tileIndex);
+    if (it != m_rulerTiles.end())
+        return it->second;
+
+    int tileHeight = int(boundingRect().height());
+    QPixmap tile(int(ceil(RULER_TILE_WIDTH * a_devicePixelRatio)),
+        int(ceil(tileHeight * a_devicePixelRatio)));
+    tile.setDevicePixelRatio(a_devicePixelRatio);
+    tile.fill(QColor("#abcdd7"));
+
+    int tileStart = a_tileIndex * RULER_TILE_WIDTH;
+    QPainter painter(&tile);
+    painter.translate(-tileStart, 0);
+    // labels of ticks left of the tile may reach into it
+    drawRuler(&painter, tileStart - RULER_LABEL_MAX_WIDTH,
+        tileStart + RULER_TILE_WIDTH);
+    if (m_stripVisible)
+        drawStrip(&painter, tileStart, tileStart + RULER_TILE_WIDTH);
+    if (!m_curves.empty())
+        drawCurves(&painter, tileStart - 1, tileStart + RULER_TILE_WIDTH + 1);
+    painter.end();
+
+    m_rulerTiles[a_tileIndex] = tile;
+    return tile;
+}
+
+// END OF QPixmap TimeLine::rulerTile(int a_tileIndex, qreal a_devicePixelRatio)
+//==============================================================================
+
+void TimeLine::drawRuler(QPainter * a_pPainter, int a_from, int a_to) const
+{
+    DisplayMode l_displayMode = Time;
+    if((m_displayMode == Frames) || (m_fps == 0.0))
+        l_displayMode = Frames;
 
-    QFont defaultFont = painter->font();
     QFont rulerTextFont("Arial", 10);
+    a_pPainter->setFont(rulerTextFont);
+
+    int longTickWidth = m_widthPerSegment;
+    int mediumTickWidth = int(double(longTickWidth) / double(2));
+    int shortTickWidth = (longTickWidth - mediumTickWidth) / 4;
+
+    int from = std::max(a_from, 0);
+    int to = std::min(a_to, m_viewWidth);
+
+    // short ticks share positions with medium and long ones, walk them
+    // and pick the tallest tick for each position
+    int firstTick = (from + shortTickWidth - 1) / shortTickWidth * shortTickWidth;
+    QVector<QLineF> lines;
+    for (int i = firstTick; i < to; i += shortTickWidth) {
+        if (i % longTickWidth == 0) {
+            lines.append(QLineF(i, 17, i, 39));
+
+            // get frame
+            int current_frame = posToFrame(i);
+
+            QString labelString;
+            if(l_displayMode == Frames)
+                labelString = QVariant(current_frame).toString();
+            else {
+                labelString = vsedit::timeToString(double(current_frame) / m_fps);
+            }
 
-    QRectF rec = boundingRect();
+            a_pPainter->drawText(QPoint(i, 15), labelString);
+        }
+        else if (i % mediumTickWidth == 0)
+            lines.append(QLineF(i, 22, i, 39));
+        else
+            lines.append(QLineF(i, 30, i, 39));
+    }
+    a_pPainter->drawLines(lines);
+}
 
-    painter->fillRect(rec, rulerBrush);
+// END OF void TimeLine::drawRuler(QPainter * a_pPainter, int a_from, int a_to) const
+//==============================================================================
 
-    // don't run on initial paint when max frame has not been set yet
-    if (m_maxFrame > 0) {
-
-        DisplayMode l_displayMode = Time;
-        if((m_displayMode == Frames) || (m_fps == 0.0))
-            l_displayMode = Frames;
-
-        // drawing ruler
-        int longTickWidth = m_widthPerSegment;
-        int mediumTickWidth = int(double(longTickWidth) / double(2));
-        int shortTickWidth = (longTickWidth - mediumTickWidth) / 4;
-
-        int accumLongTickWidth = 0;
-        int accumMediumTickWidth = 0;
-        int accumShortTickWidth = 0;
-
-        for (int i = 0; i < m_viewWidth; i++) {
-            if ( i % longTickWidth== 0 ) {
-                painter->drawLine(i, 17, i, 39);
-                accumLongTickWidth += longTickWidth;
-
-                // get frame
-                int current_frame = posToFrame(i);
-
-                QString labelString;
-                if(l_displayMode == Frames)
-                    labelString = QVariant(current_frame).toString();
-                else {
-                    labelString = vsedit::timeToString(double(current_frame) / m_fps);
-                }
-
-                QPoint labelPos(i, 15);
-                painter->setFont(rulerTextFont);
-                painter->drawText(labelPos, labelString);
+void TimeLine::drawStrip(QPainter * a_pPainter, int a_from, int a_to) const
+{
+    if (m_strip.isEmpty() || (m_maxFrame <= 0))
+        return;
+
+    int from = std::max(a_from, 0);
+    int to = std::min(a_to, m_viewWidth);
+    if (from >= to)
+        return;
+
+    int samples = m_strip.samplesNumber();
+
+    // thumbnails, thinned out so they don't overlap when zoomed out
+    int thumbnailFrames = m_strip.step * m_strip.thumbnailEvery;
+    double thumbnailPitch = double(thumbnailFrames) * double(m_viewWidth) /
+        double(m_maxFrame);
+    int thumbnailWidth = 0;
+    for (const QImage & thumbnail : m_strip.thumbnails) {
+        if (!thumbnail.isNull()) {
+            thumbnailWidth = thumbnail.width();
+            break;
+        }
+    }
+
+    if ((thumbnailWidth > 0) && (thumbnailPitch > 0.0)) {
+        int thumbnailStride = std::max(1,
+            int(ceil(double(thumbnailWidth) / thumbnailPitch)));
+        int firstThumbnail = posToFrame(from - thumbnailWidth) / thumbnailFrames;
+        firstThumbnail = std::max(0, firstThumbnail - firstThumbnail % thumbnailStride);
+        int lastThumbnail = std::min(int(m_strip.thumbnails.size()) - 1,
+            posToFrame(to) / thumbnailFrames);
+
+        for (int i = firstThumbnail; i <= lastThumbnail; i += thumbnailStride) {
+            const QImage & thumbnail = m_strip.thumbnails[size_t(i)];
+            if (thumbnail.isNull())
+                continue;
+            int x = frameToPos(i * thumbnailFrames);
+            a_pPainter->drawImage(QRect(x, THUMBNAILS_TOP,
+                thumbnail.width(), THUMBNAILS_HEIGHT), thumbnail);
+        }
+    }
+
+    // metrics lane: average luma as background, frame difference as bars
+    QColor differenceColor("#d7301f");
+    for (int x = from; x < to; x++) {
+        int firstSample = m_strip.frameToSample(posToFrame(x));
+        int endSample = std::max(firstSample + 1,
+            m_strip.frameToSample(posToFrame(x + 1)));
+        endSample = std::min(endSample, samples);
+
+        float lumaSum = 0.0f;
+        int lumaCount = 0;
+        float maxDifference = -1.0f;
+        for (int s = firstSample; s < endSample; s++) {
+            if (m_strip.luma[size_t(s)] >= 0.0f) {
+                lumaSum += m_strip.luma[size_t(s)];
+                lumaCount++;
             }
+            maxDifference = std::max(maxDifference, m_strip.difference[size_t(s)]);
+        }
 
-            // draw medium tick
-            if (i % mediumTickWidth == 0 && i % longTickWidth != 0) {
-                painter->drawLine(i, 22, i, 39);
-                accumMediumTickWidth += mediumTickWidth;
+        if (lumaCount == 0)
+            continue;
+
+        int gray = int(lumaSum / float(lumaCount) * 255.0f);
+        a_pPainter->fillRect(x, METRICS_TOP, 1, METRICS_HEIGHT, QColor(gray, gray, gray));
+
+        // differences above a quarter of the range are scene changes
+        float level = std::min(1.0f, maxDifference * 4.0f);
+        int barHeight = int(level * float(METRICS_HEIGHT));
+        if (barHeight > 0)
+            a_pPainter->fillRect(x, METRICS_TOP + METRICS_HEIGHT - barHeight,
+                1, barHeight, differenceColor);
+    }
+}
+
+// END OF void TimeLine::drawStrip(QPainter * a_pPainter, int a_from, int a_to) const
+//==============================================================================
+
+void TimeLine::drawCurves(QPainter * a_pPainter, int a_from, int a_to) const
+{
+    if (m_maxFrame <= 0)
+        return;
+
+    int from = std::max(a_from, 0);
+    int to = std::min(a_to, m_viewWidth);
+    if (from >= to)
+        return;
+
+    a_pPainter->save();
+    a_pPainter->setRenderHint(QPainter::Antialiasing);
+
+    for (const TimeLineCurve & curve : m_curves) {
+        int frames = int(curve.values.size());
+        a_pPainter->setPen(QPen(curve.color, 1.5));
+
+        // the worst frame under each pixel, lines break at gaps
+        QPolygonF line;
+        for (int x = from; x < to; x++) {
+            int firstFrame = std::max(posToFrame(x), 0);
+            int endFrame = std::min(std::max(firstFrame + 1,
+                posToFrame(x + 1)), frames);
+
+            float value = 2.0f;
+            for (int frame = firstFrame; frame < endFrame; frame++) {
+                float frameValue = curve.values[size_t(frame)];
+                if (frameValue >= 0.0f)
+                    value = std::min(value, frameValue);
             }
 
-            // draw short tick
-            if (i % shortTickWidth == 0 && i % longTickWidth != 0 && i % mediumTickWidth != 0) {
-                painter->drawLine(i, 30, i, 39);
-                accumShortTickWidth += shortTickWidth;
+            if (value > 1.0f) {
+                if (line.size() > 1)
+                    a_pPainter->drawPolyline(line);
+                line.clear();
+                continue;
             }
+
+            line << QPointF(x + 0.5,
+                CURVES_TOP + (1.0 - double(value)) * CURVES_HEIGHT);
         }
+        if (line.size() > 1)
+            a_pPainter->drawPolyline(line);
     }
+
+    a_pPainter->restore();
 }
-// END OF void TimeLine::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+
+// END OF void TimeLine::drawCurves(QPainter * a_pPainter, int a_from, int a_to) const
 //==============================================================================
 
 int TimeLine::zoomFactor()
@@ -130,8 +348,9 @@ void TimeLine::setViewWidth(int a_viewWidth)
     if (m_viewWidth == a_viewWidth)
         return;
 
-    m_viewWidth = a_viewWidth;
     prepareGeometryChange();
+    m_viewWidth = a_viewWidth;
+    m_rulerTiles.clear();
 
     emit signalTimeLineWidthChanged();
 }
@@ -245,8 +464,8 @@ void TimeLine::setFrame(int a_frame)
     if(m_currentFrame == oldCurrentFrame)
         return;
 
-    update();
-
+    // the ruler does not depend on the current frame,
+    // the playhead is a separate item
     emit signalFrameChanged(m_currentFrame);
 }
 
@@ -259,7 +478,7 @@ void TimeLine::setFramesNumber(int a_framesNumber)
 
 //    if(m_currentFrame > m_maxFrame)
 //        setFrame(m_maxFrame);
-    update();
+    invalidateRuler();
 }
 
 // END OF void TimeLine::setFramesNumber(int a_framesNumber)
@@ -268,7 +487,7 @@ void TimeLine::setFramesNumber(int a_framesNumber)
 void TimeLine::setFPS(double a_fps)
 {
     m_fps = a_fps;
-    update();
+    invalidateRuler();
 }
 
 double TimeLine::fps()
@@ -290,7 +509,7 @@ TimeLine::DisplayMode TimeLine::displayMode() const
 void TimeLine::setDisplayMode(DisplayMode a_displayMode)
 {
     m_displayMode = a_displayMode;
-    update();
+    invalidateRuler();
 }
 
 // END OF void TimeLine::setDisplayMode(DisplayMode a_displayMode)
@@ -383,6 +602,51 @@ int TimeLine::getClosestBookmark(int a_frame) const
 // END OF int TimeLine::getClosestBookmark(int a_frame) const
 //==============================================================================
 
+void TimeLine::setStrip(const TimeLineStrip & a_strip)
+{
+    m_strip = a_strip;
+    if (m_stripVisible)
+        invalidateRuler();
+}
+
+// END OF void TimeLine::setStrip(const TimeLineStrip & a_strip)
+//==============================================================================
+
+void TimeLine::setStripVisible(bool a_visible)
+{
+    if (m_stripVisible == a_visible)
+        return;
+
+    prepareGeometryChange();
+    m_stripVisible = a_visible;
+    invalidateRuler();
+
+    emit signalTimeLineWidthChanged();
+}
+
+// END OF void TimeLine::setStripVisible(bool a_visible)
+//==============================================================================
+
+bool TimeLine::stripVisible() const
+{
+    return m_stripVisible;
+}
+
+// END OF bool TimeLine::stripVisible() const
+//==============================================================================
+
+void TimeLine::setCurves(const std::vector<TimeLineCurve> & a_curves)
+{
+    if (m_curves.empty() && a_curves.empty())
+        return;
+
+    m_curves = a_curves;
+    invalidateRuler();
+}
+
+// END OF void TimeLine::setCurves(const std::vector<TimeLineCurve> & a_curves)
+//==============================================================================
+
 
 int TimeLine::posToFrame(int a_pos) const
 {
@@ -1,10 +1,14 @@
 #ifndef TIMELINE_H
 #define TIMELINE_H
 
+#include "timeline_strip.h"
+
 #include <QGraphicsObject>
 #include <QWidget>
 #include <QPainter>
+#include <QPixmap>
 #include <set>
+#include <map>
 
 using namespace std;
 
@@ -79,8 +83,26 @@ public:
     void clearBookmarks();
     int getClosestBookmark(int a_frame) const;
 
+    // thumbnails and metrics
+    void setStrip(const TimeLineStrip & a_strip);
+    void setStripVisible(bool a_visible);
+    bool stripVisible() const;
+
+    // measured quality curves over the ruler
+    void setCurves(const std::vector<TimeLineCurve> & a_curves);
+
 private:
 
+    void invalidateRuler();
+
+    QPixmap rulerTile(int a_tileIndex, qreal a_devicePixelRatio);
+
+    void drawRuler(QPainter * a_pPainter, int a_from, int a_to) const;
+
+    void drawStrip(QPainter * a_pPainter, int a_from, int a_to) const;
+
+    void drawCurves(QPainter * a_pPainter, int a_from, int a_to) const;
+
     int m_baseWidth;
     int m_viewWidth;
 
@@ -109,6 +131,17 @@ private:
     // bookmarks
     std::set<int> m_bookmarks;
 
+    // thumbnails and metrics lanes under the ruler
+    TimeLineStrip m_strip;
+    bool m_stripVisible;
+
+    std::vector<TimeLineCurve> m_curves;
+
+    // ruler and strip are rendered into fixed width tiles once per zoom,
+    // size or strip change
+    std::map<int, QPixmap> m_rulerTiles;
+    qreal m_rulerTilesPixelRatio;
+
 
 public slots:
 
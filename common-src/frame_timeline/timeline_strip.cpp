@@ -0,0 +1,225 @@
+#include "timeline_strip.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileInfoList>
+#include <QDateTime>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+
+const quint32 TIMELINE_STRIP_MAGIC = 0x5653544c; // "VSTL"
+const quint32 TIMELINE_STRIP_VERSION = 1;
+
+// quoted strings of a script, source paths are among them
+const QRegularExpression SCRIPT_STRING_REGEXP("([\"'])([^\"'\\r\\n]+)\\1");
+
+// the least recently used strips go once the cache grows past this
+const qint64 TIMELINE_CACHE_MAX_BYTES = 256 * 1024 * 1024;
+
+static void pruneCacheDir(const QString & a_dirPath)
+{
+    QFileInfoList files = QDir(a_dirPath).entryInfoList(
+        QStringList() << "*.vstl", QDir::Files, QDir::Time);
+
+    // newest first, everything past the budget is removed
+    qint64 totalSize = 0;
+    for (const QFileInfo & fileInfo : files) {
+        totalSize += fileInfo.size();
+        if (totalSize > TIMELINE_CACHE_MAX_BYTES)
+            QFile::remove(fileInfo.absoluteFilePath());
+    }
+}
+
+// END OF static void pruneCacheDir(const QString & a_dirPath)
+//==============================================================================
+
+TimeLineStrip::TimeLineStrip() :
+    framesNumber(0),
+    step(1),
+    thumbnailEvery(1)
+{
+}
+
+// END OF TimeLineStrip::TimeLineStrip()
+//==============================================================================
+
+void TimeLineStrip::reset(int a_framesNumber, int a_step, int a_thumbnailEvery)
+{
+    framesNumber = a_framesNumber;
+    step = std::max(a_step, 1);
+    thumbnailEvery = std::max(a_thumbnailEvery, 1);
+
+    int samples = (framesNumber + step - 1) / step;
+    luma.assign(size_t(samples), -1.0f);
+    difference.assign(size_t(samples), -1.0f);
+    thumbnails.assign(size_t((samples + thumbnailEvery - 1) / thumbnailEvery),
+        QImage());
+}
+
+// END OF void TimeLineStrip::reset(int a_framesNumber, int a_step, int a_thumbnailEvery)
+//==============================================================================
+
+bool TimeLineStrip::isEmpty() const
+{
+    return luma.empty();
+}
+
+// END OF bool TimeLineStrip::isEmpty() const
+//==============================================================================
+
+int TimeLineStrip::samplesNumber() const
+{
+    return int(luma.size());
+}
+
+// END OF int TimeLineStrip::samplesNumber() const
+//==============================================================================
+
+int TimeLineStrip::sampleToFrame(int a_sample) const
+{
+    return a_sample * step;
+}
+
+// END OF int TimeLineStrip::sampleToFrame(int a_sample) const
+//==============================================================================
+
+int TimeLineStrip::frameToSample(int a_frame) const
+{
+    return a_frame / step;
+}
+
+// END OF int TimeLineStrip::frameToSample(int a_frame) const
+//==============================================================================
+
+bool TimeLineStrip::save(const QString & a_filePath) const
+{
+    QDir().mkpath(QFileInfo(a_filePath).absolutePath());
+
+    QSaveFile file(a_filePath);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream << TIMELINE_STRIP_MAGIC << TIMELINE_STRIP_VERSION;
+    stream << qint32(framesNumber) << qint32(step) << qint32(thumbnailEvery);
+    stream << quint32(luma.size());
+    for (size_t i = 0; i < luma.size(); i++)
+        stream << luma[i] << difference[i];
+    stream << quint32(thumbnails.size());
+    for (const QImage & thumbnail : thumbnails)
+        stream << thumbnail;
+
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    if (!file.commit())
+        return false;
+
+    pruneCacheDir(QFileInfo(a_filePath).absolutePath());
+    return true;
+}
+
+// END OF bool TimeLineStrip::save(const QString & a_filePath) const
+//==============================================================================
+
+bool TimeLineStrip::load(const QString & a_filePath, int a_framesNumber)
+{
+    QFile file(a_filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_6);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if ((magic != TIMELINE_STRIP_MAGIC) || (version != TIMELINE_STRIP_VERSION))
+        return false;
+
+    qint32 framesNumberRead = 0;
+    qint32 stepRead = 0;
+    qint32 thumbnailEveryRead = 0;
+    stream >> framesNumberRead >> stepRead >> thumbnailEveryRead;
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    // a damaged header must not size the vectors below
+    if ((framesNumberRead != a_framesNumber) || (framesNumberRead <= 0) ||
+        (stepRead < 1) || (stepRead > framesNumberRead))
+        return false;
+    int samplesRead = (framesNumberRead + stepRead - 1) / stepRead;
+    if ((thumbnailEveryRead < 1) || (thumbnailEveryRead > samplesRead))
+        return false;
+
+    TimeLineStrip strip;
+    strip.reset(framesNumberRead, stepRead, thumbnailEveryRead);
+
+    quint32 samples = 0;
+    stream >> samples;
+    if (samples != quint32(strip.luma.size()))
+        return false;
+    for (size_t i = 0; i < strip.luma.size(); i++)
+        stream >> strip.luma[i] >> strip.difference[i];
+
+    quint32 thumbnailsNumber = 0;
+    stream >> thumbnailsNumber;
+    if (thumbnailsNumber != quint32(strip.thumbnails.size()))
+        return false;
+    for (QImage & thumbnail : strip.thumbnails)
+        stream >> thumbnail;
+
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    // the pruning keeps the strips that are still opened
+    file.close();
+    if (file.open(QIODevice::Append)) {
+        file.setFileTime(QDateTime::currentDateTime(),
+            QFileDevice::FileModificationTime);
+    }
+
+    *this = strip;
+    return true;
+}
+
+// END OF bool TimeLineStrip::load(const QString & a_filePath,
+//		int a_framesNumber)
+//==============================================================================
+
+QString TimeLineStrip::cacheFilePath(const QString & a_script,
+    const QString & a_scriptName, const QString & a_clipKey)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(a_script.toUtf8());
+    hash.addData(a_clipKey.toUtf8());
+
+    // A re-encoded source leaves the script as it was, so the files
+    // it opens are part of the key. Relative paths are resolved
+    // against the script directory.
+    QDir scriptDir = QFileInfo(a_scriptName).absoluteDir();
+    QRegularExpressionMatchIterator it =
+        SCRIPT_STRING_REGEXP.globalMatch(a_script);
+    while (it.hasNext()) {
+        QFileInfo fileInfo(scriptDir, it.next().captured(2));
+        if (!fileInfo.isFile())
+            continue;
+        hash.addData(QString("%1|%2|%3").arg(fileInfo.absoluteFilePath())
+            .arg(fileInfo.size())
+            .arg(fileInfo.lastModified().toMSecsSinceEpoch()).toUtf8());
+    }
+
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+        QString("/timeline/%1.vstl").arg(
+        QString::fromLatin1(hash.result().toHex()));
+}
+
+// END OF QString TimeLineStrip::cacheFilePath(const QString & a_script,
+//		const QString & a_scriptName, const QString & a_clipKey)
+//==============================================================================
@@ -0,0 +1,57 @@
+#ifndef TIMELINE_STRIP_H
+#define TIMELINE_STRIP_H
+
+#include <QColor>
+#include <QImage>
+#include <QString>
+#include <vector>
+
+// thumbnails and per-frame metrics shown under the timeline ruler,
+// sampled every 'step' frames of the clip
+struct TimeLineStrip
+{
+    int framesNumber;
+    int step;
+    int thumbnailEvery; // samples per thumbnail
+
+    // 0..1 per sample, negative when not computed yet
+    std::vector<float> luma;
+    std::vector<float> difference;
+
+    // one per thumbnailEvery samples, null when not computed yet
+    std::vector<QImage> thumbnails;
+
+    TimeLineStrip();
+
+    void reset(int a_framesNumber, int a_step, int a_thumbnailEvery);
+
+    bool isEmpty() const;
+
+    int samplesNumber() const;
+
+    int sampleToFrame(int a_sample) const;
+
+    int frameToSample(int a_frame) const;
+
+    bool save(const QString & a_filePath) const;
+
+    // fails unless the file holds a strip of a_framesNumber frames
+    bool load(const QString & a_filePath, int a_framesNumber);
+
+    // sidecar cache file for a script, keyed by the script, the clip
+    // and the size and time of files the script names in its strings,
+    // the cache directory is pruned to a size budget on save
+    static QString cacheFilePath(const QString & a_script,
+        const QString & a_scriptName, const QString & a_clipKey);
+};
+
+// per-frame values drawn as a line over the ruler
+struct TimeLineCurve
+{
+    QColor color;
+
+    // 0..1 per frame of the clip, negative when not measured
+    std::vector<float> values;
+};
+
+#endif // TIMELINE_STRIP_H
@@ -13,7 +13,8 @@ TimeLineView::TimeLineView (QWidget * a_pParent ):
     m_pTimeLine = new TimeLine();
     m_pSlider = new Slider();
 
-    m_pTimeLine->setCacheMode(QGraphicsItem::ItemCoordinateCache);
+    // the timeline caches its ruler in tiles itself
+    m_pTimeLine->setCacheMode(QGraphicsItem::NoCache);
 
     m_pScene->addItem(m_pTimeLine);
     m_pScene->addItem(m_pSlider);
@@ -87,6 +88,21 @@ void TimeLineView::centerSliderOnCurrentFrame()
     this->centerOn(pos_in_scene);
 }
 
+void TimeLineView::setStrip(const TimeLineStrip & a_strip)
+{
+    m_pTimeLine->setStrip(a_strip);
+}
+
+void TimeLineView::setStripVisible(bool a_visible)
+{
+    m_pTimeLine->setStripVisible(a_visible);
+}
+
+void TimeLineView::setCurves(const std::vector<TimeLineCurve> & a_curves)
+{
+    m_pTimeLine->setCurves(a_curves);
+}
+
 void TimeLineView::slotSetTimeLine(int a_numFrames, int64_t a_fpsNum, int64_t a_fpsDen)
 {
     int current_viewWidth = this->width();
@@ -43,6 +43,12 @@ public:
 
     void centerSliderOnCurrentFrame();
 
+    void setStrip(const TimeLineStrip & a_strip);
+
+    void setStripVisible(bool a_visible);
+
+    void setCurves(const std::vector<TimeLineCurve> & a_curves);
+
 signals:
 
     void signalFrameChanged(int a_frame);
@@ -9,6 +9,8 @@ static const uint16_t JOB_SERVER_PORT = 3370;
 // Client messages
 static const char MSG_GET_JOBS_INFO[] = "GJI";
 static const char MSG_GET_LOG[] = "GL";
+static const char MSG_GET_LOG_PAGE[] = "GLP";
+static const char MSG_GET_JOBS_TELEMETRY[] = "GJT";
 static const char MSG_SUBSCRIBE[] = "SS";
 static const char MSG_UNSUBSCRIBE[] = "USS";
 static const char MSG_CLOSE_SERVER[] = "CS";
@@ -30,11 +32,14 @@ static const char MSG_ABORT_ACTIVE_JOBS[] = "AACJ";
 // Server messages
 static const char SMSG_JOBS_INFO[] = "JI";
 static const char SMSG_COMPLETE_LOG[] = "LOG";
+static const char SMSG_LOG_PAGE[] = "LOGP";
 static const char SMSG_LOG_MESSAGE[] = "LM";
 static const char SMSG_JOB_CREATED[] = "JC";
 static const char SMSG_JOB_UPDATE[] = "JU";
 static const char SMSG_JOB_STATE_UPDATE[] = "JSU";
 static const char SMSG_JOB_PROGRESS_UPDATE[] = "JPU";
+static const char SMSG_JOBS_PROGRESS_UPDATE[] = "JSPU";
+static const char SMSG_JOBS_TELEMETRY[] = "JTL";
 static const char SMSG_JOB_START_TIME_UPDATE[] = "JSTU";
 static const char SMSG_JOB_END_TIME_UPDATE[] = "JETU";
 static const char SMSG_JOB_DEPENDENCIES_UPDATE[] = "JDU";
@@ -44,6 +49,34 @@ static const char SMSG_REFUSE[] = "RF";
 static const char SMSG_CLOSING_SERVER[] = "SCS";
 static const char SMSG_TRUSTED_CLIENTS_INFO[] = "TCI";
 
+// Log page request and reply keys
+static const char LOG_PAGE_FIRST[] = "first";
+static const char LOG_PAGE_COUNT[] = "count";
+static const char LOG_PAGE_TOTAL[] = "total";
+static const char LOG_PAGE_ENTRIES[] = "entries";
+
+// Jobs telemetry keys
+static const char TELEMETRY_SAMPLES[] = "samples";
+
+// Coordinator <-> Worker job server communication
+
+// Worker messages
+static const char MSG_REGISTER_WORKER[] = "RGW";
+static const char MSG_WORKER_HEARTBEAT[] = "WHB";
+static const char MSG_WORKER_JOB_UPDATE[] = "WJU";
+
+// Coordinator messages
+static const char CMSG_DISPATCH_JOB[] = "DPJ";
+static const char CMSG_ABORT_DISPATCHED_JOB[] = "ADPJ";
+static const char CMSG_COORDINATOR_HEARTBEAT[] = "CHB";
+
+// Worker report keys
+static const char WORKER_NAME[] = "name";
+static const char WORKER_CORES[] = "cores";
+static const char WORKER_FREE_SLOTS[] = "freeSlots";
+static const char WORKER_FREE_MEMORY[] = "freeMemory";
+static const char WORKER_JOBS[] = "jobs";
+
 // Editor <-> Watcher communication
 
 static const char JOB_SERVER_WATCHER_LOCAL_SERVER_NAME[] =
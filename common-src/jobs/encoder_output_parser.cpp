@@ -0,0 +1,166 @@
+#include "encoder_output_parser.h"
+
+#include "../settings/settings_definitions_core.h"
+
+#include <QTimer>
+#include <QStringList>
+#include <QRegularExpression>
+
+//==============================================================================
+
+namespace
+{
+
+// x264/x265: "1234 frames: 45.67 fps, 1234.56 kb/s"
+// ffmpeg: "frame= 1234 fps= 46 q=28.0 ... bitrate=1234.5kbits/s"
+const QRegularExpression FPS_REGEXP(
+	"(?:fps=\\s*(\\d+(?:\\.\\d+)?))|(?:(\\d+(?:\\.\\d+)?)\\s*fps)");
+const QRegularExpression BITRATE_REGEXP(
+	"(\\d+(?:\\.\\d+)?)\\s*kb(?:its)?/s");
+
+}
+
+//==============================================================================
+
+vsedit::EncoderOutputParser::EncoderOutputParser(QObject * a_pParent) :
+	  QObject(a_pParent)
+	, m_fps(0.0)
+	, m_bitrate(0.0)
+	, m_statusPending(false)
+	, m_pStatusTimer(nullptr)
+{
+	m_pStatusTimer = new QTimer(this);
+	m_pStatusTimer->setSingleShot(true);
+	m_pStatusTimer->setInterval(DEFAULT_ENCODER_STATUS_UPDATE_INTERVAL);
+	connect(m_pStatusTimer, &QTimer::timeout,
+		this, &EncoderOutputParser::slotEmitStatus);
+}
+
+// END OF vsedit::EncoderOutputParser::EncoderOutputParser(
+//		QObject * a_pParent)
+//==============================================================================
+
+vsedit::EncoderOutputParser::~EncoderOutputParser()
+{
+}
+
+// END OF vsedit::EncoderOutputParser::~EncoderOutputParser()
+//==============================================================================
+
+void vsedit::EncoderOutputParser::slotParse(const QByteArray & a_data)
+{
+	m_buffer += a_data;
+
+	QStringList lines;
+	int start = 0;
+
+	while(start < m_buffer.size())
+	{
+		int end = start;
+		while((end < m_buffer.size()) && (m_buffer[end] != '\r') &&
+			(m_buffer[end] != '\n'))
+			++end;
+
+		// Incomplete line. Keep it until the rest arrives.
+		if(end == m_buffer.size())
+			break;
+
+		bool statusLine = false;
+		int next = end + 1;
+		if(m_buffer[end] == '\r')
+		{
+			// Can not tell a bare CR from a split CRLF yet.
+			if(next == m_buffer.size())
+				break;
+			if(m_buffer[next] == '\n')
+				++next;
+			else
+				statusLine = true;
+		}
+
+		// Delimiters are ASCII, so the segment is a complete UTF-8 sequence.
+		QString text = QString::fromUtf8(m_buffer.constData() + start,
+			end - start).trimmed();
+		if(!text.isEmpty())
+		{
+			if(statusLine)
+				setStatus(text);
+			else
+				lines << text;
+		}
+
+		start = next;
+	}
+
+	m_buffer.remove(0, start);
+
+	if(!lines.isEmpty())
+		emit signalLogLines(lines.join('\n'));
+}
+
+// END OF void vsedit::EncoderOutputParser::slotParse(const QByteArray & a_data)
+//==============================================================================
+
+void vsedit::EncoderOutputParser::slotFlush()
+{
+	QString text = QString::fromUtf8(m_buffer).trimmed();
+	m_buffer.clear();
+	if(!text.isEmpty())
+		emit signalLogLines(text);
+
+	m_pStatusTimer->stop();
+	if(m_statusPending)
+		slotEmitStatus();
+
+	emit signalFlushed();
+}
+
+// END OF void vsedit::EncoderOutputParser::slotFlush()
+//==============================================================================
+
+void vsedit::EncoderOutputParser::slotReset()
+{
+	m_pStatusTimer->stop();
+	m_buffer.clear();
+	m_status.clear();
+	m_fps = 0.0;
+	m_bitrate = 0.0;
+	m_statusPending = false;
+}
+
+// END OF void vsedit::EncoderOutputParser::slotReset()
+//==============================================================================
+
+void vsedit::EncoderOutputParser::slotEmitStatus()
+{
+	m_statusPending = false;
+	emit signalStatusChanged(m_status, m_fps, m_bitrate);
+}
+
+// END OF void vsedit::EncoderOutputParser::slotEmitStatus()
+//==============================================================================
+
+void vsedit::EncoderOutputParser::setStatus(const QString & a_status)
+{
+	m_status = a_status;
+
+	QRegularExpressionMatch fpsMatch = FPS_REGEXP.match(a_status);
+	if(fpsMatch.hasMatch())
+	{
+		QString fpsString = fpsMatch.captured(1);
+		if(fpsString.isEmpty())
+			fpsString = fpsMatch.captured(2);
+		m_fps = fpsString.toDouble();
+	}
+
+	QRegularExpressionMatch bitrateMatch = BITRATE_REGEXP.match(a_status);
+	if(bitrateMatch.hasMatch())
+		m_bitrate = bitrateMatch.captured(1).toDouble();
+
+	m_statusPending = true;
+	if(!m_pStatusTimer->isActive())
+		m_pStatusTimer->start();
+}
+
+// END OF void vsedit::EncoderOutputParser::setStatus(const QString & a_status)
+//==============================================================================
@@ -0,0 +1,61 @@
+#ifndef ENCODER_OUTPUT_PARSER_H_INCLUDED
+#define ENCODER_OUTPUT_PARSER_H_INCLUDED
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+
+class QTimer;
+
+namespace vsedit
+{
+
+/// Splits raw encoder stderr into log lines and a progress status.
+/// Lines terminated with a bare carriage return are progress updates
+/// that the encoder rewrites in place. They are collapsed into a single
+/// status that is reported at a limited rate. Intended to be moved to
+/// a worker thread.
+class EncoderOutputParser : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	EncoderOutputParser(QObject * a_pParent = nullptr);
+	virtual ~EncoderOutputParser() override;
+
+public slots:
+
+	void slotParse(const QByteArray & a_data);
+	void slotFlush();
+	void slotReset();
+
+signals:
+
+	void signalLogLines(const QString & a_lines);
+	void signalStatusChanged(const QString & a_status, double a_fps,
+		double a_bitrate);
+	// emitted after the output of slotFlush(), queued in order with it
+	void signalFlushed();
+
+private slots:
+
+	void slotEmitStatus();
+
+private:
+
+	void setStatus(const QString & a_status);
+
+	QByteArray m_buffer;
+
+	QString m_status;
+	double m_fps;
+	double m_bitrate;
+	bool m_statusPending;
+
+	QTimer * m_pStatusTimer;
+};
+
+}
+
+#endif // ENCODER_OUTPUT_PARSER_H_INCLUDED
@@ -7,9 +7,11 @@
 #include "../frame_header_writers/frame_header_writer_null.h"
 #include "../frame_header_writers/frame_header_writer_y4m.h"
 #include "../../../common-src/jobs/job_variables.h"
+#include "../../../common-src/jobs/encoder_output_parser.h"
 
 #include <QFileInfo>
 #include <QFile>
+#include <QThread>
 #include <algorithm>
 #include <vapoursynth/VSHelper.h>
 
@@ -31,6 +33,10 @@ vsedit::Job::Job(const JobProperties & a_properties,
 	  QObject(a_pParent)
 	, JobVariables()
 	, m_properties(a_properties)
+	, m_pEncoderOutputParser(nullptr)
+	, m_exitCode(0)
+	, m_exitStatus(QProcess::NormalExit)
+	, m_ignoredFlushes(0)
 	, m_lastFrameProcessed(-1)
 	, m_lastFrameRequested(-1)
 	, m_encodingState(EncodingState::Idle)
@@ -64,6 +70,16 @@ vsedit::Job::Job(const JobProperties & a_properties,
 		this, SLOT(slotProcessBytesWritten(qint64)));
 	connect(&m_process, SIGNAL(readyReadStandardError()),
 		this, SLOT(slotProcessReadyReadStandardError()));
+
+	// Parser may live in another thread, so it can not be our child.
+	m_pEncoderOutputParser = new EncoderOutputParser();
+	connect(m_pEncoderOutputParser, SIGNAL(signalLogLines(const QString &)),
+		this, SLOT(slotEncoderLogLines(const QString &)));
+	connect(m_pEncoderOutputParser,
+		SIGNAL(signalStatusChanged(const QString &, double, double)),
+		this, SLOT(slotEncoderStatusChanged(const QString &, double, double)));
+	connect(m_pEncoderOutputParser, SIGNAL(signalFlushed()),
+		this, SLOT(slotEncoderOutputFlushed()));
 }
 
 // END OF vsedit::Job::Job(const JobProperties & a_properties,
@@ -73,6 +89,7 @@ vsedit::Job::Job(const JobProperties & a_properties,
 
 vsedit::Job::~Job()
 {
+	m_pEncoderOutputParser->deleteLater();
 }
 
 // END OF vsedit::Job::~Job()
@@ -448,6 +465,28 @@ size_t vsedit::Job::maxThreads() const
 // END OF size_t vsedit::Job::maxThreads() const
 //==============================================================================
 
+qint64 vsedit::Job::encoderProcessId() const
+{
+	if(m_process.state() == QProcess::NotRunning)
+		return 0;
+	return m_process.processId();
+}
+
+// END OF qint64 vsedit::Job::encoderProcessId() const
+//==============================================================================
+
+bool vsedit::Job::coreInfo(VSCoreInfo * a_pCoreInfo) const
+{
+	if(m_properties.type != JobType::EncodeScriptCLI)
+		return false;
+	if(!m_pVapourSynthScriptProcessor)
+		return false;
+	return m_pVapourSynthScriptProcessor->coreInfo(a_pCoreInfo);
+}
+
+// END OF bool vsedit::Job::coreInfo(VSCoreInfo * a_pCoreInfo) const
+//==============================================================================
+
 JobProperties vsedit::Job::properties() const
 {
 	return m_properties;
@@ -604,6 +643,15 @@ void vsedit::Job::cleanUpEncoding()
 // END OF void vsedit::Job::cleanUpEncoding()
 //==============================================================================
 
+void vsedit::Job::setOutputParsingThread(QThread * a_pThread)
+{
+	Q_ASSERT(a_pThread);
+	m_pEncoderOutputParser->moveToThread(a_pThread);
+}
+
+// END OF void vsedit::Job::setOutputParsingThread(QThread * a_pThread)
+//==============================================================================
+
 void vsedit::Job::start()
 {
 	if(m_properties.jobState == JobState::Paused)
@@ -632,6 +680,10 @@ void vsedit::Job::start()
 	}
 	else if(!isActive())
 	{
+		QMetaObject::invokeMethod(m_pEncoderOutputParser, "slotReset");
+		m_properties.encoderStatus.clear();
+		m_properties.encoderFps = 0.0;
+		m_properties.encoderBitrate = 0.0;
 		m_properties.timeStarted = QDateTime::currentDateTimeUtc();
 		changeStateAndNotify(JobState::Running);
 		emit signalStartTimeChanged();
@@ -776,24 +828,59 @@ void vsedit::Job::slotProcessStarted()
 void vsedit::Job::slotProcessFinished(int a_exitCode,
 	QProcess::ExitStatus a_exitStatus)
 {
+	slotProcessReadyReadStandardError();
+
+	// The sanity check process finishes inside waitForFinished() and
+	// the encoder is started right after it. Its flush is ignored so it
+	// can not be taken for the end of the real encode.
+	if((m_properties.type == JobType::EncodeScriptCLI) &&
+		((m_encodingState == EncodingState::CheckingEncoderSanity) ||
+		(m_encodingState == EncodingState::Idle)))
+	{
+		m_ignoredFlushes++;
+		QMetaObject::invokeMethod(m_pEncoderOutputParser, "slotFlush");
+		return;
+	}
+
+	m_exitCode = a_exitCode;
+	m_exitStatus = a_exitStatus;
+
+	// The parser may live in another thread. The state changes after
+	// its last lines and status have arrived, see
+	// slotEncoderOutputFlushed().
+	QMetaObject::invokeMethod(m_pEncoderOutputParser, "slotFlush");
+}
+
+// END OF void vsedit::Job::slotProcessFinished(int a_exitCode,
+//		QProcess::ExitStatus a_exitStatus)
+//==============================================================================
+
+void vsedit::Job::slotEncoderOutputFlushed()
+{
+	// flushes are delivered in the order they were queued
+	if(m_ignoredFlushes > 0)
+	{
+		m_ignoredFlushes--;
+		return;
+	}
+
 	if(m_properties.type == JobType::EncodeScriptCLI)
 	{
 		EncodingState workingStates[] = {EncodingState::WaitingForFrames,
 			EncodingState::WritingFrame, EncodingState::WritingHeader};
 
-		if(m_encodingState == EncodingState::CheckingEncoderSanity)
-			return;
-		else if(m_encodingState == EncodingState::Idle)
+		// cleaned up meanwhile, by an error for example
+		if(m_encodingState == EncodingState::Idle)
 			return;
 		else if(m_encodingState == EncodingState::Finishing)
 			changeStateAndNotify(JobState::CompletedCleanUp);
 		else if(vsedit::contains(workingStates, m_encodingState))
 		{
-			QString exitStatusString = (a_exitStatus == QProcess::CrashExit) ?
+			QString exitStatusString = (m_exitStatus == QProcess::CrashExit) ?
                 tr("crash") : tr("normal exit");
             emit signalLogMessage(tr("Encoder has finished "
 				"unexpectedly.\nReason: %1; exit code: %2")
-				.arg(exitStatusString).arg(a_exitCode), LOG_STYLE_ERROR);
+				.arg(exitStatusString).arg(m_exitCode), LOG_STYLE_ERROR);
 			changeStateAndNotify(JobState::FailedCleanUp);
 		}
 
@@ -806,23 +893,22 @@ void vsedit::Job::slotProcessFinished(int a_exitCode,
 		QString logStyle = LOG_STYLE_POSITIVE;
 		JobState nextState = JobState::Completed;
 
-		if(a_exitStatus == QProcess::CrashExit)
+		if(m_exitStatus == QProcess::CrashExit)
 		{
             message = tr("Process has crashed.");
 			logStyle = LOG_STYLE_ERROR;
 			nextState = JobState::Failed;
 		}
-		else if(a_exitCode != 0)
+		else if(m_exitCode != 0)
 			logStyle = LOG_STYLE_WARNING;
 
         emit signalLogMessage(tr("%1 Exit code: %2")
-			.arg(message).arg(a_exitCode), logStyle);
+			.arg(message).arg(m_exitCode), logStyle);
 		changeStateAndNotify(nextState);
 	}
 }
 
-// END OF void vsedit::Job::slotProcessFinished(int a_exitCode,
-//		QProcess::ExitStatus a_exitStatus)
+// END OF void vsedit::Job::slotEncoderOutputFlushed()
 //==============================================================================
 
 void vsedit::Job::slotProcessError(QProcess::ProcessError a_error)
@@ -1043,15 +1129,36 @@ void vsedit::Job::slotProcessBytesWritten(qint64 a_bytes)
 void vsedit::Job::slotProcessReadyReadStandardError()
 {
 	QByteArray standardError = m_process.readAllStandardError();
-	QString standardErrorText = QString::fromUtf8(standardError);
-	standardErrorText = standardErrorText.trimmed();
-	if(!standardErrorText.isEmpty())
-		emit signalLogMessage(standardErrorText);
+	if(standardError.isEmpty())
+		return;
+	QMetaObject::invokeMethod(m_pEncoderOutputParser, "slotParse",
+		Q_ARG(QByteArray, standardError));
 }
 
 // END OF void vsedit::Job::slotProcessReadyReadStandardError()
 //==============================================================================
 
+void vsedit::Job::slotEncoderLogLines(const QString & a_lines)
+{
+	emit signalLogMessage(a_lines);
+}
+
+// END OF void vsedit::Job::slotEncoderLogLines(const QString & a_lines)
+//==============================================================================
+
+void vsedit::Job::slotEncoderStatusChanged(const QString & a_status,
+	double a_fps, double a_bitrate)
+{
+	m_properties.encoderStatus = a_status;
+	m_properties.encoderFps = a_fps;
+	m_properties.encoderBitrate = a_bitrate;
+	emit signalEncoderStatusChanged();
+}
+
+// END OF void vsedit::Job::slotEncoderStatusChanged(const QString & a_status,
+//		double a_fps, double a_bitrate)
+//==============================================================================
+
 void vsedit::Job::slotWriteLogMessage(int a_messageType,
 	const QString & a_message)
 {
@@ -1288,6 +1395,9 @@ void vsedit::Job::changeStateAndNotify(JobState a_state)
 		m_memorizedEncodingTime = 0.0;
 		m_properties.fps = 0.0;
 		m_properties.framesProcessed = 0;
+		m_properties.encoderStatus.clear();
+		m_properties.encoderFps = 0.0;
+		m_properties.encoderBitrate = 0.0;
 	}
 
 	emit signalStateChanged(m_properties.jobState, oldState);
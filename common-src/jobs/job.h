@@ -19,10 +19,13 @@ class SettingsManagerCore;
 class VSScriptLibrary;
 class VapourSynthScriptProcessor;
 class FrameHeaderWriter;
+class QThread;
 
 namespace vsedit
 {
 
+class EncoderOutputParser;
+
 class Job : public QObject, public JobVariables
 {
 	Q_OBJECT
@@ -97,6 +100,9 @@ public:
 	virtual size_t framesInProcess() const;
 	virtual size_t maxThreads() const;
 
+	virtual qint64 encoderProcessId() const;
+	virtual bool coreInfo(VSCoreInfo * a_pCoreInfo) const;
+
 	virtual JobProperties properties() const;
 	virtual bool setProperties(const JobProperties & a_properties);
 
@@ -106,6 +112,8 @@ public:
 
 	virtual void cleanUpEncoding();
 
+	virtual void setOutputParsingThread(QThread * a_pThread);
+
 public slots:
 
 	virtual void start();
@@ -119,6 +127,7 @@ signals:
 	void signalProgressChanged();
 	void signalStartTimeChanged();
 	void signalEndTimeChanged();
+	void signalEncoderStatusChanged();
 
 	void signalLogMessage(const QString & a_message,
 		const QString & a_style = LOG_STYLE_DEFAULT);
@@ -133,6 +142,11 @@ protected slots:
 	virtual void slotProcessBytesWritten(qint64 a_bytes);
 	virtual void slotProcessReadyReadStandardError();
 
+	virtual void slotEncoderLogLines(const QString & a_lines);
+	virtual void slotEncoderStatusChanged(const QString & a_status,
+		double a_fps, double a_bitrate);
+	virtual void slotEncoderOutputFlushed();
+
 	virtual void slotWriteLogMessage(int a_messageType,
 		const QString & a_message);
 	virtual void slotFrameQueueStateChanged(size_t a_inQueue,
@@ -172,6 +186,15 @@ protected:
 
 	QProcess m_process;
 
+	EncoderOutputParser * m_pEncoderOutputParser;
+
+	// The process result is handled once the parser has flushed
+	// the last of the encoder output.
+	int m_exitCode;
+	QProcess::ExitStatus m_exitStatus;
+	// queued flushes of processes whose finish was handled already
+	int m_ignoredFlushes;
+
 	std::vector<char> m_framebuffer;
 
 	int m_lastFrameProcessed;
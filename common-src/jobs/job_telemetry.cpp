@@ -0,0 +1,88 @@
+#include "job_telemetry.h"
+
+#include <QVariant>
+
+//==============================================================================
+
+const char JT_TIME[] = "t";
+const char JT_VS_CPU[] = "vsCpu";
+const char JT_VS_RSS[] = "vsRss";
+const char JT_VS_READ_RATE[] = "vsRead";
+const char JT_VS_WRITE_RATE[] = "vsWrite";
+const char JT_ENCODER_CPU[] = "encCpu";
+const char JT_ENCODER_RSS[] = "encRss";
+const char JT_ENCODER_READ_RATE[] = "encRead";
+const char JT_ENCODER_WRITE_RATE[] = "encWrite";
+const char JT_FRAMEBUFFER_USED[] = "fbUsed";
+const char JT_FRAMEBUFFER_MAX[] = "fbMax";
+const char JT_FRAMES_IN_QUEUE[] = "inQueue";
+const char JT_FRAMES_IN_PROCESS[] = "inProcess";
+
+//==============================================================================
+
+JobTelemetrySample::JobTelemetrySample() :
+	  time(0)
+	, vsCpu(0.0)
+	, vsRss(0)
+	, vsReadRate(0.0)
+	, vsWriteRate(0.0)
+	, encoderCpu(0.0)
+	, encoderRss(0)
+	, encoderReadRate(0.0)
+	, encoderWriteRate(0.0)
+	, framebufferUsed(0)
+	, framebufferMax(0)
+	, framesInQueue(0)
+	, framesInProcess(0)
+{
+}
+
+// END OF JobTelemetrySample::JobTelemetrySample()
+//==============================================================================
+
+QJsonObject JobTelemetrySample::toJson() const
+{
+	QJsonObject jsSample;
+	jsSample[JT_TIME] = time;
+	jsSample[JT_VS_CPU] = vsCpu;
+	jsSample[JT_VS_RSS] = vsRss;
+	jsSample[JT_VS_READ_RATE] = vsReadRate;
+	jsSample[JT_VS_WRITE_RATE] = vsWriteRate;
+	jsSample[JT_ENCODER_CPU] = encoderCpu;
+	jsSample[JT_ENCODER_RSS] = encoderRss;
+	jsSample[JT_ENCODER_READ_RATE] = encoderReadRate;
+	jsSample[JT_ENCODER_WRITE_RATE] = encoderWriteRate;
+	jsSample[JT_FRAMEBUFFER_USED] = framebufferUsed;
+	jsSample[JT_FRAMEBUFFER_MAX] = framebufferMax;
+	jsSample[JT_FRAMES_IN_QUEUE] = framesInQueue;
+	jsSample[JT_FRAMES_IN_PROCESS] = framesInProcess;
+	return jsSample;
+}
+
+// END OF QJsonObject JobTelemetrySample::toJson() const
+//==============================================================================
+
+JobTelemetrySample JobTelemetrySample::fromJson(const QJsonObject & a_object)
+{
+	JobTelemetrySample sample;
+	sample.time = a_object[JT_TIME].toVariant().toLongLong();
+	sample.vsCpu = a_object[JT_VS_CPU].toDouble();
+	sample.vsRss = a_object[JT_VS_RSS].toVariant().toLongLong();
+	sample.vsReadRate = a_object[JT_VS_READ_RATE].toDouble();
+	sample.vsWriteRate = a_object[JT_VS_WRITE_RATE].toDouble();
+	sample.encoderCpu = a_object[JT_ENCODER_CPU].toDouble();
+	sample.encoderRss = a_object[JT_ENCODER_RSS].toVariant().toLongLong();
+	sample.encoderReadRate = a_object[JT_ENCODER_READ_RATE].toDouble();
+	sample.encoderWriteRate = a_object[JT_ENCODER_WRITE_RATE].toDouble();
+	sample.framebufferUsed =
+		a_object[JT_FRAMEBUFFER_USED].toVariant().toLongLong();
+	sample.framebufferMax =
+		a_object[JT_FRAMEBUFFER_MAX].toVariant().toLongLong();
+	sample.framesInQueue = a_object[JT_FRAMES_IN_QUEUE].toInt();
+	sample.framesInProcess = a_object[JT_FRAMES_IN_PROCESS].toInt();
+	return sample;
+}
+
+// END OF JobTelemetrySample JobTelemetrySample::fromJson(
+//		const QJsonObject & a_object)
+//==============================================================================
@@ -0,0 +1,50 @@
+#ifndef JOB_TELEMETRY_H_INCLUDED
+#define JOB_TELEMETRY_H_INCLUDED
+
+#include <QJsonObject>
+#include <QtGlobal>
+
+extern const char JT_TIME[];
+extern const char JT_VS_CPU[];
+extern const char JT_VS_RSS[];
+extern const char JT_VS_READ_RATE[];
+extern const char JT_VS_WRITE_RATE[];
+extern const char JT_ENCODER_CPU[];
+extern const char JT_ENCODER_RSS[];
+extern const char JT_ENCODER_READ_RATE[];
+extern const char JT_ENCODER_WRITE_RATE[];
+extern const char JT_FRAMEBUFFER_USED[];
+extern const char JT_FRAMEBUFFER_MAX[];
+extern const char JT_FRAMES_IN_QUEUE[];
+extern const char JT_FRAMES_IN_PROCESS[];
+
+/// Resource usage of a running job at one point in time.
+/// CPU usage is in percent of one core, I/O rates are in bytes per second.
+/// The VapourSynth side is measured for the whole process running the
+/// script, the encoder side for the encoder process only.
+struct JobTelemetrySample
+{
+	qint64 time;
+
+	double vsCpu;
+	qint64 vsRss;
+	double vsReadRate;
+	double vsWriteRate;
+
+	double encoderCpu;
+	qint64 encoderRss;
+	double encoderReadRate;
+	double encoderWriteRate;
+
+	qint64 framebufferUsed;
+	qint64 framebufferMax;
+	int framesInQueue;
+	int framesInProcess;
+
+	JobTelemetrySample();
+
+	QJsonObject toJson() const;
+	static JobTelemetrySample fromJson(const QJsonObject & a_object);
+};
+
+#endif // JOB_TELEMETRY_H_INCLUDED
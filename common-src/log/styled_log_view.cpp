@@ -7,6 +7,9 @@
 #include <QDir>
 #include <QFileDialog>
 #include <QFile>
+#include <QTextStream>
+#include <QTextCursor>
+#include <QTextBlock>
 
 //==============================================================================
 
@@ -20,8 +23,12 @@ StyledLogView::StyledLogView(QWidget * a_pParent) :
 	, m_pContextMenu(nullptr)
 	, m_pSettingsDialog(nullptr)
 	, m_maxEntriesToShow(DEFAULT_MAX_ENTRIES_TO_SHOW)
+	, m_shownEntries(0)
+	, m_hiddenEntries(0)
+	, m_groupOpen(false)
 {
 	setReadOnly(true);
+	setUndoRedoEnabled(false);
 	setContextMenuPolicy(Qt::CustomContextMenu);
 	addStyle(TextBlockStyle(LOG_STYLE_DEFAULT));
 	createActionsAndMenus();
@@ -142,6 +149,7 @@ void StyledLogView::startNewBlock()
 	if(m_entries.back().isDivider)
 		return;
 	m_entries.push_back(LogEntry::divider());
+	appendToView(m_entries.back());
 }
 
 // END OF void StyledLogView::startNewBlock()
@@ -161,7 +169,7 @@ bool StyledLogView::setMillisecondsToDivideBlocks(qint64 a_value)
 		return false;
 
 	m_millisecondsToDivideBlocks = a_value;
-	updateHtml();
+	updateView();
 	return true;
 }
 
@@ -194,14 +202,16 @@ bool StyledLogView::saveHtml(const QString & a_filePath,
 	if(!result)
 		return false;
 
-	QByteArray htmlData = realHtml(a_excludeFiltered).toUtf8();
-	qint64 bytesWritten = file.write(htmlData);
-	file.close();
+	QTextStream stream(&file);
+	stream.setCodec("UTF-8");
+	writeHtml(stream, a_excludeFiltered);
+	stream.flush();
 
-	if(bytesWritten != htmlData.size())
-		return false;
+	result = (stream.status() == QTextStream::Ok) &&
+		(file.error() == QFileDevice::NoError);
+	file.close();
 
-	return true;
+	return result;
 }
 
 // END OF bool StyledLogView::saveHtml(const QString & a_filePath,
@@ -231,7 +241,7 @@ bool StyledLogView::saveHtml(bool a_excludeFiltered)
 void StyledLogView::addEntry(const QString & a_text, const QString & a_style)
 {
 	m_entries.push_back(LogEntry(a_text, a_style));
-	updateHtml();
+	appendToView(m_entries.back());
 }
 
 // END OF void StyledLogView::addEntry(const QString & a_text,
@@ -241,7 +251,7 @@ void StyledLogView::addEntry(const QString & a_text, const QString & a_style)
 void StyledLogView::addEntry(const LogEntry & a_entry)
 {
 	m_entries.push_back(a_entry);
-	updateHtml();
+	appendToView(m_entries.back());
 }
 
 // END OF void void StyledLogView::addEntry(const LogEntry & a_entry)
@@ -250,7 +260,7 @@ void StyledLogView::addEntry(const LogEntry & a_entry)
 void StyledLogView::clear()
 {
 	m_entries.clear();
-	QTextEdit::clear();
+	updateView();
 }
 
 // END OF void StyledLogView::clear()
@@ -295,124 +305,187 @@ void StyledLogView::slotLogSettings()
 void StyledLogView::slotLogSettingsChanged()
 {
 	m_styles = m_pSettingsDialog->styles();
-	updateHtml();
+	updateView();
 }
 
 // END OF void StyledLogView::slotLogSettingsChanged()
 //==============================================================================
 
-void StyledLogView::updateHtml()
+void StyledLogView::updateView()
 {
-	if(m_entries.empty())
+	QTextEdit::clear();
+	m_shownGroups.clear();
+	m_shownEntries = 0;
+	m_hiddenEntries = 0;
+	m_groupOpen = false;
+	m_lastTime = QDateTime();
+	m_lastStyle.clear();
+
+	// Only the entries that fit into the view are laid out.
+	size_t firstEntryToShow = m_entries.size();
+	size_t entriesToShow = 0;
+	while((firstEntryToShow > 0) && (entriesToShow < m_maxEntriesToShow))
 	{
-		QTextEdit::clear();
-		return;
+		firstEntryToShow--;
+		const LogEntry & entry = m_entries[firstEntryToShow];
+		if((!entry.isDivider) && getStyle(entry.style).isVisible)
+			entriesToShow++;
 	}
 
-	QString borderColor = palette().color(QPalette::Dark).name();
+	for(size_t i = 0; i < firstEntryToShow; ++i)
+	{
+		const LogEntry & entry = m_entries[i];
+		if((!entry.isDivider) && getStyle(entry.style).isVisible)
+			m_hiddenEntries++;
+	}
 
-	QString html = QString(
-		"<body>\n"
-		"<style type=\"text/css\">\n"
-		"table {"
-			"border-width: 1px;"
-			"border-style: solid;"
-			"border-color: {table-border-color};"
-		"}\n"
-		"div {"
-			"margin-left: 2px;"
-			"margin-top: 2px;"
-			"margin-right: 2px;"
-			"margin-bottom: 2px;"
-		"}\n"
-		"</style>\n"
-		"<table width=\"100%\" cellspacing=\"-1\">\n"
-		).replace("{table-border-color}", borderColor);
+	updateHiddenEntriesNotice();
 
-	bool openBlock = false;
-	QDateTime lastTime;
-	QString lastStyle;
+	for(size_t i = firstEntryToShow; i < m_entries.size(); ++i)
+		appendToView(m_entries[i]);
+}
+
+// END OF void StyledLogView::updateView()
+//==============================================================================
+
+void StyledLogView::appendToView(const LogEntry & a_entry)
+{
+	TextBlockStyle style = getStyle(a_entry.style);
 
-	size_t firstEntryToShow = 0;
+	if(!style.isVisible)
+		return;
 
-	if(m_entries.size() > m_maxEntriesToShow)
+	if(m_groupOpen)
 	{
-		firstEntryToShow = m_entries.size() - m_maxEntriesToShow;
-        html += tr("<tr><td align=\"center\">%1 entries not shown. "
-			"Save the log to read.</td></tr>\n").arg(firstEntryToShow);
+		if(a_entry.isDivider ||
+			(m_lastTime.msecsTo(a_entry.time) > m_millisecondsToDivideBlocks) ||
+			(a_entry.style != m_lastStyle))
+			m_groupOpen = false;
 	}
 
-	for(size_t i = firstEntryToShow; i < m_entries.size(); ++i)
+	m_lastStyle = a_entry.style;
+	m_lastTime = a_entry.time;
+
+	if(a_entry.isDivider)
+		return;
+
+	QTextCharFormat format = style.textFormat;
+
+	QTextBlockFormat blockFormat;
+	blockFormat.setBackground(format.background());
+	blockFormat.setLeftMargin(2.0);
+	blockFormat.setRightMargin(2.0);
+
+	QTextCursor cursor(document());
+	cursor.movePosition(QTextCursor::End);
+
+	if(!m_groupOpen)
 	{
-		const LogEntry & entry = m_entries[i];
+		QTextBlockFormat headerFormat = blockFormat;
+		headerFormat.setTopMargin(3.0);
+		QTextCharFormat timeFormat;
+		timeFormat.setForeground(format.foreground());
+		qreal pointSize = document()->defaultFont().pointSizeF();
+		if(pointSize > 0.0)
+			timeFormat.setFontPointSize(pointSize * 0.75);
+		cursor.insertBlock(headerFormat, timeFormat);
+		cursor.insertText(a_entry.time.toString("yyyy-MM-dd hh:mm:ss.zzz"),
+			timeFormat);
+		m_shownGroups.push_back(0);
+		m_groupOpen = true;
+	}
 
-		TextBlockStyle style = getStyle(entry.style);
+	QTextCharFormat textFormat = format;
+	textFormat.clearBackground();
+	QString text = a_entry.text;
+	text.replace('\n', QChar::LineSeparator);
+	cursor.insertBlock(blockFormat, textFormat);
+	cursor.insertText(text, textFormat);
 
-		if(!style.isVisible)
-			continue;
+	m_shownGroups.back()++;
+	m_shownEntries++;
 
-		if(openBlock)
-		{
-			if(entry.isDivider ||
-				(lastTime.msecsTo(entry.time) > m_millisecondsToDivideBlocks) ||
-				(entry.style != lastStyle))
-			{
-				html += QString("</td></tr>\n");
-				openBlock = false;
-			}
-		}
+	trimView();
 
-		lastStyle = entry.style;
-		lastTime = entry.time;
+	verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+}
 
-		if(entry.isDivider)
-			continue;
+// END OF void StyledLogView::appendToView(const LogEntry & a_entry)
+//==============================================================================
 
-		QTextCharFormat format = style.textFormat;
-		QFont styleFont = format.font();
+void StyledLogView::trimView()
+{
+	if(m_shownEntries <= m_maxEntriesToShow)
+		return;
 
-		if(!openBlock)
+	while((m_shownEntries > m_maxEntriesToShow) && (!m_shownGroups.empty()))
+	{
+		// Block 0 is the notice, block 1 is the oldest timestamp.
+		if(m_shownGroups.front() > 1)
 		{
-			html += QString("<tr bgcolor=\"%1\"><td>")
-				.arg(format.background().color().name());
-			QString timeString = entry.time.toString("yyyy-MM-dd hh:mm:ss.zzz");
-			html += QString("<div><font size=\"-2\" "
-				"color=\"%1\">%2</font></div>")
-				.arg(format.foreground().color().name())
-				.arg(timeString);
-			openBlock = true;
+			removeViewBlocks(2, 1);
+			m_shownGroups.front()--;
 		}
+		else
+		{
+			removeViewBlocks(1, 2);
+			m_shownGroups.pop_front();
+		}
+		m_shownEntries--;
+		m_hiddenEntries++;
+	}
 
-		QString entryHtml = entry.text;
-		entryHtml.replace("\n", "<br>");
+	updateHiddenEntriesNotice();
+}
 
-		if(styleFont.bold())
-			entryHtml = QString("<b>%1</b>").arg(entryHtml);
-		if(styleFont.italic())
-			entryHtml = QString("<i>%1</i>").arg(entryHtml);
-		if(styleFont.underline())
-			entryHtml = QString("<u>%1</u>").arg(entryHtml);
-		if(styleFont.strikeOut())
-			entryHtml = QString("<s>%1</s>").arg(entryHtml);
+// END OF void StyledLogView::trimView()
+//==============================================================================
 
-		html += QString("<div><font face=\"%1\" "
-			"color=\"%2\">%3</font></div>")
-			.arg(styleFont.family())
-			.arg(format.foreground().color().name())
-			.arg(entryHtml);
-	}
+void StyledLogView::removeViewBlocks(int a_firstBlock, int a_count)
+{
+	Q_ASSERT(a_firstBlock > 0);
+	QTextBlock firstBlock = document()->findBlockByNumber(a_firstBlock);
+	if(!firstBlock.isValid())
+		return;
+	QTextBlock nextBlock =
+		document()->findBlockByNumber(a_firstBlock + a_count);
+
+	// Remove the separators preceding the blocks, so the following block
+	// keeps its own format.
+	QTextCursor cursor(document());
+	cursor.setPosition(firstBlock.position() - 1);
+	if(nextBlock.isValid())
+		cursor.setPosition(nextBlock.position() - 1, QTextCursor::KeepAnchor);
+	else
+		cursor.movePosition(QTextCursor::End, QTextCursor::KeepAnchor);
+	cursor.removeSelectedText();
+}
 
-	if(openBlock)
-		html += QString("</td></tr>\n");
+// END OF void StyledLogView::removeViewBlocks(int a_firstBlock, int a_count)
+//==============================================================================
 
-	html += QString("</table>\n</body>");
+void StyledLogView::updateHiddenEntriesNotice()
+{
+	QTextCursor cursor(document()->firstBlock());
+	cursor.movePosition(QTextCursor::EndOfBlock, QTextCursor::KeepAnchor);
 
-	setHtml(html);
+	QTextBlockFormat noticeFormat;
+	if(m_hiddenEntries == 0)
+	{
+		// Collapse the empty notice.
+		noticeFormat.setLineHeight(0.0, QTextBlockFormat::FixedHeight);
+		cursor.setBlockFormat(noticeFormat);
+		cursor.removeSelectedText();
+		return;
+	}
 
-	verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+	noticeFormat.setAlignment(Qt::AlignCenter);
+	cursor.setBlockFormat(noticeFormat);
+	cursor.insertText(tr("%1 entries not shown. Save the log to read.")
+		.arg(m_hiddenEntries));
 }
 
-// END OF void StyledLogView::updateHtml()
+// END OF void StyledLogView::updateHiddenEntriesNotice()
 //==============================================================================
 
 void StyledLogView::createActionsAndMenus()
@@ -459,7 +532,8 @@ void StyledLogView::createActionsAndMenus()
 // END OF void StyledLogView::createActionsAndMenus()
 //==============================================================================
 
-QString StyledLogView::realHtml(bool a_excludeFiltered) const
+void StyledLogView::writeHtml(QTextStream & a_stream,
+	bool a_excludeFiltered) const
 {
     QString title = tr("VapourSynth Editor log ") +
 		QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
@@ -475,7 +549,7 @@ QString StyledLogView::realHtml(bool a_excludeFiltered) const
 
 	styleText += "</style>\n";
 
-	QString html = QString(
+	a_stream << QString(
 		"<!DOCTYPE HTML PUBLIC \"-//W3C//DTD HTML 4.01//EN\" "
 		"\"http://www.w3.org/TR/html4/strict.dtd\">\n"
 		"<html>\n"
@@ -505,7 +579,7 @@ QString StyledLogView::realHtml(bool a_excludeFiltered) const
 				(lastTime.msecsTo(entry.time) > m_millisecondsToDivideBlocks) ||
 				(entry.style != lastStyle))
 			{
-				html += QString("</td></tr>\n");
+				a_stream << QString("</td></tr>\n");
 				openBlock = false;
 			}
 		}
@@ -521,17 +595,17 @@ QString StyledLogView::realHtml(bool a_excludeFiltered) const
 
 		if(!openBlock)
 		{
-			html += QString("<tr bgcolor=\"%1\"><td>\n")
+			a_stream << QString("<tr bgcolor=\"%1\"><td>\n")
 				.arg(format.background().color().name());
 			QString timeString = entry.time.toString("yyyy-MM-dd hh:mm:ss.zzz");
-			html += QString("<p style=\"font-size: 70%; "
+			a_stream << QString("<p style=\"font-size: 70%; "
 				"color: %1;\">%2</p>\n")
 				.arg(format.foreground().color().name())
 				.arg(timeString);
 			openBlock = true;
 		}
 
-		QString entryHtml = entry.text;
+		QString entryHtml = entry.text.toHtmlEscaped();
 		entryHtml.replace("\n", "<br>\n");
 
 		if(styleFont.bold())
@@ -543,19 +617,18 @@ QString StyledLogView::realHtml(bool a_excludeFiltered) const
 		if(styleFont.strikeOut())
 			entryHtml = QString("<s>%1</s>").arg(entryHtml);
 
-		html += QString("<p style=\"font-family: %1; color: %2;\">%3</p>\n")
+		a_stream << QString("<p style=\"font-family: %1; color: %2;\">%3</p>\n")
 			.arg(styleFont.family())
 			.arg(format.foreground().color().name())
 			.arg(entryHtml);
 	}
 
 	if(openBlock)
-		html += QString("</td>\n</tr>\n");
-
-	html += "</table>\n</body>\n</html>\n";
+		a_stream << QString("</td>\n</tr>\n");
 
-	return html;
+	a_stream << "</table>\n</body>\n</html>\n";
 }
 
-// END OF QString StyledLogView::realHtml(bool a_excludeFiltered) const
+// END OF void StyledLogView::writeHtml(QTextStream & a_stream,
+//		bool a_excludeFiltered) const
 //==============================================================================
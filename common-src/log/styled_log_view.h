@@ -4,9 +4,12 @@
 #include "styled_log_view_structures.h"
 
 #include <QTextEdit>
+#include <QDateTime>
 #include <vector>
+#include <deque>
 
 class StyledLogViewSettingsDialog;
+class QTextStream;
 
 class StyledLogView : public QTextEdit
 {
@@ -64,11 +67,20 @@ protected slots:
 
 protected:
 
-	virtual void updateHtml();
+	virtual void updateView();
+
+	virtual void appendToView(const LogEntry & a_entry);
+
+	virtual void trimView();
+
+	virtual void removeViewBlocks(int a_firstBlock, int a_count);
+
+	virtual void updateHiddenEntriesNotice();
 
 	virtual void createActionsAndMenus();
 
-	virtual QString realHtml(bool a_excludeFiltered = false) const;
+	virtual void writeHtml(QTextStream & a_stream,
+		bool a_excludeFiltered = false) const;
 
 	std::vector<TextBlockStyle> m_styles;
 	std::vector<LogEntry> m_entries;
@@ -80,6 +92,17 @@ protected:
 	StyledLogViewSettingsDialog * m_pSettingsDialog;
 
 	size_t m_maxEntriesToShow;
+
+	// The document holds the latest entries only. New entries are
+	// appended to it and the oldest ones are removed from its top.
+	// The first block holds a notice about the removed entries,
+	// followed by a timestamp block and entry blocks for each group.
+	std::deque<size_t> m_shownGroups;
+	size_t m_shownEntries;
+	size_t m_hiddenEntries;
+	bool m_groupOpen;
+	QDateTime m_lastTime;
+	QString m_lastStyle;
 };
 
 #endif // STYLED_LOG_VIEW_H_INCLUDED
@@ -70,6 +70,7 @@ bool VSEditorLog::loadSettings()
 			style = *it;
 	}
 
+	updateView();
 	return true;
 }
 
@@ -33,8 +33,16 @@ const int DEFAULT_LAST_PREVIEW_FRAME = 0;
 const bool DEFAULT_HIGHLIGHT_SELECTION_MATCHES = true;
 const int DEFAULT_HIGHLIGHT_SELECTION_MATCHES_MIN_LENGTH = 3;
 const bool DEFAULT_TIMELINE_PANEL_VISIBLE = true;
+const bool DEFAULT_TIMELINE_STRIP_VISIBLE = false;
+const bool DEFAULT_PLAYBACK_DROP_LATE_FRAMES = true;
+const PreviewProxyMode DEFAULT_PREVIEW_PROXY_MODE = PreviewProxyMode::Viewport;
+const double DEFAULT_PREVIEW_PROXY_FRACTION = 0.25;
+const int DEFAULT_PREVIEW_DISPLAY_BIT_DEPTH = 8;
+const HdrTonemapMode DEFAULT_HDR_TONEMAP_MODE = HdrTonemapMode::Off;
+const double DEFAULT_HDR_PEAK_LUMINANCE = 1000.0;
 const bool DEFAULT_ALWAYS_KEEP_CURRENT_FRAME = true;
 const QString DEFAULT_LAST_SNAPSHOT_EXTENSION = "png";
+const QString DEFAULT_FRAME_EXPORT_FILE_NAME_TEMPLATE = "{script} - {frame}";
 const int DEFAULT_FPS_DISPLAY_PRECISION = 3;
 const double DEFAULT_TIMELINE_LABELS_HEIGHT = 5.0;
 const char DEFAULT_DROP_FILE_TEMPLATE[] = "r\'{f}\'";
@@ -68,6 +76,7 @@ const char ACTION_ID_PREVIEW[] = "preview";
 const char ACTION_ID_CHECK_SCRIPT[] = "check_script";
 const char ACTION_ID_RELEASE_MEMORY[] = "release_memory";
 const char ACTION_ID_BENCHMARK[] = "benchmark";
+const char ACTION_ID_CLIP_METRICS[] = "clip_metrics";
 const char ACTION_ID_CLI_ENCODE[] = "cli_encode";
 const char ACTION_ID_ENQUEUE_ENCODE_JOB[] = "enqueue_encode_job";
 const char ACTION_ID_JOBS[] = "jobs";
@@ -85,6 +94,7 @@ const char ACTION_ID_PLUGINS_FOLDER[] = "plugins_folder";
 const char ACTION_ID_SCRIPTS_FOLDER[] = "scripts_folder";
 const char ACTION_ID_AUTOCOMPLETE[] = "autocomplete";
 const char ACTION_ID_SAVE_SNAPSHOT[] = "save_snapshot";
+const char ACTION_ID_EXPORT_FRAMES[] = "export_frames";
 const char ACTION_ID_TOGGLE_ZOOM_PANEL[] = "toggle_zoom_panel";
 const char ACTION_ID_SET_ZOOM_MODE_NO_ZOOM[] = "set_zoom_mode_no_zoom";
 const char ACTION_ID_SET_ZOOM_MODE_FIXED_RATIO[] = "set_zoom_mode_fixed_ratio";
@@ -98,6 +108,13 @@ const char ACTION_ID_PASTE_CROP_SNIPPET_INTO_SCRIPT[] =
 	"paste_crop_snippet_into_script";
 const char ACTION_ID_FRAME_TO_CLIPBOARD[] = "frame_to_clipboard";
 const char ACTION_ID_TOGGLE_TIMELINE_PANEL[] = "toggle_timeline_panel";
+const char ACTION_ID_TOGGLE_TIMELINE_STRIP[] = "toggle_timeline_strip";
+const char ACTION_ID_TOGGLE_DROP_LATE_FRAMES[] = "toggle_drop_late_frames";
+const char ACTION_ID_SET_PREVIEW_PROXY_OFF[] = "set_preview_proxy_off";
+const char ACTION_ID_SET_PREVIEW_PROXY_VIEWPORT[] =
+	"set_preview_proxy_viewport";
+const char ACTION_ID_SET_PREVIEW_PROXY_FRACTION[] =
+	"set_preview_proxy_fraction";
 const char ACTION_ID_SET_TIMELINE_MODE_TIME[] = "set_timeline_mode_time";
 const char ACTION_ID_SET_TIMELINE_MODE_FRAMES[] = "set_timeline_mode_frames";
 const char ACTION_ID_TIME_STEP_FORWARD[] = "time_step_forward";
@@ -114,6 +131,7 @@ const char ACTION_ID_SHOW_BOOKMARK_MANAGER[] = "show_bookmark_manager";
 const char ACTION_ID_SHOW_FRAME_INFO_DIALOG[] = "show_frame_info_dialog";
 const char ACTION_ID_SHOW_PREVIEW_FILTERS_DIALOG[] = "show_preview_filters_dialog";
 const char ACTION_ID_SHOW_SELECTION_TOOLS_DIALOG[] = "show_selection_tools_dialog";
+const char ACTION_ID_SHOW_SCOPES_DIALOG[] = "show_scopes_dialog";
 const char ACTION_ID_TIMELINE_BOOKMARK_CURRENT_FRAME[] =
 	"timeline_bookmark_current_frame";
 const char ACTION_ID_PASTE_SHOWN_FRAME_NUMBER_INTO_SCRIPT[] =
@@ -19,6 +19,21 @@ enum class ZoomMode
 	FitToFrame,
 };
 
+enum class PreviewProxyMode
+{
+	Off,
+	Viewport,
+	Fraction,
+};
+
+enum class HdrTonemapMode
+{
+	Off,
+	Auto,
+	PQ,
+	HLG,
+};
+
 enum class CropMode
 {
 	Absolute,
@@ -113,8 +128,16 @@ extern const int DEFAULT_LAST_PREVIEW_FRAME;
 extern const bool DEFAULT_HIGHLIGHT_SELECTION_MATCHES;
 extern const int DEFAULT_HIGHLIGHT_SELECTION_MATCHES_MIN_LENGTH;
 extern const bool DEFAULT_TIMELINE_PANEL_VISIBLE;
+extern const bool DEFAULT_TIMELINE_STRIP_VISIBLE;
+extern const bool DEFAULT_PLAYBACK_DROP_LATE_FRAMES;
+extern const PreviewProxyMode DEFAULT_PREVIEW_PROXY_MODE;
+extern const double DEFAULT_PREVIEW_PROXY_FRACTION;
+extern const int DEFAULT_PREVIEW_DISPLAY_BIT_DEPTH;
+extern const HdrTonemapMode DEFAULT_HDR_TONEMAP_MODE;
+extern const double DEFAULT_HDR_PEAK_LUMINANCE;
 extern const bool DEFAULT_ALWAYS_KEEP_CURRENT_FRAME;
 extern const QString DEFAULT_LAST_SNAPSHOT_EXTENSION;
+extern const QString DEFAULT_FRAME_EXPORT_FILE_NAME_TEMPLATE;
 extern const int DEFAULT_FPS_DISPLAY_PRECISION;
 extern const double DEFAULT_TIMELINE_LABELS_HEIGHT;
 extern const char DEFAULT_DROP_FILE_TEMPLATE[];
@@ -147,6 +170,7 @@ extern const char ACTION_ID_PREVIEW[];
 extern const char ACTION_ID_CHECK_SCRIPT[];
 extern const char ACTION_ID_RELEASE_MEMORY[];
 extern const char ACTION_ID_BENCHMARK[];
+extern const char ACTION_ID_CLIP_METRICS[];
 extern const char ACTION_ID_CLI_ENCODE[];
 extern const char ACTION_ID_ENQUEUE_ENCODE_JOB[];
 extern const char ACTION_ID_JOBS[];
@@ -164,6 +188,7 @@ extern const char ACTION_ID_PLUGINS_FOLDER[];
 extern const char ACTION_ID_SCRIPTS_FOLDER[];
 extern const char ACTION_ID_AUTOCOMPLETE[];
 extern const char ACTION_ID_SAVE_SNAPSHOT[];
+extern const char ACTION_ID_EXPORT_FRAMES[];
 extern const char ACTION_ID_TOGGLE_ZOOM_PANEL[];
 extern const char ACTION_ID_SET_ZOOM_MODE_NO_ZOOM[];
 extern const char ACTION_ID_SET_ZOOM_MODE_FIXED_RATIO[];
@@ -173,6 +198,11 @@ extern const char ACTION_ID_SET_ZOOM_SCALE_MODE_BILINEAR[];
 extern const char ACTION_ID_PASTE_CROP_SNIPPET_INTO_SCRIPT[];
 extern const char ACTION_ID_FRAME_TO_CLIPBOARD[];
 extern const char ACTION_ID_TOGGLE_TIMELINE_PANEL[];
+extern const char ACTION_ID_TOGGLE_TIMELINE_STRIP[];
+extern const char ACTION_ID_TOGGLE_DROP_LATE_FRAMES[];
+extern const char ACTION_ID_SET_PREVIEW_PROXY_OFF[];
+extern const char ACTION_ID_SET_PREVIEW_PROXY_VIEWPORT[];
+extern const char ACTION_ID_SET_PREVIEW_PROXY_FRACTION[];
 extern const char ACTION_ID_SET_TIMELINE_MODE_TIME[];
 extern const char ACTION_ID_SET_TIMELINE_MODE_FRAMES[];
 extern const char ACTION_ID_TIME_STEP_FORWARD[];
@@ -189,6 +219,7 @@ extern const char ACTION_ID_SHOW_BOOKMARK_MANAGER[];
 extern const char ACTION_ID_SHOW_FRAME_INFO_DIALOG[];
 extern const char ACTION_ID_SHOW_PREVIEW_FILTERS_DIALOG[];
 extern const char ACTION_ID_SHOW_SELECTION_TOOLS_DIALOG[];
+extern const char ACTION_ID_SHOW_SCOPES_DIALOG[];
 extern const char ACTION_ID_TIMELINE_BOOKMARK_CURRENT_FRAME[];
 extern const char ACTION_ID_PASTE_SHOWN_FRAME_NUMBER_INTO_SCRIPT[];
 extern const char ACTION_ID_SAVE_BOOKMARK_TO_FILE[];
@@ -25,7 +25,16 @@ const int DEFAULT_JOB_LAST_FRAME = -1;
 const int DEFAULT_JOB_FRAMES_PROCESSED = 0;
 const double DEFAULT_JOB_FPS = 0.0;
 const int DEFAULT_RECENT_JOB_SERVERS_NUMBER = 10;
-const int DEFAULT_WINDOW_GEOMETRY_SAVE_DELAY = 2000;
+const int DEFAULT_SETTINGS_FLUSH_DELAY = 2000;
+const int DEFAULT_SETTINGS_FLUSH_MAX_DELAY = 10000;
+const int DEFAULT_JOB_SERVER_PROGRESS_UPDATE_INTERVAL = 250;
+const int DEFAULT_JOB_SERVER_LOG_CAPACITY = 10000;
+const int DEFAULT_JOB_SERVER_LOG_TAIL_SIZE = 500;
+const int DEFAULT_ENCODER_STATUS_UPDATE_INTERVAL = 500;
+const int DEFAULT_JOB_SERVER_HEARTBEAT_INTERVAL = 1000;
+const int DEFAULT_JOB_SERVER_HEARTBEAT_TIMEOUT = 5000;
+const int DEFAULT_JOB_SERVER_TELEMETRY_INTERVAL = 1000;
+const int DEFAULT_JOB_TELEMETRY_HISTORY_SIZE = 120;
 
 //==============================================================================
 
@@ -45,6 +54,8 @@ JobProperties::JobProperties():
 	, lastFrameReal(-1)
 	, framesProcessed(0)
 	, fps(0.0)
+	, encoderFps(0.0)
+	, encoderBitrate(0.0)
 {
 }
 
@@ -129,6 +140,9 @@ const char JP_LAST_FRAME[] = "lastFrame";
 const char JP_LAST_FRAME_REAL[] = "lastFrameReal";
 const char JP_FRAMES_PROCESSED[] = "framesProcessed";
 const char JP_FPS[] = "fps";
+const char JP_ENCODER_STATUS[] = "encoderStatus";
+const char JP_ENCODER_FPS[] = "encoderFps";
+const char JP_ENCODER_BITRATE[] = "encoderBitrate";
 
 QJsonObject JobProperties::toJson() const
 {
@@ -157,6 +171,9 @@ QJsonObject JobProperties::toJson() const
 	jsJob[JP_LAST_FRAME_REAL] = lastFrameReal;
 	jsJob[JP_FRAMES_PROCESSED] = framesProcessed;
 	jsJob[JP_FPS] = fps;
+	jsJob[JP_ENCODER_STATUS] = encoderStatus;
+	jsJob[JP_ENCODER_FPS] = encoderFps;
+	jsJob[JP_ENCODER_BITRATE] = encoderBitrate;
 	return jsJob;
 }
 
@@ -212,6 +229,12 @@ JobProperties JobProperties::fromJson(const QJsonObject & a_object)
 		properties.framesProcessed = a_object[JP_FRAMES_PROCESSED].toInt();
 	if(a_object.contains(JP_FPS))
 		properties.fps = a_object[JP_FPS].toDouble();
+	if(a_object.contains(JP_ENCODER_STATUS))
+		properties.encoderStatus = a_object[JP_ENCODER_STATUS].toString();
+	if(a_object.contains(JP_ENCODER_FPS))
+		properties.encoderFps = a_object[JP_ENCODER_FPS].toDouble();
+	if(a_object.contains(JP_ENCODER_BITRATE))
+		properties.encoderBitrate = a_object[JP_ENCODER_BITRATE].toDouble();
 	return properties;
 }
 
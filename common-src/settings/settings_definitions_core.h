@@ -90,6 +90,9 @@ extern const char JP_LAST_FRAME[];
 extern const char JP_LAST_FRAME_REAL[];
 extern const char JP_FRAMES_PROCESSED[];
 extern const char JP_FPS[];
+extern const char JP_ENCODER_STATUS[];
+extern const char JP_ENCODER_FPS[];
+extern const char JP_ENCODER_BITRATE[];
 
 struct JobProperties
 {
@@ -112,6 +115,9 @@ struct JobProperties
 	int lastFrameReal;
 	int framesProcessed;
 	double fps;
+	QString encoderStatus;
+	double encoderFps;
+	double encoderBitrate;
 
 	JobProperties();
 	JobProperties(const JobProperties &) = default;
@@ -160,7 +166,16 @@ extern const int DEFAULT_JOB_LAST_FRAME;
 extern const int DEFAULT_JOB_FRAMES_PROCESSED;
 extern const double DEFAULT_JOB_FPS;
 extern const int DEFAULT_RECENT_JOB_SERVERS_NUMBER;
-extern const int DEFAULT_WINDOW_GEOMETRY_SAVE_DELAY;
+extern const int DEFAULT_SETTINGS_FLUSH_DELAY;
+extern const int DEFAULT_SETTINGS_FLUSH_MAX_DELAY;
+extern const int DEFAULT_JOB_SERVER_PROGRESS_UPDATE_INTERVAL;
+extern const int DEFAULT_JOB_SERVER_LOG_CAPACITY;
+extern const int DEFAULT_JOB_SERVER_LOG_TAIL_SIZE;
+extern const int DEFAULT_ENCODER_STATUS_UPDATE_INTERVAL;
+extern const int DEFAULT_JOB_SERVER_HEARTBEAT_INTERVAL;
+extern const int DEFAULT_JOB_SERVER_HEARTBEAT_TIMEOUT;
+extern const int DEFAULT_JOB_SERVER_TELEMETRY_INTERVAL;
+extern const int DEFAULT_JOB_TELEMETRY_HISTORY_SIZE;
 
 //==============================================================================
 
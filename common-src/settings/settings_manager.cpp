@@ -15,6 +15,7 @@ const char PREVIEW_DIALOG_GEOMETRY_KEY[] = "prewiew_dialog_geometry";
 const char BOOKMARK_MANAGER_DIALOG_GEOMETRY_KEY[] = "bookmark_manager_dialog_geometry";
 const char FRAME_INFO_DIALOG_GEOMETRY_KEY[] = "frame_info_dialog_geometry";
 const char PREVIEW_FILTERS_DIALOG_GEOMETRY_KEY[] = "preview_filters_dialog_geometry";
+const char SCOPES_DIALOG_GEOMETRY_KEY[] = "scopes_dialog_geometry";
 const char JOB_SERVER_WATCHER_GEOMETRY_KEY[] = "job_server_watcher_geometry";
 const char MAIN_WINDOW_MAXIMIZED_KEY[] = "main_window_maximized";
 const char PREVIEW_DIALOG_MAXIMIZED_KEY[] = "preview_dialog_maximized";
@@ -50,8 +51,18 @@ const char HIGHLIGHT_SELECTION_MATCHES_KEY[] = "highlight_selection_matches";
 const char HIGHLIGHT_SELECTION_MATCHES_MIN_LENGTH_KEY[] =
 	"highlight_selection_matches_min_length";
 const char TIMELINE_PANEL_VISIBLE_KEY[] = "timeline_panel_visible";
+const char TIMELINE_STRIP_VISIBLE_KEY[] = "timeline_strip_visible";
+const char PLAYBACK_DROP_LATE_FRAMES_KEY[] = "playback_drop_late_frames";
+const char PREVIEW_PROXY_MODE_KEY[] = "preview_proxy_mode";
+const char PREVIEW_PROXY_FRACTION_KEY[] = "preview_proxy_fraction";
+const char PREVIEW_DISPLAY_BIT_DEPTH_KEY[] = "preview_display_bit_depth";
+const char HDR_TONEMAP_MODE_KEY[] = "hdr_tonemap_mode";
+const char HDR_PEAK_LUMINANCE_KEY[] = "hdr_peak_luminance";
 const char ALWAYS_KEEP_CURRENT_FRAME_KEY[] = "always_keep_current_frame";
 const char LAST_SNAPSHOT_EXTENSION_KEY[] = "last_snapshot_extension";
+const char FRAME_EXPORT_FILE_NAME_TEMPLATE_KEY[] =
+	"frame_export_file_name_template";
+const char FRAME_EXPORT_DIRECTORY_KEY[] = "frame_export_directory";
 const char BOOKMARK_SAVING_FORMAT_KEY[] = "bookmark_saving_format";
 const char BOOKMARK_DELIMITER_KEY[] = "bookmark_delimiter";
 const char THEME_NAME_KEY[] = "theme_name";
@@ -166,6 +177,8 @@ void SettingsManager::initializeStandardActions()
             QKeySequence()},
         {ACTION_ID_BENCHMARK, tr("Benchmark"), QIcon(":benchmark.png"),
 			QKeySequence(Qt::Key_F7)},
+        {ACTION_ID_CLIP_METRICS, tr("Clip metrics"), QIcon(),
+            QKeySequence()},
         {ACTION_ID_CLI_ENCODE, tr("Encode video"),
 			QIcon(":film_save.png"), QKeySequence(Qt::Key_F8)},
         {ACTION_ID_ENQUEUE_ENCODE_JOB, tr("Enqueue encode job"),
@@ -182,6 +195,8 @@ void SettingsManager::initializeStandardActions()
 			QIcon(":image_to_clipboard.png"), QKeySequence(Qt::Key_X)},
         {ACTION_ID_SAVE_SNAPSHOT, tr("Save snapshot"),
 			QIcon(":snapshot.png"), QKeySequence(Qt::Key_S)},
+        {ACTION_ID_EXPORT_FRAMES, tr("Export frames..."), QIcon(),
+            QKeySequence()},
         {ACTION_ID_TOGGLE_ZOOM_PANEL, tr("Show zoom panel"),
 			QIcon(":zoom.png"), QKeySequence(Qt::Key_Z)},
         {ACTION_ID_SET_ZOOM_MODE_NO_ZOOM, tr("Zoom: No zoom"),
@@ -199,6 +214,17 @@ void SettingsManager::initializeStandardActions()
 			QKeySequence()},
         {ACTION_ID_TOGGLE_TIMELINE_PANEL, tr("Show timeline panel"),
 			QIcon(":timeline.png"), QKeySequence(Qt::Key_T)},
+        {ACTION_ID_TOGGLE_TIMELINE_STRIP, tr("Show timeline thumbnails"),
+			QIcon(), QKeySequence()},
+        {ACTION_ID_TOGGLE_DROP_LATE_FRAMES,
+            tr("Drop late frames during playback"), QIcon(), QKeySequence()},
+        {ACTION_ID_SET_PREVIEW_PROXY_OFF, tr("Scrubbing proxy: Off"),
+			QIcon(), QKeySequence()},
+        {ACTION_ID_SET_PREVIEW_PROXY_VIEWPORT,
+            tr("Scrubbing proxy: Viewport size"), QIcon(), QKeySequence()},
+        {ACTION_ID_SET_PREVIEW_PROXY_FRACTION,
+            tr("Scrubbing proxy: Fraction of frame size"), QIcon(),
+			QKeySequence()},
         {ACTION_ID_SET_TIMELINE_MODE_TIME, tr("Timeline mode: Time"),
 			QIcon(":timeline.png"), QKeySequence()},
         {ACTION_ID_SET_TIMELINE_MODE_FRAMES, tr("Timeline mode: Frames"),
@@ -221,6 +247,8 @@ void SettingsManager::initializeStandardActions()
         {ACTION_ID_SHOW_PREVIEW_FILTERS_DIALOG, tr("Preview Filters"),
             QIcon(":preview_filters.png"), QKeySequence()},
         {ACTION_ID_SHOW_SELECTION_TOOLS_DIALOG, tr("Selection Tools"),
+            QIcon(), QKeySequence()},
+        {ACTION_ID_SHOW_SCOPES_DIALOG, tr("Scopes"),
             QIcon(), QKeySequence()},
 		{ACTION_ID_TIMELINE_BOOKMARK_CURRENT_FRAME,
             tr("Bookmark current frame"),
@@ -481,7 +509,7 @@ QByteArray SettingsManager::getMainWindowGeometry() const
 bool SettingsManager::setMainWindowGeometry(
 	const QByteArray & a_mainWindowGeometry)
 {
-	return setValue(MAIN_WINDOW_GEOMETRY_KEY, a_mainWindowGeometry);
+	return setValueDeferred(MAIN_WINDOW_GEOMETRY_KEY, a_mainWindowGeometry);
 }
 
 //==============================================================================
@@ -494,7 +522,7 @@ bool SettingsManager::getMainWindowMaximized() const
 
 bool SettingsManager::setMainWindowMaximized(bool a_mainWindowMaximized)
 {
-	return setValue(MAIN_WINDOW_MAXIMIZED_KEY, a_mainWindowMaximized);
+	return setValueDeferred(MAIN_WINDOW_MAXIMIZED_KEY, a_mainWindowMaximized);
 }
 
 //==============================================================================
@@ -507,7 +535,7 @@ QByteArray SettingsManager::getPreviewDialogGeometry() const
 bool SettingsManager::setPreviewDialogGeometry(
 	const QByteArray & a_previewDialogGeometry)
 {
-	return setValue(PREVIEW_DIALOG_GEOMETRY_KEY, a_previewDialogGeometry);
+	return setValueDeferred(PREVIEW_DIALOG_GEOMETRY_KEY, a_previewDialogGeometry);
 }
 
 //==============================================================================
@@ -520,7 +548,7 @@ bool SettingsManager::getPreviewDialogMaximized() const
 
 bool SettingsManager::setPreviewDialogMaximized(bool a_previewDialogMaximized)
 {
-    return setValue(PREVIEW_DIALOG_MAXIMIZED_KEY, a_previewDialogMaximized);
+    return setValueDeferred(PREVIEW_DIALOG_MAXIMIZED_KEY, a_previewDialogMaximized);
 }
 
 //==============================================================================
@@ -532,7 +560,7 @@ QByteArray SettingsManager::getBookmarkManagerDialogGeometry() const
 
 bool SettingsManager::setBookmarkManagerDialogGeometry(const QByteArray & a_bookmarkManagerDialogGeometry)
 {
-    return setValue(BOOKMARK_MANAGER_DIALOG_GEOMETRY_KEY, a_bookmarkManagerDialogGeometry);
+    return setValueDeferred(BOOKMARK_MANAGER_DIALOG_GEOMETRY_KEY, a_bookmarkManagerDialogGeometry);
 }
 
 //==============================================================================
@@ -544,7 +572,7 @@ QByteArray SettingsManager::getFrameInfoDialogGeometry() const
 
 bool SettingsManager::setFrameInfoDialogGeometry(const QByteArray & a_frameInfoDialogGeometry)
 {
-    return setValue(FRAME_INFO_DIALOG_GEOMETRY_KEY, a_frameInfoDialogGeometry);
+    return setValueDeferred(FRAME_INFO_DIALOG_GEOMETRY_KEY, a_frameInfoDialogGeometry);
 }
 
 //==============================================================================
@@ -556,7 +584,19 @@ QByteArray SettingsManager::getPreviewFiltersDialogGeometry() const
 
 bool SettingsManager::setPreviewFiltersDialogGeometry(const QByteArray & a_previewFiltersDialogGeometry)
 {
-    return setValue(PREVIEW_FILTERS_DIALOG_GEOMETRY_KEY, a_previewFiltersDialogGeometry);
+    return setValueDeferred(PREVIEW_FILTERS_DIALOG_GEOMETRY_KEY, a_previewFiltersDialogGeometry);
+}
+
+//==============================================================================
+
+QByteArray SettingsManager::getScopesDialogGeometry() const
+{
+    return value(SCOPES_DIALOG_GEOMETRY_KEY).toByteArray();
+}
+
+bool SettingsManager::setScopesDialogGeometry(const QByteArray & a_scopesDialogGeometry)
+{
+    return setValueDeferred(SCOPES_DIALOG_GEOMETRY_KEY, a_scopesDialogGeometry);
 }
 
 //==============================================================================
@@ -569,7 +609,7 @@ QByteArray SettingsManager::getJobServerWatcherGeometry() const
 bool SettingsManager::setJobServerWatcherGeometry(
 	const QByteArray & a_geometry)
 {
-	return setValue(JOB_SERVER_WATCHER_GEOMETRY_KEY, a_geometry);
+	return setValueDeferred(JOB_SERVER_WATCHER_GEOMETRY_KEY, a_geometry);
 }
 
 //==============================================================================
@@ -582,7 +622,7 @@ bool SettingsManager::getJobServerWatcherMaximized() const
 
 bool SettingsManager::setJobServerWatcherMaximized(bool a_maximized)
 {
-	return setValue(JOB_SERVER_WATCHER_MAXIMIZED_KEY, a_maximized);
+	return setValueDeferred(JOB_SERVER_WATCHER_MAXIMIZED_KEY, a_maximized);
 }
 
 //==============================================================================
@@ -594,7 +634,7 @@ QByteArray SettingsManager::getJobsHeaderState() const
 
 bool SettingsManager::setJobsHeaderState(const QByteArray & a_headerState)
 {
-	return setValue(JOBS_HEADER_STATE_KEY, a_headerState);
+	return setValueDeferred(JOBS_HEADER_STATE_KEY, a_headerState);
 }
 
 //==============================================================================
@@ -641,7 +681,7 @@ ZoomMode SettingsManager::getZoomMode() const
 
 bool SettingsManager::setZoomMode(ZoomMode a_zoomMode)
 {
-    return setValue(ZOOM_MODE_KEY, int(a_zoomMode));
+    return setValueDeferred(ZOOM_MODE_KEY, int(a_zoomMode));
 }
 
 //==============================================================================
@@ -653,7 +693,7 @@ double SettingsManager::getZoomRatio() const
 
 bool SettingsManager::setZoomRatio(double a_zoomRatio)
 {
-	return setValue(ZOOM_RATIO_KEY, a_zoomRatio);
+	return setValueDeferred(ZOOM_RATIO_KEY, a_zoomRatio);
 }
 
 //==============================================================================
@@ -690,7 +730,7 @@ int SettingsManager::getCropZoomRatio() const
 
 bool SettingsManager::setCropZoomRatio(int a_cropZoomRatio)
 {
-	return setValue(CROP_ZOOM_RATIO_KEY, a_cropZoomRatio);
+	return setValueDeferred(CROP_ZOOM_RATIO_KEY, a_cropZoomRatio);
 }
 
 //==============================================================================
@@ -1052,6 +1092,97 @@ bool SettingsManager::setTimeLinePanelVisible(bool a_visible)
 
 //==============================================================================
 
+bool SettingsManager::getTimeLineStripVisible() const
+{
+	return value(TIMELINE_STRIP_VISIBLE_KEY,
+		DEFAULT_TIMELINE_STRIP_VISIBLE).toBool();
+}
+
+bool SettingsManager::setTimeLineStripVisible(bool a_visible)
+{
+	return setValue(TIMELINE_STRIP_VISIBLE_KEY, a_visible);
+}
+
+//==============================================================================
+
+bool SettingsManager::getPlaybackDropLateFrames() const
+{
+	return value(PLAYBACK_DROP_LATE_FRAMES_KEY,
+		DEFAULT_PLAYBACK_DROP_LATE_FRAMES).toBool();
+}
+
+bool SettingsManager::setPlaybackDropLateFrames(bool a_drop)
+{
+	return setValue(PLAYBACK_DROP_LATE_FRAMES_KEY, a_drop);
+}
+
+//==============================================================================
+
+PreviewProxyMode SettingsManager::getPreviewProxyMode() const
+{
+	return PreviewProxyMode(value(PREVIEW_PROXY_MODE_KEY,
+		int(DEFAULT_PREVIEW_PROXY_MODE)).toInt());
+}
+
+bool SettingsManager::setPreviewProxyMode(PreviewProxyMode a_mode)
+{
+	return setValue(PREVIEW_PROXY_MODE_KEY, int(a_mode));
+}
+
+//==============================================================================
+
+double SettingsManager::getPreviewProxyFraction() const
+{
+	return value(PREVIEW_PROXY_FRACTION_KEY,
+		DEFAULT_PREVIEW_PROXY_FRACTION).toDouble();
+}
+
+bool SettingsManager::setPreviewProxyFraction(double a_fraction)
+{
+	return setValue(PREVIEW_PROXY_FRACTION_KEY, a_fraction);
+}
+
+//==============================================================================
+
+int SettingsManager::getPreviewDisplayBitDepth() const
+{
+	return value(PREVIEW_DISPLAY_BIT_DEPTH_KEY,
+		DEFAULT_PREVIEW_DISPLAY_BIT_DEPTH).toInt();
+}
+
+bool SettingsManager::setPreviewDisplayBitDepth(int a_bitDepth)
+{
+	return setValue(PREVIEW_DISPLAY_BIT_DEPTH_KEY, a_bitDepth);
+}
+
+//==============================================================================
+
+HdrTonemapMode SettingsManager::getHdrTonemapMode() const
+{
+	return HdrTonemapMode(value(HDR_TONEMAP_MODE_KEY,
+		int(DEFAULT_HDR_TONEMAP_MODE)).toInt());
+}
+
+bool SettingsManager::setHdrTonemapMode(HdrTonemapMode a_mode)
+{
+	return setValue(HDR_TONEMAP_MODE_KEY, int(a_mode));
+}
+
+//==============================================================================
+
+double SettingsManager::getHdrPeakLuminance() const
+{
+	return value(HDR_PEAK_LUMINANCE_KEY,
+		DEFAULT_HDR_PEAK_LUMINANCE).toDouble();
+}
+
+bool SettingsManager::setHdrPeakLuminance(double a_nits)
+{
+	return setValue(HDR_PEAK_LUMINANCE_KEY, a_nits);
+}
+
+//==============================================================================
+
 bool SettingsManager::getAlwaysKeepCurrentFrame() const
 {
 	return value(ALWAYS_KEEP_CURRENT_FRAME_KEY,
@@ -1152,6 +1283,28 @@ bool SettingsManager::setLastSnapshotExtension(const QString & a_extension)
     return setValue(LAST_SNAPSHOT_EXTENSION_KEY, a_extension);
 }
 
+QString SettingsManager::getFrameExportFileNameTemplate() const
+{
+	return value(FRAME_EXPORT_FILE_NAME_TEMPLATE_KEY,
+		DEFAULT_FRAME_EXPORT_FILE_NAME_TEMPLATE).toString();
+}
+
+bool SettingsManager::setFrameExportFileNameTemplate(
+	const QString & a_template)
+{
+	return setValue(FRAME_EXPORT_FILE_NAME_TEMPLATE_KEY, a_template);
+}
+
+QString SettingsManager::getFrameExportDirectory() const
+{
+	return value(FRAME_EXPORT_DIRECTORY_KEY, QString()).toString();
+}
+
+bool SettingsManager::setFrameExportDirectory(const QString & a_directory)
+{
+	return setValue(FRAME_EXPORT_DIRECTORY_KEY, a_directory);
+}
+
 //==============================================================================
 
 BookmarkSavingFormat SettingsManager::getBookmarkSavingFormat() const
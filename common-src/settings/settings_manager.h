@@ -89,6 +89,10 @@ public:
 
     bool setPreviewFiltersDialogGeometry(const QByteArray & a_previewFiltersDialogGeometry);
 
+    QByteArray getScopesDialogGeometry() const;
+
+    bool setScopesDialogGeometry(const QByteArray & a_scopesDialogGeometry);
+
 
 	QByteArray getJobServerWatcherGeometry() const;
 
@@ -217,6 +221,34 @@ public:
 
 	bool setTimeLinePanelVisible(bool a_visible);
 
+	bool getTimeLineStripVisible() const;
+
+	bool setTimeLineStripVisible(bool a_visible);
+
+	bool getPlaybackDropLateFrames() const;
+
+	bool setPlaybackDropLateFrames(bool a_drop);
+
+	PreviewProxyMode getPreviewProxyMode() const;
+
+	bool setPreviewProxyMode(PreviewProxyMode a_mode);
+
+	double getPreviewProxyFraction() const;
+
+	bool setPreviewProxyFraction(double a_fraction);
+
+	int getPreviewDisplayBitDepth() const;
+
+	bool setPreviewDisplayBitDepth(int a_bitDepth);
+
+	HdrTonemapMode getHdrTonemapMode() const;
+
+	bool setHdrTonemapMode(HdrTonemapMode a_mode);
+
+	double getHdrPeakLuminance() const;
+
+	bool setHdrPeakLuminance(double a_nits);
+
 	bool getAlwaysKeepCurrentFrame() const;
 
 	bool setAlwaysKeepCurrentFrame(bool a_keep);
@@ -230,6 +262,14 @@ public:
 
 	bool setLastSnapshotExtension(const QString & a_extension);
 
+	QString getFrameExportFileNameTemplate() const;
+
+	bool setFrameExportFileNameTemplate(const QString & a_template);
+
+	QString getFrameExportDirectory() const;
+
+	bool setFrameExportDirectory(const QString & a_directory);
+
     BookmarkSavingFormat getBookmarkSavingFormat() const;
 
     bool setBookmarkSavingFormat(const BookmarkSavingFormat & a_format);
@@ -5,6 +5,7 @@
 #include <QFileInfo>
 #include <QStandardPaths>
 #include <QSettings>
+#include <QTimer>
 
 //==============================================================================
 
@@ -24,6 +25,17 @@ const char BICUBIC_FILTER_PARAMETER_C_KEY[] = "bicubic_filter_parameter_c";
 const char LANCZOS_FILTER_TAPS_KEY[] = "lanczos_filter_taps";
 const char RECENT_JOB_SERVERS_KEY[] = "recent_job_servers";
 const char TRUSTED_CLIENTS_ADDRESSES_KEY[] = "trusted_clients_addresses";
+const char JOB_SERVER_PROGRESS_UPDATE_INTERVAL_KEY[] =
+	"job_server_progress_update_interval";
+const char JOB_SERVER_LOG_CAPACITY_KEY[] = "job_server_log_capacity";
+const char JOB_SERVER_LOG_TAIL_SIZE_KEY[] = "job_server_log_tail_size";
+const char JOB_SERVER_LOG_SPILL_FILE_PATH_KEY[] =
+	"job_server_log_spill_file_path";
+const char JOB_SERVER_HEARTBEAT_INTERVAL_KEY[] =
+	"job_server_heartbeat_interval";
+const char JOB_SERVER_HEARTBEAT_TIMEOUT_KEY[] = "job_server_heartbeat_timeout";
+const char JOB_SERVER_TELEMETRY_INTERVAL_KEY[] =
+	"job_server_telemetry_interval";
 
 //==============================================================================
 
@@ -62,6 +74,7 @@ const char JOB_FPS_KEY[] = "fps";
 
 SettingsManagerCore::SettingsManagerCore(QObject * a_pParent) :
 	QObject(a_pParent)
+	, m_pDeferredFlushTimer(nullptr)
 {
 	QString applicationDir = QCoreApplication::applicationDirPath();
 
@@ -73,11 +86,24 @@ SettingsManagerCore::SettingsManagerCore(QObject * a_pParent) :
 		m_settingsFilePath = QStandardPaths::writableLocation(
 			QStandardPaths::GenericConfigLocation) + SETTINGS_FILE_NAME;
 	}
+
+	m_pDeferredFlushTimer = new QTimer(this);
+	m_pDeferredFlushTimer->setSingleShot(true);
+	m_pDeferredFlushTimer->setInterval(DEFAULT_SETTINGS_FLUSH_DELAY);
+	connect(m_pDeferredFlushTimer, &QTimer::timeout,
+		this, [this]() {flushDeferredValues();});
+
+	if(QCoreApplication::instance())
+	{
+		connect(QCoreApplication::instance(),
+			&QCoreApplication::aboutToQuit,
+			this, [this]() {flushDeferredValues();});
+	}
 }
 
 SettingsManagerCore::~SettingsManagerCore()
 {
-
+	flushDeferredValues();
 }
 
 //==============================================================================
@@ -100,6 +126,8 @@ bool SettingsManagerCore::setPortableMode(bool a_portableMod)
 	if(a_portableMod == currentModePortable)
 		return true;
 
+	flushDeferredValues();
+
 	QString applicationDir = QCoreApplication::applicationDirPath();
 	QString genericConfigDir = QStandardPaths::writableLocation(
 		QStandardPaths::GenericConfigLocation);
@@ -140,6 +168,11 @@ bool SettingsManagerCore::setPortableMode(bool a_portableMod)
 QVariant SettingsManagerCore::valueInGroup(const QString & a_group,
 	const QString & a_key, const QVariant & a_defaultValue) const
 {
+	std::map<GroupKey, QVariant>::const_iterator it =
+		m_deferredValues.find(GroupKey(a_group, a_key));
+	if(it != m_deferredValues.end())
+		return it->second;
+
 	QSettings settings(m_settingsFilePath, QSettings::IniFormat);
 	settings.beginGroup(a_group);
 	return settings.value(a_key, a_defaultValue);
@@ -148,6 +181,9 @@ QVariant SettingsManagerCore::valueInGroup(const QString & a_group,
 bool SettingsManagerCore::setValueInGroup(const QString & a_group,
 	const QString & a_key, const QVariant & a_value)
 {
+	// a pending deferred value must not overwrite this one later
+	m_deferredValues.erase(GroupKey(a_group, a_key));
+
 	QSettings settings(m_settingsFilePath, QSettings::IniFormat);
 	settings.beginGroup(a_group);
 	settings.setValue(a_key, a_value);
@@ -159,6 +195,8 @@ bool SettingsManagerCore::setValueInGroup(const QString & a_group,
 bool SettingsManagerCore::deleteValueInGroup(const QString & a_group,
 	const QString & a_key)
 {
+	m_deferredValues.erase(GroupKey(a_group, a_key));
+
 	QSettings settings(m_settingsFilePath, QSettings::IniFormat);
 	settings.beginGroup(a_group);
 	settings.remove(a_key);
@@ -181,9 +219,57 @@ bool SettingsManagerCore::setValue(const QString & a_key,
     return setValueInGroup(COMMON_GROUP, a_key, a_value);
 }
 
+bool SettingsManagerCore::setValueInGroupDeferred(const QString & a_group,
+	const QString & a_key, const QVariant & a_value)
+{
+	m_deferredValues[GroupKey(a_group, a_key)] = a_value;
+
+	// restarting the timer coalesces a burst into one write,
+	// but a burst that never settles is still written periodically
+	if(!m_pDeferredFlushTimer->isActive())
+	{
+		m_deferredSince.start();
+		m_pDeferredFlushTimer->start();
+	}
+	else if(m_deferredSince.elapsed() < DEFAULT_SETTINGS_FLUSH_MAX_DELAY)
+		m_pDeferredFlushTimer->start();
+
+	return true;
+}
+
+bool SettingsManagerCore::setValueDeferred(const QString & a_key,
+	const QVariant & a_value)
+{
+	return setValueInGroupDeferred(COMMON_GROUP, a_key, a_value);
+}
+
+bool SettingsManagerCore::flushDeferredValues()
+{
+	if(m_pDeferredFlushTimer)
+		m_pDeferredFlushTimer->stop();
+
+	if(m_deferredValues.empty())
+		return true;
+
+	// one file rewrite for everything pending
+	QSettings settings(m_settingsFilePath, QSettings::IniFormat);
+	for(const std::pair<const GroupKey, QVariant> & entry : m_deferredValues)
+	{
+		settings.beginGroup(entry.first.first);
+		settings.setValue(entry.first.second, entry.second);
+		settings.endGroup();
+	}
+	m_deferredValues.clear();
+
+	settings.sync();
+	bool success = (QSettings::NoError == settings.status());
+	return success;
+}
+
 QString SettingsManagerCore::getSettingsFileDir()
 {
-    return m_settingsFilePath.replace(SETTINGS_FILE_NAME, "");
+	QString settingsFileDir = m_settingsFilePath;
+	return settingsFileDir.replace(SETTINGS_FILE_NAME, "");
 }
 
 //==============================================================================
@@ -540,3 +626,93 @@ bool SettingsManagerCore::setTrustedClientsAddresses(
 }
 
 //==============================================================================
+
+int SettingsManagerCore::getJobServerProgressUpdateInterval() const
+{
+	return value(JOB_SERVER_PROGRESS_UPDATE_INTERVAL_KEY,
+		DEFAULT_JOB_SERVER_PROGRESS_UPDATE_INTERVAL).toInt();
+}
+
+bool SettingsManagerCore::setJobServerProgressUpdateInterval(int a_interval)
+{
+	return setValue(JOB_SERVER_PROGRESS_UPDATE_INTERVAL_KEY, a_interval);
+}
+
+//==============================================================================
+
+int SettingsManagerCore::getJobServerLogCapacity() const
+{
+	return value(JOB_SERVER_LOG_CAPACITY_KEY,
+		DEFAULT_JOB_SERVER_LOG_CAPACITY).toInt();
+}
+
+bool SettingsManagerCore::setJobServerLogCapacity(int a_capacity)
+{
+	return setValue(JOB_SERVER_LOG_CAPACITY_KEY, a_capacity);
+}
+
+//==============================================================================
+
+int SettingsManagerCore::getJobServerLogTailSize() const
+{
+	return value(JOB_SERVER_LOG_TAIL_SIZE_KEY,
+		DEFAULT_JOB_SERVER_LOG_TAIL_SIZE).toInt();
+}
+
+bool SettingsManagerCore::setJobServerLogTailSize(int a_size)
+{
+	return setValue(JOB_SERVER_LOG_TAIL_SIZE_KEY, a_size);
+}
+
+//==============================================================================
+
+QString SettingsManagerCore::getJobServerLogSpillFilePath() const
+{
+	return value(JOB_SERVER_LOG_SPILL_FILE_PATH_KEY).toString();
+}
+
+bool SettingsManagerCore::setJobServerLogSpillFilePath(const QString & a_path)
+{
+	return setValue(JOB_SERVER_LOG_SPILL_FILE_PATH_KEY, a_path);
+}
+
+//==============================================================================
+
+int SettingsManagerCore::getJobServerHeartbeatInterval() const
+{
+	return value(JOB_SERVER_HEARTBEAT_INTERVAL_KEY,
+		DEFAULT_JOB_SERVER_HEARTBEAT_INTERVAL).toInt();
+}
+
+bool SettingsManagerCore::setJobServerHeartbeatInterval(int a_interval)
+{
+	return setValue(JOB_SERVER_HEARTBEAT_INTERVAL_KEY, a_interval);
+}
+
+//==============================================================================
+
+int SettingsManagerCore::getJobServerHeartbeatTimeout() const
+{
+	return value(JOB_SERVER_HEARTBEAT_TIMEOUT_KEY,
+		DEFAULT_JOB_SERVER_HEARTBEAT_TIMEOUT).toInt();
+}
+
+bool SettingsManagerCore::setJobServerHeartbeatTimeout(int a_timeout)
+{
+	return setValue(JOB_SERVER_HEARTBEAT_TIMEOUT_KEY, a_timeout);
+}
+
+//==============================================================================
+
+int SettingsManagerCore::getJobServerTelemetryInterval() const
+{
+	return value(JOB_SERVER_TELEMETRY_INTERVAL_KEY,
+		DEFAULT_JOB_SERVER_TELEMETRY_INTERVAL).toInt();
+}
+
+bool SettingsManagerCore::setJobServerTelemetryInterval(int a_interval)
+{
+	return setValue(JOB_SERVER_TELEMETRY_INTERVAL_KEY, a_interval);
+}
+
+//==============================================================================
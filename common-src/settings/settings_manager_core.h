@@ -5,8 +5,13 @@
 
 #include <QObject>
 #include <QVariant>
+#include <QElapsedTimer>
+#include <map>
+#include <utility>
 #include <vector>
 
+class QTimer;
+
 /// Base class that manages non-GUI related settings
 class SettingsManagerCore : public QObject
 {
@@ -77,6 +82,40 @@ public:
 
 	bool setTrustedClientsAddresses(const QStringList & a_addresses);
 
+	int getJobServerProgressUpdateInterval() const;
+
+	bool setJobServerProgressUpdateInterval(int a_interval);
+
+	int getJobServerLogCapacity() const;
+
+	bool setJobServerLogCapacity(int a_capacity);
+
+	int getJobServerLogTailSize() const;
+
+	bool setJobServerLogTailSize(int a_size);
+
+	QString getJobServerLogSpillFilePath() const;
+
+	bool setJobServerLogSpillFilePath(const QString & a_path);
+
+	int getJobServerHeartbeatInterval() const;
+
+	bool setJobServerHeartbeatInterval(int a_interval);
+
+	int getJobServerHeartbeatTimeout() const;
+
+	bool setJobServerHeartbeatTimeout(int a_timeout);
+
+	int getJobServerTelemetryInterval() const;
+
+	bool setJobServerTelemetryInterval(int a_interval);
+
+	//----------------------------------------------------------------------
+
+	/// Writes values stored with the deferred setters. Happens by itself
+	/// once the writes settle, at application exit and on destruction.
+	bool flushDeferredValues();
+
 protected:
 
 	QVariant valueInGroup(const QString & a_group, const QString & a_key,
@@ -92,7 +131,25 @@ protected:
 
 	bool setValue(const QString & a_key, const QVariant & a_value);
 
+	/// For UI state that changes in bursts (geometry, zoom). The value
+	/// is visible to getters at once and written with others later.
+	bool setValueInGroupDeferred(const QString & a_group,
+		const QString & a_key, const QVariant & a_value);
+
+	bool setValueDeferred(const QString & a_key, const QVariant & a_value);
+
 	QString m_settingsFilePath;
+
+private:
+
+	typedef std::pair<QString, QString> GroupKey;
+
+	std::map<GroupKey, QVariant> m_deferredValues;
+
+	QTimer * m_pDeferredFlushTimer;
+
+	// bounds the delay while writes keep coming
+	QElapsedTimer m_deferredSince;
 };
 
 #endif // SETTINGS_MANAGER_CORE_H_INCLUDED
@@ -4,11 +4,14 @@
 #include "vs_script_library.h"
 
 #include <vector>
+#include <algorithm>
 #include <cmath>
 #include <utility>
 #include <memory>
 #include <functional>
 
+const int DEFAULT_FRAME_REQUESTS_LIMIT = 2;
+
 //==============================================================================
 
 /* callback function for VSAPI->getFrameAsync() */
@@ -34,6 +37,26 @@ void VS_CC frameReady(void * a_pUserData,
 //	VSNodeRef * a_pNodeRef, const char * a_errorMessage)
 //==============================================================================
 
+/* callback function for thumbnail requests */
+void VS_CC thumbnailReady(void * a_pUserData,
+	const VSFrameRef * a_cpFrameRef, int a_frameNumber,
+	VSNodeRef * a_pNodeRef, const char * a_errorMessage)
+{
+	(void)a_frameNumber;
+	(void)a_pNodeRef;
+	VapourSynthScriptProcessor * pScriptProcessor =
+		static_cast<VapourSynthScriptProcessor *>(a_pUserData);
+	Q_ASSERT(pScriptProcessor);
+	pScriptProcessor->storeThumbnail(a_cpFrameRef, QString(a_errorMessage));
+	QMetaObject::invokeMethod(pScriptProcessor,
+		"slotReceiveThumbnailAndProcessQueue", Qt::QueuedConnection);
+}
+
+// END OF void VS_CC thumbnailReady(void * a_pUserData,
+//	const VSFrameRef * a_cpFrameRef, int a_frameNumber,
+//	VSNodeRef * a_pNodeRef, const char * a_errorMessage)
+//==============================================================================
+
 VapourSynthScriptProcessor::VapourSynthScriptProcessor(
 	SettingsManagerCore * a_pSettingsManager,
 	VSScriptLibrary * a_pVSScriptLibrary,
@@ -50,6 +73,15 @@ VapourSynthScriptProcessor::VapourSynthScriptProcessor(
     , m_cpVideoInfo(nullptr)
     , m_cpCoreInfo(VSCoreInfo{})
 	, m_finalizing(false)
+	, m_proxyWidth(0)
+	, m_proxyHeight(0)
+	, m_frameRequestsLimit(DEFAULT_FRAME_REQUESTS_LIMIT)
+	, m_previewBitDepth(8)
+	, m_pThumbnailNode(nullptr)
+	, m_thumbnailSampleNumber(-1)
+	, m_pThumbnailRequestNode(nullptr)
+	, m_thumbnailInProcess(false)
+	, m_cpThumbnailFrameRef(nullptr)
 {
 	Q_ASSERT(m_pSettingsManager);
 	Q_ASSERT(m_pVSScriptLibrary);
@@ -153,6 +185,12 @@ bool VapourSynthScriptProcessor::finalize()
 	if(!noFrameTicketsInProcess)
 		return false;
 
+	// A thumbnail is a single small frame, so it is waited for
+	// instead of leaving the processor busy.
+	flushThumbnailQueue();
+	waitForThumbnail();
+	freeThumbnailClip();
+
     flushNodePairMap();
 
 	m_cpVideoInfo = nullptr;
@@ -224,8 +262,25 @@ const VSVideoInfo * VapourSynthScriptProcessor::videoInfo(int a_outputIndex)
 // END OF const VSVideoInfo * VapourSynthScriptProcessor::videoInfo() const
 //==============================================================================
 
+bool VapourSynthScriptProcessor::coreInfo(VSCoreInfo * a_pCoreInfo) const
+{
+	Q_ASSERT(a_pCoreInfo);
+	if(!m_initialized)
+		return false;
+	// Framebuffer usage changes all the time, so the info is queried anew.
+	VSCore * pCore = m_pVSScriptLibrary->getCore(m_pVSScript);
+	if(!pCore)
+		return false;
+	m_cpVSAPI->getCoreInfo2(pCore, a_pCoreInfo);
+	return true;
+}
+
+// END OF bool VapourSynthScriptProcessor::coreInfo(
+//		VSCoreInfo * a_pCoreInfo) const
+//==============================================================================
+
 bool VapourSynthScriptProcessor::requestFrameAsync(int a_frameNumber,
-	int a_outputIndex, bool a_needPreview)
+	int a_outputIndex, bool a_needPreview, bool a_proxy)
 {
     /* request video node from api, then request frame using video node */
 	if(!m_initialized)
@@ -241,7 +296,10 @@ bool VapourSynthScriptProcessor::requestFrameAsync(int a_frameNumber,
 
 	Q_ASSERT(m_cpVSAPI);
 
-	NodePair & nodePair = getNodePair(a_outputIndex, a_needPreview);
+	bool proxy = a_needPreview && a_proxy &&
+		(m_proxyWidth > 0) && (m_proxyHeight > 0);
+
+	NodePair & nodePair = getNodePair(a_outputIndex, a_needPreview, proxy);
 	if(!nodePair.pOutputNode)
 		return false;
 
@@ -257,11 +315,13 @@ bool VapourSynthScriptProcessor::requestFrameAsync(int a_frameNumber,
 		return false;
 	}
 
-	if(a_needPreview && (!nodePair.pPreviewNode))
+	VSNodeRef * pPreviewNode =
+		proxy ? nodePair.pProxyNode : nodePair.pPreviewNode;
+	if(a_needPreview && (!pPreviewNode))
 		return false;
 
 	FrameTicket newFrameTicket(a_frameNumber, a_outputIndex,
-		nodePair.pOutputNode, a_needPreview, nodePair.pPreviewNode);
+		nodePair.pOutputNode, a_needPreview, pPreviewNode, proxy);
 
 	m_frameTicketsQueue.push_back(newFrameTicket);
     sendFrameQueueChangeSignal(); // send signal to update the status icon
@@ -271,12 +331,13 @@ bool VapourSynthScriptProcessor::requestFrameAsync(int a_frameNumber,
 }
 
 // END OF void VapourSynthScriptProcessor::requestFrameAsync(int a_frameNumber,
-//		int a_outputIndex, bool a_needPreview)
+//		int a_outputIndex, bool a_needPreview, bool a_proxy)
 //==============================================================================
 
 bool VapourSynthScriptProcessor::flushFrameTicketsQueue()
 {
-    // add discard flag to all tickets
+    // add discard flag to all tickets, requests already passed
+    // to VapourSynth can't be aborted, but their preview stage is skipped
 	for(FrameTicket & ticket : m_frameTicketsInProcess)
 		ticket.discard = true;
 
@@ -301,6 +362,8 @@ void VapourSynthScriptProcessor::flushNodePairMap()
             m_cpVSAPI->freeNode(nodePair.pOutputNode);
         if(nodePair.pPreviewNode)
             m_cpVSAPI->freeNode(nodePair.pPreviewNode);
+        if(nodePair.pProxyNode)
+            m_cpVSAPI->freeNode(nodePair.pProxyNode);
     }
     m_nodePairMap.clear();
 }
@@ -333,6 +396,171 @@ void VapourSynthScriptProcessor::setScriptName(const QString & a_scriptName)
 //		const QString & a_scriptName)
 //==============================================================================
 
+void VapourSynthScriptProcessor::setPreviewProxySize(int a_width,
+	int a_height)
+{
+	if((a_width <= 0) || (a_height <= 0))
+	{
+		a_width = 0;
+		a_height = 0;
+	}
+
+	if((a_width == m_proxyWidth) && (a_height == m_proxyHeight))
+		return;
+
+	m_proxyWidth = a_width;
+	m_proxyHeight = a_height;
+
+	// Proxy nodes are created again on the next proxy request.
+	for(std::pair<const int, NodePair> & mapItem : m_nodePairMap)
+	{
+		NodePair & nodePair = mapItem.second;
+		if(nodePair.pProxyNode)
+		{
+			m_cpVSAPI->freeNode(nodePair.pProxyNode);
+			nodePair.pProxyNode = nullptr;
+		}
+	}
+}
+
+// END OF void VapourSynthScriptProcessor::setPreviewProxySize(int a_width,
+//		int a_height)
+//==============================================================================
+
+void VapourSynthScriptProcessor::setFrameRequestsLimit(int a_limit)
+{
+	m_frameRequestsLimit = std::max(a_limit, 0);
+	if(m_initialized)
+		processFrameTicketsQueue();
+}
+
+// END OF void VapourSynthScriptProcessor::setFrameRequestsLimit(int a_limit)
+//==============================================================================
+
+int VapourSynthScriptProcessor::frameRequestsLimit() const
+{
+	return m_frameRequestsLimit;
+}
+
+// END OF int VapourSynthScriptProcessor::frameRequestsLimit() const
+//==============================================================================
+
+void VapourSynthScriptProcessor::setPreviewBitDepth(int a_bitsPerSample)
+{
+	int bitDepth = (a_bitsPerSample > 8) ? 16 : 8;
+	if(bitDepth == m_previewBitDepth)
+		return;
+
+	m_previewBitDepth = bitDepth;
+
+	// Preview nodes are created again on the next preview request.
+	for(std::pair<const int, NodePair> & mapItem : m_nodePairMap)
+	{
+		NodePair & nodePair = mapItem.second;
+		if(nodePair.pPreviewNode)
+		{
+			m_cpVSAPI->freeNode(nodePair.pPreviewNode);
+			nodePair.pPreviewNode = nullptr;
+		}
+	}
+}
+
+// END OF void VapourSynthScriptProcessor::setPreviewBitDepth(
+//		int a_bitsPerSample)
+//==============================================================================
+
+int VapourSynthScriptProcessor::previewBitDepth() const
+{
+	return m_previewBitDepth;
+}
+
+// END OF int VapourSynthScriptProcessor::previewBitDepth() const
+//==============================================================================
+
+bool VapourSynthScriptProcessor::setThumbnailClip(int a_step, int a_width,
+	int a_height, int a_outputIndex)
+{
+	if(!m_initialized)
+		return false;
+
+	flushThumbnailQueue();
+	waitForThumbnail();
+	freeThumbnailClip();
+
+	NodePair & nodePair = getNodePair(a_outputIndex, false);
+	if(!nodePair.pOutputNode)
+		return false;
+
+	VSNodeRef * pNode = m_cpVSAPI->cloneNodeRef(nodePair.pOutputNode);
+
+	if(a_step > 1)
+	{
+		VSCore * pCore = m_pVSScriptLibrary->getCore(m_pVSScript);
+		VSPlugin * pStdPlugin = m_cpVSAPI->getPluginById(
+			"com.vapoursynth.std", pCore);
+
+		VSMap * pArgumentMap = m_cpVSAPI->createMap();
+		m_cpVSAPI->propSetNode(pArgumentMap, "clip", pNode, paReplace);
+		m_cpVSAPI->propSetInt(pArgumentMap, "cycle", a_step, paReplace);
+		m_cpVSAPI->propSetInt(pArgumentMap, "offsets", 0, paReplace);
+		VSMap * pResultMap = m_cpVSAPI->invoke(pStdPlugin, "SelectEvery",
+			pArgumentMap);
+		m_cpVSAPI->freeMap(pArgumentMap);
+		m_cpVSAPI->freeNode(pNode);
+
+		const char * cpResultError = m_cpVSAPI->getError(pResultMap);
+		if(cpResultError)
+		{
+			m_error = tr("Failed to create the thumbnail clip:\n");
+			m_error += cpResultError;
+			emit signalWriteLogMessage(mtWarning, m_error);
+			m_cpVSAPI->freeMap(pResultMap);
+			return false;
+		}
+
+		pNode = m_cpVSAPI->propGetNode(pResultMap, "clip", 0, nullptr);
+		m_cpVSAPI->freeMap(pResultMap);
+		Q_ASSERT(pNode);
+	}
+
+	m_pThumbnailNode = createRGBNode(pNode, a_width, a_height);
+	m_cpVSAPI->freeNode(pNode);
+
+	return (m_pThumbnailNode != nullptr);
+}
+
+// END OF bool VapourSynthScriptProcessor::setThumbnailClip(int a_step,
+//		int a_width, int a_height, int a_outputIndex)
+//==============================================================================
+
+bool VapourSynthScriptProcessor::requestThumbnailAsync(int a_sampleNumber)
+{
+	if((!m_initialized) || (!m_pThumbnailNode))
+		return false;
+
+	const VSVideoInfo * cpVideoInfo =
+		m_cpVSAPI->getVideoInfo(m_pThumbnailNode);
+	if((a_sampleNumber < 0) || (a_sampleNumber >= cpVideoInfo->numFrames))
+		return false;
+
+	m_thumbnailQueue.push_back(a_sampleNumber);
+	processFrameTicketsQueue();
+
+	return true;
+}
+
+// END OF bool VapourSynthScriptProcessor::requestThumbnailAsync(
+//		int a_sampleNumber)
+//==============================================================================
+
+void VapourSynthScriptProcessor::flushThumbnailQueue()
+{
+	m_thumbnailQueue.clear();
+}
+
+// END OF void VapourSynthScriptProcessor::flushThumbnailQueue()
+//==============================================================================
+
 void VapourSynthScriptProcessor::slotReceiveFrameAndProcessQueue(
 	const VSFrameRef * a_cpFrameRef, int a_frameNumber, VSNodeRef * a_pNodeRef,
 	QString a_errorMessage)
@@ -346,6 +574,46 @@ void VapourSynthScriptProcessor::slotReceiveFrameAndProcessQueue(
 //		VSNodeRef * a_pNodeRef, QString a_errorMessage)
 //==============================================================================
 
+void VapourSynthScriptProcessor::slotReceiveThumbnailAndProcessQueue()
+{
+	// The thumbnail may have been taken by waitForThumbnail() already.
+	if(!m_pThumbnailRequestNode)
+		return;
+
+	const VSFrameRef * cpFrameRef = nullptr;
+	QString errorMessage;
+	{
+		std::lock_guard<std::mutex> lock(m_thumbnailMutex);
+		if(m_thumbnailInProcess)
+			return;
+		cpFrameRef = m_cpThumbnailFrameRef;
+		m_cpThumbnailFrameRef = nullptr;
+		errorMessage.swap(m_thumbnailError);
+	}
+
+	int sampleNumber = m_thumbnailSampleNumber;
+	m_thumbnailSampleNumber = -1;
+	m_cpVSAPI->freeNode(m_pThumbnailRequestNode);
+	m_pThumbnailRequestNode = nullptr;
+
+	if(!errorMessage.isEmpty())
+	{
+		emit signalWriteLogMessage(mtWarning,
+			tr("Error on thumbnail %1 request:\n%2")
+			.arg(sampleNumber).arg(errorMessage));
+	}
+
+	emit signalDistributeThumbnail(sampleNumber, cpFrameRef);
+
+	if(cpFrameRef)
+		m_cpVSAPI->freeFrame(cpFrameRef);
+
+	processFrameTicketsQueue();
+}
+
+// END OF void VapourSynthScriptProcessor::slotReceiveThumbnailAndProcessQueue()
+//==============================================================================
+
 void VapourSynthScriptProcessor::slotResetSettings()
 {
 	m_yuvMatrix = m_pSettingsManager->getYuvMatrixCoefficients();
@@ -373,6 +641,8 @@ void VapourSynthScriptProcessor::slotResetSettings()
 		NodePair & nodePair = mapItem.second;
 		if(nodePair.pPreviewNode)
 			recreatePreviewNode(nodePair);
+		if(nodePair.pProxyNode)
+			recreateProxyNode(nodePair);
 	}
 }
 
@@ -417,7 +687,7 @@ void VapourSynthScriptProcessor::receiveFrame(
 			if(it->needPreview)
 			{
 				Q_ASSERT(it->pPreviewNode);
-				if(a_cpFrameRef)
+				if(a_cpFrameRef && (!it->discard))
 				{
 					m_cpVSAPI->getFrameAsync(it->frameNumber, it->pPreviewNode,
 						frameReady, this);
@@ -484,20 +754,32 @@ void VapourSynthScriptProcessor::processFrameTicketsQueue()
     size_t oldInProcess = size_t(m_frameTicketsInProcess.size());
 
 
+	int liveTicketsLimit = m_frameRequestsLimit;
+	if(liveTicketsLimit == 0)
+		liveTicketsLimit = std::max(m_cpCoreInfo.numThreads, 1);
+
+	// Discarded tickets still wait for their output frame, they only
+	// count against the thread number so new requests are not held back.
+	int maxTicketsInProcess =
+		std::max(m_cpCoreInfo.numThreads, liveTicketsLimit);
+
     /* move frame ticket from queue to inProcess */
-    while((int(m_frameTicketsInProcess.size()) < 2) &&
+    while((liveFrameTicketsInProcess() < liveTicketsLimit) &&
+        (m_frameTicketsInProcess.size() < maxTicketsInProcess) &&
         (!m_frameTicketsQueue.empty()))
     {
 		FrameTicket ticket = std::move(m_frameTicketsQueue.front());
 		m_frameTicketsQueue.pop_front();
 
 		// In case preview node was hot-swapped.
-		NodePair & nodePair =
-			getNodePair(ticket.outputIndex, ticket.needPreview);
+		NodePair & nodePair = getNodePair(ticket.outputIndex,
+			ticket.needPreview, ticket.proxy);
+		VSNodeRef * pPreviewNode =
+			ticket.proxy ? nodePair.pProxyNode : nodePair.pPreviewNode;
 
 		bool validPair = (nodePair.pOutputNode != nullptr);
 		if(ticket.needPreview)
-			validPair = validPair && (nodePair.pPreviewNode != nullptr);
+			validPair = validPair && (pPreviewNode != nullptr);
 		if(!validPair)
 		{
             QString reason = tr("No nodes to produce the frame "
@@ -510,8 +792,7 @@ void VapourSynthScriptProcessor::processFrameTicketsQueue()
 
 		ticket.pOutputNode = m_cpVSAPI->cloneNodeRef(nodePair.pOutputNode);
 		if(ticket.needPreview)
-			ticket.pPreviewNode =
-				m_cpVSAPI->cloneNodeRef(nodePair.pPreviewNode);
+			ticket.pPreviewNode = m_cpVSAPI->cloneNodeRef(pPreviewNode);
 
 		m_cpVSAPI->getFrameAsync(ticket.frameNumber, ticket.pOutputNode,
 			frameReady, this);
@@ -524,6 +805,22 @@ void VapourSynthScriptProcessor::processFrameTicketsQueue()
 	if((inQueue != oldInQueue) || (oldInProcess != inProcess))
 		sendFrameQueueChangeSignal();
 
+	// Thumbnails only run when the preview has nothing to do.
+	if((!m_finalizing) && m_frameTicketsQueue.empty() &&
+		m_frameTicketsInProcess.empty() && m_pThumbnailNode &&
+		(!m_pThumbnailRequestNode) && (!m_thumbnailQueue.empty()))
+	{
+		m_thumbnailSampleNumber = m_thumbnailQueue.front();
+		m_thumbnailQueue.pop_front();
+		m_pThumbnailRequestNode = m_cpVSAPI->cloneNodeRef(m_pThumbnailNode);
+		{
+			std::lock_guard<std::mutex> lock(m_thumbnailMutex);
+			m_thumbnailInProcess = true;
+		}
+		m_cpVSAPI->getFrameAsync(m_thumbnailSampleNumber,
+			m_pThumbnailRequestNode, thumbnailReady, this);
+	}
+
 	if(m_finalizing)
 		finalize();
 }
@@ -557,19 +854,56 @@ bool VapourSynthScriptProcessor::recreatePreviewNode(NodePair & a_nodePair)
 		a_nodePair.pPreviewNode = nullptr;
 	}
 
-	const VSVideoInfo * cpVideoInfo =
-		m_cpVSAPI->getVideoInfo(a_nodePair.pOutputNode);
-	if(!cpVideoInfo)
+	a_nodePair.pPreviewNode = createRGBNode(a_nodePair.pOutputNode, 0, 0,
+		(m_previewBitDepth > 8));
+	return (a_nodePair.pPreviewNode != nullptr);
+}
+
+// END OF bool VapourSynthScriptProcessor::recreatePreviewNode(
+//		NodePair & a_nodePair)
+//==============================================================================
+
+bool VapourSynthScriptProcessor::recreateProxyNode(NodePair & a_nodePair)
+{
+	if(!a_nodePair.pOutputNode)
+		return false;
+
+	if(!m_cpVSAPI)
 		return false;
-	const VSFormat * cpFormat = cpVideoInfo->format;
 
-	if(cpFormat->id == pfCompatBGR32)
+	if(a_nodePair.pProxyNode)
 	{
-		a_nodePair.pPreviewNode =
-			m_cpVSAPI->cloneNodeRef(a_nodePair.pOutputNode);
-		return true;
+		m_cpVSAPI->freeNode(a_nodePair.pProxyNode);
+		a_nodePair.pProxyNode = nullptr;
 	}
 
+	if((m_proxyWidth <= 0) || (m_proxyHeight <= 0))
+		return false;
+
+	a_nodePair.pProxyNode = createRGBNode(a_nodePair.pOutputNode,
+		m_proxyWidth, m_proxyHeight);
+	return (a_nodePair.pProxyNode != nullptr);
+}
+
+// END OF bool VapourSynthScriptProcessor::recreateProxyNode(
+//		NodePair & a_nodePair)
+//==============================================================================
+
+VSNodeRef * VapourSynthScriptProcessor::createRGBNode(VSNodeRef * a_pNode,
+	int a_width, int a_height, bool a_deepColor)
+{
+	Q_ASSERT(a_pNode);
+	Q_ASSERT(m_cpVSAPI);
+
+	const VSVideoInfo * cpVideoInfo = m_cpVSAPI->getVideoInfo(a_pNode);
+	if(!cpVideoInfo)
+		return nullptr;
+	const VSFormat * cpFormat = cpVideoInfo->format;
+
+	// Compat input is passed as is, consumers scale it if needed.
+	if((cpFormat->id == pfCompatBGR32) && (!a_deepColor))
+		return m_cpVSAPI->cloneNodeRef(a_pNode);
+
 	bool isYUV = ((cpFormat->colorFamily == cmYUV) ||
 		(cpFormat->id == pfCompatYUY2));
 	bool canSubsample = (isYUV || (cpFormat->colorFamily == cmYCoCg));
@@ -580,9 +914,14 @@ bool VapourSynthScriptProcessor::recreatePreviewNode(NodePair & a_nodePair)
 	const char * resizeName = "Point";
 
 	VSMap * pArgumentMap = m_cpVSAPI->createMap();
-	m_cpVSAPI->propSetNode(pArgumentMap, "clip", a_nodePair.pOutputNode,
-		paReplace);
-	m_cpVSAPI->propSetInt(pArgumentMap, "format", pfCompatBGR32, paReplace);
+	m_cpVSAPI->propSetNode(pArgumentMap, "clip", a_pNode, paReplace);
+	m_cpVSAPI->propSetInt(pArgumentMap, "format",
+		a_deepColor ? pfRGB48 : pfCompatBGR32, paReplace);
+	if((a_width > 0) && (a_height > 0))
+	{
+		m_cpVSAPI->propSetInt(pArgumentMap, "width", a_width, paReplace);
+		m_cpVSAPI->propSetInt(pArgumentMap, "height", a_height, paReplace);
+	}
 
 	if(canSubsample)
 	{
@@ -693,21 +1032,20 @@ bool VapourSynthScriptProcessor::recreatePreviewNode(NodePair & a_nodePair)
 		m_error += cpResultError;
 		emit signalWriteLogMessage(mtCritical, m_error);
 		m_cpVSAPI->freeMap(pResultMap);
-		return false;
+		return nullptr;
 	}
 
-	VSNodeRef * pPreviewNode = m_cpVSAPI->propGetNode(pResultMap, "clip", 0,
+	VSNodeRef * pRGBNode = m_cpVSAPI->propGetNode(pResultMap, "clip", 0,
 		nullptr);
-	Q_ASSERT(pPreviewNode);
-	a_nodePair.pPreviewNode = pPreviewNode;
+	Q_ASSERT(pRGBNode);
 
 	m_cpVSAPI->freeMap(pResultMap);
 
-	return true;
+	return pRGBNode;
 }
 
-// END OF bool VapourSynthScriptProcessor::recreatePreviewNode(
-//		NodePair & a_nodePair)
+// END OF VSNodeRef * VapourSynthScriptProcessor::createRGBNode(
+//		VSNodeRef * a_pNode, int a_width, int a_height, bool a_deepColor)
 //==============================================================================
 
 void VapourSynthScriptProcessor::freeFrameTicket(FrameTicket & a_ticket)
@@ -747,7 +1085,7 @@ void VapourSynthScriptProcessor::freeFrameTicket(FrameTicket & a_ticket)
 //==============================================================================
 
 NodePair & VapourSynthScriptProcessor::getNodePair(int a_outputIndex,
-	bool a_needPreview)
+	bool a_needPreview, bool a_proxy)
 {
     // retrieve two video nodes from vsscript library, outputNode and PreviewNode
     // outputNode to retrieve general info of the video,
@@ -783,11 +1121,33 @@ NodePair & VapourSynthScriptProcessor::getNodePair(int a_outputIndex,
 		}
 	}
 
+	if(a_needPreview && a_proxy && (!nodePair.pProxyNode))
+	{
+		bool proxyNodeCreated = recreateProxyNode(nodePair);
+		if(!proxyNodeCreated)
+		{
+			m_error = tr("Couldn't create proxy node for output "
+				"number %1.").arg(a_outputIndex);
+			emit signalWriteLogMessage(mtCritical, m_error);
+			return nodePair;
+		}
+	}
+
 	return nodePair;
 }
 
 // END OF NodePair VapourSynthScriptProcessor::getNodePair(int a_outputIndex,
-//		bool a_needPreview)
+//		bool a_needPreview, bool a_proxy)
+//==============================================================================
+
+int VapourSynthScriptProcessor::liveFrameTicketsInProcess() const
+{
+	return int(std::count_if(m_frameTicketsInProcess.begin(),
+		m_frameTicketsInProcess.end(),
+		[](const FrameTicket & a_ticket){return !a_ticket.discard;}));
+}
+
+// END OF int VapourSynthScriptProcessor::liveFrameTicketsInProcess() const
 //==============================================================================
 
 QString VapourSynthScriptProcessor::framePropsString(
@@ -982,3 +1342,57 @@ void VapourSynthScriptProcessor::printFrameProps(const VSFrameRef * a_cpFrame)
 // END OF void VapourSynthScriptProcessor::printFrameProps(
 //		const VSFrameRef * a_cpFrame)
 //==============================================================================
+
+void VapourSynthScriptProcessor::storeThumbnail(
+	const VSFrameRef * a_cpFrameRef, const QString & a_errorMessage)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_thumbnailMutex);
+		m_cpThumbnailFrameRef = a_cpFrameRef;
+		m_thumbnailError = a_errorMessage;
+		m_thumbnailInProcess = false;
+	}
+	m_thumbnailCondition.notify_all();
+}
+
+// END OF void VapourSynthScriptProcessor::storeThumbnail(
+//		const VSFrameRef * a_cpFrameRef, const QString & a_errorMessage)
+//==============================================================================
+
+void VapourSynthScriptProcessor::waitForThumbnail()
+{
+	if(!m_pThumbnailRequestNode)
+		return;
+
+	const VSFrameRef * cpFrameRef = nullptr;
+	{
+		std::unique_lock<std::mutex> lock(m_thumbnailMutex);
+		m_thumbnailCondition.wait(lock,
+			[&](){return !m_thumbnailInProcess;});
+		cpFrameRef = m_cpThumbnailFrameRef;
+		m_cpThumbnailFrameRef = nullptr;
+		m_thumbnailError.clear();
+	}
+
+	if(cpFrameRef)
+		m_cpVSAPI->freeFrame(cpFrameRef);
+	m_cpVSAPI->freeNode(m_pThumbnailRequestNode);
+	m_pThumbnailRequestNode = nullptr;
+	m_thumbnailSampleNumber = -1;
+}
+
+// END OF void VapourSynthScriptProcessor::waitForThumbnail()
+//==============================================================================
+
+void VapourSynthScriptProcessor::freeThumbnailClip()
+{
+	if(!m_pThumbnailNode)
+		return;
+
+	Q_ASSERT(m_cpVSAPI);
+	m_cpVSAPI->freeNode(m_pThumbnailNode);
+	m_pThumbnailNode = nullptr;
+}
+
+// END OF void VapourSynthScriptProcessor::freeThumbnailClip()
+//==============================================================================
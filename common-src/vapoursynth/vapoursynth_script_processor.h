@@ -9,6 +9,8 @@
 #include <deque>
 #include <vector>
 #include <map>
+#include <mutex>
+#include <condition_variable>
 
 class VSScriptLibrary;
 
@@ -35,8 +37,12 @@ public:
 
 	const VSVideoInfo * videoInfo(int a_outputIndex = 0);
 
+	bool coreInfo(VSCoreInfo * a_pCoreInfo) const;
+
+	/// With a_proxy the preview frame comes from the downscaled proxy
+	/// node if a proxy size is set, otherwise from the full preview node.
 	bool requestFrameAsync(int a_frameNumber, int a_outputIndex = 0,
-		bool a_needPreview = false);
+		bool a_needPreview = false, bool a_proxy = false);
 
 	bool flushFrameTicketsQueue();
 
@@ -50,6 +56,33 @@ public:
 
     QString framePropsString(const VSFrameRef * a_cpFrame) const;
 
+	/// Size of the RGB proxy frames used for interactive scrubbing.
+	/// Zero size disables proxies.
+	void setPreviewProxySize(int a_width, int a_height);
+
+	/// Frames rendered at once. The preview keeps 2 so a new request
+	/// is served soon, batch consumers may use 0 for the core threads.
+	void setFrameRequestsLimit(int a_limit);
+
+	int frameRequestsLimit() const;
+
+	/// Preview frames are CompatBGR32 for 8 bits and planar RGB48
+	/// for 16 bits, other values are rounded to one of these.
+	void setPreviewBitDepth(int a_bitsPerSample);
+
+	int previewBitDepth() const;
+
+	/// Sets up a downscaled RGB clip holding every a_step frame
+	/// of the output for background thumbnail requests.
+	bool setThumbnailClip(int a_step, int a_width, int a_height,
+		int a_outputIndex = 0);
+
+	/// Thumbnails are requested one at a time and only while
+	/// no preview frames are queued or in process.
+	bool requestThumbnailAsync(int a_sampleNumber);
+
+	void flushThumbnailQueue();
+
 public slots:
 
 	void slotResetSettings();
@@ -70,14 +103,30 @@ signals:
 
 	void signalFinalized();
 
+	void signalDistributeThumbnail(int a_sampleNumber,
+		const VSFrameRef * a_cpFrameRef);
+
 private slots:
 
 	void slotReceiveFrameAndProcessQueue(
 		const VSFrameRef * a_cpFrameRef, int a_frameNumber,
 		VSNodeRef * a_pNodeRef, QString a_errorMessage);
 
+	void slotReceiveThumbnailAndProcessQueue();
+
 private:
 
+	friend void VS_CC thumbnailReady(void * a_pUserData,
+		const VSFrameRef * a_cpFrameRef, int a_frameNumber,
+		VSNodeRef * a_pNodeRef, const char * a_errorMessage);
+
+	void storeThumbnail(const VSFrameRef * a_cpFrameRef,
+		const QString & a_errorMessage);
+
+	void waitForThumbnail();
+
+	void freeThumbnailClip();
+
 	void receiveFrame(const VSFrameRef * a_cpFrameRef, int a_frameNumber,
 		VSNodeRef * a_pNodeRef, const QString & a_errorMessage);
 
@@ -87,9 +136,17 @@ private:
 
 	bool recreatePreviewNode(NodePair & a_nodePair);
 
+	bool recreateProxyNode(NodePair & a_nodePair);
+
+	VSNodeRef * createRGBNode(VSNodeRef * a_pNode, int a_width = 0,
+		int a_height = 0, bool a_deepColor = false);
+
 	void freeFrameTicket(FrameTicket & a_ticket);
 
-	NodePair & getNodePair(int a_outputIndex, bool a_needPreview);
+	NodePair & getNodePair(int a_outputIndex, bool a_needPreview,
+		bool a_proxy = false);
+
+	int liveFrameTicketsInProcess() const;
 
 
 	void printFrameProps(const VSFrameRef * a_cpFrame);
@@ -124,6 +181,25 @@ private:
 	YuvMatrixCoefficients m_yuvMatrix;
 
 	bool m_finalizing;
+
+	int m_proxyWidth;
+	int m_proxyHeight;
+
+	int m_frameRequestsLimit;
+
+	int m_previewBitDepth;
+
+	VSNodeRef * m_pThumbnailNode;
+	std::deque<int> m_thumbnailQueue;
+	int m_thumbnailSampleNumber;
+	VSNodeRef * m_pThumbnailRequestNode;
+
+	// Filled by the frame callback on a VapourSynth thread.
+	std::mutex m_thumbnailMutex;
+	std::condition_variable m_thumbnailCondition;
+	bool m_thumbnailInProcess;
+	const VSFrameRef * m_cpThumbnailFrameRef;
+	QString m_thumbnailError;
 };
 
 //==============================================================================
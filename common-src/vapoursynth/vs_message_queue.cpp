@@ -0,0 +1,84 @@
+#include "vs_message_queue.h"
+
+//==============================================================================
+
+VSMessageQueue::Message::Message(int a_type, const QString & a_text) :
+	  type(a_type)
+	, text(a_text)
+{
+}
+
+// END OF VSMessageQueue::Message::Message(int a_type,
+//		const QString & a_text)
+//==============================================================================
+
+VSMessageQueue::Node::Node() :
+	  next(nullptr)
+{
+}
+
+// END OF VSMessageQueue::Node::Node()
+//==============================================================================
+
+VSMessageQueue::VSMessageQueue() :
+	  m_head(nullptr)
+	, m_tail(new Node)
+{
+	m_head.store(m_tail, std::memory_order_relaxed);
+}
+
+// END OF VSMessageQueue::VSMessageQueue()
+//==============================================================================
+
+VSMessageQueue::~VSMessageQueue()
+{
+	while(m_tail)
+	{
+		Node * pNext = m_tail->next.load(std::memory_order_relaxed);
+		delete m_tail;
+		m_tail = pNext;
+	}
+}
+
+// END OF VSMessageQueue::~VSMessageQueue()
+//==============================================================================
+
+void VSMessageQueue::push(int a_type, const QString & a_text)
+{
+	Node * pNode = new Node;
+	pNode->message.type = a_type;
+	pNode->message.text = a_text;
+
+	Node * pPrevious = m_head.exchange(pNode, std::memory_order_acq_rel);
+	pPrevious->next.store(pNode, std::memory_order_release);
+}
+
+// END OF void VSMessageQueue::push(int a_type, const QString & a_text)
+//==============================================================================
+
+bool VSMessageQueue::pop(Message & a_message)
+{
+	Node * pNext = m_tail->next.load(std::memory_order_acquire);
+	if(!pNext)
+		return false;
+
+	// The popped node becomes the new stub.
+	a_message.type = pNext->message.type;
+	a_message.text.swap(pNext->message.text);
+	delete m_tail;
+	m_tail = pNext;
+	return true;
+}
+
+// END OF bool VSMessageQueue::pop(Message & a_message)
+//==============================================================================
+
+bool VSMessageQueue::isEmpty() const
+{
+	// A node may already be taken by a producer but not yet linked,
+	// so compare with the head rather than checking the link.
+	return (m_head.load(std::memory_order_acquire) == m_tail);
+}
+
+// END OF bool VSMessageQueue::isEmpty() const
+//==============================================================================
@@ -0,0 +1,54 @@
+#ifndef VS_MESSAGE_QUEUE_H_INCLUDED
+#define VS_MESSAGE_QUEUE_H_INCLUDED
+
+#include <QString>
+#include <atomic>
+
+//==============================================================================
+
+/// Unbounded lock-free queue of core messages.
+/// Any number of threads may push, only one thread may pop.
+class VSMessageQueue
+{
+public:
+
+	struct Message
+	{
+		int type;
+		QString text;
+
+		Message(int a_type = 0, const QString & a_text = QString());
+	};
+
+	VSMessageQueue();
+
+	VSMessageQueue(const VSMessageQueue &) = delete;
+	VSMessageQueue & operator=(const VSMessageQueue &) = delete;
+
+	virtual ~VSMessageQueue();
+
+	void push(int a_type, const QString & a_text);
+
+	bool pop(Message & a_message);
+
+	bool isEmpty() const;
+
+private:
+
+	struct Node
+	{
+		std::atomic<Node *> next;
+		Message message;
+
+		Node();
+	};
+
+	// Producers link new nodes after m_head. The consumer owns m_tail,
+	// which is a stub node preceding the next message.
+	std::atomic<Node *> m_head;
+	Node * m_tail;
+};
+
+//==============================================================================
+
+#endif // VS_MESSAGE_QUEUE_H_INCLUDED
@@ -5,6 +5,28 @@
 
 #include <QSettings>
 #include <QProcessEnvironment>
+#include <QTimer>
+#include <QThread>
+#include <algorithm>
+
+//==============================================================================
+
+// Messages emitted per drain interval.
+const int MESSAGE_DRAIN_INTERVAL = 100;
+const int MAX_MESSAGES_PER_DRAIN = 50;
+
+// Messages waiting in the queue before new ones are dropped.
+const int MAX_QUEUED_MESSAGES = 10000;
+
+// Token bucket of each message source.
+const double SOURCE_MESSAGES_PER_SECOND = 20.0;
+const double SOURCE_MESSAGES_BURST = 40.0;
+
+// How often repeated and suppressed messages are summarized.
+const int MESSAGE_SUMMARY_INTERVAL = 1000;
+
+const int MAX_MESSAGE_SOURCE_LENGTH = 48;
+const int MAX_MESSAGE_SOURCES = 256;
 
 //==============================================================================
 
@@ -20,6 +42,20 @@ void VS_CC vsMessageHandler(int a_msgType, const char * a_message,
 //		void * a_pUserData)
 //==============================================================================
 
+VSScriptLibrary::SourceLimit::SourceLimit(int a_messageType,
+	const QString & a_name, qint64 a_time) :
+	  messageType(a_messageType)
+	, name(a_name)
+	, tokens(SOURCE_MESSAGES_BURST)
+	, lastTime(a_time)
+	, suppressed(0)
+{
+}
+
+// END OF VSScriptLibrary::SourceLimit::SourceLimit(int a_messageType,
+//		const QString & a_name, qint64 a_time)
+//==============================================================================
+
 VSScriptLibrary::VSScriptLibrary(SettingsManagerCore * a_pSettingsManager,
 	QObject * a_pParent):
 	QObject(a_pParent)
@@ -28,8 +64,24 @@ VSScriptLibrary::VSScriptLibrary(SettingsManagerCore * a_pSettingsManager,
 	, m_vsScriptInitialized(false)
 	, m_initialized(false)
 	, m_cpVSAPI(nullptr)
+	, m_queuedMessages(0)
+	, m_droppedMessages(0)
+	, m_drainScheduled(false)
+	, m_pDrainTimer(nullptr)
+	, m_drainWindowStart(0)
+	, m_drainBudget(MAX_MESSAGES_PER_DRAIN)
+	, m_lastSummaryTime(0)
+	, m_lastMessageValid(false)
+	, m_repeatCount(0)
 {
 	Q_ASSERT(m_pSettingsManager);
+
+	m_messageClock.start();
+
+	m_pDrainTimer = new QTimer(this);
+	m_pDrainTimer->setSingleShot(true);
+	connect(m_pDrainTimer, &QTimer::timeout,
+		this, &VSScriptLibrary::slotDrainMessages);
 }
 
 // END OF VSScriptLibrary::VSScriptLibrary(
@@ -343,12 +395,218 @@ void VSScriptLibrary::freeLibrary()
 // END OF void VSScriptLibrary::freeLibrary()
 //==============================================================================
 
+void VSScriptLibrary::slotDrainMessages()
+{
+	qint64 now = m_messageClock.elapsed();
+	if(now - m_drainWindowStart >= MESSAGE_DRAIN_INTERVAL)
+	{
+		m_drainWindowStart = now;
+		m_drainBudget = MAX_MESSAGES_PER_DRAIN;
+	}
+
+	VSMessageQueue::Message message;
+	while((m_drainBudget > 0) && m_messageQueue.pop(message))
+	{
+		m_queuedMessages.fetch_sub(1, std::memory_order_relaxed);
+		processMessage(message);
+	}
+
+	if(!m_messageQueue.isEmpty())
+	{
+		// Out of budget, or a message is still being pushed.
+		m_drainScheduled.store(true);
+		int delay = 0;
+		if(m_drainBudget <= 0)
+			delay = int(MESSAGE_DRAIN_INTERVAL - (now - m_drainWindowStart));
+		m_pDrainTimer->start(std::max(delay, 0));
+		return;
+	}
+
+	bool summaryPending = (m_repeatCount > 0) ||
+		(m_droppedMessages.load(std::memory_order_relaxed) > 0);
+	for(const SourceLimit & limit : m_sourceLimits)
+		summaryPending = summaryPending || (limit.suppressed > 0);
+
+	qint64 sinceSummary = now - m_lastSummaryTime;
+	if(summaryPending && (sinceSummary >= MESSAGE_SUMMARY_INTERVAL))
+		flushMessageSummaries();
+	else if(summaryPending)
+		m_pDrainTimer->start(int(MESSAGE_SUMMARY_INTERVAL - sinceSummary));
+
+	m_drainScheduled.store(false);
+	// A producer may have pushed after the queue was seen empty
+	// but before the flag was cleared.
+	if(!m_messageQueue.isEmpty())
+		scheduleMessagesDrain();
+}
+
+// END OF void VSScriptLibrary::slotDrainMessages()
+//==============================================================================
+
 void VSScriptLibrary::handleVSMessage(int a_messageType,
 	const QString & a_message)
 {
-	emit signalWriteLogMessage(a_messageType, a_message);
+	bool ownThread = (QThread::currentThread() == thread());
+
+	// The core aborts right after a fatal message is handled, so severe
+	// messages bypass the queue, the rate limits and the repeat filter.
+	if(a_messageType >= mtCritical)
+	{
+		if(ownThread)
+		{
+			// what is already queued goes first, past the budget
+			VSMessageQueue::Message message;
+			while(m_messageQueue.pop(message))
+			{
+				m_queuedMessages.fetch_sub(1, std::memory_order_relaxed);
+				processMessage(message);
+			}
+			flushRepeatedMessage();
+			m_lastMessageValid = false;
+		}
+		emit signalWriteLogMessage(a_messageType, a_message);
+		return;
+	}
+
+	int queued = m_queuedMessages.fetch_add(1, std::memory_order_relaxed);
+	if(queued >= MAX_QUEUED_MESSAGES)
+	{
+		m_queuedMessages.fetch_sub(1, std::memory_order_relaxed);
+		m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	m_messageQueue.push(a_messageType, a_message);
+
+	// Keep messages in order with the rest of the log when they come
+	// from the library thread itself.
+	if(ownThread)
+		slotDrainMessages();
+	else
+		scheduleMessagesDrain();
 }
 
 // END OF void VSScriptLibrary::handleVSMessage(int a_messageType,
 //		const QString & a_message)
 //==============================================================================
+
+void VSScriptLibrary::scheduleMessagesDrain()
+{
+	if(m_drainScheduled.exchange(true))
+		return;
+
+	QMetaObject::invokeMethod(this, "slotDrainMessages",
+		Qt::QueuedConnection);
+}
+
+// END OF void VSScriptLibrary::scheduleMessagesDrain()
+//==============================================================================
+
+void VSScriptLibrary::processMessage(const VSMessageQueue::Message & a_message)
+{
+	if(m_lastMessageValid && (a_message.type == m_lastMessage.type) &&
+		(a_message.text == m_lastMessage.text))
+	{
+		m_repeatCount++;
+		return;
+	}
+
+	flushRepeatedMessage();
+
+	QString source = messageSource(a_message.text);
+	QString key = QString("%1:%2").arg(a_message.type).arg(source);
+	qint64 now = m_messageClock.elapsed();
+
+	QHash<QString, SourceLimit>::iterator it = m_sourceLimits.find(key);
+	if(it == m_sourceLimits.end())
+	{
+		it = m_sourceLimits.insert(key,
+			SourceLimit(a_message.type, source, now));
+	}
+
+	SourceLimit & limit = it.value();
+	limit.tokens = std::min(SOURCE_MESSAGES_BURST, limit.tokens +
+		double(now - limit.lastTime) * SOURCE_MESSAGES_PER_SECOND / 1000.0);
+	limit.lastTime = now;
+
+	if(limit.tokens < 1.0)
+	{
+		limit.suppressed++;
+		return;
+	}
+	limit.tokens -= 1.0;
+
+	emit signalWriteLogMessage(a_message.type, a_message.text);
+	m_drainBudget--;
+
+	m_lastMessage = a_message;
+	m_lastMessageValid = true;
+}
+
+// END OF void VSScriptLibrary::processMessage(
+//		const VSMessageQueue::Message & a_message)
+//==============================================================================
+
+void VSScriptLibrary::flushRepeatedMessage()
+{
+	if(m_repeatCount == 0)
+		return;
+
+	emit signalWriteLogMessage(m_lastMessage.type,
+		tr("Last message repeated %1 more times.").arg(m_repeatCount));
+	m_repeatCount = 0;
+}
+
+// END OF void VSScriptLibrary::flushRepeatedMessage()
+//==============================================================================
+
+void VSScriptLibrary::flushMessageSummaries()
+{
+	flushRepeatedMessage();
+
+	for(SourceLimit & limit : m_sourceLimits)
+	{
+		if(limit.suppressed == 0)
+			continue;
+
+		QString sourceName = limit.name.isEmpty() ?
+			tr("VapourSynth core") : limit.name;
+		emit signalWriteLogMessage(limit.messageType,
+			tr("%1 messages from \"%2\" were suppressed.")
+			.arg(limit.suppressed).arg(sourceName));
+		limit.suppressed = 0;
+	}
+
+	if(m_sourceLimits.size() > MAX_MESSAGE_SOURCES)
+		m_sourceLimits.clear();
+
+	int dropped = m_droppedMessages.exchange(0);
+	if(dropped > 0)
+	{
+		emit signalWriteLogMessage(mtWarning,
+			tr("%1 messages were dropped because the log "
+			"could not keep up.").arg(dropped));
+	}
+
+	m_lastSummaryTime = m_messageClock.elapsed();
+}
+
+// END OF void VSScriptLibrary::flushMessageSummaries()
+//==============================================================================
+
+QString VSScriptLibrary::messageSource(const QString & a_message)
+{
+	// Plugins usually prefix their messages with their name.
+	int colonIndex = a_message.indexOf(':');
+	if((colonIndex <= 0) || (colonIndex > MAX_MESSAGE_SOURCE_LENGTH))
+		return QString();
+
+	QString source = a_message.left(colonIndex);
+	if(source.contains('\n'))
+		return QString();
+
+	return source.trimmed();
+}
+
+// END OF QString VSScriptLibrary::messageSource(const QString & a_message)
+//==============================================================================
@@ -1,12 +1,18 @@
 #ifndef VS_SCRIPT_LIBRARY_H_INCLUDED
 #define VS_SCRIPT_LIBRARY_H_INCLUDED
 
+#include "vs_message_queue.h"
+
 #include <vapoursynth/VSScript.h>
 
 #include <QObject>
 #include <QLibrary>
+#include <QHash>
+#include <QElapsedTimer>
+#include <atomic>
 
 class SettingsManagerCore;
+class QTimer;
 
 //==============================================================================
 
@@ -57,6 +63,10 @@ signals:
 
 	void signalWriteLogMessage(int a_messageType, const QString & a_message);
 
+private slots:
+
+	void slotDrainMessages();
+
 private:
 
 	bool initLibrary();
@@ -65,6 +75,16 @@ private:
 
 	void handleVSMessage(int a_messageType, const QString & a_message);
 
+	void scheduleMessagesDrain();
+
+	void processMessage(const VSMessageQueue::Message & a_message);
+
+	void flushRepeatedMessage();
+
+	void flushMessageSummaries();
+
+	static QString messageSource(const QString & a_message);
+
 	friend void VS_CC vsMessageHandler(int a_msgType,
 		const char * a_message, void * a_pUserData);
 
@@ -86,6 +106,40 @@ private:
 	bool m_initialized;
 
 	const VSAPI * m_cpVSAPI;
+
+	// Core messages arrive from any thread. They are queued and drained
+	// into signalWriteLogMessage() on the library thread at a bounded rate,
+	// with repeats collapsed and chatty sources rate limited. Critical
+	// and fatal messages are emitted right away.
+
+	struct SourceLimit
+	{
+		int messageType;
+		QString name;
+		double tokens;
+		qint64 lastTime;
+		int suppressed;
+
+		SourceLimit(int a_messageType = 0,
+			const QString & a_name = QString(), qint64 a_time = 0);
+	};
+
+	VSMessageQueue m_messageQueue;
+	std::atomic<int> m_queuedMessages;
+	std::atomic<int> m_droppedMessages;
+	std::atomic<bool> m_drainScheduled;
+
+	QTimer * m_pDrainTimer;
+	QElapsedTimer m_messageClock;
+	qint64 m_drainWindowStart;
+	int m_drainBudget;
+	qint64 m_lastSummaryTime;
+
+	VSMessageQueue::Message m_lastMessage;
+	bool m_lastMessageValid;
+	int m_repeatCount;
+
+	QHash<QString, SourceLimit> m_sourceLimits;
 };
 
 //==============================================================================
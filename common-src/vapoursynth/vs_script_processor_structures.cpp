@@ -25,7 +25,7 @@ FrameTicket::FrameTicket()
 
 FrameTicket::FrameTicket(int a_frameNumber, int a_outputIndex,
 		VSNodeRef * a_pOutputNode, bool a_needPreview,
-		VSNodeRef * a_pPreviewNode):
+		VSNodeRef * a_pPreviewNode, bool a_proxy):
 	frameNumber(a_frameNumber)
 	, outputIndex(a_outputIndex)
 	, pOutputNode(a_pOutputNode)
@@ -34,6 +34,7 @@ FrameTicket::FrameTicket(int a_frameNumber, int a_outputIndex,
 	, cpOutputFrameRef(nullptr)
 	, cpPreviewFrameRef(nullptr)
 	, discard(false)
+	, proxy(a_proxy)
 {
 }
 
@@ -53,6 +54,7 @@ NodePair::NodePair():
 	  outputIndex(-1)
 	, pOutputNode(nullptr)
 	, pPreviewNode(nullptr)
+	, pProxyNode(nullptr)
 {
 }
 
@@ -63,6 +65,7 @@ NodePair::NodePair(int a_outputIndex, VSNodeRef * a_pOutputNode,
 	  outputIndex(a_outputIndex)
 	, pOutputNode(a_pOutputNode)
 	, pPreviewNode(a_pPreviewNode)
+	, pProxyNode(nullptr)
 {
 }
 
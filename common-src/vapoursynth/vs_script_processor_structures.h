@@ -30,11 +30,13 @@ struct FrameTicket
 	const VSFrameRef * cpOutputFrameRef;
 	const VSFrameRef * cpPreviewFrameRef;
 	bool discard;
+	// preview comes from the downscaled proxy node
+	bool proxy;
 
     FrameTicket();
 	FrameTicket(int a_frameNumber, int a_outputIndex,
 		VSNodeRef * a_pOutputNode, bool a_needPreview = false,
-		VSNodeRef * a_pPreviewNode = nullptr);
+		VSNodeRef * a_pPreviewNode = nullptr, bool a_proxy = false);
 
 	bool isComplete() const;
 };
@@ -46,6 +48,7 @@ struct NodePair
 	int outputIndex;
 	VSNodeRef * pOutputNode;
 	VSNodeRef * pPreviewNode;
+	VSNodeRef * pProxyNode;
 
 	NodePair();
 	NodePair(int a_outputIndex, VSNodeRef * a_pOutputNode,
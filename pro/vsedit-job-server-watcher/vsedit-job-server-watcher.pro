@@ -169,13 +169,16 @@ HEADERS += $${COMMON_DIRECTORY}/common-src/log/styled_log_view.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/log/vs_editor_log_definitions.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/log/vs_editor_log.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_library.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_message_queue.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_processor_structures.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vapoursynth_script_processor.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/jobs/job_variables.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/jobs/job_telemetry.h
 HEADERS += $${PROJECT_DIRECTORY}/src/jobs/jobs_model.h
 HEADERS += $${PROJECT_DIRECTORY}/src/jobs/job_edit_dialog.h
 HEADERS += $${PROJECT_DIRECTORY}/src/jobs/job_dependencies_delegate.h
 HEADERS += $${PROJECT_DIRECTORY}/src/jobs/job_state_delegate.h
+HEADERS += $${PROJECT_DIRECTORY}/src/jobs/job_telemetry_delegate.h
 HEADERS += $${PROJECT_DIRECTORY}/src/connect_to_server_dialog.h
 HEADERS += $${PROJECT_DIRECTORY}/src/trusted_clients_addresses_dialog.h
 HEADERS += $${PROJECT_DIRECTORY}/src/main_window.h
@@ -194,13 +197,16 @@ SOURCES += $${COMMON_DIRECTORY}/common-src/log/styled_log_view.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/log/vs_editor_log_definitions.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/log/vs_editor_log.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_library.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_message_queue.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_processor_structures.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vapoursynth_script_processor.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/jobs/job_variables.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/jobs/job_telemetry.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/jobs/jobs_model.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/jobs/job_edit_dialog.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/jobs/job_dependencies_delegate.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/jobs/job_state_delegate.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/jobs/job_telemetry_delegate.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/connect_to_server_dialog.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/trusted_clients_addresses_dialog.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/main_window.cpp
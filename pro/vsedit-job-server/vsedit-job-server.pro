@@ -150,6 +150,7 @@ HEADERS += $${COMMON_DIRECTORY}/common-src/settings/settings_manager_core.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/log/styled_log_view_core.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/log/vs_editor_log_definitions.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_library.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_message_queue.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_processor_structures.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vapoursynth_script_processor.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/frame_header_writers/frame_header_writer.h
@@ -157,11 +158,19 @@ HEADERS += $${COMMON_DIRECTORY}/common-src/frame_header_writers/frame_header_wri
 HEADERS += $${COMMON_DIRECTORY}/common-src/frame_header_writers/frame_header_writer_y4m.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/jobs/job.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/jobs/job_variables.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/jobs/encoder_output_parser.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/jobs/job_telemetry.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/application_instance_file_guard/application_instance_file_guard.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/ipc_defines.h
 
 HEADERS += $${PROJECT_DIRECTORY}/src/jobs/job_definitions.h
 HEADERS += $${PROJECT_DIRECTORY}/src/jobs/jobs_manager.h
+HEADERS += $${PROJECT_DIRECTORY}/src/jobs/jobs_store.h
+HEADERS += $${PROJECT_DIRECTORY}/src/jobs/process_usage.h
+HEADERS += $${PROJECT_DIRECTORY}/src/log/server_log.h
+HEADERS += $${PROJECT_DIRECTORY}/src/federation/remote_job.h
+HEADERS += $${PROJECT_DIRECTORY}/src/federation/worker_pool.h
+HEADERS += $${PROJECT_DIRECTORY}/src/federation/worker_link.h
 HEADERS += $${PROJECT_DIRECTORY}/src/job_server.h
 
 SOURCES += $${COMMON_DIRECTORY}/common-src/helpers.cpp
@@ -170,6 +179,7 @@ SOURCES += $${COMMON_DIRECTORY}/common-src/settings/settings_manager_core.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/log/styled_log_view_core.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/log/vs_editor_log_definitions.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_library.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_message_queue.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_processor_structures.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vapoursynth_script_processor.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/frame_header_writers/frame_header_writer.cpp
@@ -177,9 +187,17 @@ SOURCES += $${COMMON_DIRECTORY}/common-src/frame_header_writers/frame_header_wri
 SOURCES += $${COMMON_DIRECTORY}/common-src/frame_header_writers/frame_header_writer_y4m.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/jobs/job.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/jobs/job_variables.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/jobs/encoder_output_parser.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/jobs/job_telemetry.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/application_instance_file_guard/application_instance_file_guard.cpp
 
 SOURCES += $${PROJECT_DIRECTORY}/src/jobs/jobs_manager.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/jobs/jobs_store.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/jobs/process_usage.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/log/server_log.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/federation/remote_job.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/federation/worker_pool.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/federation/worker_link.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/job_server.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/main.cpp
 
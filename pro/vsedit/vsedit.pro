@@ -116,6 +116,11 @@ macx {
 	ICON = $${COMMON_DIRECTORY}/resources/vsedit.icns
 }
 
+unix {
+	# dladdr() for the path of the loaded VapourSynth library
+	LIBS += -ldl
+}
+
 win32 {
 	QT += winextras
 
@@ -185,11 +190,15 @@ FORMS += $${PROJECT_DIRECTORY}/src/settings/theme_select_dialog.ui
 FORMS += $${PROJECT_DIRECTORY}/src/script_status_bar_widget/script_status_bar_widget.ui
 FORMS += $${PROJECT_DIRECTORY}/src/preview/preview_advanced_settings_dialog.ui
 FORMS += $${PROJECT_DIRECTORY}/src/preview/frame_info_dialog.ui
+FORMS += $${PROJECT_DIRECTORY}/src/preview/scopes_dialog.ui
 FORMS += $${PROJECT_DIRECTORY}/src/frame_consumers/benchmark_dialog.ui
+FORMS += $${PROJECT_DIRECTORY}/src/frame_consumers/clip_metrics_dialog.ui
+FORMS += $${PROJECT_DIRECTORY}/src/frame_consumers/frame_export_dialog.ui
 FORMS += $${PROJECT_DIRECTORY}/src/frame_consumers/encode_dialog.ui
 FORMS += $${PROJECT_DIRECTORY}/src/script_templates/templates_dialog.ui
 FORMS += $${PROJECT_DIRECTORY}/src/script_editor/find_dialog.ui
 FORMS += $${PROJECT_DIRECTORY}/src/selection_tools/selection_tools_dialog.ui
+FORMS += $${PROJECT_DIRECTORY}/src/selection_tools/region_statistics_dialog.ui
 FORMS += $${PROJECT_DIRECTORY}/src/bookmark_manager/bookmark_manager_dialog.ui
 FORMS += $${PROJECT_DIRECTORY}/src/preview_filters/preview_filters_dialog.ui
 FORMS += $${PROJECT_DIRECTORY}/src/main_window.ui
@@ -209,6 +218,7 @@ HEADERS += $${COMMON_DIRECTORY}/common-src/log/styled_log_view.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/log/vs_editor_log_definitions.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/log/vs_editor_log.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_library.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_message_queue.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_processor_structures.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vapoursynth_script_processor.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/frame_header_writers/frame_header_writer.h
@@ -216,6 +226,7 @@ HEADERS += $${COMMON_DIRECTORY}/common-src/frame_header_writers/frame_header_wri
 HEADERS += $${COMMON_DIRECTORY}/common-src/frame_header_writers/frame_header_writer_y4m.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/jobs/job.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/jobs/job_variables.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/jobs/encoder_output_parser.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/qt_widgets_subclasses/zoom_ratio_spinbox.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/qt_widgets_subclasses/spinbox_extended_lineedit.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/qt_widgets_subclasses/generic_spinbox.h
@@ -224,6 +235,7 @@ HEADERS += $${COMMON_DIRECTORY}/common-src/qt_widgets_subclasses/collapse_expand
 HEADERS += $${COMMON_DIRECTORY}/common-src/qt_widgets_subclasses/generic_stringlist_model.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/frame_timeline/timeline.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/frame_timeline/timeline_view.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/frame_timeline/timeline_strip.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/frame_timeline/slider.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/kdsingleapplication/kdsingleapplication_lib.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/kdsingleapplication/kdsingleapplication_localsocket_p.h
@@ -242,6 +254,12 @@ HEADERS += $${PROJECT_DIRECTORY}/src/preview/preview_advanced_settings_dialog.h
 HEADERS += $${PROJECT_DIRECTORY}/src/preview/script_processor.h
 HEADERS += $${PROJECT_DIRECTORY}/src/preview/frame_info_dialog.h
 HEADERS += $${PROJECT_DIRECTORY}/src/preview/frame_painter.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/timeline_strip_builder.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/play_prefetch_ring.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/video_scopes.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/video_scopes_builder.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/scopes_dialog.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/deep_color_converter.h
 HEADERS += $${PROJECT_DIRECTORY}/src/script_editor/number_matcher.h
 HEADERS += $${PROJECT_DIRECTORY}/src/script_editor/syntax_highlighter.h
 HEADERS += $${PROJECT_DIRECTORY}/src/script_editor/script_completer_model.h
@@ -251,11 +269,17 @@ HEADERS += $${PROJECT_DIRECTORY}/src/script_editor/find_dialog.h
 HEADERS += $${PROJECT_DIRECTORY}/src/selection_tools/selection_tools_dialog.h
 HEADERS += $${PROJECT_DIRECTORY}/src/selection_tools/canvas.h
 HEADERS += $${PROJECT_DIRECTORY}/src/selection_tools/line_painter.h
+HEADERS += $${PROJECT_DIRECTORY}/src/selection_tools/region_statistics.h
+HEADERS += $${PROJECT_DIRECTORY}/src/selection_tools/region_statistics_dialog.h
 HEADERS += $${PROJECT_DIRECTORY}/src/vapoursynth/vs_plugin_data.h
+HEADERS += $${PROJECT_DIRECTORY}/src/vapoursynth/vs_plugins_metadata_cache.h
 HEADERS += $${PROJECT_DIRECTORY}/src/vapoursynth/vapoursynth_plugins_manager.h
 HEADERS += $${PROJECT_DIRECTORY}/src/vapoursynth/vs_script_processor_dialog.h
 HEADERS += $${PROJECT_DIRECTORY}/src/job_server_watcher_socket.h
 HEADERS += $${PROJECT_DIRECTORY}/src/frame_consumers/benchmark_dialog.h
+HEADERS += $${PROJECT_DIRECTORY}/src/frame_consumers/clip_metrics.h
+HEADERS += $${PROJECT_DIRECTORY}/src/frame_consumers/clip_metrics_dialog.h
+HEADERS += $${PROJECT_DIRECTORY}/src/frame_consumers/frame_export_dialog.h
 HEADERS += $${PROJECT_DIRECTORY}/src/frame_consumers/encode_dialog.h
 HEADERS += $${PROJECT_DIRECTORY}/src/script_templates/drop_file_category_model.h
 HEADERS += $${PROJECT_DIRECTORY}/src/script_templates/templates_dialog.h
@@ -277,6 +301,7 @@ SOURCES += $${COMMON_DIRECTORY}/common-src/log/styled_log_view.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/log/vs_editor_log_definitions.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/log/vs_editor_log.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_library.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_message_queue.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_processor_structures.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vapoursynth_script_processor.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/frame_header_writers/frame_header_writer.cpp
@@ -284,6 +309,7 @@ SOURCES += $${COMMON_DIRECTORY}/common-src/frame_header_writers/frame_header_wri
 SOURCES += $${COMMON_DIRECTORY}/common-src/frame_header_writers/frame_header_writer_y4m.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/jobs/job.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/jobs/job_variables.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/jobs/encoder_output_parser.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/qt_widgets_subclasses/zoom_ratio_spinbox.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/qt_widgets_subclasses/spinbox_extended_lineedit.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/qt_widgets_subclasses/generic_spinbox.cpp
@@ -292,6 +318,7 @@ SOURCES += $${COMMON_DIRECTORY}/common-src/qt_widgets_subclasses/collapse_expand
 SOURCES += $${COMMON_DIRECTORY}/common-src/qt_widgets_subclasses/generic_stringlist_model.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/frame_timeline/timeline.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/frame_timeline/timeline_view.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/frame_timeline/timeline_strip.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/frame_timeline/slider.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/kdsingleapplication/kdsingleapplication.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/kdsingleapplication/kdsingleapplication_localsocket.cpp
@@ -309,6 +336,12 @@ SOURCES += $${PROJECT_DIRECTORY}/src/preview/preview_advanced_settings_dialog.cp
 SOURCES += $${PROJECT_DIRECTORY}/src/preview/script_processor.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/preview/frame_info_dialog.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/preview/frame_painter.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/timeline_strip_builder.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/play_prefetch_ring.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/video_scopes.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/video_scopes_builder.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/scopes_dialog.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/deep_color_converter.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/script_editor/number_matcher.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/script_editor/syntax_highlighter.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/script_editor/script_completer_model.cpp
@@ -318,11 +351,17 @@ SOURCES += $${PROJECT_DIRECTORY}/src/script_editor/find_dialog.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/selection_tools/selection_tools_dialog.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/selection_tools/canvas.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/selection_tools/line_painter.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/selection_tools/region_statistics.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/selection_tools/region_statistics_dialog.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/vapoursynth/vs_plugin_data.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/vapoursynth/vs_plugins_metadata_cache.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/vapoursynth/vapoursynth_plugins_manager.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/vapoursynth/vs_script_processor_dialog.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/job_server_watcher_socket.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/frame_consumers/benchmark_dialog.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/frame_consumers/clip_metrics.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/frame_consumers/clip_metrics_dialog.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/frame_consumers/frame_export_dialog.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/frame_consumers/encode_dialog.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/script_templates/drop_file_category_model.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/script_templates/templates_dialog.cpp
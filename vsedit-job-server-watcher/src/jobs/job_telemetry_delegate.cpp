@@ -0,0 +1,81 @@
+#include "job_telemetry_delegate.h"
+
+#include "jobs_model.h"
+
+#include <QPainter>
+#include <QPolygonF>
+#include <algorithm>
+
+JobTelemetryDelegate::JobTelemetryDelegate(QObject * a_pParent) :
+	QStyledItemDelegate(a_pParent)
+{
+}
+
+JobTelemetryDelegate::~JobTelemetryDelegate()
+{
+}
+
+void JobTelemetryDelegate::paint(QPainter * a_pPainter,
+	const QStyleOptionViewItem & a_option, const QModelIndex & a_index) const
+{
+	const JobsModel * cpModel =
+		qobject_cast<const JobsModel *>(a_index.model());
+	Q_ASSERT(cpModel);
+	Q_ASSERT(a_index.column() == JobsModel::TELEMETRY_COLUMN);
+
+	QStyledItemDelegate::paint(a_pPainter, a_option, a_index);
+
+	std::deque<JobTelemetrySample> telemetry =
+		cpModel->jobTelemetry(a_index.row());
+	if(telemetry.empty())
+		return;
+
+	a_pPainter->save();
+	a_pPainter->setRenderHint(QPainter::Antialiasing);
+
+	QRectF area = QRectF(a_option.rect).adjusted(2.0, 2.0, -2.0, -2.0);
+
+	const JobTelemetrySample & last = telemetry.back();
+	if(last.framebufferMax > 0)
+	{
+		double fill = std::min(double(last.framebufferUsed) /
+			double(last.framebufferMax), 1.0);
+		QRectF fillRect = area;
+		fillRect.setTop(area.bottom() - area.height() * fill);
+		a_pPainter->fillRect(fillRect, QColor("#e4f4e4"));
+	}
+
+	// Several cores may be busy, so the scale grows past one core.
+	double maxCpu = 100.0;
+	for(const JobTelemetrySample & sample : telemetry)
+		maxCpu = std::max({maxCpu, sample.vsCpu, sample.encoderCpu});
+
+	double step = area.width() /
+		double(std::max(DEFAULT_JOB_TELEMETRY_HISTORY_SIZE - 1, 1));
+	double left = area.right() - step * double(telemetry.size() - 1);
+
+	QPolygonF vsLine;
+	QPolygonF encoderLine;
+	for(size_t i = 0; i < telemetry.size(); ++i)
+	{
+		double x = left + step * double(i);
+		vsLine << QPointF(x,
+			area.bottom() - area.height() * telemetry[i].vsCpu / maxCpu);
+		encoderLine << QPointF(x,
+			area.bottom() - area.height() * telemetry[i].encoderCpu / maxCpu);
+	}
+
+	a_pPainter->setPen(QPen(QColor("#3070c0"), 1.5));
+	a_pPainter->drawPolyline(vsLine);
+	a_pPainter->setPen(QPen(QColor("#e08020"), 1.5));
+	a_pPainter->drawPolyline(encoderLine);
+
+	a_pPainter->restore();
+}
+
+QSize JobTelemetryDelegate::sizeHint(const QStyleOptionViewItem & a_option,
+	const QModelIndex & a_index) const
+{
+	QSize size = QStyledItemDelegate::sizeHint(a_option, a_index);
+	return size.expandedTo(QSize(DEFAULT_JOB_TELEMETRY_HISTORY_SIZE, 24));
+}
@@ -0,0 +1,25 @@
+#ifndef JOB_TELEMETRY_DELEGATE_H_INCLUDED
+#define JOB_TELEMETRY_DELEGATE_H_INCLUDED
+
+#include <QStyledItemDelegate>
+
+/// Draws the CPU usage of the VapourSynth and encoder sides of a job
+/// as sparklines over the fill of the VapourSynth frame cache.
+class JobTelemetryDelegate : public QStyledItemDelegate
+{
+	Q_OBJECT
+
+public:
+
+	JobTelemetryDelegate(QObject * a_pParent = nullptr);
+	virtual ~JobTelemetryDelegate();
+
+	virtual void paint(QPainter * a_pPainter,
+		const QStyleOptionViewItem & a_option,
+		const QModelIndex & a_index) const override;
+
+	virtual QSize sizeHint(const QStyleOptionViewItem & a_option,
+		const QModelIndex & a_index) const override;
+};
+
+#endif // JOB_TELEMETRY_DELEGATE_H_INCLUDED
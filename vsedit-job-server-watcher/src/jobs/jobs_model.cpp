@@ -4,6 +4,7 @@
 #include "../../../common-src/helpers.h"
 
 #include <QGuiApplication>
+#include <QTimer>
 #include <set>
 
 //==============================================================================
@@ -16,17 +17,37 @@ const int JobsModel::DEPENDS_ON_COLUMN = 4;
 const int JobsModel::TIME_START_COLUMN = 5;
 const int JobsModel::TIME_END_COLUMN = 6;
 const int JobsModel::FPS_COLUMN = 7;
-const int JobsModel::COLUMNS_NUMBER = 8;
+const int JobsModel::ENCODER_COLUMN = 8;
+const int JobsModel::TELEMETRY_COLUMN = 9;
+const int JobsModel::COLUMNS_NUMBER = 10;
 
 //==============================================================================
 
+JobsModel::RowCache::RowCache() :
+	  values(COLUMNS_NUMBER)
+	, valid(COLUMNS_NUMBER, false)
+{
+}
+
+// END OF JobsModel::RowCache::RowCache()
+//==============================================================================
+
 JobsModel::JobsModel(SettingsManager * a_pSettingsManager,
 	QObject * a_pParent) :
 	  QAbstractItemModel(a_pParent)
+	, m_pendingUpdates(COLUMNS_NUMBER)
+	, m_pendingProgressJobId()
+	, m_pUpdateTimer(nullptr)
 	, m_pSettingsManager(a_pSettingsManager)
 	, m_fpsDisplayPrecision(DEFAULT_FPS_DISPLAY_PRECISION)
 {
 	Q_ASSERT(m_pSettingsManager);
+
+	m_pUpdateTimer = new QTimer(this);
+	m_pUpdateTimer->setSingleShot(true);
+	m_pUpdateTimer->setInterval(0);
+	connect(m_pUpdateTimer, &QTimer::timeout,
+		this, &JobsModel::slotFlushUpdates);
 }
 
 // END OF JobsModel::JobsModel(SettingsManager * a_pSettingsManager,
@@ -113,6 +134,10 @@ QVariant JobsModel::headerData(int a_section, Qt::Orientation a_orientation,
         return tr("Ended");
 	case FPS_COLUMN:
         return tr("FPS");
+	case ENCODER_COLUMN:
+        return tr("Encoder");
+	case TELEMETRY_COLUMN:
+        return tr("Resources");
 	default:
 		return QVariant();
 	}
@@ -134,61 +159,18 @@ QVariant JobsModel::data(const QModelIndex & a_index, int a_role) const
 		(a_index.column() >= COLUMNS_NUMBER))
 		return QVariant();
 
-	const QString dateTimeFormat = "yyyy-MM-dd\nhh:mm:ss.z";
-
-	if((a_role == Qt::DisplayRole) || (a_role == Qt::ToolTipRole))
+	if(a_role == Qt::DisplayRole)
 	{
-		if(column == NAME_COLUMN)
-            return tr("Job %1").arg(row + 1);
-		else if(column == TYPE_COLUMN)
-			return JobProperties::typeName(m_jobs[row].type);
-		else if(column == SUBJECT_COLUMN)
-			return m_jobs[row].subject();
-		else if(column == STATE_COLUMN)
-			return JobProperties::stateName(m_jobs[row].jobState);
-		else if(column == DEPENDS_ON_COLUMN)
-		{
-			QStringList dependsList;
-			for(const QUuid & id : m_jobs[row].dependsOnJobIds)
-			{
-				ptrdiff_t index = indexOfJob(id);
-				if(index < 0)
-                    dependsList << tr("<invalid job>");
-				else
-                    dependsList << tr("Job %1").arg(index + 1);
-			}
-			return dependsList.join(", ");
-		}
-		else if(column == TIME_START_COLUMN)
-		{
-			QDateTime timeStarted = m_jobs[row].timeStarted;
-			if(timeStarted != QDateTime())
-				return timeStarted.toLocalTime().toString(dateTimeFormat);
-		}
-		else if(column == TIME_END_COLUMN)
-		{
-			QDateTime timeStarted = m_jobs[row].timeEnded;
-			if(timeStarted != QDateTime())
-				return timeStarted.toLocalTime().toString(dateTimeFormat);
-		}
-		else if((column == FPS_COLUMN) &&
-			(m_jobs[row].type == JobType::EncodeScriptCLI) &&
-			(m_jobs[row].framesProcessed > 0))
+		RowCache & cache = m_rowCache[row];
+		if(!cache.valid[column])
 		{
-			QString fps = QString::number(m_jobs[row].fps, 'f',
-				m_fpsDisplayPrecision);
-			int framesTotal = m_jobs[row].framesTotal();
-			if(vsedit::contains(ACTIVE_JOB_STATES, m_jobs[row].jobState) &&
-				(m_jobs[row].framesProcessed < framesTotal))
-			{
-				int framesLeft = framesTotal - m_jobs[row].framesProcessed;
-				double secondsToFinish = (double)framesLeft / m_jobs[row].fps;
-				fps += "\n";
-				fps += vsedit::timeToString(secondsToFinish);
-			}
-			return fps;
+			cache.values[column] = cellText(row, column, a_role);
+			cache.valid[column] = true;
 		}
+		return cache.values[column];
 	}
+	else if(a_role == Qt::ToolTipRole)
+		return cellText(row, column, a_role);
 	else if(a_role == Qt::TextAlignmentRole)
 	{
 		const int centeredColumns[] = {STATE_COLUMN, TIME_START_COLUMN,
@@ -266,8 +248,13 @@ void JobsModel::clear()
 	if(m_jobs.empty())
 		return;
 
+	slotFlushUpdates();
+
 	beginRemoveRows(QModelIndex(), 0, (int)m_jobs.size() - 1);
 	m_jobs.clear();
+	m_rowCache.clear();
+	m_indexById.clear();
+	m_telemetry.clear();
 	endRemoveRows();
 }
 
@@ -285,8 +272,12 @@ std::vector<JobProperties> JobsModel::jobs() const
 
 bool JobsModel::setJobs(const std::vector<JobProperties> & a_jobs)
 {
+	slotFlushUpdates();
+
 	beginResetModel();
 	m_jobs = a_jobs;
+	m_rowCache.assign(m_jobs.size(), RowCache());
+	reindexJobs();
 	endResetModel();
 	return true;
 }
@@ -309,6 +300,8 @@ int JobsModel::createJob(const JobProperties & a_jobProperties)
 	int newRow = (int)m_jobs.size();
 	beginInsertRows(QModelIndex(), newRow, newRow);
 	m_jobs.push_back(a_jobProperties);
+	m_rowCache.push_back(RowCache());
+	reindexJobs(newRow);
 	endInsertRows();
 	return newRow;
 }
@@ -327,9 +320,13 @@ bool JobsModel::swapJobs(const QUuid & a_id1, const QUuid & a_id2)
 		return false;
 
 	std::swap(m_jobs[index1], m_jobs[index2]);
+	m_indexById[a_id1] = index2;
+	m_indexById[a_id2] = index1;
 
 	notifyJobUpdated(index1);
 	notifyJobUpdated(index2);
+	// Other jobs may refer to the swapped ones by number.
+	notifyColumnUpdated(DEPENDS_ON_COLUMN);
 
 	return true;
 }
@@ -339,6 +336,10 @@ bool JobsModel::swapJobs(const QUuid & a_id1, const QUuid & a_id2)
 
 bool JobsModel::deleteJobs(std::vector<QUuid> a_ids)
 {
+	// Pending updates refer to rows by position.
+	slotFlushUpdates();
+
+	bool deleted = false;
 	for(const QUuid & id : a_ids)
 	{
 		int index = indexOfJob(id);
@@ -347,7 +348,19 @@ bool JobsModel::deleteJobs(std::vector<QUuid> a_ids)
 
 		beginRemoveRows(QModelIndex(), index, index);
 		m_jobs.erase(m_jobs.begin() + index);
+		m_rowCache.erase(m_rowCache.begin() + index);
+		m_indexById.remove(id);
+		reindexJobs(index);
+		m_telemetry.erase(id);
 		endRemoveRows();
+		deleted = true;
+	}
+
+	if(deleted)
+	{
+		// Names and references of the following jobs have changed.
+		notifyColumnUpdated(NAME_COLUMN);
+		notifyColumnUpdated(DEPENDS_ON_COLUMN);
 	}
 
 	return true;
@@ -404,7 +417,8 @@ bool JobsModel::setJobProgress(const QUuid & a_id, int a_progress, double a_fps)
 	m_jobs[index].fps = a_fps;
 	notifyJobUpdated(index, STATE_COLUMN);
 	notifyJobUpdated(index, FPS_COLUMN);
-	emit signalProgressChanged(index, a_progress, m_jobs[index].framesTotal());
+	// Only the latest progress matters to listeners.
+	m_pendingProgressJobId = a_id;
 	return true;
 }
 
@@ -412,6 +426,23 @@ bool JobsModel::setJobProgress(const QUuid & a_id, int a_progress, double a_fps)
 //		double a_fps)
 //==============================================================================
 
+bool JobsModel::setJobEncoderStatus(const QUuid & a_id,
+	const QString & a_status, double a_fps, double a_bitrate)
+{
+	int index = indexOfJob(a_id);
+	if(index < 0)
+		return false;
+	m_jobs[index].encoderStatus = a_status;
+	m_jobs[index].encoderFps = a_fps;
+	m_jobs[index].encoderBitrate = a_bitrate;
+	notifyJobUpdated(index, ENCODER_COLUMN);
+	return true;
+}
+
+// END OF bool JobsModel::setJobEncoderStatus(const QUuid & a_id,
+//		const QString & a_status, double a_fps, double a_bitrate)
+//==============================================================================
+
 bool JobsModel::setJobState(const QUuid & a_id, JobState a_state)
 {
 	int index = indexOfJob(a_id);
@@ -419,6 +450,11 @@ bool JobsModel::setJobState(const QUuid & a_id, JobState a_state)
 		return false;
 	m_jobs[index].jobState = a_state;
 	notifyJobUpdated(index, STATE_COLUMN);
+	// Time left is only shown for active jobs.
+	notifyJobUpdated(index, FPS_COLUMN);
+	// A reset job starts a new telemetry series.
+	if((a_state == JobState::Waiting) && (m_telemetry.erase(a_id) > 0))
+		notifyJobUpdated(index, TELEMETRY_COLUMN);
 	emit signalStateChanged(index, a_state);
 	return true;
 }
@@ -454,6 +490,45 @@ bool JobsModel::setJobEndTime(const QUuid & a_id, const QDateTime & a_time)
 //		const QDateTime & a_time)
 //==============================================================================
 
+bool JobsModel::addJobTelemetry(const QUuid & a_id,
+	const std::vector<JobTelemetrySample> & a_samples)
+{
+	int index = indexOfJob(a_id);
+	if(index < 0)
+		return false;
+	std::deque<JobTelemetrySample> & telemetry = m_telemetry[a_id];
+	for(const JobTelemetrySample & sample : a_samples)
+	{
+		// The complete history may overlap with already received samples.
+		if((!telemetry.empty()) && (sample.time <= telemetry.back().time))
+			continue;
+		telemetry.push_back(sample);
+	}
+	while(telemetry.size() > (size_t)DEFAULT_JOB_TELEMETRY_HISTORY_SIZE)
+		telemetry.pop_front();
+	notifyJobUpdated(index, TELEMETRY_COLUMN);
+	return true;
+}
+
+// END OF bool JobsModel::addJobTelemetry(const QUuid & a_id,
+//		const std::vector<JobTelemetrySample> & a_samples)
+//==============================================================================
+
+std::deque<JobTelemetrySample> JobsModel::jobTelemetry(int a_index) const
+{
+	if((a_index < 0) || ((size_t)a_index >= m_jobs.size()))
+		return std::deque<JobTelemetrySample>();
+	std::map<QUuid, std::deque<JobTelemetrySample> >::const_iterator it =
+		m_telemetry.find(m_jobs[a_index].id);
+	if(it == m_telemetry.end())
+		return std::deque<JobTelemetrySample>();
+	return it->second;
+}
+
+// END OF std::deque<JobTelemetrySample> JobsModel::jobTelemetry(int a_index)
+//		const
+//==============================================================================
+
 bool JobsModel::canModifyJob(int a_index) const
 {
 	if((a_index < 0) || ((size_t)a_index >= m_jobs.size()))
@@ -527,40 +602,206 @@ std::vector<QUuid> JobsModel::idsFromSelection(
 //		const QItemSelection & a_selection)
 //==============================================================================
 
-int JobsModel::indexOfJob(const QUuid & a_uuid) const
+QVariant JobsModel::cellText(int a_row, int a_column, int a_role) const
 {
-	std::vector<JobProperties>::const_iterator it =
-		std::find_if(m_jobs.cbegin(), m_jobs.cend(),
-			[&](const JobProperties & a_properties)->bool
-			{
-				return (a_properties.id == a_uuid);
-			});
+	const QString dateTimeFormat = "yyyy-MM-dd\nhh:mm:ss.z";
+
+	if(a_column == NAME_COLUMN)
+		return tr("Job %1").arg(a_row + 1);
+	else if(a_column == TYPE_COLUMN)
+		return JobProperties::typeName(m_jobs[a_row].type);
+	else if(a_column == SUBJECT_COLUMN)
+		return m_jobs[a_row].subject();
+	else if(a_column == STATE_COLUMN)
+		return JobProperties::stateName(m_jobs[a_row].jobState);
+	else if(a_column == DEPENDS_ON_COLUMN)
+	{
+		QStringList dependsList;
+		for(const QUuid & id : m_jobs[a_row].dependsOnJobIds)
+		{
+			ptrdiff_t index = indexOfJob(id);
+			if(index < 0)
+				dependsList << tr("<invalid job>");
+			else
+				dependsList << tr("Job %1").arg(index + 1);
+		}
+		return dependsList.join(", ");
+	}
+	else if(a_column == TIME_START_COLUMN)
+	{
+		QDateTime timeStarted = m_jobs[a_row].timeStarted;
+		if(timeStarted != QDateTime())
+			return timeStarted.toLocalTime().toString(dateTimeFormat);
+	}
+	else if(a_column == TIME_END_COLUMN)
+	{
+		QDateTime timeStarted = m_jobs[a_row].timeEnded;
+		if(timeStarted != QDateTime())
+			return timeStarted.toLocalTime().toString(dateTimeFormat);
+	}
+	else if((a_column == FPS_COLUMN) &&
+		(m_jobs[a_row].type == JobType::EncodeScriptCLI) &&
+		(m_jobs[a_row].framesProcessed > 0))
+	{
+		QString fps = QString::number(m_jobs[a_row].fps, 'f',
+			m_fpsDisplayPrecision);
+		int framesTotal = m_jobs[a_row].framesTotal();
+		if(vsedit::contains(ACTIVE_JOB_STATES, m_jobs[a_row].jobState) &&
+			(m_jobs[a_row].framesProcessed < framesTotal))
+		{
+			int framesLeft = framesTotal - m_jobs[a_row].framesProcessed;
+			double secondsToFinish = (double)framesLeft / m_jobs[a_row].fps;
+			fps += "\n";
+			fps += vsedit::timeToString(secondsToFinish);
+		}
+		return fps;
+	}
+	else if((a_column == ENCODER_COLUMN) &&
+		(!m_jobs[a_row].encoderStatus.isEmpty()))
+	{
+		if(a_role == Qt::ToolTipRole)
+			return m_jobs[a_row].encoderStatus;
+
+		QStringList encoderInfo;
+		if(m_jobs[a_row].encoderFps > 0.0)
+		{
+			encoderInfo << tr("%1 fps").arg(QString::number(
+				m_jobs[a_row].encoderFps, 'f', m_fpsDisplayPrecision));
+		}
+		if(m_jobs[a_row].encoderBitrate > 0.0)
+		{
+			encoderInfo << tr("%1 kb/s").arg(QString::number(
+				m_jobs[a_row].encoderBitrate, 'f', 2));
+		}
+		if(encoderInfo.isEmpty())
+			return m_jobs[a_row].encoderStatus;
+		return encoderInfo.join("\n");
+	}
+	else if((a_column == TELEMETRY_COLUMN) && (a_role == Qt::ToolTipRole))
+	{
+		std::map<QUuid, std::deque<JobTelemetrySample> >::const_iterator
+			it = m_telemetry.find(m_jobs[a_row].id);
+		if((it != m_telemetry.end()) && (!it->second.empty()))
+			return telemetryString(it->second.back());
+	}
+
+	return QVariant();
+}
+
+// END OF QVariant JobsModel::cellText(int a_row, int a_column, int a_role)
+//		const
+//==============================================================================
 
-	return (it == m_jobs.cend()) ?
-		-1 : std::distance(m_jobs.cbegin(), it);
+int JobsModel::indexOfJob(const QUuid & a_uuid) const
+{
+	return m_indexById.value(a_uuid, -1);
 }
 
 // END OF int JobsModel::indexOfJob(const QUuid & a_uuid) const
 //==============================================================================
 
+void JobsModel::reindexJobs(size_t a_fromIndex)
+{
+	if(a_fromIndex == 0)
+		m_indexById.clear();
+	for(size_t i = a_fromIndex; i < m_jobs.size(); ++i)
+		m_indexById[m_jobs[i].id] = (int)i;
+}
+
+// END OF void JobsModel::reindexJobs(size_t a_fromIndex)
+//==============================================================================
+
+QString JobsModel::telemetryString(const JobTelemetrySample & a_sample) const
+{
+	auto mebibytes = [](double a_bytes)->QString
+	{
+		return QString::number(a_bytes / 1048576.0, 'f', 1);
+	};
+
+	QStringList lines;
+	lines << tr("VapourSynth: CPU %1%, RSS %2 MiB, read %3 MiB/s, "
+		"write %4 MiB/s").arg(QString::number(a_sample.vsCpu, 'f', 0))
+		.arg(mebibytes(a_sample.vsRss))
+		.arg(mebibytes(a_sample.vsReadRate))
+		.arg(mebibytes(a_sample.vsWriteRate));
+	lines << tr("Encoder: CPU %1%, RSS %2 MiB, read %3 MiB/s, "
+		"write %4 MiB/s").arg(QString::number(a_sample.encoderCpu, 'f', 0))
+		.arg(mebibytes(a_sample.encoderRss))
+		.arg(mebibytes(a_sample.encoderReadRate))
+		.arg(mebibytes(a_sample.encoderWriteRate));
+	lines << tr("Frame cache: %1 / %2 MiB").arg(
+		mebibytes(a_sample.framebufferUsed))
+		.arg(mebibytes(a_sample.framebufferMax));
+	lines << tr("Frames: %1 queued, %2 in process")
+		.arg(a_sample.framesInQueue).arg(a_sample.framesInProcess);
+	return lines.join("\n");
+}
+
+// END OF QString JobsModel::telemetryString(
+//		const JobTelemetrySample & a_sample) const
+//==============================================================================
+
 void JobsModel::notifyJobUpdated(int a_index, int a_column)
 {
-	QModelIndex first;
-	QModelIndex last;
+	if((a_index < 0) || ((size_t)a_index >= m_jobs.size()))
+		return;
 
-	if(a_column < 0)
+	int firstColumn = (a_column < 0) ? 0 : a_column;
+	int lastColumn = (a_column < 0) ? COLUMNS_NUMBER - 1 : a_column;
+	for(int column = firstColumn; column <= lastColumn; ++column)
 	{
-		first = createIndex(a_index, 0);
-		last = createIndex(a_index, COLUMNS_NUMBER - 1);
+		m_rowCache[a_index].valid[column] = false;
+		m_pendingUpdates[column].insert(a_index);
 	}
-	else
+
+	if(!m_pUpdateTimer->isActive())
+		m_pUpdateTimer->start();
+}
+
+// END OF void JobsModel::notifyJobUpdated(int a_index, int a_column)
+//==============================================================================
+
+void JobsModel::notifyColumnUpdated(int a_column)
+{
+	for(size_t i = 0; i < m_jobs.size(); ++i)
+		notifyJobUpdated((int)i, a_column);
+}
+
+// END OF void JobsModel::notifyColumnUpdated(int a_column)
+//==============================================================================
+
+void JobsModel::slotFlushUpdates()
+{
+	m_pUpdateTimer->stop();
+
+	// One signal for each run of adjacent rows in a column.
+	for(int column = 0; column < COLUMNS_NUMBER; ++column)
 	{
-		first = createIndex(a_index, a_column);
-		last = createIndex(a_index, a_column);
+		std::set<int> & rows = m_pendingUpdates[column];
+		std::set<int>::const_iterator it = rows.cbegin();
+		while(it != rows.cend())
+		{
+			int first = *it;
+			int last = first;
+			for(++it; (it != rows.cend()) && (*it == last + 1); ++it)
+				last = *it;
+			emit dataChanged(createIndex(first, column),
+				createIndex(last, column));
+		}
+		rows.clear();
 	}
 
-	emit dataChanged(first, last);
+	if(!m_pendingProgressJobId.isNull())
+	{
+		int index = indexOfJob(m_pendingProgressJobId);
+		m_pendingProgressJobId = QUuid();
+		if(index >= 0)
+		{
+			emit signalProgressChanged(index, m_jobs[index].framesProcessed,
+				m_jobs[index].framesTotal());
+		}
+	}
 }
 
-// END OF void JobsModel::noifyJobUpdated(int a_index)
+// END OF void JobsModel::slotFlushUpdates()
 //==============================================================================
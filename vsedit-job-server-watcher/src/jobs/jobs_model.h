@@ -3,12 +3,18 @@
 
 #include "../../../common-src/settings/settings_definitions_core.h"
 #include "../../../common-src/log/styled_log_view_core.h"
+#include "../../../common-src/jobs/job_telemetry.h"
 
 #include <QAbstractItemModel>
 #include <QItemSelection>
+#include <QHash>
 #include <vector>
+#include <deque>
+#include <map>
+#include <set>
 
 class SettingsManager;
+class QTimer;
 
 class JobsModel : public QAbstractItemModel
 {
@@ -24,6 +30,8 @@ public:
 	static const int TIME_START_COLUMN;
 	static const int TIME_END_COLUMN;
 	static const int FPS_COLUMN;
+	static const int ENCODER_COLUMN;
+	static const int TELEMETRY_COLUMN;
 	static const int COLUMNS_NUMBER;
 
 	JobsModel(SettingsManager * a_pSettingsManager,
@@ -71,9 +79,15 @@ public:
 	void requestJobDependsOnIds(const QUuid & a_id,
 		const std::vector<QUuid> & a_dependencies);
 	bool setJobProgress(const QUuid & a_id, int a_progress, double a_fps);
+	bool setJobEncoderStatus(const QUuid & a_id, const QString & a_status,
+		double a_fps, double a_bitrate);
 	bool setJobState(const QUuid & a_id, JobState a_state);
 	bool setJobStartTime(const QUuid & a_id, const QDateTime & a_time);
 	bool setJobEndTime(const QUuid & a_id, const QDateTime & a_time);
+	bool addJobTelemetry(const QUuid & a_id,
+		const std::vector<JobTelemetrySample> & a_samples);
+
+	std::deque<JobTelemetrySample> jobTelemetry(int a_index) const;
 
 	bool canModifyJob(int a_index) const;
 
@@ -95,14 +109,50 @@ signals:
 	void signalSetDependencies(const QUuid & a_id,
 		std::vector<QUuid> a_dependencies);
 
+private slots:
+
+	void slotFlushUpdates();
+
 private:
 
+	// Formatted display values of a row, computed on demand.
+	struct RowCache
+	{
+		std::vector<QVariant> values;
+		std::vector<bool> valid;
+
+		RowCache();
+	};
+
+	QVariant cellText(int a_row, int a_column, int a_role) const;
+
 	int indexOfJob(const QUuid & a_id) const;
 
+	void reindexJobs(size_t a_fromIndex = 0);
+
 	void notifyJobUpdated(int a_index, int a_column = -1);
 
+	void notifyColumnUpdated(int a_column);
+
+	QString telemetryString(const JobTelemetrySample & a_sample) const;
+
 	std::vector<JobProperties> m_jobs;
 
+	mutable std::vector<RowCache> m_rowCache;
+
+	// Position of each job in m_jobs.
+	QHash<QUuid, int> m_indexById;
+
+	// Rows to repaint for each column. Updates received in one
+	// event loop pass are delivered to views together.
+	std::vector<std::set<int> > m_pendingUpdates;
+	// By id, the row may move before the flush.
+	QUuid m_pendingProgressJobId;
+	QTimer * m_pUpdateTimer;
+
+	// Kept apart from the properties to survive job updates.
+	std::map<QUuid, std::deque<JobTelemetrySample> > m_telemetry;
+
 	SettingsManager * m_pSettingsManager;
 
 	int m_fpsDisplayPrecision;
@@ -3,6 +3,7 @@
 #include "jobs/jobs_model.h"
 #include "jobs/job_state_delegate.h"
 #include "jobs/job_dependencies_delegate.h"
+#include "jobs/job_telemetry_delegate.h"
 #include "jobs/job_edit_dialog.h"
 #include "connect_to_server_dialog.h"
 #include "trusted_clients_addresses_dialog.h"
@@ -57,6 +58,7 @@ MainWindow::MainWindow() : QMainWindow()
 	, m_pJobsModel(nullptr)
 	, m_pJobStateDelegate(nullptr)
 	, m_pJobDependenciesDelegate(nullptr)
+	, m_pJobTelemetryDelegate(nullptr)
 	, m_pVSScriptLibrary(nullptr)
 	, m_pJobEditDialog(nullptr)
 	, m_pServerSocket(nullptr)
@@ -71,7 +73,6 @@ MainWindow::MainWindow() : QMainWindow()
 	, m_pConnectToServerDialog(nullptr)
 	, m_nextServerAddress(QHostAddress::LocalHost)
 	, m_pTaskServer(nullptr)
-	, m_pGeometrySaveTimer(nullptr)
 #ifdef Q_OS_WIN
 	, m_pWinTaskbarButton(nullptr)
 	, m_pWinTaskbarProgress(nullptr)
@@ -93,6 +94,9 @@ MainWindow::MainWindow() : QMainWindow()
 	m_pJobDependenciesDelegate = new JobDependenciesDelegate(this);
 	m_ui.jobsTableView->setItemDelegateForColumn(
 		JobsModel::DEPENDS_ON_COLUMN, m_pJobDependenciesDelegate);
+	m_pJobTelemetryDelegate = new JobTelemetryDelegate(this);
+	m_ui.jobsTableView->setItemDelegateForColumn(
+		JobsModel::TELEMETRY_COLUMN, m_pJobTelemetryDelegate);
 
 	QHeaderView * pHorizontalHeader = m_ui.jobsTableView->horizontalHeader();
 	pHorizontalHeader->setSectionsMovable(true);
@@ -110,11 +114,6 @@ MainWindow::MainWindow() : QMainWindow()
 	m_pServerSocket = new QWebSocket(QString(),
 		QWebSocketProtocol::VersionLatest, this);
 
-	m_pGeometrySaveTimer = new QTimer(this);
-	m_pGeometrySaveTimer->setInterval(DEFAULT_WINDOW_GEOMETRY_SAVE_DELAY);
-	connect(m_pGeometrySaveTimer, &QTimer::timeout,
-		this, &MainWindow::slotSaveGeometry);
-
 	m_windowGeometry = m_pSettingsManager->getJobServerWatcherGeometry();
 	if(!m_windowGeometry.isEmpty())
 		restoreGeometry(m_windowGeometry);
@@ -236,12 +235,6 @@ MainWindow::MainWindow() : QMainWindow()
 
 MainWindow::~MainWindow()
 {
-	if(m_pGeometrySaveTimer->isActive())
-	{
-		m_pGeometrySaveTimer->stop();
-		slotSaveGeometry();
-	}
-
 	m_pServerSocket->close(QWebSocketProtocol::CloseCodeNormal,
         tr("Closing watcher."));
 	for(QLocalSocket * pClient : m_taskClients)
@@ -480,7 +473,7 @@ void MainWindow::slotJobMoveDownButtonClicked()
 	std::vector<int> selection = selectedIndexes();
 	if(selection.size() != 1)
 		return;
-	if(selection[0] >= (int)m_pJobsModel->jobs().size())
+	if(selection[0] >= m_pJobsModel->rowCount())
 		return;
 	QJsonArray jsSwap;
 	jsSwap << m_pJobsModel->jobProperties(selection[0]).id.toString();
@@ -723,6 +716,7 @@ void MainWindow::slotServerConnected()
 	changeState(WatcherState::Connected);
 	m_connectionAttempts = 0;
 	m_pServerSocket->sendBinaryMessage(MSG_GET_JOBS_INFO);
+	m_pServerSocket->sendBinaryMessage(MSG_GET_JOBS_TELEMETRY);
 	m_pServerSocket->sendBinaryMessage(MSG_GET_LOG);
 	m_pServerSocket->sendBinaryMessage(MSG_SUBSCRIBE);
 	processTaskList();
@@ -885,6 +879,53 @@ void MainWindow::slotTextMessageReceived(const QString & a_message)
 		return;
 	}
 
+	if(command == QString(SMSG_JOBS_PROGRESS_UPDATE))
+	{
+		QJsonArray jsJobs = jsArguments.array();
+		for(int i = 0; i < jsJobs.count(); ++i)
+		{
+			QJsonObject jsJob = jsJobs[i].toObject();
+			if(!jsJob.contains(JP_ID))
+				continue;
+			QUuid id(jsJob[JP_ID].toString());
+			if(jsJob.contains(JP_FRAMES_PROCESSED) && jsJob.contains(JP_FPS))
+			{
+				int progress = jsJob[JP_FRAMES_PROCESSED].toInt();
+				double fps = jsJob[JP_FPS].toDouble();
+				m_pJobsModel->setJobProgress(id, progress, fps);
+			}
+			if(jsJob.contains(JP_ENCODER_STATUS))
+			{
+				m_pJobsModel->setJobEncoderStatus(id,
+					jsJob[JP_ENCODER_STATUS].toString(),
+					jsJob[JP_ENCODER_FPS].toDouble(),
+					jsJob[JP_ENCODER_BITRATE].toDouble());
+			}
+		}
+		return;
+	}
+
+	if(command == QString(SMSG_JOBS_TELEMETRY))
+	{
+		QJsonArray jsJobs = jsArguments.array();
+		for(int i = 0; i < jsJobs.count(); ++i)
+		{
+			QJsonObject jsJob = jsJobs[i].toObject();
+			if(!jsJob.contains(JP_ID))
+				continue;
+			QJsonArray jsSamples = jsJob[TELEMETRY_SAMPLES].toArray();
+			std::vector<JobTelemetrySample> samples;
+			for(int j = 0; j < jsSamples.count(); ++j)
+			{
+				samples.push_back(JobTelemetrySample::fromJson(
+					jsSamples[j].toObject()));
+			}
+			m_pJobsModel->addJobTelemetry(QUuid(jsJob[JP_ID].toString()),
+				samples);
+		}
+		return;
+	}
+
 	if(command == QString(SMSG_JOB_START_TIME_UPDATE))
 	{
 		QJsonObject jsJob = jsArguments.object();
@@ -1181,15 +1222,6 @@ void MainWindow::slotSetTrustedClientsAddresses()
 // END OF void MainWindow::slotSetTrustedClientsAddresses()
 //==============================================================================
 
-void MainWindow::slotSaveGeometry()
-{
-	m_pGeometrySaveTimer->stop();
-	m_pSettingsManager->setJobServerWatcherGeometry(m_windowGeometry);
-}
-
-// END OF void MainWindow::slotSaveGeometry()
-//==============================================================================
-
 void MainWindow::createActionsAndMenus()
 {
 	struct ActionToCreate
@@ -1401,7 +1433,7 @@ void MainWindow::resetWindowTitle(int a_jobIndex)
 		}
 
 		title = QString("%1%2/%3 %4").arg(progress).arg(a_jobIndex + 1)
-			.arg(m_pJobsModel->jobs().size()).arg(WINDOW_TITLE);
+			.arg(m_pJobsModel->rowCount()).arg(WINDOW_TITLE);
 	}
 	setWindowTitle(title);
 
@@ -1450,8 +1482,9 @@ void MainWindow::saveGeometryDelayed()
 	QApplication::processEvents();
 	if(!isMaximized())
 	{
+		// the settings manager coalesces the writes of a drag
 		m_windowGeometry = saveGeometry();
-		m_pGeometrySaveTimer->start();
+		m_pSettingsManager->setJobServerWatcherGeometry(m_windowGeometry);
 	}
 }
 
@@ -17,13 +17,13 @@ class JobsModel;
 class JobEditDialog;
 class JobStateDelegate;
 class JobDependenciesDelegate;
+class JobTelemetryDelegate;
 class VSScriptLibrary;
 class QMenu;
 class ConnectToServerDialog;
 class QLocalServer;
 class QLocalSocket;
 class TrustedClientsAddressesDialog;
-class QTimer;
 
 #ifdef Q_OS_WIN
 	class QWinTaskbarButton;
@@ -110,8 +110,6 @@ private slots:
 
 	void slotSetTrustedClientsAddresses();
 
-	void slotSaveGeometry();
-
 private:
 
 	enum class WatcherState
@@ -154,6 +152,7 @@ private:
 	JobsModel * m_pJobsModel;
 	JobStateDelegate * m_pJobStateDelegate;
 	JobDependenciesDelegate * m_pJobDependenciesDelegate;
+	JobTelemetryDelegate * m_pJobTelemetryDelegate;
 
 	VSScriptLibrary * m_pVSScriptLibrary;
 	JobEditDialog * m_pJobEditDialog;
@@ -186,7 +185,6 @@ private:
 
 	QStringList m_trustedClientsAddresses;
 
-	QTimer * m_pGeometrySaveTimer;
 	QByteArray m_windowGeometry;
 
 #ifdef Q_OS_WIN
@@ -0,0 +1,127 @@
+#include "remote_job.h"
+
+#include "worker_pool.h"
+
+//==============================================================================
+
+RemoteJob::RemoteJob(const JobProperties & a_properties,
+	WorkerPool * a_pWorkerPool, SettingsManagerCore * a_pSettingsManager,
+	VSScriptLibrary * a_pVSScriptLibrary, QObject * a_pParent) :
+	  vsedit::Job(a_properties, a_pSettingsManager, a_pVSScriptLibrary,
+		a_pParent)
+	, m_pWorkerPool(a_pWorkerPool)
+{
+	Q_ASSERT(m_pWorkerPool);
+}
+
+// END OF RemoteJob::RemoteJob(const JobProperties & a_properties,
+//		WorkerPool * a_pWorkerPool, SettingsManagerCore * a_pSettingsManager,
+//		VSScriptLibrary * a_pVSScriptLibrary, QObject * a_pParent)
+//==============================================================================
+
+RemoteJob::~RemoteJob()
+{
+}
+
+// END OF RemoteJob::~RemoteJob()
+//==============================================================================
+
+void RemoteJob::applyWorkerUpdate(const QJsonObject & a_update)
+{
+	// Late reports for an aborted or requeued dispatch.
+	if(!isActive())
+		return;
+
+	bool propertiesChanged = false;
+	if(a_update.contains(JP_FIRST_FRAME_REAL))
+	{
+		int frame = a_update[JP_FIRST_FRAME_REAL].toInt();
+		propertiesChanged |= (frame != m_properties.firstFrameReal);
+		m_properties.firstFrameReal = frame;
+	}
+	if(a_update.contains(JP_LAST_FRAME_REAL))
+	{
+		int frame = a_update[JP_LAST_FRAME_REAL].toInt();
+		propertiesChanged |= (frame != m_properties.lastFrameReal);
+		m_properties.lastFrameReal = frame;
+	}
+	if(propertiesChanged)
+		emit signalPropertiesChanged();
+
+	if(a_update.contains(JP_FRAMES_PROCESSED))
+	{
+		m_properties.framesProcessed = a_update[JP_FRAMES_PROCESSED].toInt();
+		m_properties.fps = a_update[JP_FPS].toDouble();
+		emit signalProgressChanged();
+	}
+
+	if(a_update.contains(JP_ENCODER_STATUS))
+	{
+		m_properties.encoderStatus = a_update[JP_ENCODER_STATUS].toString();
+		m_properties.encoderFps = a_update[JP_ENCODER_FPS].toDouble();
+		m_properties.encoderBitrate = a_update[JP_ENCODER_BITRATE].toDouble();
+		emit signalEncoderStatusChanged();
+	}
+
+	if(a_update.contains(JP_JOB_STATE))
+	{
+		// The worker queues a dispatched job before starting it.
+		JobState state = JobState(a_update[JP_JOB_STATE].toInt());
+		if(state != JobState::Waiting)
+			changeStateAndNotify(state);
+	}
+}
+
+// END OF void RemoteJob::applyWorkerUpdate(const QJsonObject & a_update)
+//==============================================================================
+
+void RemoteJob::requeue()
+{
+	if(!isActive())
+		return;
+	changeStateAndNotify(JobState::Waiting);
+}
+
+// END OF void RemoteJob::requeue()
+//==============================================================================
+
+void RemoteJob::start()
+{
+	if(m_properties.jobState != JobState::Waiting)
+		return;
+
+	if(!m_pWorkerPool->dispatchJob(m_properties))
+		return;
+
+	m_properties.encoderStatus.clear();
+	m_properties.encoderFps = 0.0;
+	m_properties.encoderBitrate = 0.0;
+	m_encodeRangeStartTime = hr_clock::now();
+	changeStateAndNotify(JobState::Running);
+	emit signalStartTimeChanged();
+}
+
+// END OF void RemoteJob::start()
+//==============================================================================
+
+void RemoteJob::pause()
+{
+	if(m_properties.jobState != JobState::Running)
+		return;
+	emit signalLogMessage(tr("Jobs running on a worker server "
+		"can not be paused."), LOG_STYLE_WARNING);
+}
+
+// END OF void RemoteJob::pause()
+//==============================================================================
+
+void RemoteJob::abort()
+{
+	if(!isActive())
+		return;
+	m_pWorkerPool->abortJob(id());
+	changeStateAndNotify(JobState::Aborted);
+}
+
+// END OF void RemoteJob::abort()
+//==============================================================================
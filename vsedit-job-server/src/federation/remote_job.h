@@ -0,0 +1,40 @@
+#ifndef REMOTE_JOB_H_INCLUDED
+#define REMOTE_JOB_H_INCLUDED
+
+#include "../../../common-src/jobs/job.h"
+
+#include <QJsonObject>
+
+class WorkerPool;
+
+/// Job of a coordinator server. It is not run locally but dispatched
+/// to a worker server, and mirrors the progress the worker reports.
+class RemoteJob : public vsedit::Job
+{
+	Q_OBJECT
+
+public:
+
+	RemoteJob(const JobProperties & a_properties,
+		WorkerPool * a_pWorkerPool,
+		SettingsManagerCore * a_pSettingsManager = nullptr,
+		VSScriptLibrary * a_pVSScriptLibrary = nullptr,
+		QObject * a_pParent = nullptr);
+	virtual ~RemoteJob() override;
+
+	virtual void applyWorkerUpdate(const QJsonObject & a_update);
+
+	virtual void requeue();
+
+public slots:
+
+	virtual void start() override;
+	virtual void pause() override;
+	virtual void abort() override;
+
+protected:
+
+	WorkerPool * m_pWorkerPool;
+};
+
+#endif // REMOTE_JOB_H_INCLUDED
@@ -0,0 +1,380 @@
+#include "worker_link.h"
+
+#include "../../../common-src/ipc_defines.h"
+#include "../../../common-src/helpers.h"
+#include "../../../common-src/settings/settings_manager_core.h"
+#include "../jobs/jobs_manager.h"
+
+#include <QWebSocket>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QTimer>
+#include <QThread>
+#include <QFile>
+#include <algorithm>
+
+#ifdef Q_OS_WIN
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#endif
+
+//==============================================================================
+
+namespace
+{
+
+qint64 freePhysicalMemory()
+{
+#if defined(Q_OS_WIN)
+	MEMORYSTATUSEX status;
+	status.dwLength = sizeof(status);
+	if(GlobalMemoryStatusEx(&status))
+		return (qint64)status.ullAvailPhys;
+#elif defined(Q_OS_LINUX)
+	QFile memoryInfo("/proc/meminfo");
+	if(memoryInfo.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		while(!memoryInfo.atEnd())
+		{
+			QByteArray line = memoryInfo.readLine();
+			if(!line.startsWith("MemAvailable:"))
+				continue;
+			QList<QByteArray> fields = line.simplified().split(' ');
+			if(fields.size() >= 2)
+				return fields[1].toLongLong() * 1024;
+		}
+	}
+#endif
+	return 0;
+}
+
+}
+
+//==============================================================================
+
+WorkerLink::WorkerLink(const QUrl & a_coordinatorUrl, const QString & a_name,
+	JobsManager * a_pJobsManager, SettingsManagerCore * a_pSettingsManager,
+	QObject * a_pParent) :
+	  QObject(a_pParent)
+	, m_coordinatorUrl(a_coordinatorUrl)
+	, m_name(a_name)
+	, m_pJobsManager(a_pJobsManager)
+	, m_pSocket(nullptr)
+	, m_pHeartbeatTimer(nullptr)
+	, m_pReconnectTimer(nullptr)
+	, m_heartbeatTimeout(DEFAULT_JOB_SERVER_HEARTBEAT_TIMEOUT)
+{
+	Q_ASSERT(m_pJobsManager);
+	Q_ASSERT(a_pSettingsManager);
+
+	int heartbeatInterval = std::max(
+		a_pSettingsManager->getJobServerHeartbeatInterval(), 1);
+
+	m_pSocket = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest,
+		this);
+	connect(m_pSocket, &QWebSocket::connected,
+		this, &WorkerLink::slotConnected);
+	connect(m_pSocket, &QWebSocket::disconnected,
+		this, &WorkerLink::slotDisconnected);
+	connect(m_pSocket, &QWebSocket::binaryMessageReceived,
+		this, &WorkerLink::slotBinaryMessageReceived);
+	connect(m_pSocket, &QWebSocket::textMessageReceived,
+		this, &WorkerLink::slotTextMessageReceived);
+
+	m_pHeartbeatTimer = new QTimer(this);
+	m_pHeartbeatTimer->setInterval(heartbeatInterval);
+	connect(m_pHeartbeatTimer, &QTimer::timeout,
+		this, &WorkerLink::slotSendHeartbeat);
+
+	m_heartbeatTimeout = std::max(
+		a_pSettingsManager->getJobServerHeartbeatTimeout(), heartbeatInterval);
+
+	m_pReconnectTimer = new QTimer(this);
+	m_pReconnectTimer->setInterval(m_heartbeatTimeout);
+	connect(m_pReconnectTimer, &QTimer::timeout,
+		this, &WorkerLink::slotReconnect);
+
+	connect(m_pJobsManager, &JobsManager::signalJobChanged,
+		this, &WorkerLink::slotJobChanged);
+	connect(m_pJobsManager, &JobsManager::signalJobStateChanged,
+		this, &WorkerLink::slotJobStateChanged);
+	connect(m_pJobsManager, &JobsManager::signalJobProgressChanged,
+		this, &WorkerLink::slotJobProgressChanged);
+	connect(m_pJobsManager, &JobsManager::signalJobEncoderStatusChanged,
+		this, &WorkerLink::slotJobEncoderStatusChanged);
+}
+
+// END OF WorkerLink::WorkerLink(const QUrl & a_coordinatorUrl,
+//		const QString & a_name, JobsManager * a_pJobsManager,
+//		SettingsManagerCore * a_pSettingsManager, QObject * a_pParent)
+//==============================================================================
+
+WorkerLink::~WorkerLink()
+{
+	m_pReconnectTimer->stop();
+	m_pHeartbeatTimer->stop();
+	disconnect(m_pSocket, nullptr, this, nullptr);
+	m_pSocket->close();
+}
+
+// END OF WorkerLink::~WorkerLink()
+//==============================================================================
+
+void WorkerLink::start()
+{
+	m_pReconnectTimer->start();
+	slotReconnect();
+}
+
+// END OF void WorkerLink::start()
+//==============================================================================
+
+void WorkerLink::slotReconnect()
+{
+	if(m_pSocket->state() != QAbstractSocket::UnconnectedState)
+		return;
+	m_pSocket->open(m_coordinatorUrl);
+}
+
+// END OF void WorkerLink::slotReconnect()
+//==============================================================================
+
+void WorkerLink::slotConnected()
+{
+	emit signalLogMessage(tr("Connected to coordinator %1.")
+		.arg(m_coordinatorUrl.toString()));
+	m_pSocket->sendBinaryMessage(vsedit::jsonMessage(MSG_REGISTER_WORKER,
+		workerInfo()));
+	m_lastCoordinatorMessage.restart();
+	m_pHeartbeatTimer->start();
+}
+
+// END OF void WorkerLink::slotConnected()
+//==============================================================================
+
+void WorkerLink::slotDisconnected()
+{
+	m_pHeartbeatTimer->stop();
+	emit signalLogMessage(tr("Lost connection to coordinator %1.")
+		.arg(m_coordinatorUrl.toString()), LOG_STYLE_WARNING);
+	abandonDispatchedJobs();
+}
+
+// END OF void WorkerLink::slotDisconnected()
+//==============================================================================
+
+void WorkerLink::slotBinaryMessageReceived(const QByteArray & a_message)
+{
+	processMessage(QString::fromUtf8(a_message));
+}
+
+// END OF void WorkerLink::slotBinaryMessageReceived(
+//		const QByteArray & a_message)
+//==============================================================================
+
+void WorkerLink::slotTextMessageReceived(const QString & a_message)
+{
+	processMessage(a_message);
+}
+
+// END OF void WorkerLink::slotTextMessageReceived(const QString & a_message)
+//==============================================================================
+
+void WorkerLink::slotSendHeartbeat()
+{
+	if(m_pSocket->state() != QAbstractSocket::ConnectedState)
+		return;
+
+	// A half-open connection never reports the disconnect.
+	if(m_lastCoordinatorMessage.elapsed() > m_heartbeatTimeout)
+	{
+		emit signalLogMessage(tr("Coordinator %1 stopped responding.")
+			.arg(m_coordinatorUrl.toString()), LOG_STYLE_WARNING);
+		m_pHeartbeatTimer->stop();
+		abandonDispatchedJobs();
+		m_pSocket->abort();
+		return;
+	}
+
+	m_pSocket->sendBinaryMessage(vsedit::jsonMessage(MSG_WORKER_HEARTBEAT,
+		workerInfo()));
+}
+
+// END OF void WorkerLink::slotSendHeartbeat()
+//==============================================================================
+
+void WorkerLink::slotJobChanged(const JobProperties & a_properties)
+{
+	std::map<QUuid, QJsonObject>::iterator it =
+		m_dispatchedJobs.find(a_properties.id);
+	if(it == m_dispatchedJobs.end())
+		return;
+	it->second[JP_FIRST_FRAME_REAL] = a_properties.firstFrameReal;
+	it->second[JP_LAST_FRAME_REAL] = a_properties.lastFrameReal;
+}
+
+// END OF void WorkerLink::slotJobChanged(const JobProperties & a_properties)
+//==============================================================================
+
+void WorkerLink::slotJobStateChanged(const QUuid & a_jobID, JobState a_state)
+{
+	std::map<QUuid, QJsonObject>::iterator it = m_dispatchedJobs.find(a_jobID);
+	if(it == m_dispatchedJobs.end())
+		return;
+
+	JobProperties properties = m_pJobsManager->jobProperties(a_jobID);
+	QJsonObject jsJob = it->second;
+	jsJob[JP_ID] = a_jobID.toString();
+	jsJob[JP_JOB_STATE] = (int)a_state;
+	jsJob[JP_FIRST_FRAME_REAL] = properties.firstFrameReal;
+	jsJob[JP_LAST_FRAME_REAL] = properties.lastFrameReal;
+	jsJob[JP_FRAMES_PROCESSED] = properties.framesProcessed;
+	jsJob[JP_FPS] = properties.fps;
+
+	if((a_state != JobState::Waiting) &&
+		(!vsedit::contains(ACTIVE_JOB_STATES, a_state)))
+		m_dispatchedJobs.erase(it);
+
+	if(m_pSocket->state() == QAbstractSocket::ConnectedState)
+	{
+		m_pSocket->sendBinaryMessage(vsedit::jsonMessage(
+			MSG_WORKER_JOB_UPDATE, jsJob));
+	}
+}
+
+// END OF void WorkerLink::slotJobStateChanged(const QUuid & a_jobID,
+//		JobState a_state)
+//==============================================================================
+
+void WorkerLink::slotJobProgressChanged(const QUuid & a_jobID, int a_progress,
+	double a_fps)
+{
+	std::map<QUuid, QJsonObject>::iterator it = m_dispatchedJobs.find(a_jobID);
+	if(it == m_dispatchedJobs.end())
+		return;
+	it->second[JP_FRAMES_PROCESSED] = a_progress;
+	it->second[JP_FPS] = a_fps;
+}
+
+// END OF void WorkerLink::slotJobProgressChanged(const QUuid & a_jobID,
+//		int a_progress, double a_fps)
+//==============================================================================
+
+void WorkerLink::slotJobEncoderStatusChanged(const QUuid & a_jobID,
+	const QString & a_status, double a_fps, double a_bitrate)
+{
+	std::map<QUuid, QJsonObject>::iterator it = m_dispatchedJobs.find(a_jobID);
+	if(it == m_dispatchedJobs.end())
+		return;
+	it->second[JP_ENCODER_STATUS] = a_status;
+	it->second[JP_ENCODER_FPS] = a_fps;
+	it->second[JP_ENCODER_BITRATE] = a_bitrate;
+}
+
+// END OF void WorkerLink::slotJobEncoderStatusChanged(const QUuid & a_jobID,
+//		const QString & a_status, double a_fps, double a_bitrate)
+//==============================================================================
+
+void WorkerLink::processMessage(const QString & a_message)
+{
+	// Any message proves the coordinator alive, its heartbeat carries
+	// nothing else.
+	m_lastCoordinatorMessage.restart();
+
+	QString command = a_message;
+	QString arguments;
+	int spaceIndex = a_message.indexOf(' ');
+	if(spaceIndex >= 0)
+	{
+		command = a_message.left(spaceIndex);
+		arguments = a_message.mid(spaceIndex + 1);
+	}
+
+	QJsonObject jsArguments =
+		QJsonDocument::fromJson(arguments.toUtf8()).object();
+
+	if(command == QString(CMSG_DISPATCH_JOB))
+	{
+		JobProperties properties = JobProperties::fromJson(jsArguments);
+		if(properties.id.isNull())
+			return;
+
+		// A job dispatched again replaces the copy left from an earlier try.
+		if(m_pJobsManager->hasJob(properties.id))
+		{
+			if(vsedit::contains(ACTIVE_JOB_STATES,
+				m_pJobsManager->jobProperties(properties.id).jobState))
+			{
+				emit signalLogMessage(tr("Dispatched job %1 is already "
+					"running.").arg(properties.id.toString()),
+					LOG_STYLE_WARNING);
+				return;
+			}
+			m_pJobsManager->deleteJobs({properties.id});
+		}
+
+		QJsonObject jsJob;
+		jsJob[JP_ID] = properties.id.toString();
+		m_dispatchedJobs[properties.id] = jsJob;
+		m_pJobsManager->createJob(properties);
+		slotSendHeartbeat();
+		// Jobs of the worker's own queue are not started along with it.
+		m_pJobsManager->startJob(properties.id);
+		return;
+	}
+
+	if(command == QString(CMSG_ABORT_DISPATCHED_JOB))
+	{
+		QUuid id(jsArguments[JP_ID].toString());
+		if(m_dispatchedJobs.erase(id) == 0)
+			return;
+		if(!m_pJobsManager->abortJob(id))
+			m_pJobsManager->setJobState(id, JobState::Aborted);
+		return;
+	}
+}
+
+// END OF void WorkerLink::processMessage(const QString & a_message)
+//==============================================================================
+
+QJsonObject WorkerLink::workerInfo() const
+{
+	// Jobs run one at a time, so a worker has a single slot.
+	bool busy = m_pJobsManager->hasActiveJobs() || (!m_dispatchedJobs.empty());
+
+	QJsonArray jsJobs;
+	for(const std::pair<const QUuid, QJsonObject> & dispatched :
+		m_dispatchedJobs)
+		jsJobs.push_back(dispatched.second);
+
+	QJsonObject jsInfo;
+	jsInfo[WORKER_NAME] = m_name;
+	jsInfo[WORKER_CORES] = QThread::idealThreadCount();
+	jsInfo[WORKER_FREE_SLOTS] = busy ? 0 : 1;
+	jsInfo[WORKER_FREE_MEMORY] = freePhysicalMemory();
+	jsInfo[WORKER_JOBS] = jsJobs;
+	return jsInfo;
+}
+
+// END OF QJsonObject WorkerLink::workerInfo() const
+//==============================================================================
+
+void WorkerLink::abandonDispatchedJobs()
+{
+	std::vector<QUuid> ids;
+	for(const std::pair<const QUuid, QJsonObject> & dispatched :
+		m_dispatchedJobs)
+		ids.push_back(dispatched.first);
+	m_dispatchedJobs.clear();
+
+	for(const QUuid & id : ids)
+	{
+		if(!m_pJobsManager->abortJob(id))
+			m_pJobsManager->setJobState(id, JobState::Aborted);
+	}
+}
+
+// END OF void WorkerLink::abandonDispatchedJobs()
+//==============================================================================
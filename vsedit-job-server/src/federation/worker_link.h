@@ -0,0 +1,84 @@
+#ifndef WORKER_LINK_H_INCLUDED
+#define WORKER_LINK_H_INCLUDED
+
+#include "../../../common-src/settings/settings_definitions_core.h"
+#include "../../../common-src/log/vs_editor_log_definitions.h"
+
+#include <QObject>
+#include <QUrl>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include <map>
+
+class SettingsManagerCore;
+class JobsManager;
+class QWebSocket;
+class QTimer;
+
+/// Connection of a worker server to its coordinator.
+/// Registers the worker, reports free resources and the progress of
+/// dispatched jobs with every heartbeat, and queues the jobs the
+/// coordinator dispatches. Dispatched jobs are abandoned when the
+/// coordinator is lost, because it queues them again elsewhere. The
+/// coordinator is lost when the connection drops or when nothing has
+/// come from it for the heartbeat timeout.
+class WorkerLink : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	WorkerLink(const QUrl & a_coordinatorUrl, const QString & a_name,
+		JobsManager * a_pJobsManager, SettingsManagerCore * a_pSettingsManager,
+		QObject * a_pParent = nullptr);
+	virtual ~WorkerLink();
+
+	void start();
+
+signals:
+
+	void signalLogMessage(const QString & a_message,
+		const QString & a_style = LOG_STYLE_DEFAULT);
+
+private slots:
+
+	void slotReconnect();
+	void slotConnected();
+	void slotDisconnected();
+	void slotBinaryMessageReceived(const QByteArray & a_message);
+	void slotTextMessageReceived(const QString & a_message);
+	void slotSendHeartbeat();
+
+	void slotJobChanged(const JobProperties & a_properties);
+	void slotJobStateChanged(const QUuid & a_jobID, JobState a_state);
+	void slotJobProgressChanged(const QUuid & a_jobID, int a_progress,
+		double a_fps);
+	void slotJobEncoderStatusChanged(const QUuid & a_jobID,
+		const QString & a_status, double a_fps, double a_bitrate);
+
+private:
+
+	void processMessage(const QString & a_message);
+
+	QJsonObject workerInfo() const;
+
+	void abandonDispatchedJobs();
+
+	QUrl m_coordinatorUrl;
+	QString m_name;
+
+	JobsManager * m_pJobsManager;
+
+	QWebSocket * m_pSocket;
+	QTimer * m_pHeartbeatTimer;
+	QTimer * m_pReconnectTimer;
+
+	// Time since the coordinator was last heard from.
+	QElapsedTimer m_lastCoordinatorMessage;
+	int m_heartbeatTimeout;
+
+	// Latest reported state of each dispatched job.
+	std::map<QUuid, QJsonObject> m_dispatchedJobs;
+};
+
+#endif // WORKER_LINK_H_INCLUDED
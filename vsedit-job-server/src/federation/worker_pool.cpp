@@ -0,0 +1,346 @@
+#include "worker_pool.h"
+
+#include "../../../common-src/ipc_defines.h"
+#include "../../../common-src/helpers.h"
+#include "../../../common-src/settings/settings_manager_core.h"
+
+#include <QWebSocket>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QTimer>
+#include <algorithm>
+
+//==============================================================================
+
+WorkerPool::WorkerPool(SettingsManagerCore * a_pSettingsManager,
+	QObject * a_pParent) :
+	  QObject(a_pParent)
+	, m_heartbeatTimeout(DEFAULT_JOB_SERVER_HEARTBEAT_TIMEOUT)
+	, m_pHeartbeatCheckTimer(nullptr)
+	, m_pHeartbeatTimer(nullptr)
+{
+	Q_ASSERT(a_pSettingsManager);
+	m_heartbeatTimeout = std::max(
+		a_pSettingsManager->getJobServerHeartbeatTimeout(), 1);
+
+	m_pHeartbeatCheckTimer = new QTimer(this);
+	m_pHeartbeatCheckTimer->setInterval(std::max(m_heartbeatTimeout / 2, 1));
+	connect(m_pHeartbeatCheckTimer, &QTimer::timeout,
+		this, &WorkerPool::slotCheckHeartbeats);
+	m_pHeartbeatCheckTimer->start();
+
+	m_pHeartbeatTimer = new QTimer(this);
+	m_pHeartbeatTimer->setInterval(std::max(
+		a_pSettingsManager->getJobServerHeartbeatInterval(), 1));
+	connect(m_pHeartbeatTimer, &QTimer::timeout,
+		this, &WorkerPool::slotSendHeartbeats);
+	m_pHeartbeatTimer->start();
+}
+
+// END OF WorkerPool::WorkerPool(SettingsManagerCore * a_pSettingsManager,
+//		QObject * a_pParent)
+//==============================================================================
+
+WorkerPool::~WorkerPool()
+{
+	for(WorkerNode & node : m_workers)
+	{
+		disconnect(node.pSocket, nullptr, this, nullptr);
+		delete node.pSocket;
+	}
+	m_workers.clear();
+}
+
+// END OF WorkerPool::~WorkerPool()
+//==============================================================================
+
+void WorkerPool::addWorker(QWebSocket * a_pSocket, const QJsonObject & a_info)
+{
+	Q_ASSERT(a_pSocket);
+	if(findWorker(a_pSocket) != m_workers.end())
+		return;
+
+	a_pSocket->setParent(this);
+	connect(a_pSocket, &QWebSocket::binaryMessageReceived,
+		this, &WorkerPool::slotBinaryMessageReceived);
+	connect(a_pSocket, &QWebSocket::textMessageReceived,
+		this, &WorkerPool::slotTextMessageReceived);
+	connect(a_pSocket, &QWebSocket::disconnected,
+		this, &WorkerPool::slotWorkerDisconnected);
+
+	WorkerNode node;
+	node.pSocket = a_pSocket;
+	node.cores = 1;
+	node.freeSlots = 0;
+	node.freeMemory = 0;
+	m_workers.push_back(node);
+
+	WorkerNode & newNode = m_workers.back();
+	updateWorker(newNode, a_info);
+	if(newNode.name.isEmpty())
+	{
+		newNode.name = QString("%1:%2").arg(a_pSocket->peerAddress()
+			.toString()).arg(a_pSocket->peerPort());
+	}
+
+	emit signalLogMessage(tr("Worker %1 registered with %2 cores.")
+		.arg(newNode.name).arg(newNode.cores));
+
+	if(newNode.freeSlots > 0)
+		emit signalWorkerAvailable();
+}
+
+// END OF void WorkerPool::addWorker(QWebSocket * a_pSocket,
+//		const QJsonObject & a_info)
+//==============================================================================
+
+size_t WorkerPool::workersNumber() const
+{
+	return m_workers.size();
+}
+
+// END OF size_t WorkerPool::workersNumber() const
+//==============================================================================
+
+bool WorkerPool::dispatchJob(const JobProperties & a_properties)
+{
+	std::list<WorkerNode>::iterator best = m_workers.end();
+	for(std::list<WorkerNode>::iterator it = m_workers.begin();
+		it != m_workers.end(); ++it)
+	{
+		if(it->freeSlots <= 0)
+			continue;
+		if((best == m_workers.end()) || (it->cores > best->cores) ||
+			((it->cores == best->cores) && (it->freeMemory > best->freeMemory)))
+			best = it;
+	}
+
+	if(best == m_workers.end())
+		return false;
+
+	// Dependencies are resolved by the coordinator.
+	JobProperties properties = a_properties;
+	properties.jobState = JobState::Waiting;
+	properties.dependsOnJobIds.clear();
+
+	best->pSocket->sendBinaryMessage(vsedit::jsonMessage(CMSG_DISPATCH_JOB,
+		properties.toJson()));
+	best->freeSlots--;
+	best->jobs.push_back(properties.id);
+
+	emit signalLogMessage(tr("Job %1 dispatched to worker %2.")
+		.arg(properties.id.toString()).arg(best->name));
+
+	return true;
+}
+
+// END OF bool WorkerPool::dispatchJob(const JobProperties & a_properties)
+//==============================================================================
+
+void WorkerPool::abortJob(const QUuid & a_jobID)
+{
+	for(WorkerNode & node : m_workers)
+	{
+		std::vector<QUuid>::iterator it =
+			std::find(node.jobs.begin(), node.jobs.end(), a_jobID);
+		if(it == node.jobs.end())
+			continue;
+		node.jobs.erase(it);
+		QJsonObject jsJob;
+		jsJob[JP_ID] = a_jobID.toString();
+		node.pSocket->sendBinaryMessage(vsedit::jsonMessage(
+			CMSG_ABORT_DISPATCHED_JOB, jsJob));
+		return;
+	}
+}
+
+// END OF void WorkerPool::abortJob(const QUuid & a_jobID)
+//==============================================================================
+
+void WorkerPool::slotBinaryMessageReceived(const QByteArray & a_message)
+{
+	std::list<WorkerNode>::iterator it =
+		findWorker(qobject_cast<QWebSocket *>(sender()));
+	if(it == m_workers.end())
+		return;
+	processMessage(*it, QString::fromUtf8(a_message));
+}
+
+// END OF void WorkerPool::slotBinaryMessageReceived(
+//		const QByteArray & a_message)
+//==============================================================================
+
+void WorkerPool::slotTextMessageReceived(const QString & a_message)
+{
+	std::list<WorkerNode>::iterator it =
+		findWorker(qobject_cast<QWebSocket *>(sender()));
+	if(it == m_workers.end())
+		return;
+	processMessage(*it, a_message);
+}
+
+// END OF void WorkerPool::slotTextMessageReceived(const QString & a_message)
+//==============================================================================
+
+void WorkerPool::slotWorkerDisconnected()
+{
+	std::list<WorkerNode>::iterator it =
+		findWorker(qobject_cast<QWebSocket *>(sender()));
+	if(it == m_workers.end())
+		return;
+	dropWorker(it, tr("disconnected"));
+}
+
+// END OF void WorkerPool::slotWorkerDisconnected()
+//==============================================================================
+
+void WorkerPool::slotCheckHeartbeats()
+{
+	std::list<WorkerNode>::iterator it = m_workers.begin();
+	while(it != m_workers.end())
+	{
+		std::list<WorkerNode>::iterator next = std::next(it);
+		if(it->lastHeartbeat.elapsed() > m_heartbeatTimeout)
+			dropWorker(it, tr("stopped responding"));
+		it = next;
+	}
+}
+
+// END OF void WorkerPool::slotCheckHeartbeats()
+//==============================================================================
+
+void WorkerPool::slotSendHeartbeats()
+{
+	for(WorkerNode & node : m_workers)
+	{
+		node.pSocket->sendBinaryMessage(vsedit::jsonMessage(
+			CMSG_COORDINATOR_HEARTBEAT, QJsonObject()));
+	}
+}
+
+// END OF void WorkerPool::slotSendHeartbeats()
+//==============================================================================
+
+void WorkerPool::processMessage(WorkerNode & a_node,
+	const QString & a_message)
+{
+	QString command = a_message;
+	QString arguments;
+	int spaceIndex = a_message.indexOf(' ');
+	if(spaceIndex >= 0)
+	{
+		command = a_message.left(spaceIndex);
+		arguments = a_message.mid(spaceIndex + 1);
+	}
+
+	QJsonObject jsArguments =
+		QJsonDocument::fromJson(arguments.toUtf8()).object();
+
+	if(command == QString(MSG_WORKER_HEARTBEAT))
+	{
+		updateWorker(a_node, jsArguments);
+		for(const QJsonValue & value : jsArguments[WORKER_JOBS].toArray())
+		{
+			QJsonObject jsJob = value.toObject();
+			emit signalJobUpdated(QUuid(jsJob[JP_ID].toString()), jsJob);
+		}
+		if(a_node.freeSlots > 0)
+			emit signalWorkerAvailable();
+		return;
+	}
+
+	if(command == QString(MSG_WORKER_JOB_UPDATE))
+	{
+		QUuid id(jsArguments[JP_ID].toString());
+		if(!vsedit::contains(a_node.jobs, id))
+			return;
+
+		if(jsArguments.contains(JP_JOB_STATE))
+		{
+			JobState state = JobState(jsArguments[JP_JOB_STATE].toInt());
+			if((state != JobState::Waiting) &&
+				(!vsedit::contains(ACTIVE_JOB_STATES, state)))
+			{
+				a_node.jobs.erase(std::remove(a_node.jobs.begin(),
+					a_node.jobs.end(), id), a_node.jobs.end());
+			}
+		}
+
+		emit signalJobUpdated(id, jsArguments);
+		return;
+	}
+}
+
+// END OF void WorkerPool::processMessage(WorkerNode & a_node,
+//		const QString & a_message)
+//==============================================================================
+
+void WorkerPool::updateWorker(WorkerNode & a_node, const QJsonObject & a_info)
+{
+	a_node.lastHeartbeat.restart();
+
+	if(a_info.contains(WORKER_NAME))
+		a_node.name = a_info[WORKER_NAME].toString();
+	if(a_info.contains(WORKER_CORES))
+		a_node.cores = std::max(a_info[WORKER_CORES].toInt(), 1);
+	if(a_info.contains(WORKER_FREE_MEMORY))
+		a_node.freeMemory = a_info[WORKER_FREE_MEMORY].toVariant().toLongLong();
+
+	if(!a_info.contains(WORKER_FREE_SLOTS))
+		return;
+
+	// Jobs dispatched after the report was sent are not counted in it.
+	std::vector<QUuid> reportedJobs;
+	for(const QJsonValue & value : a_info[WORKER_JOBS].toArray())
+		reportedJobs.push_back(QUuid(value.toObject()[JP_ID].toString()));
+	int unacknowledgedJobs = 0;
+	for(const QUuid & id : a_node.jobs)
+	{
+		if(!vsedit::contains(reportedJobs, id))
+			unacknowledgedJobs++;
+	}
+
+	a_node.freeSlots = std::max(
+		a_info[WORKER_FREE_SLOTS].toInt() - unacknowledgedJobs, 0);
+}
+
+// END OF void WorkerPool::updateWorker(WorkerNode & a_node,
+//		const QJsonObject & a_info)
+//==============================================================================
+
+void WorkerPool::dropWorker(std::list<WorkerNode>::iterator a_it,
+	const QString & a_reason)
+{
+	QWebSocket * pSocket = a_it->pSocket;
+	std::vector<QUuid> lostJobs = a_it->jobs;
+	QString name = a_it->name;
+	m_workers.erase(a_it);
+
+	disconnect(pSocket, nullptr, this, nullptr);
+	pSocket->close();
+	pSocket->deleteLater();
+
+	emit signalLogMessage(tr("Worker %1 %2. %3 job(s) will be queued again.")
+		.arg(name).arg(a_reason).arg(lostJobs.size()), LOG_STYLE_WARNING);
+
+	if(!lostJobs.empty())
+		emit signalJobsLost(lostJobs);
+}
+
+// END OF void WorkerPool::dropWorker(std::list<WorkerNode>::iterator a_it,
+//		const QString & a_reason)
+//==============================================================================
+
+std::list<WorkerPool::WorkerNode>::iterator WorkerPool::findWorker(
+	QWebSocket * a_pSocket)
+{
+	return std::find_if(m_workers.begin(), m_workers.end(),
+		[&](const WorkerNode & a_node)->bool
+		{
+			return (a_node.pSocket == a_pSocket);
+		});
+}
+
+// END OF std::list<WorkerPool::WorkerNode>::iterator WorkerPool::findWorker(
+//		QWebSocket * a_pSocket)
+//==============================================================================
@@ -0,0 +1,86 @@
+#ifndef WORKER_POOL_H_INCLUDED
+#define WORKER_POOL_H_INCLUDED
+
+#include "../../../common-src/settings/settings_definitions_core.h"
+#include "../../../common-src/log/vs_editor_log_definitions.h"
+
+#include <QObject>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include <list>
+#include <vector>
+
+class SettingsManagerCore;
+class QWebSocket;
+class QTimer;
+
+/// Worker servers registered with a coordinator server.
+/// Jobs are dispatched to the worker with a free slot and the most
+/// cores and memory. Workers that stop sending heartbeats are dropped
+/// and their jobs are reported lost so they can be queued again. The
+/// pool sends heartbeats of its own so workers can detect a dead
+/// coordinator as well.
+class WorkerPool : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	WorkerPool(SettingsManagerCore * a_pSettingsManager,
+		QObject * a_pParent = nullptr);
+	virtual ~WorkerPool();
+
+	void addWorker(QWebSocket * a_pSocket, const QJsonObject & a_info);
+
+	size_t workersNumber() const;
+
+	bool dispatchJob(const JobProperties & a_properties);
+	void abortJob(const QUuid & a_jobID);
+
+signals:
+
+	void signalLogMessage(const QString & a_message,
+		const QString & a_style = LOG_STYLE_DEFAULT);
+	void signalJobUpdated(const QUuid & a_jobID, const QJsonObject & a_update);
+	void signalJobsLost(const std::vector<QUuid> & a_ids);
+	void signalWorkerAvailable();
+
+private slots:
+
+	void slotBinaryMessageReceived(const QByteArray & a_message);
+	void slotTextMessageReceived(const QString & a_message);
+	void slotWorkerDisconnected();
+	void slotCheckHeartbeats();
+	void slotSendHeartbeats();
+
+private:
+
+	struct WorkerNode
+	{
+		QWebSocket * pSocket;
+		QString name;
+		int cores;
+		int freeSlots;
+		qint64 freeMemory;
+		QElapsedTimer lastHeartbeat;
+		std::vector<QUuid> jobs;
+	};
+
+	void processMessage(WorkerNode & a_node, const QString & a_message);
+
+	void updateWorker(WorkerNode & a_node, const QJsonObject & a_info);
+
+	void dropWorker(std::list<WorkerNode>::iterator a_it,
+		const QString & a_reason);
+
+	std::list<WorkerNode>::iterator findWorker(QWebSocket * a_pSocket);
+
+	std::list<WorkerNode> m_workers;
+
+	int m_heartbeatTimeout;
+
+	QTimer * m_pHeartbeatCheckTimer;
+	QTimer * m_pHeartbeatTimer;
+};
+
+#endif // WORKER_POOL_H_INCLUDED
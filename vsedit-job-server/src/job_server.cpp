@@ -3,26 +3,82 @@
 #include "../../common-src/ipc_defines.h"
 #include "../../common-src/helpers.h"
 #include "jobs/jobs_manager.h"
+#include "federation/worker_pool.h"
+#include "federation/worker_link.h"
 
 #include <QWebSocketServer>
 #include <QWebSocket>
+#include <QTimer>
+#include <QSysInfo>
 
 //==============================================================================
 
-JobServer::JobServer(QObject * a_pParent) : QObject(a_pParent)
+JobServerOptions::JobServerOptions() :
+	  port(JOB_SERVER_PORT)
+	, coordinator(false)
+{
+}
+
+// END OF JobServerOptions::JobServerOptions()
+//==============================================================================
+
+JobServer::JobServer(const JobServerOptions & a_options, QObject * a_pParent) :
+	  QObject(a_pParent)
+	, m_options(a_options)
 	, m_pSettingsManager(nullptr)
 	, m_pJobsManager(nullptr)
 	, m_pWebSocketServer(nullptr)
+	, m_pWorkerPool(nullptr)
+	, m_pWorkerLink(nullptr)
+	, m_pProgressUpdateTimer(nullptr)
+	, m_log(DEFAULT_JOB_SERVER_LOG_CAPACITY)
+	, m_logTailSize(DEFAULT_JOB_SERVER_LOG_TAIL_SIZE)
 {
 	m_pSettingsManager = new SettingsManagerCore(this);
 
 	m_trustedClientsAddresses =
 		m_pSettingsManager->getTrustedClientsAddresses();
 
+	m_log.setCapacity((size_t)std::max(
+		m_pSettingsManager->getJobServerLogCapacity(), 1));
+	m_logTailSize = (size_t)std::max(
+		m_pSettingsManager->getJobServerLogTailSize(), 0);
+	QString spillFilePath =
+		m_pSettingsManager->getJobServerLogSpillFilePath();
+	if(!m_log.setSpillFilePath(spillFilePath))
+	{
+		slotLogMessage(tr("Could not open log spill file \"%1\".")
+			.arg(spillFilePath), LOG_STYLE_WARNING);
+	}
+
+	// Progress is reported by jobs after every written frame.
+	// Coalesce it per job and broadcast in batches at a limited rate.
+	m_pProgressUpdateTimer = new QTimer(this);
+	m_pProgressUpdateTimer->setSingleShot(true);
+	m_pProgressUpdateTimer->setInterval(
+		m_pSettingsManager->getJobServerProgressUpdateInterval());
+	connect(m_pProgressUpdateTimer, &QTimer::timeout,
+		this, &JobServer::slotFlushJobsProgress);
+
 	m_pJobsManager = new JobsManager(m_pSettingsManager, this);
-	m_pJobsManager->loadJobs();
+	if(!m_options.instanceName.isEmpty())
+	{
+		m_pJobsManager->setJournalFilePath(
+			m_pSettingsManager->getSettingsFileDir() +
+			QString("/vsedit2-jobs-%1.journal").arg(m_options.instanceName));
+	}
 	connect(m_pJobsManager, &JobsManager::signalLogMessage,
 		this, &JobServer::slotLogMessage);
+
+	if(m_options.coordinator)
+	{
+		m_pWorkerPool = new WorkerPool(m_pSettingsManager, this);
+		connect(m_pWorkerPool, &WorkerPool::signalLogMessage,
+			this, &JobServer::slotLogMessage);
+		m_pJobsManager->setWorkerPool(m_pWorkerPool);
+	}
+
+	m_pJobsManager->loadJobs();
 	connect(m_pJobsManager, &JobsManager::signalJobCreated,
 		this, &JobServer::slotJobCreated);
 	connect(m_pJobsManager, &JobsManager::signalJobChanged,
@@ -35,20 +91,35 @@ JobServer::JobServer(QObject * a_pParent) : QObject(a_pParent)
 		this, &JobServer::slotJobStartTimeChanged);
 	connect(m_pJobsManager, &JobsManager::signalJobEndTimeChanged,
 		this, &JobServer::slotJobEndTimeChanged);
+	connect(m_pJobsManager, &JobsManager::signalJobEncoderStatusChanged,
+		this, &JobServer::slotJobEncoderStatusChanged);
 	connect(m_pJobsManager, &JobsManager::signalJobDependenciesChanged,
 		this, &JobServer::slotJobDependenciesChanged);
 	connect(m_pJobsManager, &JobsManager::signalJobsSwapped,
 		this, &JobServer::slotJobsSwapped);
 	connect(m_pJobsManager, &JobsManager::signalJobsDeleted,
 		this, &JobServer::slotJobsDeleted);
+	connect(m_pJobsManager, &JobsManager::signalJobTelemetry,
+		this, &JobServer::slotJobTelemetry);
 
 	m_pWebSocketServer = new QWebSocketServer(JOB_SERVER_NAME,
 		QWebSocketServer::NonSecureMode, this);
 	connect(m_pWebSocketServer, &QWebSocketServer::newConnection,
 		this, &JobServer::slotNewConnection);
+
+	if(m_options.coordinatorUrl.isValid())
+	{
+		QString workerName = QString("%1:%2")
+			.arg(QSysInfo::machineHostName()).arg(m_options.port);
+		m_pWorkerLink = new WorkerLink(m_options.coordinatorUrl, workerName,
+			m_pJobsManager, m_pSettingsManager, this);
+		connect(m_pWorkerLink, &WorkerLink::signalLogMessage,
+			this, &JobServer::slotLogMessage);
+	}
 }
 
-// END OF JobServer::JobServer(QObject * a_pParent)
+// END OF JobServer::JobServer(const JobServerOptions & a_options,
+//		QObject * a_pParent)
 //==============================================================================
 
 JobServer::~JobServer()
@@ -61,6 +132,8 @@ JobServer::~JobServer()
 	}
 	m_clients.clear();
 	m_subscribers.clear();
+	m_pendingProgress.clear();
+	m_pendingTelemetry.clear();
 	m_pWebSocketServer->close();
 	m_pJobsManager->saveJobs();
 }
@@ -71,7 +144,11 @@ JobServer::~JobServer()
 bool JobServer::start()
 {
 	Q_ASSERT(m_pWebSocketServer);
-	return m_pWebSocketServer->listen(QHostAddress::Any, JOB_SERVER_PORT);
+	bool listening = m_pWebSocketServer->listen(QHostAddress::Any,
+		m_options.port);
+	if(listening && m_pWorkerLink)
+		m_pWorkerLink->start();
+	return listening;
 }
 
 // END OF bool JobServer::start()
@@ -142,7 +219,7 @@ void JobServer::slotLogMessage(const QString & a_message,
 	const QString & a_style)
 {
 	LogEntry entry(a_message, a_style);
-	m_logEntries.push_back(entry);
+	m_log.append(entry);
 	broadcastMessage(vsedit::jsonMessage(SMSG_LOG_MESSAGE, entry.toJson()));
 }
 
@@ -161,6 +238,7 @@ void JobServer::slotJobCreated(const JobProperties & a_properties)
 
 void JobServer::slotJobChanged(const JobProperties & a_properties)
 {
+	m_pendingProgress.erase(a_properties.id);
 	broadcastMessage(vsedit::jsonMessage(SMSG_JOB_UPDATE,
 		a_properties.toJson()));
 }
@@ -170,6 +248,13 @@ void JobServer::slotJobChanged(const JobProperties & a_properties)
 
 void JobServer::slotJobStateChanged(const QUuid & a_jobID, JobState a_state)
 {
+	// Deliver the exact final progress before the state it led to.
+	slotFlushJobsProgress();
+
+	// A reset job starts a new telemetry series.
+	if(a_state == JobState::Waiting)
+		m_telemetryHistory.erase(a_jobID);
+
 	QJsonObject jsJob;
 	jsJob[JP_ID] = a_jobID.toString();
 	jsJob[JP_JOB_STATE] = (int)a_state;
@@ -183,11 +268,11 @@ void JobServer::slotJobStateChanged(const QUuid & a_jobID, JobState a_state)
 void JobServer::slotJobProgressChanged(const QUuid & a_jobID, int a_progress,
 	double a_fps)
 {
-	QJsonObject jsJob;
-	jsJob[JP_ID] = a_jobID.toString();
+	QJsonObject & jsJob = m_pendingProgress[a_jobID];
 	jsJob[JP_FRAMES_PROCESSED] = a_progress;
 	jsJob[JP_FPS] = a_fps;
-	broadcastMessage(vsedit::jsonMessage(SMSG_JOB_PROGRESS_UPDATE, jsJob));
+	if(!m_pProgressUpdateTimer->isActive())
+		m_pProgressUpdateTimer->start();
 }
 
 // END OF void JobServer::slotJobProgressChanged(const QUuid & a_jobID,
@@ -210,6 +295,8 @@ void JobServer::slotJobStartTimeChanged(const QUuid & a_jobID,
 void JobServer::slotJobEndTimeChanged(const QUuid & a_jobID,
 	const QDateTime & a_time)
 {
+	slotFlushJobsProgress();
+
 	QJsonObject jsJob;
 	jsJob[JP_ID] = a_jobID.toString();
 	jsJob[JP_TIME_ENDED] = a_time.toMSecsSinceEpoch();
@@ -220,6 +307,21 @@ void JobServer::slotJobEndTimeChanged(const QUuid & a_jobID,
 //		const QDateTime & a_time)
 //==============================================================================
 
+void JobServer::slotJobEncoderStatusChanged(const QUuid & a_jobID,
+	const QString & a_status, double a_fps, double a_bitrate)
+{
+	QJsonObject & jsJob = m_pendingProgress[a_jobID];
+	jsJob[JP_ENCODER_STATUS] = a_status;
+	jsJob[JP_ENCODER_FPS] = a_fps;
+	jsJob[JP_ENCODER_BITRATE] = a_bitrate;
+	if(!m_pProgressUpdateTimer->isActive())
+		m_pProgressUpdateTimer->start();
+}
+
+// END OF void JobServer::slotJobEncoderStatusChanged(const QUuid & a_jobID,
+//		const QString & a_status, double a_fps, double a_bitrate)
+//==============================================================================
+
 void JobServer::slotJobDependenciesChanged(const QUuid & a_jobID,
 	const std::vector<QUuid> & a_dependencies)
 {
@@ -250,6 +352,13 @@ void JobServer::slotJobsSwapped(const QUuid & a_jobID1, const QUuid & a_jobID2)
 
 void JobServer::slotJobsDeleted(const std::vector<QUuid> & a_ids)
 {
+	for(const QUuid & id : a_ids)
+	{
+		m_pendingProgress.erase(id);
+		m_pendingTelemetry.erase(id);
+		m_telemetryHistory.erase(id);
+	}
+
 	QJsonArray jsIdsArray;
 	for(const QUuid & id : a_ids)
 		jsIdsArray.push_back(id.toString());
@@ -259,6 +368,66 @@ void JobServer::slotJobsDeleted(const std::vector<QUuid> & a_ids)
 // END OF void JobServer::slotJobsDeleted(const std::vector<QUuid> & a_ids)
 //==============================================================================
 
+void JobServer::slotJobTelemetry(const QUuid & a_jobID,
+	const JobTelemetrySample & a_sample)
+{
+	std::deque<JobTelemetrySample> & history = m_telemetryHistory[a_jobID];
+	history.push_back(a_sample);
+	while(history.size() > (size_t)DEFAULT_JOB_TELEMETRY_HISTORY_SIZE)
+		history.pop_front();
+
+	m_pendingTelemetry[a_jobID].push_back(a_sample);
+	if(!m_pProgressUpdateTimer->isActive())
+		m_pProgressUpdateTimer->start();
+}
+
+// END OF void JobServer::slotJobTelemetry(const QUuid & a_jobID,
+//		const JobTelemetrySample & a_sample)
+//==============================================================================
+
+void JobServer::slotFlushJobsProgress()
+{
+	m_pProgressUpdateTimer->stop();
+
+	if(!m_pendingProgress.empty())
+	{
+		QJsonArray jsJobs;
+		for(const std::pair<const QUuid, QJsonObject> & pending :
+			m_pendingProgress)
+		{
+			QJsonObject jsJob = pending.second;
+			jsJob[JP_ID] = pending.first.toString();
+			jsJobs.push_back(jsJob);
+		}
+		m_pendingProgress.clear();
+
+		broadcastMessage(vsedit::jsonMessage(SMSG_JOBS_PROGRESS_UPDATE,
+			jsJobs));
+	}
+
+	if(!m_pendingTelemetry.empty())
+	{
+		QJsonArray jsJobs;
+		for(const std::pair<const QUuid, std::vector<JobTelemetrySample> > &
+			pending : m_pendingTelemetry)
+		{
+			QJsonArray jsSamples;
+			for(const JobTelemetrySample & sample : pending.second)
+				jsSamples.push_back(sample.toJson());
+			QJsonObject jsJob;
+			jsJob[JP_ID] = pending.first.toString();
+			jsJob[TELEMETRY_SAMPLES] = jsSamples;
+			jsJobs.push_back(jsJob);
+		}
+		m_pendingTelemetry.clear();
+
+		broadcastMessage(vsedit::jsonMessage(SMSG_JOBS_TELEMETRY, jsJobs));
+	}
+}
+
+// END OF void JobServer::slotFlushJobsProgress()
+//==============================================================================
+
 void JobServer::processMessage(QWebSocket * a_pClient,
 	const QString & a_message)
 {
@@ -277,7 +446,7 @@ void JobServer::processMessage(QWebSocket * a_pClient,
 		MSG_CHANGE_JOB, MSG_SWAP_JOBS, MSG_RESET_JOBS, MSG_DELETE_JOBS,
 		MSG_START_ALL_WAITING_JOBS, MSG_PAUSE_ACTIVE_JOBS,
 		MSG_RESUME_PAUSED_JOBS, MSG_ABORT_ACTIVE_JOBS, MSG_GET_TRUSTED_CLIENTS,
-		MSG_SET_TRUSTED_CLIENTS};
+		MSG_SET_TRUSTED_CLIENTS, MSG_REGISTER_WORKER};
 
 	if(vsedit::contains(trustedOnlyCommands, command) && (!trustedClient))
 	{
@@ -296,7 +465,46 @@ void JobServer::processMessage(QWebSocket * a_pClient,
 
 	if(command == QString(MSG_GET_LOG))
 	{
-		a_pClient->sendBinaryMessage(completeLogMessage());
+		size_t tailSize = m_logTailSize;
+		QJsonObject jsRequest = jsArguments.object();
+		if(jsRequest.contains(LOG_PAGE_COUNT))
+			tailSize = (size_t)std::max(jsRequest[LOG_PAGE_COUNT].toInt(), 0);
+		a_pClient->sendBinaryMessage(completeLogMessage(tailSize));
+		return;
+	}
+
+	if(command == QString(MSG_GET_LOG_PAGE))
+	{
+		QJsonObject jsRequest = jsArguments.object();
+		if(!jsRequest.contains(LOG_PAGE_FIRST))
+			return;
+		size_t first = (size_t)std::max(
+			jsRequest[LOG_PAGE_FIRST].toVariant().toLongLong(), 0ll);
+		size_t count = m_logTailSize;
+		if(jsRequest.contains(LOG_PAGE_COUNT))
+			count = (size_t)std::max(jsRequest[LOG_PAGE_COUNT].toInt(), 0);
+		a_pClient->sendBinaryMessage(logPageMessage(first, count));
+		return;
+	}
+
+	if(command == QString(MSG_GET_JOBS_TELEMETRY))
+	{
+		a_pClient->sendBinaryMessage(jobsTelemetryMessage());
+		return;
+	}
+
+	if(command == QString(MSG_REGISTER_WORKER))
+	{
+		if(!m_pWorkerPool)
+		{
+			a_pClient->sendBinaryMessage("This server is not a coordinator.");
+			return;
+		}
+		// The worker pool takes over the connection.
+		disconnect(a_pClient, nullptr, this, nullptr);
+		m_clients.remove(a_pClient);
+		m_subscribers.remove(a_pClient);
+		m_pWorkerPool->addWorker(a_pClient, jsArguments.object());
 		return;
 	}
 
@@ -456,16 +664,54 @@ QByteArray JobServer::jobsInfoMessage() const
 // END OF QByteArray JobServer::jobsInfoMessage() const
 //==============================================================================
 
-QByteArray JobServer::completeLogMessage() const
+QByteArray JobServer::completeLogMessage(size_t a_tailSize) const
 {
 	QJsonArray jsEntries;
-	for(const LogEntry & entry : m_logEntries)
+	for(const LogEntry & entry : m_log.tail(a_tailSize))
 		jsEntries.push_back(entry.toJson());
 	QByteArray message = vsedit::jsonMessage(SMSG_COMPLETE_LOG, jsEntries);
 	return message;
 }
 
-// END OF QByteArray JobServer::completeLogMessage() const
+// END OF QByteArray JobServer::completeLogMessage(size_t a_tailSize) const
+//==============================================================================
+
+QByteArray JobServer::logPageMessage(size_t a_first, size_t a_count) const
+{
+	QJsonArray jsEntries;
+	for(const LogEntry & entry : m_log.entries(a_first, a_count))
+		jsEntries.push_back(entry.toJson());
+	QJsonObject jsPage;
+	jsPage[LOG_PAGE_FIRST] = (qint64)std::max(a_first, m_log.firstIndex());
+	jsPage[LOG_PAGE_TOTAL] = (qint64)m_log.totalEntries();
+	jsPage[LOG_PAGE_ENTRIES] = jsEntries;
+	QByteArray message = vsedit::jsonMessage(SMSG_LOG_PAGE, jsPage);
+	return message;
+}
+
+// END OF QByteArray JobServer::logPageMessage(size_t a_first,
+//		size_t a_count) const
+//==============================================================================
+
+QByteArray JobServer::jobsTelemetryMessage() const
+{
+	QJsonArray jsJobs;
+	for(const std::pair<const QUuid, std::deque<JobTelemetrySample> > &
+		history : m_telemetryHistory)
+	{
+		QJsonArray jsSamples;
+		for(const JobTelemetrySample & sample : history.second)
+			jsSamples.push_back(sample.toJson());
+		QJsonObject jsJob;
+		jsJob[JP_ID] = history.first.toString();
+		jsJob[TELEMETRY_SAMPLES] = jsSamples;
+		jsJobs.push_back(jsJob);
+	}
+	QByteArray message = vsedit::jsonMessage(SMSG_JOBS_TELEMETRY, jsJobs);
+	return message;
+}
+
+// END OF QByteArray JobServer::jobsTelemetryMessage() const
 //==============================================================================
 
 void JobServer::broadcastMessage(const QString & a_message,
@@ -3,19 +3,43 @@
 
 #include "../../common-src/settings/settings_manager_core.h"
 #include "../../common-src/log/styled_log_view_core.h"
+#include "log/server_log.h"
+#include "../../common-src/jobs/job_telemetry.h"
 
 #include <QObject>
+#include <QUrl>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <list>
+#include <deque>
 #include <vector>
+#include <map>
 
 class SettingsManagerCore;
 class JobsManager;
+class WorkerPool;
+class WorkerLink;
 class QWebSocketServer;
 class QWebSocket;
 class QHostAddress;
+class QTimer;
+
+struct JobServerOptions
+{
+	uint16_t port;
+
+	// Separates the jobs of several servers sharing one settings file.
+	QString instanceName;
+
+	// Dispatch jobs to registered worker servers instead of running them.
+	bool coordinator;
+
+	// Run jobs dispatched by this coordinator.
+	QUrl coordinatorUrl;
+
+	JobServerOptions();
+};
 
 class JobServer : public QObject
 {
@@ -23,7 +47,8 @@ class JobServer : public QObject
 
 public:
 
-	JobServer(QObject * a_pParent = nullptr);
+	JobServer(const JobServerOptions & a_options = JobServerOptions(),
+		QObject * a_pParent = nullptr);
 	virtual ~JobServer();
 
 	bool start();
@@ -49,16 +74,24 @@ private slots:
 		const QDateTime & a_time);
 	void slotJobEndTimeChanged(const QUuid & a_jobID,
 		const QDateTime & a_time);
+	void slotJobEncoderStatusChanged(const QUuid & a_jobID,
+		const QString & a_status, double a_fps, double a_bitrate);
 	void slotJobDependenciesChanged(const QUuid & a_jobID,
 		const std::vector<QUuid> & a_dependencies);
 	void slotJobsSwapped(const QUuid & a_jobID1, const QUuid & a_jobID2);
 	void slotJobsDeleted(const std::vector<QUuid> & a_ids);
+	void slotJobTelemetry(const QUuid & a_jobID,
+		const JobTelemetrySample & a_sample);
+
+	void slotFlushJobsProgress();
 
 private:
 
 	void processMessage(QWebSocket * a_pClient, const QString & a_message);
 	QByteArray jobsInfoMessage() const;
-	QByteArray completeLogMessage() const;
+	QByteArray completeLogMessage(size_t a_tailSize) const;
+	QByteArray logPageMessage(size_t a_first, size_t a_count) const;
+	QByteArray jobsTelemetryMessage() const;
 
 	void broadcastMessage(const QString & a_message,
 		bool a_includeNonSubscribers = false, bool a_trustedOnly = false);
@@ -69,11 +102,25 @@ private:
 
 	bool trustedClientAddress(const QHostAddress & a_address);
 
+	JobServerOptions m_options;
+
 	SettingsManagerCore * m_pSettingsManager;
 	JobsManager * m_pJobsManager;
 	QWebSocketServer * m_pWebSocketServer;
 
-	std::vector<LogEntry> m_logEntries;
+	WorkerPool * m_pWorkerPool;
+	WorkerLink * m_pWorkerLink;
+
+	QTimer * m_pProgressUpdateTimer;
+	std::map<QUuid, QJsonObject> m_pendingProgress;
+
+	// Recent telemetry of each job for newly connected watchers
+	// and samples not broadcast yet.
+	std::map<QUuid, std::deque<JobTelemetrySample> > m_telemetryHistory;
+	std::map<QUuid, std::vector<JobTelemetrySample> > m_pendingTelemetry;
+
+	ServerLog m_log;
+	size_t m_logTailSize;
 
 	std::list<QWebSocket *> m_clients;
 	std::list<QWebSocket *> m_subscribers;
@@ -2,6 +2,18 @@
 
 #include "../../../common-src/settings/settings_manager_core.h"
 #include "../../../common-src/vapoursynth/vs_script_library.h"
+#include "../federation/worker_pool.h"
+#include "../federation/remote_job.h"
+
+#include <QThread>
+#include <QFileInfo>
+#include <QTimer>
+#include <QCoreApplication>
+#include <algorithm>
+
+//==============================================================================
+
+const char JOBS_JOURNAL_FILE_NAME[] = "/vsedit2-jobs.journal";
 
 //==============================================================================
 
@@ -10,14 +22,33 @@ JobsManager::JobsManager(SettingsManagerCore * a_pSettingsManager,
 	  QObject(a_pParent)
 	, m_pSettingsManager(a_pSettingsManager)
 	, m_pVSScriptLibrary(nullptr)
+	, m_pWorkerPool(nullptr)
+	, m_runQueue(false)
+	, m_pOutputParsingThread(nullptr)
+	, m_pTelemetryTimer(nullptr)
+	, m_lastTelemetryTime(0)
 {
 	Q_ASSERT(m_pSettingsManager);
 
+	m_pOutputParsingThread = new QThread(this);
+	m_pOutputParsingThread->start(QThread::LowPriority);
+
 	m_pVSScriptLibrary = new VSScriptLibrary(m_pSettingsManager, this);
 
 	connect(m_pVSScriptLibrary,
 		SIGNAL(signalWriteLogMessage(int, const QString &)),
 		this, SLOT(slotLogMessage(int, const QString &)));
+
+	m_pTelemetryTimer = new QTimer(this);
+	connect(m_pTelemetryTimer, &QTimer::timeout,
+		this, &JobsManager::slotSampleTelemetry);
+	int telemetryInterval = m_pSettingsManager->getJobServerTelemetryInterval();
+	if(telemetryInterval > 0)
+	{
+		m_pTelemetryTimer->setInterval(telemetryInterval);
+		m_telemetryClock.start();
+		m_pTelemetryTimer->start();
+	}
 }
 
 // END OF
@@ -25,6 +56,39 @@ JobsManager::JobsManager(SettingsManagerCore * a_pSettingsManager,
 
 JobsManager::~JobsManager()
 {
+	clearJobs();
+	m_pOutputParsingThread->quit();
+	m_pOutputParsingThread->wait();
+}
+
+// END OF
+//==============================================================================
+
+void JobsManager::setJournalFilePath(const QString & a_filePath)
+{
+	m_journalFilePath = a_filePath;
+}
+
+// END OF
+//==============================================================================
+
+void JobsManager::setWorkerPool(WorkerPool * a_pWorkerPool)
+{
+	Q_ASSERT(m_tickets.empty());
+
+	if(m_pWorkerPool)
+		disconnect(m_pWorkerPool, nullptr, this, nullptr);
+
+	m_pWorkerPool = a_pWorkerPool;
+	if(!m_pWorkerPool)
+		return;
+
+	connect(m_pWorkerPool, &WorkerPool::signalWorkerAvailable,
+		this, &JobsManager::slotWorkerAvailable);
+	connect(m_pWorkerPool, &WorkerPool::signalJobUpdated,
+		this, &JobsManager::slotWorkerJobUpdated);
+	connect(m_pWorkerPool, &WorkerPool::signalJobsLost,
+		this, &JobsManager::slotWorkerJobsLost);
 }
 
 // END OF
@@ -41,15 +105,35 @@ std::vector<JobProperties> JobsManager::jobsProperties() const
 // END OF
 //==============================================================================
 
+bool JobsManager::hasJob(const QUuid & a_jobID) const
+{
+	return (indexOfJob(a_jobID) >= 0);
+}
+
+// END OF
+//==============================================================================
+
+JobProperties JobsManager::jobProperties(const QUuid & a_jobID) const
+{
+	int index = indexOfJob(a_jobID);
+	if(index < 0)
+		return JobProperties();
+	return m_tickets[index].pJob->properties();
+}
+
+// END OF
+//==============================================================================
+
 int JobsManager::createJob(const JobProperties & a_jobProperties)
 {
-	vsedit::Job * pJob = new vsedit::Job(a_jobProperties,  m_pSettingsManager,
-		m_pVSScriptLibrary, this);
+	vsedit::Job * pJob = newJob(a_jobProperties);
 	connectJob(pJob);
 	JobTicket ticket = {pJob, JobWantTo::Nothing};
 	m_tickets.push_back(ticket);
+	m_indexById[pJob->id()] = (int)m_tickets.size() - 1;
+	linkDependencies(pJob);
 	int newRow = (int)m_tickets.size();
-	saveJobs();
+	commitStoreRecord(m_jobsStore.putJob(pJob->properties()));
 	emit signalJobCreated(a_jobProperties);
 	return newRow;
 }
@@ -83,7 +167,9 @@ bool JobsManager::swapJobs(const QUuid & a_jobID1, const QUuid & a_jobID2)
 	}
 
 	std::swap(m_tickets[lowerIndex], m_tickets[higherIndex]);
-	saveJobs();
+	m_indexById[m_tickets[lowerIndex].pJob->id()] = lowerIndex;
+	m_indexById[m_tickets[higherIndex].pJob->id()] = higherIndex;
+	commitStoreRecord(m_jobsStore.swapJobs(a_jobID1, a_jobID2));
 	emit signalJobsSwapped(a_jobID1, a_jobID2);
 	return true;
 }
@@ -96,10 +182,8 @@ bool JobsManager::setJobState(const QUuid & a_jobID, JobState a_state)
 	int index = indexOfJob(a_jobID);
 	if(!checkCanModifyJobAndNotify(index))
 		return false;
-	bool result = m_tickets[index].pJob->setState(a_state);
-	if(result)
-		saveJobs();
-	return result;
+	// The change is stored when the job reports its new state.
+	return m_tickets[index].pJob->setState(a_state);
 }
 
 // END OF
@@ -119,11 +203,15 @@ bool JobsManager::setJobDependsOnIds(const QUuid & a_jobID,
 			return false;
 	}
 
-	bool result = m_tickets[index].pJob->setDependsOnJobIds(a_dependencies);
+	vsedit::Job * pJob = m_tickets[index].pJob;
+	unlinkDependencies(pJob);
+	bool result = pJob->setDependsOnJobIds(a_dependencies);
+	linkDependencies(pJob);
 	if(!result)
 		return false;
 
-	saveJobs();
+	commitStoreRecord(m_jobsStore.updateJobDependencies(a_jobID,
+		a_dependencies));
 	emit signalJobDependenciesChanged(a_jobID, a_dependencies);
 
 	return true;
@@ -138,10 +226,12 @@ bool JobsManager::changeJob(const JobProperties & a_jobProperties)
 	if(!checkCanModifyJobAndNotify(index))
 		return false;
 	vsedit::Job * pJob = m_tickets[index].pJob;
+	unlinkDependencies(pJob);
 	bool result = pJob->setProperties(a_jobProperties);
+	linkDependencies(pJob);
 	if(result)
 		result = pJob->setState(JobState::Waiting);
-	saveJobs();
+	commitStoreRecord(m_jobsStore.putJob(pJob->properties()));
 	emit signalJobChanged(pJob->properties());
 	return result;
 }
@@ -167,18 +257,73 @@ bool JobsManager::loadJobs()
 
 	clearJobs();
 
-	std::vector<JobProperties> jobPropertiesList =
-		m_pSettingsManager->getJobs();
+	// Jobs used to be kept in the settings file. The journal is created
+	// as their snapshot, so it never exists without them. An empty
+	// journal is left by older versions that could die before writing it.
+	std::vector<JobProperties> jobPropertiesList;
+	bool loaded = false;
+	bool migrated = false;
+	if(!m_jobsStore.isOpen())
+	{
+		QString journalFilePath = m_journalFilePath;
+		bool defaultJournal = journalFilePath.isEmpty();
+		if(defaultJournal)
+		{
+			journalFilePath = m_pSettingsManager->getSettingsFileDir() +
+				JOBS_JOURNAL_FILE_NAME;
+		}
+
+		QFileInfo journalInfo(journalFilePath);
+		if(defaultJournal && ((!journalInfo.exists()) ||
+			(journalInfo.size() == 0)))
+		{
+			jobPropertiesList = m_pSettingsManager->getJobs();
+			loaded = true;
+			migrated = m_jobsStore.create(journalFilePath,
+				jobPropertiesList);
+		}
+		else
+			m_jobsStore.open(journalFilePath);
+
+		if(!m_jobsStore.isOpen())
+		{
+			emit signalLogMessage(tr("Can not open jobs journal \"%1\". %2")
+				.arg(journalFilePath).arg(m_jobsStore.error()),
+				LOG_STYLE_ERROR);
+		}
+	}
+
+	if(!loaded)
+	{
+		jobPropertiesList = m_jobsStore.isOpen() ? m_jobsStore.load() :
+			m_pSettingsManager->getJobs();
+	}
+
+	bool aborted = false;
 	for(const JobProperties & properties : jobPropertiesList)
 	{
-		vsedit::Job * pJob = new vsedit::Job(properties, m_pSettingsManager,
-			m_pVSScriptLibrary);
+		vsedit::Job * pJob = newJob(properties);
 		if(vsedit::contains(ACTIVE_JOB_STATES, pJob->state()))
+		{
 			pJob->setState(JobState::Aborted);
+			aborted = true;
+		}
 		connectJob(pJob);
 		JobTicket ticket = {pJob, JobWantTo::Nothing};
 		m_tickets.push_back(ticket);
+		linkDependencies(pJob);
 	}
+	reindexJobs();
+
+	if(!m_jobsStore.isOpen())
+		return true;
+
+	// the snapshot is committed, the settings copy is not needed
+	if(migrated && (!jobPropertiesList.empty()))
+		m_pSettingsManager->setJobs(std::vector<JobProperties>());
+
+	if(aborted || m_jobsStore.needsCompaction(m_tickets.size()))
+		saveJobs();
 
 	return true;
 }
@@ -195,14 +340,17 @@ bool JobsManager::saveJobs()
 		return false;
 	}
 
-	std::vector<JobProperties> jobPropertiesList;
-	for(const JobTicket & ticket : m_tickets)
-		jobPropertiesList.push_back(ticket.pJob->properties());
+	std::vector<JobProperties> jobPropertiesList = jobsProperties();
 
-	bool result = m_pSettingsManager->setJobs(jobPropertiesList);
+	bool result = m_jobsStore.isOpen() ?
+		m_jobsStore.compact(jobPropertiesList) :
+		m_pSettingsManager->setJobs(jobPropertiesList);
 
 	if(!result)
-        emit signalLogMessage(tr("Failed to save jobs.", LOG_STYLE_ERROR));
+	{
+		emit signalLogMessage(tr("Failed to save jobs. %1")
+			.arg(m_jobsStore.error()), LOG_STYLE_ERROR);
+	}
 
 	return result;
 }
@@ -225,14 +373,36 @@ bool JobsManager::hasActiveJobs()
 
 void JobsManager::startWaitingJobs()
 {
+	m_runQueue = true;
 	startFirstReadyJob();
 }
 
 // END OF
 //==============================================================================
 
+bool JobsManager::startJob(const QUuid & a_jobID)
+{
+	int index = indexOfJob(a_jobID);
+	if(index < 0)
+		return false;
+
+	JobState validStates[] = {JobState::Waiting, JobState::Paused};
+	JobTicket & ticket = m_tickets[index];
+	if(ticket.pJob->isActive() ||
+		(!vsedit::contains(validStates, ticket.pJob->state())))
+		return false;
+
+	ticket.whenDone = JobWantTo::Nothing;
+	ticket.pJob->start();
+	return true;
+}
+
+// END OF
+//==============================================================================
+
 void JobsManager::abortActiveJobs()
 {
+	m_runQueue = false;
 	for(JobTicket & ticket : m_tickets)
 	{
 		if(!vsedit::contains(ACTIVE_JOB_STATES, ticket.pJob->state()))
@@ -245,8 +415,25 @@ void JobsManager::abortActiveJobs()
 // END OF
 //==============================================================================
 
+bool JobsManager::abortJob(const QUuid & a_jobID)
+{
+	int index = indexOfJob(a_jobID);
+	if(index < 0)
+		return false;
+	JobTicket & ticket = m_tickets[index];
+	if(!ticket.pJob->isActive())
+		return false;
+	ticket.whenDone = JobWantTo::Nothing;
+	ticket.pJob->abort();
+	return true;
+}
+
+// END OF
+//==============================================================================
+
 void JobsManager::pauseActiveJobs()
 {
+	m_runQueue = false;
 	for(JobTicket & ticket : m_tickets)
 	{
 		if(ticket.pJob->state() != JobState::Running)
@@ -283,6 +470,7 @@ void JobsManager::resetJobs(const std::vector<QUuid> & a_ids)
 void JobsManager::deleteJobs(const std::vector<QUuid> & a_ids)
 {
 	std::vector<QUuid> deletedJobs;
+	int firstDeletedIndex = (int)m_tickets.size();
 	for(const QUuid & id : a_ids)
 	{
 		int index = indexOfJob(id);
@@ -294,24 +482,34 @@ void JobsManager::deleteJobs(const std::vector<QUuid> & a_ids)
 		{
             emit signalLogMessage(tr("Can not delete an active job."),
 				LOG_STYLE_WARNING);
-			return;
+			break;
 		}
 
-		for(const JobTicket & ticket : m_tickets)
+		if(hasDependentJobs(id))
 		{
-			if(vsedit::contains(ticket.pJob->dependsOnJobIds(), pJob->id()))
-			{
-                emit signalLogMessage(tr("Can not delete a job while "
-					"other jobs depend on it."), LOG_STYLE_WARNING);
-				return;
-			}
+            emit signalLogMessage(tr("Can not delete a job while "
+				"other jobs depend on it."), LOG_STYLE_WARNING);
+			break;
 		}
 
+		// Tickets are compacted once after the loop.
+		unlinkDependencies(pJob);
+		m_dependentsById.remove(id);
+		m_indexById.remove(id);
 		delete pJob;
-		m_tickets.erase(m_tickets.begin() + index);
+		m_tickets[index].pJob = nullptr;
+		firstDeletedIndex = std::min(firstDeletedIndex, index);
 		deletedJobs.push_back(id);
+		commitStoreRecord(m_jobsStore.deleteJob(id));
 	}
-	saveJobs();
+
+	m_tickets.erase(std::remove_if(m_tickets.begin(), m_tickets.end(),
+		[](const JobTicket & a_ticket)->bool
+		{
+			return (a_ticket.pJob == nullptr);
+		}), m_tickets.end());
+	reindexJobs(firstDeletedIndex);
+
 	emit signalJobsDeleted(deletedJobs);
 }
 
@@ -350,6 +548,7 @@ void JobsManager::slotJobPropertiesChanged()
 	vsedit::Job * pJob = qobject_cast<vsedit::Job *>(sender());
 	if(!pJob)
 		return;
+	commitStoreRecord(m_jobsStore.updateJobState(pJob->properties()));
 	emit signalJobChanged(pJob->properties());
 }
 
@@ -365,7 +564,7 @@ void JobsManager::slotJobStateChanged(JobState a_newState, JobState a_oldState)
 	if(!pJob)
 		return;
 
-	saveJobs();
+	commitStoreRecord(m_jobsStore.updateJobState(pJob->properties()));
 	emit signalJobStateChanged(pJob->id(), a_newState);
 
 	if(vsedit::contains(ACTIVE_JOB_STATES, a_newState))
@@ -380,11 +579,19 @@ void JobsManager::slotJobStateChanged(JobState a_newState, JobState a_oldState)
 		return;
 
 	int jobIndex = indexOfJob(pJob->id());
+	bool runNext = (m_tickets[jobIndex].whenDone == JobWantTo::RunNext);
+	m_tickets[jobIndex].whenDone = JobWantTo::Nothing;
+	if(!runNext)
+		return;
 
-	if(m_tickets[jobIndex].whenDone == JobWantTo::RunNext)
-		startFirstReadyJob(jobIndex + 1);
+	// Only the dependents of this job can have become ready.
+	if(startReadyDependents(pJob->id()))
+		return;
 
-	m_tickets[jobIndex].whenDone = JobWantTo::Nothing;
+	// Workers report the freed slot right after the job update,
+	// which schedules the queue again.
+	if(!m_pWorkerPool)
+		startFirstReadyJob(jobIndex + 1);
 }
 
 // END OF
@@ -407,6 +614,7 @@ void JobsManager::slotJobStartTimeChanged()
 	vsedit::Job * pJob = qobject_cast<vsedit::Job *>(sender());
 	if(!pJob)
 		return;
+	commitStoreRecord(m_jobsStore.updateJobState(pJob->properties()));
 	emit signalJobStartTimeChanged(pJob->id(), pJob->properties().timeStarted);
 }
 
@@ -418,12 +626,174 @@ void JobsManager::slotJobEndTimeChanged()
 	vsedit::Job * pJob = qobject_cast<vsedit::Job *>(sender());
 	if(!pJob)
 		return;
+	commitStoreRecord(m_jobsStore.updateJobState(pJob->properties()));
 	emit signalJobEndTimeChanged(pJob->id(), pJob->properties().timeEnded);
 }
 
 // END OF
 //==============================================================================
 
+void JobsManager::slotJobEncoderStatusChanged()
+{
+	vsedit::Job * pJob = qobject_cast<vsedit::Job *>(sender());
+	if(!pJob)
+		return;
+	JobProperties properties = pJob->properties();
+	emit signalJobEncoderStatusChanged(pJob->id(), properties.encoderStatus,
+		properties.encoderFps, properties.encoderBitrate);
+}
+
+// END OF
+//==============================================================================
+
+void JobsManager::slotWorkerAvailable()
+{
+	if(m_runQueue)
+		startFirstReadyJob();
+}
+
+// END OF
+//==============================================================================
+
+void JobsManager::slotWorkerJobUpdated(const QUuid & a_jobID,
+	const QJsonObject & a_update)
+{
+	int index = indexOfJob(a_jobID);
+	if(index < 0)
+		return;
+	RemoteJob * pJob = qobject_cast<RemoteJob *>(m_tickets[index].pJob);
+	if(pJob)
+		pJob->applyWorkerUpdate(a_update);
+}
+
+// END OF
+//==============================================================================
+
+void JobsManager::slotWorkerJobsLost(const std::vector<QUuid> & a_ids)
+{
+	for(const QUuid & id : a_ids)
+	{
+		int index = indexOfJob(id);
+		if(index < 0)
+			continue;
+		RemoteJob * pJob = qobject_cast<RemoteJob *>(m_tickets[index].pJob);
+		if(!pJob)
+			continue;
+		m_tickets[index].whenDone = JobWantTo::Nothing;
+		pJob->requeue();
+	}
+
+	if(m_runQueue)
+		startFirstReadyJob();
+}
+
+// END OF
+//==============================================================================
+
+void JobsManager::slotSampleTelemetry()
+{
+	// Jobs dispatched to worker servers run elsewhere.
+	if(m_pWorkerPool)
+		return;
+
+	std::vector<vsedit::Job *> runningJobs;
+	for(const JobTicket & ticket : m_tickets)
+	{
+		if(ticket.pJob->state() == JobState::Running)
+			runningJobs.push_back(ticket.pJob);
+	}
+
+	if(runningJobs.empty())
+	{
+		m_lastServerUsage = ProcessUsage();
+		m_lastEncoderUsage.clear();
+		return;
+	}
+
+	qint64 now = m_telemetryClock.elapsed();
+	double seconds = double(now - m_lastTelemetryTime) / 1000.0;
+	m_lastTelemetryTime = now;
+
+	ProcessUsage serverUsage =
+		ProcessUsage::sample(QCoreApplication::applicationPid());
+	bool serverRates = serverUsage.valid && m_lastServerUsage.valid &&
+		(seconds > 0.0);
+
+	std::map<QUuid, ProcessUsage> encoderUsage;
+	qint64 sampleTime = QDateTime::currentMSecsSinceEpoch();
+
+	for(vsedit::Job * pJob : runningJobs)
+	{
+		JobTelemetrySample sample;
+		sample.time = sampleTime;
+
+		if(pJob->type() == JobType::EncodeScriptCLI)
+		{
+			sample.vsRss = serverUsage.residentMemory;
+			if(serverRates)
+			{
+				sample.vsCpu = (serverUsage.cpuTime -
+					m_lastServerUsage.cpuTime) * 100.0 / seconds;
+				sample.vsReadRate = double(serverUsage.bytesRead -
+					m_lastServerUsage.bytesRead) / seconds;
+				sample.vsWriteRate = double(serverUsage.bytesWritten -
+					m_lastServerUsage.bytesWritten) / seconds;
+			}
+
+			VSCoreInfo coreInfo;
+			if(pJob->coreInfo(&coreInfo))
+			{
+				sample.framebufferUsed = coreInfo.usedFramebufferSize;
+				sample.framebufferMax = coreInfo.maxFramebufferSize;
+			}
+			sample.framesInQueue = int(pJob->framesInQueue());
+			sample.framesInProcess = int(pJob->framesInProcess());
+		}
+
+		ProcessUsage usage = ProcessUsage::sample(pJob->encoderProcessId());
+		if(usage.valid)
+		{
+			sample.encoderRss = usage.residentMemory;
+			std::map<QUuid, ProcessUsage>::const_iterator it =
+				m_lastEncoderUsage.find(pJob->id());
+			if((it != m_lastEncoderUsage.end()) && (seconds > 0.0))
+			{
+				const ProcessUsage & last = it->second;
+				sample.encoderCpu =
+					(usage.cpuTime - last.cpuTime) * 100.0 / seconds;
+				sample.encoderReadRate =
+					double(usage.bytesRead - last.bytesRead) / seconds;
+				sample.encoderWriteRate =
+					double(usage.bytesWritten - last.bytesWritten) / seconds;
+			}
+			encoderUsage[pJob->id()] = usage;
+		}
+
+		emit signalJobTelemetry(pJob->id(), sample);
+	}
+
+	m_lastServerUsage = serverUsage;
+	m_lastEncoderUsage.swap(encoderUsage);
+}
+
+// END OF
+//==============================================================================
+
+vsedit::Job * JobsManager::newJob(const JobProperties & a_properties)
+{
+	if(m_pWorkerPool)
+	{
+		return new RemoteJob(a_properties, m_pWorkerPool, m_pSettingsManager,
+			m_pVSScriptLibrary, this);
+	}
+
+	return new vsedit::Job(a_properties, m_pSettingsManager,
+		m_pVSScriptLibrary, this);
+}
+
+// END OF
+//==============================================================================
+
 bool JobsManager::canModifyJob(int a_index) const
 {
 	if((a_index < 0) || ((size_t)a_index >= m_tickets.size()))
@@ -445,15 +815,54 @@ bool JobsManager::canModifyJob(int a_index) const
 
 int JobsManager::indexOfJob(const QUuid & a_uuid) const
 {
-	std::vector<JobTicket>::const_iterator it =
-		std::find_if(m_tickets.cbegin(), m_tickets.cend(),
-			[&](const JobTicket & a_ticket)->bool
-			{
-				return (a_ticket.pJob->id() == a_uuid);
-			});
+	return m_indexById.value(a_uuid, -1);
+}
+
+// END OF
+//==============================================================================
 
-	return (it == m_tickets.cend()) ?
-		-1 : std::distance(m_tickets.cbegin(), it);
+void JobsManager::reindexJobs(size_t a_fromIndex)
+{
+	for(size_t i = a_fromIndex; i < m_tickets.size(); ++i)
+		m_indexById[m_tickets[i].pJob->id()] = (int)i;
+}
+
+// END OF
+//==============================================================================
+
+void JobsManager::linkDependencies(const vsedit::Job * a_pJob)
+{
+	for(const QUuid & id : a_pJob->dependsOnJobIds())
+		m_dependentsById[id].push_back(a_pJob->id());
+}
+
+// END OF
+//==============================================================================
+
+void JobsManager::unlinkDependencies(const vsedit::Job * a_pJob)
+{
+	for(const QUuid & id : a_pJob->dependsOnJobIds())
+	{
+		QHash<QUuid, std::vector<QUuid> >::iterator it =
+			m_dependentsById.find(id);
+		if(it == m_dependentsById.end())
+			continue;
+		std::vector<QUuid> & dependents = it.value();
+		dependents.erase(std::remove(dependents.begin(), dependents.end(),
+			a_pJob->id()), dependents.end());
+		if(dependents.empty())
+			m_dependentsById.erase(it);
+	}
+}
+
+// END OF
+//==============================================================================
+
+bool JobsManager::hasDependentJobs(const QUuid & a_uuid) const
+{
+	QHash<QUuid, std::vector<QUuid> >::const_iterator it =
+		m_dependentsById.constFind(a_uuid);
+	return (it != m_dependentsById.constEnd()) && (!it.value().empty());
 }
 
 // END OF
@@ -464,6 +873,8 @@ void JobsManager::clearJobs()
 	for(JobTicket & ticket : m_tickets)
 		delete ticket.pJob;
 	m_tickets.clear();
+	m_indexById.clear();
+	m_dependentsById.clear();
 }
 
 // END OF
@@ -483,6 +894,28 @@ bool JobsManager::checkCanModifyJobAndNotify(int a_index)
 // END OF
 //==============================================================================
 
+bool JobsManager::commitStoreRecord(bool a_written)
+{
+	// Without a journal every change rewrites the whole job list.
+	if(!m_jobsStore.isOpen())
+		return saveJobs();
+
+	if(!a_written)
+	{
+		emit signalLogMessage(tr("Failed to write jobs journal. %1")
+			.arg(m_jobsStore.error()), LOG_STYLE_ERROR);
+		return false;
+	}
+
+	if(m_jobsStore.needsCompaction(m_tickets.size()))
+		return saveJobs();
+
+	return true;
+}
+
+// END OF
+//==============================================================================
+
 JobsManager::DependenciesState JobsManager::dependenciesState(int a_index)
 {
 	if((a_index < 0) || (a_index >= (int)m_tickets.size()))
@@ -516,6 +949,8 @@ JobsManager::DependenciesState JobsManager::dependenciesState(int a_index)
 
 void JobsManager::connectJob(vsedit::Job * a_pJob)
 {
+	a_pJob->setOutputParsingThread(m_pOutputParsingThread);
+
 	connect(a_pJob, SIGNAL(signalPropertiesChanged()),
 		this, SLOT(slotJobPropertiesChanged()));
 	connect(a_pJob, SIGNAL(signalStateChanged(JobState, JobState)),
@@ -526,6 +961,8 @@ void JobsManager::connectJob(vsedit::Job * a_pJob)
 		this, SLOT(slotJobStartTimeChanged()));
 	connect(a_pJob, SIGNAL(signalEndTimeChanged()),
 		this, SLOT(slotJobEndTimeChanged()));
+	connect(a_pJob, SIGNAL(signalEncoderStatusChanged()),
+		this, SLOT(slotJobEncoderStatusChanged()));
 	connect(a_pJob, SIGNAL(signalLogMessage(const QString &, const QString &)),
 		this, SLOT(slotLogMessage(const QString &, const QString &)));
 }
@@ -533,6 +970,63 @@ void JobsManager::connectJob(vsedit::Job * a_pJob)
 // END OF
 //==============================================================================
 
+bool JobsManager::startReadyDependents(const QUuid & a_jobID)
+{
+	JobState validStates[] = {JobState::Waiting, JobState::Paused};
+	bool started = false;
+
+	std::vector<QUuid> pendingIds(1, a_jobID);
+	while(!pendingIds.empty())
+	{
+		QUuid id = pendingIds.back();
+		pendingIds.pop_back();
+
+		// Copied. Failed dependents change state below.
+		std::vector<QUuid> dependentIds = m_dependentsById.value(id);
+		for(const QUuid & dependentId : dependentIds)
+		{
+			int index = indexOfJob(dependentId);
+			if(index < 0)
+				continue;
+			vsedit::Job * pDependentJob = m_tickets[index].pJob;
+			if(pDependentJob->isActive() ||
+				(!vsedit::contains(validStates, pDependentJob->state())))
+				continue;
+
+			DependenciesState jobDependenciesState = dependenciesState(index);
+			if(jobDependenciesState == DependenciesState::Failed)
+			{
+				pDependentJob->setState(JobState::DependencyNotMet);
+				// Nothing that waits for it can run either.
+				pendingIds.push_back(dependentId);
+				continue;
+			}
+			if(jobDependenciesState != DependenciesState::Complete)
+				continue;
+
+			// Without workers one job runs at a time.
+			if(started && (!m_pWorkerPool))
+				continue;
+
+			m_tickets[index].whenDone = JobWantTo::RunNext;
+			pDependentJob->start();
+			if((!m_pWorkerPool) || pDependentJob->isActive())
+			{
+				started = true;
+				continue;
+			}
+			// Not dispatched. All workers are busy.
+			m_tickets[index].whenDone = JobWantTo::Nothing;
+			return started;
+		}
+	}
+
+	return started;
+}
+
+// END OF
+//==============================================================================
+
 void JobsManager::startFirstReadyJob(int a_fromIndex)
 {
 	if((a_fromIndex < 0) || (a_fromIndex >= (int)m_tickets.size()))
@@ -545,17 +1039,29 @@ void JobsManager::startFirstReadyJob(int a_fromIndex)
 		int nextIndex = i % m_tickets.size();
 		vsedit::Job * pNextJob = m_tickets[nextIndex].pJob;
 		if(pNextJob->isActive())
+		{
+			// Workers run dispatched jobs side by side.
+			if(m_pWorkerPool)
+				continue;
 			return;
+		}
 		if(!vsedit::contains(validStates, pNextJob->state()))
 			continue;
-		DependenciesState jobDependenciesState = dependenciesState(i);
+		DependenciesState jobDependenciesState = dependenciesState(nextIndex);
 		if(jobDependenciesState == DependenciesState::Failed)
 			pNextJob->setState(JobState::DependencyNotMet);
 		if(jobDependenciesState != DependenciesState::Complete)
 			continue;
 		m_tickets[nextIndex].whenDone = JobWantTo::RunNext;
 		pNextJob->start();
-		return;
+		if(!m_pWorkerPool)
+			return;
+		// Not dispatched. All workers are busy.
+		if(!pNextJob->isActive())
+		{
+			m_tickets[nextIndex].whenDone = JobWantTo::Nothing;
+			return;
+		}
 	}
 }
 
@@ -3,13 +3,22 @@
 
 #include "../../../common-src/jobs/job.h"
 #include "job_definitions.h"
+#include "jobs_store.h"
+#include "process_usage.h"
+#include "../../../common-src/jobs/job_telemetry.h"
 #include "../../../common-src/log/vs_editor_log_definitions.h"
 
 #include <QObject>
+#include <QHash>
+#include <QElapsedTimer>
 #include <vector>
+#include <map>
 
 class SettingsManagerCore;
 class VSScriptLibrary;
+class WorkerPool;
+class QThread;
+class QTimer;
 
 class JobsManager : public QObject
 {
@@ -21,8 +30,15 @@ public:
 		QObject * a_pParent = nullptr);
 	virtual ~JobsManager();
 
+	void setJournalFilePath(const QString & a_filePath);
+
+	void setWorkerPool(WorkerPool * a_pWorkerPool);
+
 	std::vector<JobProperties> jobsProperties() const;
 
+	bool hasJob(const QUuid & a_jobID) const;
+	JobProperties jobProperties(const QUuid & a_jobID) const;
+
 	int createJob(const JobProperties & a_jobProperties = JobProperties());
 
 	bool swapJobs(const QUuid & a_jobID1, const QUuid & a_jobID2);
@@ -38,7 +54,10 @@ public:
 	bool hasActiveJobs();
 
 	void startWaitingJobs();
+	// Starts one job without running the rest of the queue.
+	bool startJob(const QUuid & a_jobID);
 	void abortActiveJobs();
+	bool abortJob(const QUuid & a_jobID);
 	void pauseActiveJobs();
 	void resumePausedJobs();
 	void resetJobs(const std::vector<QUuid> & a_ids);
@@ -57,10 +76,14 @@ signals:
 		const QDateTime & a_time);
 	void signalJobEndTimeChanged(const QUuid & a_jobID,
 		const QDateTime & a_time);
+	void signalJobEncoderStatusChanged(const QUuid & a_jobID,
+		const QString & a_status, double a_fps, double a_bitrate);
 	void signalJobDependenciesChanged(const QUuid & a_jobID,
 		const std::vector<QUuid> & a_dependencies);
 	void signalJobsSwapped(const QUuid & a_jobID1, const QUuid & a_jobID2);
 	void signalJobsDeleted(const std::vector<QUuid> & a_ids);
+	void signalJobTelemetry(const QUuid & a_jobID,
+		const JobTelemetrySample & a_sample);
 
 private slots:
 
@@ -73,6 +96,14 @@ private slots:
 	void slotJobProgressChanged();
 	void slotJobStartTimeChanged();
 	void slotJobEndTimeChanged();
+	void slotJobEncoderStatusChanged();
+
+	void slotWorkerAvailable();
+	void slotWorkerJobUpdated(const QUuid & a_jobID,
+		const QJsonObject & a_update);
+	void slotWorkerJobsLost(const std::vector<QUuid> & a_ids);
+
+	void slotSampleTelemetry();
 
 private:
 
@@ -83,24 +114,66 @@ private:
 		Failed,
 	};
 
+	vsedit::Job * newJob(const JobProperties & a_properties);
+
 	bool canModifyJob(int a_index) const;
 
 	int indexOfJob(const QUuid & a_uuid) const;
 
+	void reindexJobs(size_t a_fromIndex = 0);
+
+	void linkDependencies(const vsedit::Job * a_pJob);
+
+	void unlinkDependencies(const vsedit::Job * a_pJob);
+
+	bool hasDependentJobs(const QUuid & a_uuid) const;
+
 	void clearJobs();
 
 	bool checkCanModifyJobAndNotify(int a_index);
 
+	bool commitStoreRecord(bool a_written);
+
 	DependenciesState dependenciesState(int a_index);
 
 	void connectJob(vsedit::Job * a_pJob);
 
+	// Starts the dependents a finished job has made ready and marks
+	// those it has made impossible. Returns if any was started.
+	bool startReadyDependents(const QUuid & a_jobID);
+
 	void startFirstReadyJob(int a_fromIndex = 0);
 
 	std::vector<JobTicket> m_tickets;
 
+	// Position of each job in m_tickets.
+	QHash<QUuid, int> m_indexById;
+
+	// Jobs that depend on each job.
+	QHash<QUuid, std::vector<QUuid> > m_dependentsById;
+
+	JobsStore m_jobsStore;
+	QString m_journalFilePath;
+
 	SettingsManagerCore * m_pSettingsManager;
 	VSScriptLibrary * m_pVSScriptLibrary;
+
+	// Set in coordinator mode. Jobs are then dispatched to worker servers
+	// and several of them may run at once.
+	WorkerPool * m_pWorkerPool;
+
+	// The queue has been started and waits for free workers.
+	bool m_runQueue;
+
+	QThread * m_pOutputParsingThread;
+
+	// Counters of the previous telemetry sample to compute rates from.
+	// VapourSynth runs in this process, so its usage is the server's one.
+	QTimer * m_pTelemetryTimer;
+	QElapsedTimer m_telemetryClock;
+	qint64 m_lastTelemetryTime;
+	ProcessUsage m_lastServerUsage;
+	std::map<QUuid, ProcessUsage> m_lastEncoderUsage;
 };
 
 #endif // JOBS_MANAGER_H_INCLUDED
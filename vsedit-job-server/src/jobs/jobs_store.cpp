@@ -0,0 +1,368 @@
+#include "jobs_store.h"
+
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <map>
+#include <algorithm>
+
+//==============================================================================
+
+namespace
+{
+
+const char OPERATION_KEY[] = "op";
+const char ID_KEY[] = "id";
+const char IDS_KEY[] = "ids";
+const char JOB_KEY[] = "job";
+
+const char OPERATION_PUT[] = "put";
+const char OPERATION_UPDATE[] = "update";
+const char OPERATION_SWAP[] = "swap";
+const char OPERATION_DELETE[] = "delete";
+
+// Keys that change while a job runs. Written without the script text.
+const char * const STATE_KEYS[] = {JP_JOB_STATE, JP_TIME_STARTED,
+	JP_TIME_ENDED, JP_FIRST_FRAME_REAL, JP_LAST_FRAME_REAL,
+	JP_FRAMES_PROCESSED, JP_FPS};
+
+const size_t COMPACTION_MIN_RECORDS = 1000;
+const size_t COMPACTION_RECORDS_PER_JOB = 8;
+
+QJsonObject putRecord(const JobProperties & a_properties)
+{
+	QJsonObject record;
+	record[OPERATION_KEY] = OPERATION_PUT;
+	record[JOB_KEY] = a_properties.toJson();
+	return record;
+}
+
+QByteArray recordLine(const QJsonObject & a_record)
+{
+	return QJsonDocument(a_record).toJson(QJsonDocument::Compact) + '\n';
+}
+
+}
+
+//==============================================================================
+
+JobsStore::JobsStore() :
+	  m_records(0)
+{
+}
+
+// END OF JobsStore::JobsStore()
+//==============================================================================
+
+JobsStore::~JobsStore()
+{
+	close();
+}
+
+// END OF JobsStore::~JobsStore()
+//==============================================================================
+
+bool JobsStore::open(const QString & a_filePath)
+{
+	close();
+	m_file.setFileName(a_filePath);
+	bool result = m_file.open(QIODevice::WriteOnly | QIODevice::Append);
+	if(!result)
+		m_error = m_file.errorString();
+	return result;
+}
+
+// END OF bool JobsStore::open(const QString & a_filePath)
+//==============================================================================
+
+bool JobsStore::create(const QString & a_filePath,
+	const std::vector<JobProperties> & a_jobs)
+{
+	close();
+	if(!writeSnapshot(a_filePath, a_jobs))
+		return false;
+	if(!open(a_filePath))
+		return false;
+	m_records = a_jobs.size();
+	return true;
+}
+
+// END OF bool JobsStore::create(const QString & a_filePath,
+//		const std::vector<JobProperties> & a_jobs)
+//==============================================================================
+
+void JobsStore::close()
+{
+	if(m_file.isOpen())
+		m_file.close();
+}
+
+// END OF void JobsStore::close()
+//==============================================================================
+
+bool JobsStore::isOpen() const
+{
+	return m_file.isOpen();
+}
+
+// END OF bool JobsStore::isOpen() const
+//==============================================================================
+
+QString JobsStore::error() const
+{
+	return m_error;
+}
+
+// END OF QString JobsStore::error() const
+//==============================================================================
+
+std::vector<JobProperties> JobsStore::load()
+{
+	std::vector<JobProperties> jobs;
+	m_records = 0;
+
+	QFile file(m_file.fileName());
+	if(!file.exists())
+		return jobs;
+	if(!file.open(QIODevice::ReadOnly))
+	{
+		m_error = file.errorString();
+		return jobs;
+	}
+
+	std::vector<QUuid> order;
+	std::map<QUuid, QJsonObject> objects;
+
+	// end of the last record written with its line break
+	qint64 completeSize = 0;
+
+	while(!file.atEnd())
+	{
+		QByteArray line = file.readLine();
+		// Only the last record can be torn by a crash. Skip it.
+		if(!line.endsWith('\n'))
+			break;
+		completeSize = file.pos();
+
+		line = line.trimmed();
+		if(line.isEmpty())
+			continue;
+
+		QJsonParseError parseError;
+		QJsonDocument document = QJsonDocument::fromJson(line, &parseError);
+		if((parseError.error != QJsonParseError::NoError) ||
+			(!document.isObject()))
+			continue;
+
+		m_records++;
+		QJsonObject record = document.object();
+		QString operation = record[OPERATION_KEY].toString();
+
+		if(operation == OPERATION_PUT)
+		{
+			QJsonObject jsJob = record[JOB_KEY].toObject();
+			QUuid id(jsJob[JP_ID].toString());
+			if(id.isNull())
+				continue;
+			if(objects.find(id) == objects.end())
+				order.push_back(id);
+			objects[id] = jsJob;
+		}
+		else if(operation == OPERATION_UPDATE)
+		{
+			std::map<QUuid, QJsonObject>::iterator it =
+				objects.find(QUuid(record[ID_KEY].toString()));
+			if(it == objects.end())
+				continue;
+			QJsonObject fields = record[JOB_KEY].toObject();
+			for(QJsonObject::const_iterator field = fields.constBegin();
+				field != fields.constEnd(); ++field)
+				it->second[field.key()] = field.value();
+		}
+		else if(operation == OPERATION_SWAP)
+		{
+			QJsonArray jsIds = record[IDS_KEY].toArray();
+			if(jsIds.size() != 2)
+				continue;
+			std::vector<QUuid>::iterator first = std::find(order.begin(),
+				order.end(), QUuid(jsIds[0].toString()));
+			std::vector<QUuid>::iterator second = std::find(order.begin(),
+				order.end(), QUuid(jsIds[1].toString()));
+			if((first == order.end()) || (second == order.end()))
+				continue;
+			std::iter_swap(first, second);
+		}
+		else if(operation == OPERATION_DELETE)
+		{
+			QUuid id(record[ID_KEY].toString());
+			if(objects.erase(id) == 0)
+				continue;
+			order.erase(std::remove(order.begin(), order.end(), id),
+				order.end());
+		}
+	}
+
+	// A torn tail would swallow the next appended record.
+	qint64 fileSize = file.size();
+	file.close();
+	if(completeSize < fileSize)
+	{
+		bool truncated = m_file.isOpen() ? m_file.resize(completeSize) :
+			QFile::resize(m_file.fileName(), completeSize);
+		if(!truncated)
+			m_error = m_file.errorString();
+	}
+
+	jobs.reserve(order.size());
+	for(const QUuid & id : order)
+		jobs.push_back(JobProperties::fromJson(objects[id]));
+
+	return jobs;
+}
+
+// END OF std::vector<JobProperties> JobsStore::load()
+//==============================================================================
+
+bool JobsStore::putJob(const JobProperties & a_properties)
+{
+	return appendRecord(putRecord(a_properties));
+}
+
+// END OF bool JobsStore::putJob(const JobProperties & a_properties)
+//==============================================================================
+
+bool JobsStore::updateJobState(const JobProperties & a_properties)
+{
+	QJsonObject jsJob = a_properties.toJson();
+	QJsonObject fields;
+	for(const char * cpKey : STATE_KEYS)
+		fields[cpKey] = jsJob[cpKey];
+
+	QJsonObject record;
+	record[OPERATION_KEY] = OPERATION_UPDATE;
+	record[ID_KEY] = a_properties.id.toString();
+	record[JOB_KEY] = fields;
+	return appendRecord(record);
+}
+
+// END OF bool JobsStore::updateJobState(const JobProperties & a_properties)
+//==============================================================================
+
+bool JobsStore::updateJobDependencies(const QUuid & a_id,
+	const std::vector<QUuid> & a_dependencies)
+{
+	QJsonArray jsDependencies;
+	for(const QUuid & dependencyId : a_dependencies)
+		jsDependencies.push_back(QJsonValue(dependencyId.toString()));
+	QJsonObject fields;
+	fields[JP_DEPENDS_ON_JOB_IDS] = jsDependencies;
+
+	QJsonObject record;
+	record[OPERATION_KEY] = OPERATION_UPDATE;
+	record[ID_KEY] = a_id.toString();
+	record[JOB_KEY] = fields;
+	return appendRecord(record);
+}
+
+// END OF bool JobsStore::updateJobDependencies(const QUuid & a_id,
+//		const std::vector<QUuid> & a_dependencies)
+//==============================================================================
+
+bool JobsStore::swapJobs(const QUuid & a_id1, const QUuid & a_id2)
+{
+	QJsonArray jsIds;
+	jsIds.push_back(QJsonValue(a_id1.toString()));
+	jsIds.push_back(QJsonValue(a_id2.toString()));
+
+	QJsonObject record;
+	record[OPERATION_KEY] = OPERATION_SWAP;
+	record[IDS_KEY] = jsIds;
+	return appendRecord(record);
+}
+
+// END OF bool JobsStore::swapJobs(const QUuid & a_id1, const QUuid & a_id2)
+//==============================================================================
+
+bool JobsStore::deleteJob(const QUuid & a_id)
+{
+	QJsonObject record;
+	record[OPERATION_KEY] = OPERATION_DELETE;
+	record[ID_KEY] = a_id.toString();
+	return appendRecord(record);
+}
+
+// END OF bool JobsStore::deleteJob(const QUuid & a_id)
+//==============================================================================
+
+bool JobsStore::needsCompaction(size_t a_jobsNumber) const
+{
+	return (m_records > COMPACTION_MIN_RECORDS) &&
+		(m_records > a_jobsNumber * COMPACTION_RECORDS_PER_JOB);
+}
+
+// END OF bool JobsStore::needsCompaction(size_t a_jobsNumber) const
+//==============================================================================
+
+bool JobsStore::compact(const std::vector<JobProperties> & a_jobs)
+{
+	QString filePath = m_file.fileName();
+	if(filePath.isEmpty())
+		return false;
+
+	// The journal must not be held open while it is replaced.
+	close();
+	bool result = writeSnapshot(filePath, a_jobs);
+
+	size_t records = result ? a_jobs.size() : m_records;
+	if(!open(filePath))
+		return false;
+	m_records = records;
+
+	return result;
+}
+
+// END OF bool JobsStore::compact(const std::vector<JobProperties> & a_jobs)
+//==============================================================================
+
+bool JobsStore::appendRecord(const QJsonObject & a_record)
+{
+	if(!m_file.isOpen())
+		return false;
+
+	QByteArray line = recordLine(a_record);
+	bool result = (m_file.write(line) == line.size()) && m_file.flush();
+	if(!result)
+	{
+		m_error = m_file.errorString();
+		return false;
+	}
+
+	m_records++;
+	return true;
+}
+
+// END OF bool JobsStore::appendRecord(const QJsonObject & a_record)
+//==============================================================================
+
+bool JobsStore::writeSnapshot(const QString & a_filePath,
+	const std::vector<JobProperties> & a_jobs)
+{
+	QSaveFile snapshot(a_filePath);
+	if(!snapshot.open(QIODevice::WriteOnly))
+	{
+		m_error = snapshot.errorString();
+		return false;
+	}
+
+	for(const JobProperties & properties : a_jobs)
+		snapshot.write(recordLine(putRecord(properties)));
+
+	bool result = snapshot.commit();
+	if(!result)
+		m_error = snapshot.errorString();
+	return result;
+}
+
+// END OF bool JobsStore::writeSnapshot(const QString & a_filePath,
+//		const std::vector<JobProperties> & a_jobs)
+//==============================================================================
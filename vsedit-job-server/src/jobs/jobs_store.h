@@ -0,0 +1,57 @@
+#ifndef JOBS_STORE_H_INCLUDED
+#define JOBS_STORE_H_INCLUDED
+
+#include "../../../common-src/settings/settings_definitions_core.h"
+
+#include <QString>
+#include <QFile>
+#include <QJsonObject>
+#include <vector>
+
+/// Append-only journal of the job queue.
+/// Every change is written as one JSON line, so saving costs only
+/// the size of the change and an interrupted write can only lose
+/// the last record. The journal is periodically compacted into
+/// a snapshot that is atomically swapped in.
+class JobsStore
+{
+public:
+
+	JobsStore();
+	virtual ~JobsStore();
+
+	bool open(const QString & a_filePath);
+	// Writes the jobs as the initial snapshot and opens it. The file
+	// is not created unless the snapshot is complete.
+	bool create(const QString & a_filePath,
+		const std::vector<JobProperties> & a_jobs);
+	void close();
+	bool isOpen() const;
+
+	QString error() const;
+
+	std::vector<JobProperties> load();
+
+	bool putJob(const JobProperties & a_properties);
+	bool updateJobState(const JobProperties & a_properties);
+	bool updateJobDependencies(const QUuid & a_id,
+		const std::vector<QUuid> & a_dependencies);
+	bool swapJobs(const QUuid & a_id1, const QUuid & a_id2);
+	bool deleteJob(const QUuid & a_id);
+
+	bool needsCompaction(size_t a_jobsNumber) const;
+	bool compact(const std::vector<JobProperties> & a_jobs);
+
+private:
+
+	bool appendRecord(const QJsonObject & a_record);
+
+	bool writeSnapshot(const QString & a_filePath,
+		const std::vector<JobProperties> & a_jobs);
+
+	QFile m_file;
+	size_t m_records;
+	QString m_error;
+};
+
+#endif // JOBS_STORE_H_INCLUDED
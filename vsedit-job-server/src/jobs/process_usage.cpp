@@ -0,0 +1,118 @@
+#include "process_usage.h"
+
+#ifdef Q_OS_WIN
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+	#include <psapi.h>
+#elif defined(Q_OS_LINUX)
+	#include <QFile>
+	#include <QByteArray>
+	#include <QList>
+	#include <unistd.h>
+#endif
+
+//==============================================================================
+
+ProcessUsage::ProcessUsage() :
+	  valid(false)
+	, cpuTime(0.0)
+	, residentMemory(0)
+	, bytesRead(0)
+	, bytesWritten(0)
+{
+}
+
+// END OF ProcessUsage::ProcessUsage()
+//==============================================================================
+
+ProcessUsage ProcessUsage::sample(qint64 a_processId)
+{
+	ProcessUsage usage;
+	if(a_processId <= 0)
+		return usage;
+
+#ifdef Q_OS_WIN
+	HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE,
+		DWORD(a_processId));
+	if(!hProcess)
+		return usage;
+
+	FILETIME creationTime;
+	FILETIME exitTime;
+	FILETIME kernelTime;
+	FILETIME userTime;
+	if(GetProcessTimes(hProcess, &creationTime, &exitTime, &kernelTime,
+		&userTime))
+	{
+		ULARGE_INTEGER kernel;
+		kernel.LowPart = kernelTime.dwLowDateTime;
+		kernel.HighPart = kernelTime.dwHighDateTime;
+		ULARGE_INTEGER user;
+		user.LowPart = userTime.dwLowDateTime;
+		user.HighPart = userTime.dwHighDateTime;
+		// 100 ns units.
+		usage.cpuTime = double(kernel.QuadPart + user.QuadPart) / 1.0e7;
+		usage.valid = true;
+	}
+
+	PROCESS_MEMORY_COUNTERS memoryCounters;
+	if(K32GetProcessMemoryInfo(hProcess, &memoryCounters,
+		sizeof(memoryCounters)))
+		usage.residentMemory = qint64(memoryCounters.WorkingSetSize);
+
+	IO_COUNTERS ioCounters;
+	if(GetProcessIoCounters(hProcess, &ioCounters))
+	{
+		usage.bytesRead = qint64(ioCounters.ReadTransferCount);
+		usage.bytesWritten = qint64(ioCounters.WriteTransferCount);
+	}
+
+	CloseHandle(hProcess);
+#elif defined(Q_OS_LINUX)
+	QString procPath = QString("/proc/%1/").arg(a_processId);
+
+	QFile statFile(procPath + "stat");
+	if(!statFile.open(QIODevice::ReadOnly))
+		return usage;
+	QByteArray stat = statFile.readAll();
+	statFile.close();
+
+	// The command name may contain spaces. Fields are counted after it.
+	int nameEnd = stat.lastIndexOf(')');
+	if(nameEnd < 0)
+		return usage;
+	QList<QByteArray> fields = stat.mid(nameEnd + 2).split(' ');
+	if(fields.size() < 22)
+		return usage;
+
+	long ticksPerSecond = sysconf(_SC_CLK_TCK);
+	long pageSize = sysconf(_SC_PAGESIZE);
+	if((ticksPerSecond <= 0) || (pageSize <= 0))
+		return usage;
+
+	// utime, stime and rss are fields 14, 15 and 24 of proc(5).
+	usage.cpuTime = double(fields[11].toLongLong() + fields[12].toLongLong()) /
+		double(ticksPerSecond);
+	usage.residentMemory = fields[21].toLongLong() * pageSize;
+	usage.valid = true;
+
+	// Only readable for processes of the same user.
+	QFile ioFile(procPath + "io");
+	if(!ioFile.open(QIODevice::ReadOnly))
+		return usage;
+	for(const QByteArray & line : ioFile.readAll().split('\n'))
+	{
+		if(line.startsWith("read_bytes:"))
+			usage.bytesRead = line.mid(11).trimmed().toLongLong();
+		else if(line.startsWith("write_bytes:"))
+			usage.bytesWritten = line.mid(12).trimmed().toLongLong();
+	}
+#endif
+
+	return usage;
+}
+
+// END OF ProcessUsage ProcessUsage::sample(qint64 a_processId)
+//==============================================================================
@@ -0,0 +1,23 @@
+#ifndef PROCESS_USAGE_H_INCLUDED
+#define PROCESS_USAGE_H_INCLUDED
+
+#include <QtGlobal>
+
+/// Cumulative resource counters of a process as reported by the OS.
+struct ProcessUsage
+{
+	bool valid;
+
+	// Seconds of user and system time.
+	double cpuTime;
+
+	qint64 residentMemory;
+	qint64 bytesRead;
+	qint64 bytesWritten;
+
+	ProcessUsage();
+
+	static ProcessUsage sample(qint64 a_processId);
+};
+
+#endif // PROCESS_USAGE_H_INCLUDED
@@ -0,0 +1,172 @@
+#include "server_log.h"
+
+#include <QJsonDocument>
+#include <algorithm>
+
+//==============================================================================
+
+ServerLog::ServerLog(size_t a_capacity, const QString & a_spillFilePath) :
+	  m_capacity(std::max<size_t>(a_capacity, 1))
+	, m_head(0)
+	, m_totalEntries(0)
+{
+	m_entries.reserve(m_capacity);
+	setSpillFilePath(a_spillFilePath);
+}
+
+// END OF ServerLog::ServerLog(size_t a_capacity,
+//		const QString & a_spillFilePath)
+//==============================================================================
+
+ServerLog::~ServerLog()
+{
+	if(m_spillFile.isOpen())
+		m_spillFile.close();
+}
+
+// END OF ServerLog::~ServerLog()
+//==============================================================================
+
+void ServerLog::append(const LogEntry & a_entry)
+{
+	m_totalEntries++;
+
+	if(m_entries.size() < m_capacity)
+	{
+		m_entries.push_back(a_entry);
+		return;
+	}
+
+	spill(m_entries[m_head]);
+	m_entries[m_head] = a_entry;
+	m_head = (m_head + 1) % m_capacity;
+}
+
+// END OF void ServerLog::append(const LogEntry & a_entry)
+//==============================================================================
+
+size_t ServerLog::capacity() const
+{
+	return m_capacity;
+}
+
+// END OF size_t ServerLog::capacity() const
+//==============================================================================
+
+void ServerLog::setCapacity(size_t a_capacity)
+{
+	a_capacity = std::max<size_t>(a_capacity, 1);
+	if(a_capacity == m_capacity)
+		return;
+
+	std::vector<LogEntry> ordered;
+	ordered.reserve(a_capacity);
+	size_t first = firstIndex();
+	size_t dropCount = (m_entries.size() > a_capacity) ?
+		m_entries.size() - a_capacity : 0;
+	for(size_t i = 0; i < dropCount; ++i)
+		spill(at(first + i));
+	for(size_t i = dropCount; i < m_entries.size(); ++i)
+		ordered.push_back(at(first + i));
+
+	m_entries.swap(ordered);
+	m_capacity = a_capacity;
+	m_head = 0;
+}
+
+// END OF void ServerLog::setCapacity(size_t a_capacity)
+//==============================================================================
+
+QString ServerLog::spillFilePath() const
+{
+	return m_spillFile.fileName();
+}
+
+// END OF QString ServerLog::spillFilePath() const
+//==============================================================================
+
+bool ServerLog::setSpillFilePath(const QString & a_path)
+{
+	if(m_spillFile.isOpen())
+		m_spillFile.close();
+	m_spillFile.setFileName(a_path);
+	if(a_path.isEmpty())
+		return true;
+	return m_spillFile.open(QIODevice::WriteOnly | QIODevice::Append |
+		QIODevice::Text);
+}
+
+// END OF bool ServerLog::setSpillFilePath(const QString & a_path)
+//==============================================================================
+
+size_t ServerLog::size() const
+{
+	return m_entries.size();
+}
+
+// END OF size_t ServerLog::size() const
+//==============================================================================
+
+size_t ServerLog::firstIndex() const
+{
+	return m_totalEntries - m_entries.size();
+}
+
+// END OF size_t ServerLog::firstIndex() const
+//==============================================================================
+
+size_t ServerLog::totalEntries() const
+{
+	return m_totalEntries;
+}
+
+// END OF size_t ServerLog::totalEntries() const
+//==============================================================================
+
+std::vector<LogEntry> ServerLog::entries(size_t a_first, size_t a_count) const
+{
+	std::vector<LogEntry> result;
+	size_t first = std::max(a_first, firstIndex());
+	if(first >= m_totalEntries)
+		return result;
+	size_t last = first + std::min(a_count, m_totalEntries - first);
+	result.reserve(last - first);
+	for(size_t i = first; i < last; ++i)
+		result.push_back(at(i));
+	return result;
+}
+
+// END OF std::vector<LogEntry> ServerLog::entries(size_t a_first,
+//		size_t a_count) const
+//==============================================================================
+
+std::vector<LogEntry> ServerLog::tail(size_t a_count) const
+{
+	size_t count = std::min(a_count, m_entries.size());
+	return entries(m_totalEntries - count, count);
+}
+
+// END OF std::vector<LogEntry> ServerLog::tail(size_t a_count) const
+//==============================================================================
+
+const LogEntry & ServerLog::at(size_t a_index) const
+{
+	Q_ASSERT((a_index >= firstIndex()) && (a_index < m_totalEntries));
+	size_t position = (m_head + a_index - firstIndex()) % m_entries.size();
+	return m_entries[position];
+}
+
+// END OF const LogEntry & ServerLog::at(size_t a_index) const
+//==============================================================================
+
+void ServerLog::spill(const LogEntry & a_entry)
+{
+	if(!m_spillFile.isOpen())
+		return;
+	m_spillFile.write(QJsonDocument(a_entry.toJson()).toJson(
+		QJsonDocument::Compact));
+	m_spillFile.write("\n");
+}
+
+// END OF void ServerLog::spill(const LogEntry & a_entry)
+//==============================================================================
@@ -0,0 +1,57 @@
+#ifndef SERVER_LOG_H_INCLUDED
+#define SERVER_LOG_H_INCLUDED
+
+#include "../../../common-src/log/styled_log_view_core.h"
+
+#include <QString>
+#include <QFile>
+#include <vector>
+
+/// Fixed capacity ring buffer of log entries.
+/// Entries are addressed by their absolute index since the server start.
+/// Entries pushed out of the ring are optionally appended
+/// to a spill file as JSON lines.
+class ServerLog
+{
+public:
+
+	ServerLog(size_t a_capacity, const QString & a_spillFilePath = QString());
+	virtual ~ServerLog();
+
+	void append(const LogEntry & a_entry);
+
+	size_t capacity() const;
+	void setCapacity(size_t a_capacity);
+
+	QString spillFilePath() const;
+	bool setSpillFilePath(const QString & a_path);
+
+	size_t size() const;
+
+	/// Absolute index of the oldest entry still held in memory.
+	size_t firstIndex() const;
+
+	/// Number of entries ever appended.
+	size_t totalEntries() const;
+
+	/// Entries in the range [a_first, a_first + a_count) that are still
+	/// held in memory. a_first is clamped to firstIndex().
+	std::vector<LogEntry> entries(size_t a_first, size_t a_count) const;
+
+	std::vector<LogEntry> tail(size_t a_count) const;
+
+private:
+
+	const LogEntry & at(size_t a_index) const;
+
+	void spill(const LogEntry & a_entry);
+
+	std::vector<LogEntry> m_entries;
+	size_t m_capacity;
+	size_t m_head;
+	size_t m_totalEntries;
+
+	QFile m_spillFile;
+};
+
+#endif // SERVER_LOG_H_INCLUDED
@@ -5,6 +5,7 @@
 #include <vapoursynth/VapourSynth.h>
 
 #include <QCoreApplication>
+#include <QCommandLineParser>
 
 Q_DECLARE_OPAQUE_POINTER(const VSFrameRef *)
 Q_DECLARE_OPAQUE_POINTER(VSNodeRef *)
@@ -16,7 +17,49 @@ int main(int argc, char *argv[])
 	qRegisterMetaType<const VSFrameRef *>("const VSFrameRef *");
 	qRegisterMetaType<VSNodeRef *>("VSNodeRef *");
 
-	ApplicationInstanceFileGuard guard("vsedit_job_server_running");
+	QCommandLineParser parser;
+	parser.addHelpOption();
+	QCommandLineOption portOption("port",
+		"Listen on <port> instead of the default one.", "port");
+	QCommandLineOption instanceOption("instance",
+		"Run as a separate instance with its own job queue.", "name");
+	QCommandLineOption coordinatorOption("coordinator",
+		"Dispatch jobs to registered worker servers.");
+	QCommandLineOption workerOption("worker-of",
+		"Run jobs dispatched by the coordinator at <host:port>.",
+		"host:port");
+	parser.addOption(portOption);
+	parser.addOption(instanceOption);
+	parser.addOption(coordinatorOption);
+	parser.addOption(workerOption);
+	parser.process(application);
+
+	JobServerOptions options;
+	if(parser.isSet(portOption))
+	{
+		bool validPort = false;
+		options.port = parser.value(portOption).toUShort(&validPort);
+		if(!validPort)
+		{
+			qCritical("Invalid port number.");
+			return 1;
+		}
+	}
+	options.instanceName = parser.value(instanceOption);
+	options.coordinator = parser.isSet(coordinatorOption);
+	if(parser.isSet(workerOption))
+	{
+		options.coordinatorUrl = QUrl(QString("ws://%1")
+			.arg(parser.value(workerOption)));
+		if(options.coordinatorUrl.port() < 0)
+			options.coordinatorUrl.setPort(JOB_SERVER_PORT);
+	}
+
+	QString guardName = "vsedit_job_server_running";
+	if(!options.instanceName.isEmpty())
+		guardName += "_" + options.instanceName;
+
+	ApplicationInstanceFileGuard guard(guardName);
 	if(!guard.isLocked())
 	{
 		qCritical("Couldn't start the server. "
@@ -24,7 +67,7 @@ int main(int argc, char *argv[])
 		return 1;
 	}
 
-	JobServer jobServer;
+	JobServer jobServer(options);
 
 	application.connect(&jobServer, &JobServer::finish,
 		&application, &QCoreApplication::quit);
@@ -6,7 +6,6 @@
 #include <QFileInfo>
 #include <QFileDialog>
 #include <QMessageBox>
-#include <QTimer>
 
 BookmarkManagerDialog::BookmarkManagerDialog(SettingsManager * a_pSettingsManager,
                                              QWidget * a_pParent) :
@@ -39,11 +38,6 @@ BookmarkManagerDialog::BookmarkManagerDialog(SettingsManager * a_pSettingsManage
 
 BookmarkManagerDialog::~BookmarkManagerDialog()
 {
-    if(m_pGeometrySaveTimer->isActive())
-    {
-        m_pGeometrySaveTimer->stop();
-        slotSaveGeometry();
-    }
 }
 
 void BookmarkManagerDialog::moveEvent(QMoveEvent *a_pEvent)
@@ -61,11 +55,6 @@ void BookmarkManagerDialog::hideEvent(QHideEvent *a_pEvent)
 
 void BookmarkManagerDialog::setWindowGeometry()
 {
-    m_pGeometrySaveTimer = new QTimer(this);
-    m_pGeometrySaveTimer->setInterval(DEFAULT_WINDOW_GEOMETRY_SAVE_DELAY);
-    connect(m_pGeometrySaveTimer, &QTimer::timeout,
-        this, &BookmarkManagerDialog::slotSaveGeometry);
-
     m_windowGeometry = m_pSettingsManager->getBookmarkManagerDialogGeometry();
     if(!m_windowGeometry.isEmpty())
         restoreGeometry(m_windowGeometry);
@@ -76,8 +65,9 @@ void BookmarkManagerDialog::saveGeometryDelayed()
     QApplication::processEvents();
     if(!isMaximized())
     {
+        // the settings manager coalesces the writes of a drag
         m_windowGeometry = saveGeometry();
-        m_pGeometrySaveTimer->start();
+        m_pSettingsManager->setBookmarkManagerDialogGeometry(m_windowGeometry);
     }
 }
 
@@ -301,9 +291,3 @@ void BookmarkManagerDialog::slotCloseDialog()
 {
     this->hide();
 }
-
-void BookmarkManagerDialog::slotSaveGeometry()
-{
-    m_pGeometrySaveTimer->stop();
-    m_pSettingsManager->setBookmarkManagerDialogGeometry(m_windowGeometry);
-}
@@ -67,7 +67,6 @@ protected:
     void setWindowGeometry();
     void saveGeometryDelayed();
 
-    QTimer * m_pGeometrySaveTimer;
     QByteArray m_windowGeometry;
 
 public slots:
@@ -87,10 +86,6 @@ private slots:
     void slotGotoBookmarkFromIndex(const QModelIndex &a_index);
     void slotCloseDialog();
 
-protected slots:
-
-    void slotSaveGeometry();
-
 };
 
 #endif // BOOKMARK_MANAGER_DIALOG_H
@@ -0,0 +1,511 @@
+#include "clip_metrics.h"
+
+#include <vapoursynth/VapourSynth.h>
+
+#include <QObject>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+	(defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	#define CLIP_METRICS_SSE2
+	#include <emmintrin.h>
+#endif
+
+const double MAX_PSNR = 100.0;
+
+namespace
+{
+
+// SSIM constants for samples normalized to 0..1
+const double SSIM_C1 = 0.01 * 0.01;
+const double SSIM_C2 = 0.03 * 0.03;
+
+// SSIM window is 8x8, made of 2x2 blocks of 4x4 samples
+// that overlap by one block
+const int SSIM_BLOCK = 4;
+
+const int MS_SSIM_SCALES = 5;
+const double MS_SSIM_WEIGHTS[MS_SSIM_SCALES] =
+	{0.0448, 0.2856, 0.3001, 0.2363, 0.1333};
+
+struct PlaneSamples
+{
+	int bytesPerSample;
+	bool isFloat;
+	float scale;
+};
+
+struct FloatPlane
+{
+	int width;
+	int height;
+	std::vector<float> samples;
+
+	FloatPlane(): width(0), height(0) {}
+	FloatPlane(int a_width, int a_height):
+		width(a_width), height(a_height),
+		samples(size_t(a_width) * size_t(a_height)) {}
+
+	float * row(int a_y) {return samples.data() + size_t(a_y) * width;}
+	const float * row(int a_y) const
+		{return samples.data() + size_t(a_y) * width;}
+};
+
+struct SsimTerms
+{
+	bool valid;
+	double ssim;
+	double contrastStructure;
+};
+
+//==============================================================================
+
+// Converts one row of native samples to floats in 0..1.
+void rowToFloat(const uint8_t * a_pSource, int a_width,
+	const PlaneSamples & a_samples, float * a_pTarget)
+{
+	if(a_samples.isFloat)
+	{
+		memcpy(a_pTarget, a_pSource, size_t(a_width) * sizeof(float));
+		return;
+	}
+
+	int x = 0;
+
+	if(a_samples.bytesPerSample == 1)
+	{
+#ifdef CLIP_METRICS_SSE2
+		__m128i zero = _mm_setzero_si128();
+		__m128 scale = _mm_set1_ps(a_samples.scale);
+		for(; x + 16 <= a_width; x += 16)
+		{
+			__m128i bytes = _mm_loadu_si128(
+				reinterpret_cast<const __m128i *>(a_pSource + x));
+			__m128i words[2] = {_mm_unpacklo_epi8(bytes, zero),
+				_mm_unpackhi_epi8(bytes, zero)};
+			for(int i = 0; i < 2; ++i)
+			{
+				__m128 low = _mm_cvtepi32_ps(
+					_mm_unpacklo_epi16(words[i], zero));
+				__m128 high = _mm_cvtepi32_ps(
+					_mm_unpackhi_epi16(words[i], zero));
+				_mm_storeu_ps(a_pTarget + x + i * 8,
+					_mm_mul_ps(low, scale));
+				_mm_storeu_ps(a_pTarget + x + i * 8 + 4,
+					_mm_mul_ps(high, scale));
+			}
+		}
+#endif
+		for(; x < a_width; ++x)
+			a_pTarget[x] = float(a_pSource[x]) * a_samples.scale;
+		return;
+	}
+
+	const uint16_t * pSource = reinterpret_cast<const uint16_t *>(a_pSource);
+#ifdef CLIP_METRICS_SSE2
+	__m128i zero = _mm_setzero_si128();
+	__m128 scale = _mm_set1_ps(a_samples.scale);
+	for(; x + 8 <= a_width; x += 8)
+	{
+		__m128i words = _mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(pSource + x));
+		__m128 low = _mm_cvtepi32_ps(_mm_unpacklo_epi16(words, zero));
+		__m128 high = _mm_cvtepi32_ps(_mm_unpackhi_epi16(words, zero));
+		_mm_storeu_ps(a_pTarget + x, _mm_mul_ps(low, scale));
+		_mm_storeu_ps(a_pTarget + x + 4, _mm_mul_ps(high, scale));
+	}
+#endif
+	for(; x < a_width; ++x)
+		a_pTarget[x] = float(pSource[x]) * a_samples.scale;
+}
+
+// END OF void rowToFloat(const uint8_t * a_pSource, int a_width,
+//		const PlaneSamples & a_samples, float * a_pTarget)
+//==============================================================================
+
+#ifdef CLIP_METRICS_SSE2
+inline float horizontalSum(__m128 a_vector)
+{
+	__m128 pairs = _mm_add_ps(a_vector,
+		_mm_shuffle_ps(a_vector, a_vector, _MM_SHUFFLE(1, 0, 3, 2)));
+	__m128 sum = _mm_add_ss(pairs,
+		_mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtss_f32(sum);
+}
+#endif
+
+//==============================================================================
+
+double squaredErrorSum(const float * a_pA, const float * a_pB, int a_width)
+{
+	int x = 0;
+	double sum = 0.0;
+
+#ifdef CLIP_METRICS_SSE2
+	__m128 accumulator = _mm_setzero_ps();
+	for(; x + 4 <= a_width; x += 4)
+	{
+		__m128 difference = _mm_sub_ps(_mm_loadu_ps(a_pA + x),
+			_mm_loadu_ps(a_pB + x));
+		accumulator = _mm_add_ps(accumulator,
+			_mm_mul_ps(difference, difference));
+	}
+	sum = horizontalSum(accumulator);
+#endif
+
+	for(; x < a_width; ++x)
+	{
+		double difference = double(a_pA[x]) - double(a_pB[x]);
+		sum += difference * difference;
+	}
+
+	return sum;
+}
+
+// END OF double squaredErrorSum(const float * a_pA, const float * a_pB,
+//		int a_width)
+//==============================================================================
+
+// Writes sums of a, b, a*a, b*b and a*b over a 4x4 block.
+void blockSums(const float * a_pA, const float * a_pB, int a_stride,
+	float * a_pSums)
+{
+#ifdef CLIP_METRICS_SSE2
+	__m128 sumA = _mm_setzero_ps();
+	__m128 sumB = _mm_setzero_ps();
+	__m128 sumAA = _mm_setzero_ps();
+	__m128 sumBB = _mm_setzero_ps();
+	__m128 sumAB = _mm_setzero_ps();
+	for(int y = 0; y < SSIM_BLOCK; ++y)
+	{
+		__m128 a = _mm_loadu_ps(a_pA + y * a_stride);
+		__m128 b = _mm_loadu_ps(a_pB + y * a_stride);
+		sumA = _mm_add_ps(sumA, a);
+		sumB = _mm_add_ps(sumB, b);
+		sumAA = _mm_add_ps(sumAA, _mm_mul_ps(a, a));
+		sumBB = _mm_add_ps(sumBB, _mm_mul_ps(b, b));
+		sumAB = _mm_add_ps(sumAB, _mm_mul_ps(a, b));
+	}
+
+	// four horizontal sums at once
+	_MM_TRANSPOSE4_PS(sumA, sumB, sumAA, sumBB);
+	__m128 sums = _mm_add_ps(_mm_add_ps(sumA, sumB),
+		_mm_add_ps(sumAA, sumBB));
+	_mm_storeu_ps(a_pSums, sums);
+	a_pSums[4] = horizontalSum(sumAB);
+#else
+	std::fill(a_pSums, a_pSums + 5, 0.0f);
+	for(int y = 0; y < SSIM_BLOCK; ++y)
+	{
+		for(int x = 0; x < SSIM_BLOCK; ++x)
+		{
+			float a = a_pA[y * a_stride + x];
+			float b = a_pB[y * a_stride + x];
+			a_pSums[0] += a;
+			a_pSums[1] += b;
+			a_pSums[2] += a * a;
+			a_pSums[3] += b * b;
+			a_pSums[4] += a * b;
+		}
+	}
+#endif
+}
+
+// END OF void blockSums(const float * a_pA, const float * a_pB, int a_stride,
+//		float * a_pSums)
+//==============================================================================
+
+SsimTerms ssimTerms(const FloatPlane & a_a, const FloatPlane & a_b)
+{
+	SsimTerms terms = {false, 0.0, 0.0};
+
+	int blocksX = a_a.width / SSIM_BLOCK;
+	int blocksY = a_a.height / SSIM_BLOCK;
+	if((blocksX < 2) || (blocksY < 2))
+		return terms;
+
+	std::vector<float> sums(size_t(blocksX) * size_t(blocksY) * 5);
+	for(int by = 0; by < blocksY; ++by)
+	{
+		const float * pA = a_a.row(by * SSIM_BLOCK);
+		const float * pB = a_b.row(by * SSIM_BLOCK);
+		float * pSums = sums.data() + size_t(by) * blocksX * 5;
+		for(int bx = 0; bx < blocksX; ++bx)
+		{
+			blockSums(pA + bx * SSIM_BLOCK, pB + bx * SSIM_BLOCK, a_a.width,
+				pSums + bx * 5);
+		}
+	}
+
+	const double windowSamples = double(SSIM_BLOCK * SSIM_BLOCK * 4);
+	double ssimSum = 0.0;
+	double csSum = 0.0;
+	for(int wy = 0; wy < blocksY - 1; ++wy)
+	{
+		const float * pTop = sums.data() + size_t(wy) * blocksX * 5;
+		const float * pBottom = pTop + blocksX * 5;
+		for(int wx = 0; wx < blocksX - 1; ++wx)
+		{
+			double s[5];
+			for(int i = 0; i < 5; ++i)
+			{
+				s[i] = double(pTop[wx * 5 + i]) + pTop[wx * 5 + 5 + i] +
+					pBottom[wx * 5 + i] + pBottom[wx * 5 + 5 + i];
+			}
+
+			double meanA = s[0] / windowSamples;
+			double meanB = s[1] / windowSamples;
+			double varianceA = s[2] / windowSamples - meanA * meanA;
+			double varianceB = s[3] / windowSamples - meanB * meanB;
+			double covariance = s[4] / windowSamples - meanA * meanB;
+
+			double luminance = (2.0 * meanA * meanB + SSIM_C1) /
+				(meanA * meanA + meanB * meanB + SSIM_C1);
+			double contrastStructure = (2.0 * covariance + SSIM_C2) /
+				(varianceA + varianceB + SSIM_C2);
+			ssimSum += luminance * contrastStructure;
+			csSum += contrastStructure;
+		}
+	}
+
+	double windows = double(blocksX - 1) * double(blocksY - 1);
+	terms.valid = true;
+	terms.ssim = ssimSum / windows;
+	terms.contrastStructure = csSum / windows;
+	return terms;
+}
+
+// END OF SsimTerms ssimTerms(const FloatPlane & a_a, const FloatPlane & a_b)
+//==============================================================================
+
+// Halves the plane with a 2x2 box filter.
+FloatPlane downsample(const FloatPlane & a_plane)
+{
+	FloatPlane half(a_plane.width / 2, a_plane.height / 2);
+
+	for(int y = 0; y < half.height; ++y)
+	{
+		const float * pTop = a_plane.row(y * 2);
+		const float * pBottom = a_plane.row(y * 2 + 1);
+		float * pTarget = half.row(y);
+		int x = 0;
+#ifdef CLIP_METRICS_SSE2
+		__m128 quarter = _mm_set1_ps(0.25f);
+		for(; x + 4 <= half.width; x += 4)
+		{
+			__m128 low = _mm_add_ps(_mm_loadu_ps(pTop + x * 2),
+				_mm_loadu_ps(pBottom + x * 2));
+			__m128 high = _mm_add_ps(_mm_loadu_ps(pTop + x * 2 + 4),
+				_mm_loadu_ps(pBottom + x * 2 + 4));
+			__m128 even = _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+			__m128 odd = _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+			_mm_storeu_ps(pTarget + x,
+				_mm_mul_ps(_mm_add_ps(even, odd), quarter));
+		}
+#endif
+		for(; x < half.width; ++x)
+		{
+			pTarget[x] = (pTop[x * 2] + pTop[x * 2 + 1] +
+				pBottom[x * 2] + pBottom[x * 2 + 1]) * 0.25f;
+		}
+	}
+
+	return half;
+}
+
+// END OF FloatPlane downsample(const FloatPlane & a_plane)
+//==============================================================================
+
+double psnrFromError(double a_squaredErrorSum, double a_samples)
+{
+	if(a_samples <= 0.0)
+		return 0.0;
+	double meanSquaredError = a_squaredErrorSum / a_samples;
+	if(meanSquaredError <= 0.0)
+		return MAX_PSNR;
+	return std::min(-10.0 * std::log10(meanSquaredError), MAX_PSNR);
+}
+
+// END OF double psnrFromError(double a_squaredErrorSum, double a_samples)
+//==============================================================================
+
+}
+
+//==============================================================================
+
+FrameMetrics::FrameMetrics():
+	  frameNumber(-1)
+	, planes(0)
+	, psnr{0.0, 0.0, 0.0}
+	, psnrAverage(0.0)
+	, ssim(-1.0)
+	, msSsim(-1.0)
+{
+}
+
+// END OF FrameMetrics::FrameMetrics()
+//==============================================================================
+
+bool FrameMetrics::isValid() const
+{
+	return (frameNumber >= 0) && (planes > 0) && error.isEmpty();
+}
+
+// END OF bool FrameMetrics::isValid() const
+//==============================================================================
+
+FrameMetrics FrameMetrics::compute(const VSAPI * a_cpVSAPI,
+	const VSFrameRef * a_cpReferenceFrameRef,
+	const VSFrameRef * a_cpDistortedFrameRef, int a_frameNumber,
+	bool a_msSsim)
+{
+	FrameMetrics metrics;
+	metrics.frameNumber = a_frameNumber;
+
+	Q_ASSERT(a_cpVSAPI);
+	Q_ASSERT(a_cpReferenceFrameRef);
+	Q_ASSERT(a_cpDistortedFrameRef);
+
+	// the clips come from different cores, formats match by id
+	const VSFormat * cpFormat = a_cpVSAPI->getFrameFormat(a_cpReferenceFrameRef);
+	const VSFormat * cpDistortedFormat =
+		a_cpVSAPI->getFrameFormat(a_cpDistortedFrameRef);
+	if((!cpFormat) || (!cpDistortedFormat) ||
+		(cpFormat->id != cpDistortedFormat->id))
+	{
+		metrics.error = QObject::tr("Frame formats differ.");
+		return metrics;
+	}
+
+	if((cpFormat->colorFamily == cmCompat) ||
+		((cpFormat->sampleType == stFloat) && (cpFormat->bytesPerSample != 4)))
+	{
+		metrics.error = QObject::tr("Format %1 can not be measured.")
+			.arg(cpFormat->name);
+		return metrics;
+	}
+
+	PlaneSamples samples;
+	samples.bytesPerSample = cpFormat->bytesPerSample;
+	samples.isFloat = (cpFormat->sampleType == stFloat);
+	samples.scale = samples.isFloat ? 1.0f :
+		1.0f / float((1 << cpFormat->bitsPerSample) - 1);
+
+	metrics.planes = std::min(cpFormat->numPlanes, 3);
+	double totalError = 0.0;
+	double totalSamples = 0.0;
+	FloatPlane reference;
+	FloatPlane distorted;
+
+	for(int plane = 0; plane < metrics.planes; ++plane)
+	{
+		int width = a_cpVSAPI->getFrameWidth(a_cpReferenceFrameRef, plane);
+		int height = a_cpVSAPI->getFrameHeight(a_cpReferenceFrameRef, plane);
+		if((width != a_cpVSAPI->getFrameWidth(a_cpDistortedFrameRef, plane)) ||
+			(height != a_cpVSAPI->getFrameHeight(a_cpDistortedFrameRef, plane)))
+		{
+			metrics.error = QObject::tr("Frame sizes differ.");
+			return metrics;
+		}
+
+		const uint8_t * pReference =
+			a_cpVSAPI->getReadPtr(a_cpReferenceFrameRef, plane);
+		const uint8_t * pDistorted =
+			a_cpVSAPI->getReadPtr(a_cpDistortedFrameRef, plane);
+		int referenceStride =
+			a_cpVSAPI->getStride(a_cpReferenceFrameRef, plane);
+		int distortedStride =
+			a_cpVSAPI->getStride(a_cpDistortedFrameRef, plane);
+
+		// the first plane is kept whole for SSIM,
+		// the others only need a row at a time
+		int rows = (plane == 0) ? height : 1;
+		FloatPlane referenceRows(width, rows);
+		FloatPlane distortedRows(width, rows);
+
+		double planeError = 0.0;
+		for(int y = 0; y < height; ++y)
+		{
+			float * pReferenceRow = referenceRows.row((plane == 0) ? y : 0);
+			float * pDistortedRow = distortedRows.row((plane == 0) ? y : 0);
+			rowToFloat(pReference + y * referenceStride, width, samples,
+				pReferenceRow);
+			rowToFloat(pDistorted + y * distortedStride, width, samples,
+				pDistortedRow);
+			planeError += squaredErrorSum(pReferenceRow, pDistortedRow, width);
+		}
+
+		double planeSamples = double(width) * double(height);
+		metrics.psnr[plane] = psnrFromError(planeError, planeSamples);
+		totalError += planeError;
+		totalSamples += planeSamples;
+
+		if(plane == 0)
+		{
+			reference = std::move(referenceRows);
+			distorted = std::move(distortedRows);
+		}
+	}
+
+	metrics.psnrAverage = psnrFromError(totalError, totalSamples);
+
+	SsimTerms terms = ssimTerms(reference, distorted);
+	if(!terms.valid)
+		return metrics;
+	metrics.ssim = terms.ssim;
+
+	if(!a_msSsim)
+		return metrics;
+
+	// Product of contrast-structure terms of the finer scales and full SSIM
+	// of the coarsest one. Weights of scales that do not fit the frame
+	// are left out and the rest renormalized.
+	double logSum = 0.0;
+	double weightSum = 0.0;
+	for(int scale = 0; scale < MS_SSIM_SCALES; ++scale)
+	{
+		bool last = (scale == MS_SSIM_SCALES - 1) ||
+			(reference.width / 2 < SSIM_BLOCK * 2) ||
+			(reference.height / 2 < SSIM_BLOCK * 2);
+		double value = last ? terms.ssim : terms.contrastStructure;
+		value = std::max(value, 1e-10);
+		logSum += MS_SSIM_WEIGHTS[scale] * std::log(value);
+		weightSum += MS_SSIM_WEIGHTS[scale];
+		if(last)
+			break;
+
+		reference = downsample(reference);
+		distorted = downsample(distorted);
+		terms = ssimTerms(reference, distorted);
+		Q_ASSERT(terms.valid);
+	}
+
+	metrics.msSsim = std::exp(logSum / weightSum);
+	return metrics;
+}
+
+// END OF FrameMetrics FrameMetrics::compute(const VSAPI * a_cpVSAPI,
+//		const VSFrameRef * a_cpReferenceFrameRef,
+//		const VSFrameRef * a_cpDistortedFrameRef, int a_frameNumber,
+//		bool a_msSsim)
+//==============================================================================
+
+QStringList FrameMetrics::planeNames(const VSFormat * a_cpFormat)
+{
+	if(!a_cpFormat)
+		return QStringList();
+	if(a_cpFormat->colorFamily == cmGray)
+		return {"Y"};
+	if(a_cpFormat->colorFamily == cmRGB)
+		return {"R", "G", "B"};
+	if(a_cpFormat->colorFamily == cmYCoCg)
+		return {"Y", "Co", "Cg"};
+	return {"Y", "U", "V"};
+}
+
+// END OF QStringList FrameMetrics::planeNames(const VSFormat * a_cpFormat)
+//==============================================================================
@@ -0,0 +1,47 @@
+#ifndef CLIP_METRICS_H_INCLUDED
+#define CLIP_METRICS_H_INCLUDED
+
+#include <QMetaType>
+#include <QString>
+#include <QStringList>
+
+struct VSAPI;
+struct VSFrameRef;
+struct VSFormat;
+
+extern const double MAX_PSNR;
+
+/// Objective difference between the same frame of two clips.
+/// Samples are compared at their own bit depth, normalized to 0..1.
+struct FrameMetrics
+{
+	int frameNumber;
+
+	int planes;
+	// dB per plane and from the mean squared error of all samples,
+	// identical planes are capped at MAX_PSNR
+	double psnr[3];
+	double psnrAverage;
+
+	// measured on the first plane, negative when not measured
+	double ssim;
+	double msSsim;
+
+	// empty when the frames could be compared
+	QString error;
+
+	FrameMetrics();
+
+	bool isValid() const;
+
+	static FrameMetrics compute(const VSAPI * a_cpVSAPI,
+		const VSFrameRef * a_cpReferenceFrameRef,
+		const VSFrameRef * a_cpDistortedFrameRef, int a_frameNumber,
+		bool a_msSsim);
+
+	static QStringList planeNames(const VSFormat * a_cpFormat);
+};
+
+Q_DECLARE_METATYPE(FrameMetrics)
+
+#endif // CLIP_METRICS_H_INCLUDED
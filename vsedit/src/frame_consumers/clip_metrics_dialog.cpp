@@ -0,0 +1,900 @@
+#include "clip_metrics_dialog.h"
+
+#include "../../../common-src/helpers.h"
+#include "../../../common-src/vapoursynth/vapoursynth_script_processor.h"
+
+#include <vapoursynth/VapourSynth.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+#include <algorithm>
+
+// frame pairs requested and not measured yet, bounds the frames held
+const int MAX_FRAME_PAIRS_IN_FLIGHT = 8;
+// metrics threads, the clips need the rest of the cores to render
+const int MAX_METRICS_THREADS = 4;
+
+const int CURVES_UPDATE_INTERVAL = 500;
+
+// ranges mapped to the height of the timeline curves
+const double CURVE_PSNR_LOW = 20.0;
+const double CURVE_PSNR_HIGH = 60.0;
+const double CURVE_SSIM_LOW = 0.8;
+
+const char PSNR_CURVE_COLOR[] = "#1f5fd7";
+const char SSIM_CURVE_COLOR[] = "#e07b00";
+const char MS_SSIM_CURVE_COLOR[] = "#8e2bb5";
+
+namespace
+{
+
+// Measures a frame pair and frees it. The result is queued back
+// to the dialog thread.
+class FrameMetricsTask : public QRunnable
+{
+public:
+
+	FrameMetricsTask(QObject * a_pReceiver, const VSAPI * a_cpVSAPI,
+		const VSFrameRef * a_cpReferenceFrameRef,
+		const VSFrameRef * a_cpDistortedFrameRef, int a_frameNumber,
+		bool a_msSsim, int a_generation):
+		  m_pReceiver(a_pReceiver)
+		, m_cpVSAPI(a_cpVSAPI)
+		, m_cpReferenceFrameRef(a_cpReferenceFrameRef)
+		, m_cpDistortedFrameRef(a_cpDistortedFrameRef)
+		, m_frameNumber(a_frameNumber)
+		, m_msSsim(a_msSsim)
+		, m_generation(a_generation)
+	{
+	}
+
+	virtual void run() override
+	{
+		FrameMetrics metrics = FrameMetrics::compute(m_cpVSAPI,
+			m_cpReferenceFrameRef, m_cpDistortedFrameRef, m_frameNumber,
+			m_msSsim);
+		m_cpVSAPI->freeFrame(m_cpReferenceFrameRef);
+		m_cpVSAPI->freeFrame(m_cpDistortedFrameRef);
+		QMetaObject::invokeMethod(m_pReceiver, "slotFrameMetricsReady",
+			Qt::QueuedConnection, Q_ARG(FrameMetrics, metrics),
+			Q_ARG(int, m_generation));
+	}
+
+private:
+
+	QObject * m_pReceiver;
+	const VSAPI * m_cpVSAPI;
+	const VSFrameRef * m_cpReferenceFrameRef;
+	const VSFrameRef * m_cpDistortedFrameRef;
+	int m_frameNumber;
+	bool m_msSsim;
+	int m_generation;
+};
+
+float curveValue(double a_value, double a_low, double a_high)
+{
+	return float(std::max(0.0, std::min(1.0,
+		(a_value - a_low) / (a_high - a_low))));
+}
+
+}
+
+//==============================================================================
+
+ClipMetricsDialog::MetricsSummary::MetricsSummary():
+	  measured(0)
+	, ssimMeasured(0)
+	, msSsimMeasured(0)
+	, psnrSum(0.0)
+	, ssimSum(0.0)
+	, msSsimSum(0.0)
+	, worstPsnrFrame(-1)
+	, worstSsimFrame(-1)
+	, worstPsnr(0.0)
+	, worstSsim(0.0)
+{
+}
+
+// END OF ClipMetricsDialog::MetricsSummary::MetricsSummary()
+//==============================================================================
+
+void ClipMetricsDialog::MetricsSummary::add(const FrameMetrics & a_metrics)
+{
+	measured++;
+	psnrSum += a_metrics.psnrAverage;
+	if((worstPsnrFrame < 0) || (a_metrics.psnrAverage < worstPsnr))
+	{
+		worstPsnrFrame = a_metrics.frameNumber;
+		worstPsnr = a_metrics.psnrAverage;
+	}
+
+	if(a_metrics.ssim >= 0.0)
+	{
+		ssimMeasured++;
+		ssimSum += a_metrics.ssim;
+		if((worstSsimFrame < 0) || (a_metrics.ssim < worstSsim))
+		{
+			worstSsimFrame = a_metrics.frameNumber;
+			worstSsim = a_metrics.ssim;
+		}
+	}
+
+	if(a_metrics.msSsim >= 0.0)
+	{
+		msSsimMeasured++;
+		msSsimSum += a_metrics.msSsim;
+	}
+}
+
+// END OF void ClipMetricsDialog::MetricsSummary::add(
+//		const FrameMetrics & a_metrics)
+//==============================================================================
+
+ClipMetricsDialog::ClipMetricsDialog(SettingsManager * a_pSettingsManager,
+	VSScriptLibrary * a_pVSScriptLibrary, QWidget * a_pParent):
+	VSScriptProcessorDialog(a_pSettingsManager, a_pVSScriptLibrary, a_pParent,
+		Qt::WindowFlags()
+		| Qt::Window
+		| Qt::CustomizeWindowHint
+		| Qt::WindowMinimizeButtonHint
+		| Qt::WindowCloseButtonHint
+		)
+	, m_pDistortedProcessor(nullptr)
+	, m_pThreadPool(nullptr)
+	, m_pCurvesTimer(nullptr)
+	, m_processing(false)
+	, m_msSsim(false)
+	, m_generation(0)
+	, m_firstFrame(0)
+	, m_lastFrame(-1)
+	, m_nextFrame(0)
+	, m_framesDone(0)
+	, m_framesFailed(0)
+	, m_pairsLimit(2)
+{
+	m_ui.setupUi(this);
+	setWindowIcon(QIcon(":benchmark.png"));
+
+	createStatusBar();
+
+	m_ui.feedbackTextEdit->setName("clip_metrics_log");
+	m_ui.feedbackTextEdit->setSettingsManager(m_pSettingsManager);
+	m_ui.feedbackTextEdit->loadSettings();
+
+	m_ui.legendLabel->setText(tr("Timeline: "
+		"<span style=\"color:%1\">PSNR %2-%3 dB</span>, "
+		"<span style=\"color:%4\">SSIM</span> and "
+		"<span style=\"color:%5\">MS-SSIM</span> %6-1")
+		.arg(PSNR_CURVE_COLOR).arg(CURVE_PSNR_LOW).arg(CURVE_PSNR_HIGH)
+		.arg(SSIM_CURVE_COLOR).arg(MS_SSIM_CURVE_COLOR).arg(CURVE_SSIM_LOW));
+	m_ui.exportButton->setEnabled(false);
+
+	// Both clips are batch consumers, they may keep every core busy.
+	m_pVapourSynthScriptProcessor->setFrameRequestsLimit(0);
+
+	m_pDistortedProcessor = new VapourSynthScriptProcessor(
+		m_pSettingsManager, m_pVSScriptLibrary, this);
+	m_pDistortedProcessor->setFrameRequestsLimit(0);
+
+	m_pThreadPool = new QThreadPool(this);
+	m_pThreadPool->setMaxThreadCount(std::max(1,
+		std::min(QThread::idealThreadCount() / 2, MAX_METRICS_THREADS)));
+
+	m_pCurvesTimer = new QTimer(this);
+	m_pCurvesTimer->setInterval(CURVES_UPDATE_INTERVAL);
+	m_pCurvesTimer->setSingleShot(true);
+
+	connect(m_pDistortedProcessor,
+		SIGNAL(signalWriteLogMessage(int, const QString &)),
+		this, SLOT(slotWriteLogMessage(int, const QString &)));
+	connect(m_pDistortedProcessor,
+		SIGNAL(signalDistributeFrame(int, int, const VSFrameRef *,
+			const VSFrameRef *)),
+		this, SLOT(slotReceiveDistortedFrame(int, int, const VSFrameRef *,
+			const VSFrameRef *)));
+	connect(m_pDistortedProcessor,
+		SIGNAL(signalFrameRequestDiscarded(int, int, const QString &)),
+		this, SLOT(slotDistortedFrameRequestDiscarded(int, int,
+			const QString &)));
+
+	connect(m_pCurvesTimer, SIGNAL(timeout()),
+		this, SIGNAL(signalCurvesChanged()));
+	connect(m_ui.wholeVideoButton, SIGNAL(clicked()),
+		this, SLOT(slotWholeVideoButtonPressed()));
+	connect(m_ui.startStopButton, SIGNAL(clicked()),
+		this, SLOT(slotStartStopButtonPressed()));
+	connect(m_ui.exportButton, SIGNAL(clicked()),
+		this, SLOT(slotExportButtonPressed()));
+}
+
+// END OF ClipMetricsDialog::ClipMetricsDialog(
+//		SettingsManager * a_pSettingsManager,
+//		VSScriptLibrary * a_pVSScriptLibrary, QWidget * a_pParent)
+//==============================================================================
+
+ClipMetricsDialog::~ClipMetricsDialog()
+{
+	stopAndCleanUp();
+	m_pDistortedProcessor->finalize();
+}
+
+// END OF ClipMetricsDialog::~ClipMetricsDialog()
+//==============================================================================
+
+bool ClipMetricsDialog::setClips(const ClipMetricsSource & a_reference,
+	const QVector<ClipMetricsSource> & a_candidates)
+{
+	if(m_processing)
+		return false;
+
+	bool initialized = VSScriptProcessorDialog::initialize(
+		a_reference.script, a_reference.scriptName);
+	if(!initialized)
+	{
+		emit signalWriteLogMessage(mtCritical,
+			m_pVapourSynthScriptProcessor->error());
+		return false;
+	}
+
+	// results belong to the clips they were measured on
+	if(a_reference.id != m_reference.id)
+	{
+		m_results.clear();
+		m_ui.exportButton->setEnabled(false);
+		emit signalCurvesChanged();
+	}
+
+	m_reference = a_reference;
+	m_candidates = a_candidates;
+
+	m_ui.referenceLabel->setText(m_reference.title);
+	m_ui.clipComboBox->clear();
+	for(const ClipMetricsSource & candidate : m_candidates)
+		m_ui.clipComboBox->addItem(candidate.title);
+	int lastIndex = m_ui.clipComboBox->findText(m_distorted.title);
+	if(lastIndex >= 0)
+		m_ui.clipComboBox->setCurrentIndex(lastIndex);
+
+	return true;
+}
+
+// END OF bool ClipMetricsDialog::setClips(
+//		const ClipMetricsSource & a_reference,
+//		const QVector<ClipMetricsSource> & a_candidates)
+//==============================================================================
+
+std::vector<TimeLineCurve> ClipMetricsDialog::timeLineCurves() const
+{
+	std::vector<TimeLineCurve> curves;
+	if(m_results.empty())
+		return curves;
+
+	TimeLineCurve psnrCurve;
+	psnrCurve.color = QColor(PSNR_CURVE_COLOR);
+	psnrCurve.values.assign(m_results.size(), -1.0f);
+	TimeLineCurve ssimCurve;
+	ssimCurve.color = QColor(SSIM_CURVE_COLOR);
+	ssimCurve.values.assign(m_results.size(), -1.0f);
+	TimeLineCurve msSsimCurve;
+	msSsimCurve.color = QColor(MS_SSIM_CURVE_COLOR);
+	msSsimCurve.values.assign(m_results.size(), -1.0f);
+	bool hasMsSsim = false;
+
+	for(size_t i = 0; i < m_results.size(); ++i)
+	{
+		const FrameMetrics & metrics = m_results[i];
+		if(!metrics.isValid())
+			continue;
+		psnrCurve.values[i] = curveValue(metrics.psnrAverage,
+			CURVE_PSNR_LOW, CURVE_PSNR_HIGH);
+		if(metrics.ssim >= 0.0)
+		{
+			ssimCurve.values[i] = curveValue(metrics.ssim,
+				CURVE_SSIM_LOW, 1.0);
+		}
+		if(metrics.msSsim >= 0.0)
+		{
+			msSsimCurve.values[i] = curveValue(metrics.msSsim,
+				CURVE_SSIM_LOW, 1.0);
+			hasMsSsim = true;
+		}
+	}
+
+	curves.push_back(psnrCurve);
+	curves.push_back(ssimCurve);
+	if(hasMsSsim)
+		curves.push_back(msSsimCurve);
+	return curves;
+}
+
+// END OF std::vector<TimeLineCurve> ClipMetricsDialog::timeLineCurves() const
+//==============================================================================
+
+QStringList ClipMetricsDialog::measuredClipIds() const
+{
+	if(m_results.empty())
+		return QStringList();
+	return {m_reference.id, m_distorted.id};
+}
+
+// END OF QStringList ClipMetricsDialog::measuredClipIds() const
+//==============================================================================
+
+void ClipMetricsDialog::call()
+{
+	if(m_processing)
+	{
+		show();
+		return;
+	}
+
+	if((!m_pVapourSynthScriptProcessor->isInitialized()) || m_wantToFinalize)
+		return;
+
+	Q_ASSERT(m_cpVideoInfo);
+
+	setWindowTitle(tr("Clip metrics: %1").arg(m_reference.title));
+	m_ui.feedbackTextEdit->clear();
+	if(m_candidates.isEmpty())
+	{
+		m_ui.feedbackTextEdit->addEntry(tr("There are no other clips in "
+			"the compare group of %1.").arg(m_reference.title),
+			LOG_STYLE_WARNING);
+	}
+
+	int lastFrame = m_cpVideoInfo->numFrames - 1;
+	m_ui.fromFrameSpinBox->setMaximum(lastFrame);
+	m_ui.toFrameSpinBox->setMaximum(lastFrame);
+	if((m_lastFrame < 0) || (m_lastFrame > lastFrame))
+	{
+		m_ui.fromFrameSpinBox->setValue(0);
+		m_ui.toFrameSpinBox->setValue(lastFrame);
+	}
+	m_ui.startStopButton->setEnabled(!m_candidates.isEmpty());
+
+	show();
+}
+
+// END OF void ClipMetricsDialog::call()
+//==============================================================================
+
+void ClipMetricsDialog::stopAndCleanUp()
+{
+	stopProcessing();
+	// tasks still hold frames of both cores
+	m_pThreadPool->waitForDone();
+	VSScriptProcessorDialog::stopAndCleanUp();
+}
+
+// END OF void ClipMetricsDialog::stopAndCleanUp()
+//==============================================================================
+
+void ClipMetricsDialog::slotWriteLogMessage(int a_messageType,
+	const QString & a_message)
+{
+	QString style = vsMessageTypeToStyleName(a_messageType);
+	m_ui.feedbackTextEdit->addEntry(a_message, style);
+}
+
+// END OF void ClipMetricsDialog::slotWriteLogMessage(int a_messageType,
+//		const QString & a_message)
+//==============================================================================
+
+void ClipMetricsDialog::slotReceiveFrame(int a_frameNumber,
+	int a_outputIndex, const VSFrameRef * a_cpOutputFrameRef,
+	const VSFrameRef * a_cpPreviewFrameRef)
+{
+	(void)a_cpPreviewFrameRef;
+
+	if((!m_processing) || (a_outputIndex != 0))
+		return;
+
+	storeFrame(true, a_frameNumber, a_cpOutputFrameRef);
+	requestFrames();
+}
+
+// END OF void ClipMetricsDialog::slotReceiveFrame(int a_frameNumber,
+//		int a_outputIndex, const VSFrameRef * a_cpOutputFrameRef,
+//		const VSFrameRef * a_cpPreviewFrameRef)
+//==============================================================================
+
+void ClipMetricsDialog::slotFrameRequestDiscarded(int a_frameNumber,
+	int a_outputIndex, const QString & a_reason)
+{
+	if((!m_processing) || (a_outputIndex != 0))
+		return;
+
+	frameFailed(a_frameNumber, a_reason);
+	requestFrames();
+}
+
+// END OF void ClipMetricsDialog::slotFrameRequestDiscarded(
+//		int a_frameNumber, int a_outputIndex, const QString & a_reason)
+//==============================================================================
+
+void ClipMetricsDialog::slotReceiveDistortedFrame(int a_frameNumber,
+	int a_outputIndex, const VSFrameRef * a_cpOutputFrameRef,
+	const VSFrameRef * a_cpPreviewFrameRef)
+{
+	(void)a_cpPreviewFrameRef;
+
+	if((!m_processing) || (a_outputIndex != 0))
+		return;
+
+	storeFrame(false, a_frameNumber, a_cpOutputFrameRef);
+	requestFrames();
+}
+
+// END OF void ClipMetricsDialog::slotReceiveDistortedFrame(int a_frameNumber,
+//		int a_outputIndex, const VSFrameRef * a_cpOutputFrameRef,
+//		const VSFrameRef * a_cpPreviewFrameRef)
+//==============================================================================
+
+void ClipMetricsDialog::slotDistortedFrameRequestDiscarded(int a_frameNumber,
+	int a_outputIndex, const QString & a_reason)
+{
+	if((!m_processing) || (a_outputIndex != 0))
+		return;
+
+	frameFailed(a_frameNumber, a_reason);
+	requestFrames();
+}
+
+// END OF void ClipMetricsDialog::slotDistortedFrameRequestDiscarded(
+//		int a_frameNumber, int a_outputIndex, const QString & a_reason)
+//==============================================================================
+
+void ClipMetricsDialog::slotFrameMetricsReady(const FrameMetrics & a_metrics,
+	int a_generation)
+{
+	if((a_generation != m_generation) || (!m_processing))
+		return;
+
+	m_framesDone++;
+	if(a_metrics.isValid())
+	{
+		Q_ASSERT(size_t(a_metrics.frameNumber) < m_results.size());
+		m_results[size_t(a_metrics.frameNumber)] = a_metrics;
+		m_summary.add(a_metrics);
+	}
+	else
+	{
+		m_framesFailed++;
+		if(m_framesFailed == 1)
+		{
+			m_ui.feedbackTextEdit->addEntry(tr("Frame %1 could not be "
+				"measured: %2").arg(a_metrics.frameNumber)
+				.arg(a_metrics.error), LOG_STYLE_WARNING);
+		}
+	}
+
+	updateSummary();
+
+	if(m_framesDone == m_lastFrame - m_firstFrame + 1)
+	{
+		stopProcessing();
+		return;
+	}
+
+	if(!m_pCurvesTimer->isActive())
+		m_pCurvesTimer->start();
+	requestFrames();
+}
+
+// END OF void ClipMetricsDialog::slotFrameMetricsReady(
+//		const FrameMetrics & a_metrics, int a_generation)
+//==============================================================================
+
+void ClipMetricsDialog::slotWholeVideoButtonPressed()
+{
+	Q_ASSERT(m_cpVideoInfo);
+	int lastFrame = m_cpVideoInfo->numFrames - 1;
+	m_ui.fromFrameSpinBox->setValue(0);
+	m_ui.toFrameSpinBox->setValue(lastFrame);
+}
+
+// END OF void ClipMetricsDialog::slotWholeVideoButtonPressed()
+//==============================================================================
+
+void ClipMetricsDialog::slotStartStopButtonPressed()
+{
+	if(m_processing)
+	{
+		stopProcessing();
+		return;
+	}
+
+	if((!m_pVapourSynthScriptProcessor->isInitialized()) || (!m_cpVideoInfo))
+		return;
+
+	int clipIndex = m_ui.clipComboBox->currentIndex();
+	if((clipIndex < 0) || (clipIndex >= m_candidates.size()))
+	{
+		m_ui.feedbackTextEdit->addEntry(tr("Choose a clip to compare with."),
+			LOG_STYLE_WARNING);
+		return;
+	}
+
+	int firstFrame = m_ui.fromFrameSpinBox->value();
+	int lastFrame = m_ui.toFrameSpinBox->value();
+	if(firstFrame > lastFrame)
+	{
+		m_ui.feedbackTextEdit->addEntry(tr(
+			"First frame number is larger than the last frame number."),
+			LOG_STYLE_WARNING);
+		return;
+	}
+
+	const ClipMetricsSource & candidate = m_candidates[clipIndex];
+	if(!loadDistortedClip(candidate))
+		return;
+
+	const VSVideoInfo * cpDistortedInfo = m_pDistortedProcessor->videoInfo();
+	Q_ASSERT(cpDistortedInfo);
+	const VSFormat * cpFormat = m_cpVideoInfo->format;
+	const VSFormat * cpDistortedFormat = cpDistortedInfo->format;
+
+	QString mismatch;
+	if((!cpFormat) || (!cpDistortedFormat) ||
+		(m_cpVideoInfo->width == 0) || (cpDistortedInfo->width == 0))
+		mismatch = tr("clips with variable format or size can not be measured");
+	else if(cpFormat->id != cpDistortedFormat->id)
+	{
+		mismatch = tr("formats differ: %1 and %2").arg(cpFormat->name)
+			.arg(cpDistortedFormat->name);
+	}
+	else if((m_cpVideoInfo->width != cpDistortedInfo->width) ||
+		(m_cpVideoInfo->height != cpDistortedInfo->height))
+	{
+		mismatch = tr("sizes differ: %1x%2 and %3x%4")
+			.arg(m_cpVideoInfo->width).arg(m_cpVideoInfo->height)
+			.arg(cpDistortedInfo->width).arg(cpDistortedInfo->height);
+	}
+	else if(cpDistortedInfo->numFrames <= lastFrame)
+	{
+		mismatch = tr("%1 has only %2 frames").arg(candidate.title)
+			.arg(cpDistortedInfo->numFrames);
+	}
+
+	if(!mismatch.isEmpty())
+	{
+		m_ui.feedbackTextEdit->addEntry(tr("Can not compare %1 with %2: %3.")
+			.arg(m_reference.title).arg(candidate.title).arg(mismatch),
+			LOG_STYLE_WARNING);
+		return;
+	}
+
+	m_distorted = candidate;
+	m_firstFrame = firstFrame;
+	m_lastFrame = lastFrame;
+	m_nextFrame = firstFrame;
+	m_framesDone = 0;
+	m_framesFailed = 0;
+	m_msSsim = m_ui.msSsimCheckBox->isChecked();
+	m_pairsLimit = std::max(2, std::min(QThread::idealThreadCount(),
+		MAX_FRAME_PAIRS_IN_FLIGHT));
+	m_results.assign(size_t(m_cpVideoInfo->numFrames), FrameMetrics());
+	m_summary = MetricsSummary();
+	m_planeNames = FrameMetrics::planeNames(cpFormat);
+	m_generation++;
+
+	m_ui.feedbackTextEdit->addEntry(tr("Comparing %1 with %2, frames %3 "
+		"to %4.").arg(m_reference.title).arg(m_distorted.title)
+		.arg(m_firstFrame).arg(m_lastFrame));
+	m_ui.metricsEdit->clear();
+	m_ui.processingProgressBar->setMaximum(m_lastFrame - m_firstFrame + 1);
+	m_ui.processingProgressBar->setValue(0);
+	m_ui.startStopButton->setText(tr("Stop"));
+	m_ui.exportButton->setEnabled(false);
+	m_ui.clipComboBox->setEnabled(false);
+	m_ui.msSsimCheckBox->setEnabled(false);
+
+	m_processing = true;
+	m_startTime = hr_clock::now();
+	emit signalCurvesChanged();
+
+	requestFrames();
+}
+
+// END OF void ClipMetricsDialog::slotStartStopButtonPressed()
+//==============================================================================
+
+void ClipMetricsDialog::slotExportButtonPressed()
+{
+	if(m_results.empty())
+		return;
+
+	QFileInfo scriptInfo(m_reference.scriptName);
+	QString directory = m_reference.scriptName.isEmpty() ?
+		QDir(".").absolutePath() : scriptInfo.absolutePath();
+	QString baseName = scriptInfo.completeBaseName();
+	if(baseName.isEmpty())
+		baseName = "clip";
+	QString filePath = directory + QString("/") + baseName +
+		QString("_metrics.csv");
+
+	filePath = QFileDialog::getSaveFileName(this, tr("Export metrics"),
+		filePath, tr("CSV files (*.csv);;All files (*.*)"));
+	if(filePath.isEmpty())
+		return;
+
+	QFile file(filePath);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate |
+		QIODevice::Text))
+	{
+		m_ui.feedbackTextEdit->addEntry(tr("Could not write %1: %2")
+			.arg(filePath).arg(file.errorString()), LOG_STYLE_ERROR);
+		return;
+	}
+
+	QTextStream stream(&file);
+	stream << "frame";
+	for(const QString & plane : m_planeNames)
+		stream << ",psnr_" << plane.toLower();
+	stream << ",psnr_average,ssim,ms_ssim\n";
+
+	int rows = 0;
+	for(const FrameMetrics & metrics : m_results)
+	{
+		if(!metrics.isValid())
+			continue;
+		stream << metrics.frameNumber;
+		for(int i = 0; i < metrics.planes; ++i)
+			stream << "," << QString::number(metrics.psnr[i], 'f', 4);
+		stream << "," << QString::number(metrics.psnrAverage, 'f', 4);
+		stream << "," << ((metrics.ssim >= 0.0) ?
+			QString::number(metrics.ssim, 'f', 6) : QString());
+		stream << "," << ((metrics.msSsim >= 0.0) ?
+			QString::number(metrics.msSsim, 'f', 6) : QString());
+		stream << "\n";
+		rows++;
+	}
+	stream.flush();
+
+	m_ui.feedbackTextEdit->addEntry(tr("Exported %1 frames to %2")
+		.arg(rows).arg(filePath));
+}
+
+// END OF void ClipMetricsDialog::slotExportButtonPressed()
+//==============================================================================
+
+bool ClipMetricsDialog::loadDistortedClip(const ClipMetricsSource & a_source)
+{
+	if(m_pDistortedProcessor->isInitialized())
+	{
+		if((m_pDistortedProcessor->script() == a_source.script) &&
+			(m_pDistortedProcessor->scriptName() == a_source.scriptName))
+			return true;
+
+		// no metrics task may hold a frame of the old core
+		m_pThreadPool->waitForDone();
+		if(!m_pDistortedProcessor->finalize())
+		{
+			m_ui.feedbackTextEdit->addEntry(tr("Script processor of %1 "
+				"is busy. Try again when it finishes.")
+				.arg(m_distorted.title), LOG_STYLE_WARNING);
+			return false;
+		}
+	}
+
+	if(!m_pDistortedProcessor->initialize(a_source.script,
+		a_source.scriptName))
+	{
+		m_ui.feedbackTextEdit->addEntry(m_pDistortedProcessor->error(),
+			LOG_STYLE_ERROR);
+		return false;
+	}
+
+	return true;
+}
+
+// END OF bool ClipMetricsDialog::loadDistortedClip(
+//		const ClipMetricsSource & a_source)
+//==============================================================================
+
+void ClipMetricsDialog::stopProcessing()
+{
+	if(!m_processing)
+		return;
+
+	m_processing = false;
+	// tasks already queued free their frames, their results are dropped
+	m_generation++;
+	m_pVapourSynthScriptProcessor->flushFrameTicketsQueue();
+	m_pDistortedProcessor->flushFrameTicketsQueue();
+	freeWaitingFrames();
+
+	int framesTotal = m_lastFrame - m_firstFrame + 1;
+	if(m_framesDone < framesTotal)
+	{
+		m_ui.feedbackTextEdit->addEntry(tr("Stopped after %1 of %2 frames.")
+			.arg(m_framesDone).arg(framesTotal));
+	}
+	else
+	{
+		m_ui.feedbackTextEdit->addEntry(tr("Measured %1 frames.")
+			.arg(framesTotal - m_framesFailed));
+	}
+
+	m_pCurvesTimer->stop();
+	emit signalCurvesChanged();
+
+	m_ui.startStopButton->setText(tr("Start"));
+	m_ui.exportButton->setEnabled(m_framesDone > m_framesFailed);
+	m_ui.clipComboBox->setEnabled(true);
+	m_ui.msSsimCheckBox->setEnabled(true);
+	setWindowTitle(tr("Clip metrics: %1").arg(m_reference.title));
+}
+
+// END OF void ClipMetricsDialog::stopProcessing()
+//==============================================================================
+
+void ClipMetricsDialog::requestFrames()
+{
+	while(m_processing && (m_nextFrame <= m_lastFrame) &&
+		(m_nextFrame - m_firstFrame - m_framesDone < m_pairsLimit))
+	{
+		int frameNumber = m_nextFrame++;
+		if(!m_pVapourSynthScriptProcessor->requestFrameAsync(frameNumber))
+			frameFailed(frameNumber, m_pVapourSynthScriptProcessor->error());
+		if(!m_pDistortedProcessor->requestFrameAsync(frameNumber))
+			frameFailed(frameNumber, m_pDistortedProcessor->error());
+	}
+
+	if(m_processing && (m_framesDone == m_lastFrame - m_firstFrame + 1))
+		stopProcessing();
+}
+
+// END OF void ClipMetricsDialog::requestFrames()
+//==============================================================================
+
+void ClipMetricsDialog::storeFrame(bool a_reference, int a_frameNumber,
+	const VSFrameRef * a_cpFrameRef)
+{
+	// the other clip failed to produce this frame
+	std::set<int>::iterator failed = m_failedFrames.find(a_frameNumber);
+	if(failed != m_failedFrames.end())
+	{
+		m_failedFrames.erase(failed);
+		return;
+	}
+
+	Q_ASSERT(m_cpVSAPI);
+	const VSFrameRef * cpFrameRef = m_cpVSAPI->cloneFrameRef(a_cpFrameRef);
+
+	std::map<int, const VSFrameRef *> & frames =
+		a_reference ? m_referenceFrames : m_distortedFrames;
+	std::map<int, const VSFrameRef *> & otherFrames =
+		a_reference ? m_distortedFrames : m_referenceFrames;
+
+	std::map<int, const VSFrameRef *>::iterator other =
+		otherFrames.find(a_frameNumber);
+	if(other == otherFrames.end())
+	{
+		frames[a_frameNumber] = cpFrameRef;
+		return;
+	}
+
+	const VSFrameRef * cpOtherFrameRef = other->second;
+	otherFrames.erase(other);
+
+	m_pThreadPool->start(new FrameMetricsTask(this, m_cpVSAPI,
+		a_reference ? cpFrameRef : cpOtherFrameRef,
+		a_reference ? cpOtherFrameRef : cpFrameRef,
+		a_frameNumber, m_msSsim, m_generation));
+}
+
+// END OF void ClipMetricsDialog::storeFrame(bool a_reference,
+//		int a_frameNumber, const VSFrameRef * a_cpFrameRef)
+//==============================================================================
+
+void ClipMetricsDialog::frameFailed(int a_frameNumber,
+	const QString & a_reason)
+{
+	// counted already when the other clip failed it
+	std::set<int>::iterator failed = m_failedFrames.find(a_frameNumber);
+	if(failed != m_failedFrames.end())
+	{
+		m_failedFrames.erase(failed);
+		return;
+	}
+
+	bool otherArrived = false;
+	for(std::map<int, const VSFrameRef *> * pFrames :
+		{&m_referenceFrames, &m_distortedFrames})
+	{
+		std::map<int, const VSFrameRef *>::iterator it =
+			pFrames->find(a_frameNumber);
+		if(it == pFrames->end())
+			continue;
+		m_cpVSAPI->freeFrame(it->second);
+		pFrames->erase(it);
+		otherArrived = true;
+	}
+
+	if(!otherArrived)
+		m_failedFrames.insert(a_frameNumber);
+
+	m_framesDone++;
+	m_framesFailed++;
+	if(m_framesFailed == 1)
+	{
+		QString reason = a_reason.isEmpty() ? tr("request discarded") :
+			a_reason;
+		m_ui.feedbackTextEdit->addEntry(tr("Frame %1 could not be "
+			"measured: %2").arg(a_frameNumber).arg(reason),
+			LOG_STYLE_WARNING);
+	}
+
+	updateSummary();
+}
+
+// END OF void ClipMetricsDialog::frameFailed(int a_frameNumber,
+//		const QString & a_reason)
+//==============================================================================
+
+void ClipMetricsDialog::freeWaitingFrames()
+{
+	for(std::map<int, const VSFrameRef *> * pFrames :
+		{&m_referenceFrames, &m_distortedFrames})
+	{
+		for(std::pair<const int, const VSFrameRef *> & frame : *pFrames)
+		{
+			Q_ASSERT(m_cpVSAPI);
+			m_cpVSAPI->freeFrame(frame.second);
+		}
+		pFrames->clear();
+	}
+	m_failedFrames.clear();
+}
+
+// END OF void ClipMetricsDialog::freeWaitingFrames()
+//==============================================================================
+
+void ClipMetricsDialog::updateSummary()
+{
+	int framesTotal = m_lastFrame - m_firstFrame + 1;
+	m_ui.processingProgressBar->setValue(m_framesDone);
+
+	QString text;
+	if(m_summary.measured > 0)
+	{
+		text = tr("PSNR %1 dB (min %2 at %3)")
+			.arg(m_summary.psnrSum / m_summary.measured, 0, 'f', 2)
+			.arg(m_summary.worstPsnr, 0, 'f', 2)
+			.arg(m_summary.worstPsnrFrame);
+	}
+	if(m_summary.ssimMeasured > 0)
+	{
+		text += tr("; SSIM %1 (min %2 at %3)")
+			.arg(m_summary.ssimSum / m_summary.ssimMeasured, 0, 'f', 4)
+			.arg(m_summary.worstSsim, 0, 'f', 4)
+			.arg(m_summary.worstSsimFrame);
+	}
+	if(m_summary.msSsimMeasured > 0)
+	{
+		text += tr("; MS-SSIM %1")
+			.arg(m_summary.msSsimSum / m_summary.msSsimMeasured, 0, 'f', 4);
+	}
+
+	double passed = duration_to_double(hr_clock::now() - m_startTime);
+	if(passed > 0.0)
+		text += tr("; %1 FPS").arg(double(m_framesDone) / passed, 0, 'f', 2);
+	if(m_framesFailed > 0)
+		text += tr("; %1 frames failed").arg(m_framesFailed);
+	m_ui.metricsEdit->setText(text);
+
+	int percentage = int(double(m_framesDone) * 100.0 / double(framesTotal));
+	setWindowTitle(tr("%1% Clip metrics: %2")
+		.arg(percentage).arg(m_reference.title));
+}
+
+// END OF void ClipMetricsDialog::updateSummary()
+//==============================================================================
@@ -0,0 +1,167 @@
+#ifndef CLIP_METRICS_DIALOG_H_INCLUDED
+#define CLIP_METRICS_DIALOG_H_INCLUDED
+
+#include <ui_clip_metrics_dialog.h>
+
+#include "clip_metrics.h"
+#include "../vapoursynth/vs_script_processor_dialog.h"
+#include "../../../common-src/chrono.h"
+#include "../../../common-src/frame_timeline/timeline_strip.h"
+
+#include <QVector>
+#include <map>
+#include <set>
+#include <vector>
+
+class QThreadPool;
+class QTimer;
+
+// a script of the compare group, id tells the editor tabs apart
+struct ClipMetricsSource
+{
+	QString id;
+	QString title;
+	QString script;
+	QString scriptName;
+};
+
+/// Measures PSNR, SSIM and MS-SSIM of a compare group clip against
+/// another one. Both clips render frames in parallel, the metrics are
+/// computed on a thread pool as soon as both frames of a number arrive.
+class ClipMetricsDialog : public VSScriptProcessorDialog
+{
+	Q_OBJECT
+
+public:
+
+	ClipMetricsDialog(SettingsManager * a_pSettingsManager,
+		VSScriptLibrary * a_pVSScriptLibrary,
+		QWidget * a_pParent = nullptr);
+	virtual ~ClipMetricsDialog() override;
+
+	/// Loads the reference clip. The compared clip is loaded
+	/// when measuring starts.
+	bool setClips(const ClipMetricsSource & a_reference,
+		const QVector<ClipMetricsSource> & a_candidates);
+
+	// per-frame curves of the last measurement scaled for the timeline
+	std::vector<TimeLineCurve> timeLineCurves() const;
+
+	// ids of the reference and the compared clip of the last measurement
+	QStringList measuredClipIds() const;
+
+public slots:
+
+	void call();
+
+signals:
+
+	void signalCurvesChanged();
+
+protected slots:
+
+	virtual void slotWriteLogMessage(int a_messageType,
+		const QString & a_message) override;
+
+	virtual void slotReceiveFrame(int a_frameNumber, int a_outputIndex,
+		const VSFrameRef * a_cpOutputFrameRef,
+		const VSFrameRef * a_cpPreviewFrameRef) override;
+
+	virtual void slotFrameRequestDiscarded(int a_frameNumber,
+		int a_outputIndex, const QString & a_reason) override;
+
+	void slotReceiveDistortedFrame(int a_frameNumber, int a_outputIndex,
+		const VSFrameRef * a_cpOutputFrameRef,
+		const VSFrameRef * a_cpPreviewFrameRef);
+
+	void slotDistortedFrameRequestDiscarded(int a_frameNumber,
+		int a_outputIndex, const QString & a_reason);
+
+	void slotFrameMetricsReady(const FrameMetrics & a_metrics,
+		int a_generation);
+
+	void slotWholeVideoButtonPressed();
+
+	void slotStartStopButtonPressed();
+
+	void slotExportButtonPressed();
+
+protected:
+
+	// running totals, frames are measured out of order
+	struct MetricsSummary
+	{
+		int measured;
+		int ssimMeasured;
+		int msSsimMeasured;
+		double psnrSum;
+		double ssimSum;
+		double msSsimSum;
+		int worstPsnrFrame;
+		int worstSsimFrame;
+		double worstPsnr;
+		double worstSsim;
+
+		MetricsSummary();
+
+		void add(const FrameMetrics & a_metrics);
+	};
+
+	virtual void stopAndCleanUp() override;
+
+	bool loadDistortedClip(const ClipMetricsSource & a_source);
+
+	void stopProcessing();
+
+	void requestFrames();
+
+	// pairs the frame with the same frame of the other clip
+	void storeFrame(bool a_reference, int a_frameNumber,
+		const VSFrameRef * a_cpFrameRef);
+
+	void frameFailed(int a_frameNumber, const QString & a_reason);
+
+	void freeWaitingFrames();
+
+	void updateSummary();
+
+	Ui::ClipMetricsDialog m_ui;
+
+	VapourSynthScriptProcessor * m_pDistortedProcessor;
+
+	QThreadPool * m_pThreadPool;
+
+	// the timeline is updated at most this often while measuring
+	QTimer * m_pCurvesTimer;
+
+	ClipMetricsSource m_reference;
+	QVector<ClipMetricsSource> m_candidates;
+	ClipMetricsSource m_distorted;
+
+	bool m_processing;
+	bool m_msSsim;
+
+	// results of tasks from a stopped measurement are ignored
+	int m_generation;
+
+	int m_firstFrame;
+	int m_lastFrame;
+	int m_nextFrame;
+	int m_framesDone;
+	int m_framesFailed;
+	int m_pairsLimit;
+
+	hr_time_point m_startTime;
+
+	// frames waiting for the same frame of the other clip
+	std::map<int, const VSFrameRef *> m_referenceFrames;
+	std::map<int, const VSFrameRef *> m_distortedFrames;
+	std::set<int> m_failedFrames;
+
+	// indexed by frame number, invalid where not measured
+	std::vector<FrameMetrics> m_results;
+	MetricsSummary m_summary;
+	QStringList m_planeNames;
+};
+
+#endif // CLIP_METRICS_DIALOG_H_INCLUDED
@@ -0,0 +1,696 @@
+#include "frame_export_dialog.h"
+
+#include "../../../common-src/helpers.h"
+#include "../../../common-src/settings/settings_manager.h"
+#include "../../../common-src/vapoursynth/vapoursynth_script_processor.h"
+
+#include <vapoursynth/VapourSynth.h>
+
+#include <QDir>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QImage>
+#include <QImageWriter>
+#include <QRegularExpression>
+#include <QRunnable>
+#include <QStandardPaths>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <set>
+
+// frames requested and not saved yet, bounds the frames held in memory
+const int MAX_EXPORT_FRAMES_IN_FLIGHT = 8;
+// encoding threads, the clip needs the rest of the cores to render
+const int MAX_EXPORT_THREADS = 4;
+
+const int DEFAULT_WEBP_QUALITY = 100;
+
+#if(QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
+	#define FRAME_EXPORT_DEEP_COLOR
+#endif
+
+//==============================================================================
+
+namespace
+{
+
+// Converts a preview frame, CompatBGR32 or RGB48, to an image.
+QImage imageFromFrame(const VSAPI * a_cpVSAPI, const VSFrameRef * a_cpFrameRef)
+{
+	const VSFormat * cpFormat = a_cpVSAPI->getFrameFormat(a_cpFrameRef);
+	int width = a_cpVSAPI->getFrameWidth(a_cpFrameRef, 0);
+	int height = a_cpVSAPI->getFrameHeight(a_cpFrameRef, 0);
+
+	if(cpFormat->id == pfCompatBGR32)
+	{
+		QImage frameImage(a_cpVSAPI->getReadPtr(a_cpFrameRef, 0), width,
+			height, a_cpVSAPI->getStride(a_cpFrameRef, 0),
+			QImage::Format_RGB32);
+		// compat frames are stored bottom up
+		return frameImage.mirrored();
+	}
+
+#ifdef FRAME_EXPORT_DEEP_COLOR
+	if(cpFormat->id == pfRGB48)
+	{
+		QImage image(width, height, QImage::Format_RGBX64);
+		const uint8_t * planes[3];
+		int strides[3];
+		for(int i = 0; i < 3; ++i)
+		{
+			planes[i] = a_cpVSAPI->getReadPtr(a_cpFrameRef, i);
+			strides[i] = a_cpVSAPI->getStride(a_cpFrameRef, i);
+		}
+
+		for(int y = 0; y < height; ++y)
+		{
+			const uint16_t * pR = reinterpret_cast<const uint16_t *>(
+				planes[0] + ptrdiff_t(y) * strides[0]);
+			const uint16_t * pG = reinterpret_cast<const uint16_t *>(
+				planes[1] + ptrdiff_t(y) * strides[1]);
+			const uint16_t * pB = reinterpret_cast<const uint16_t *>(
+				planes[2] + ptrdiff_t(y) * strides[2]);
+			quint16 * pLine = reinterpret_cast<quint16 *>(image.scanLine(y));
+			for(int x = 0; x < width; ++x)
+			{
+				pLine[x * 4] = pR[x];
+				pLine[x * 4 + 1] = pG[x];
+				pLine[x * 4 + 2] = pB[x];
+				pLine[x * 4 + 3] = 0xFFFF;
+			}
+		}
+		return image;
+	}
+#endif
+
+	return QImage();
+}
+
+// Converts and saves a frame, then frees it. The result is queued back
+// to the dialog thread.
+class FrameExportTask : public QRunnable
+{
+public:
+
+	FrameExportTask(QObject * a_pReceiver, const VSAPI * a_cpVSAPI,
+		const VSFrameRef * a_cpFrameRef, int a_frameNumber,
+		const QString & a_filePath, const QByteArray & a_format,
+		int a_quality, int a_generation):
+		  m_pReceiver(a_pReceiver)
+		, m_cpVSAPI(a_cpVSAPI)
+		, m_cpFrameRef(a_cpFrameRef)
+		, m_frameNumber(a_frameNumber)
+		, m_filePath(a_filePath)
+		, m_format(a_format)
+		, m_quality(a_quality)
+		, m_generation(a_generation)
+	{
+	}
+
+	virtual void run() override
+	{
+		QImage image = imageFromFrame(m_cpVSAPI, m_cpFrameRef);
+		QString formatName = m_cpVSAPI->getFrameFormat(m_cpFrameRef)->name;
+		m_cpVSAPI->freeFrame(m_cpFrameRef);
+
+		QString error;
+		if(image.isNull())
+		{
+			error = QObject::tr("Frames of format %1 can not be saved.")
+				.arg(formatName);
+		}
+		else
+		{
+			QImageWriter writer(m_filePath, m_format);
+			writer.setQuality(m_quality);
+			if(!writer.write(image))
+				error = writer.errorString();
+		}
+
+		QMetaObject::invokeMethod(m_pReceiver, "slotFrameExported",
+			Qt::QueuedConnection, Q_ARG(int, m_frameNumber),
+			Q_ARG(QString, m_filePath), Q_ARG(QString, error),
+			Q_ARG(int, m_generation));
+	}
+
+private:
+
+	QObject * m_pReceiver;
+	const VSAPI * m_cpVSAPI;
+	const VSFrameRef * m_cpFrameRef;
+	int m_frameNumber;
+	QString m_filePath;
+	QByteArray m_format;
+	int m_quality;
+	int m_generation;
+};
+
+QString fileNameSafe(QString a_text)
+{
+	static const QRegularExpression unsafe("[\\\\/:*?\"<>|\\x00-\\x1f]");
+	return a_text.replace(unsafe, "_").trimmed();
+}
+
+}
+
+//==============================================================================
+
+FrameExportDialog::FrameExportDialog(SettingsManager * a_pSettingsManager,
+	VSScriptLibrary * a_pVSScriptLibrary, QWidget * a_pParent):
+	VSScriptProcessorDialog(a_pSettingsManager, a_pVSScriptLibrary, a_pParent,
+		Qt::WindowFlags()
+		| Qt::Window
+		| Qt::CustomizeWindowHint
+		| Qt::WindowMinimizeButtonHint
+		| Qt::WindowCloseButtonHint
+		)
+	, m_pThreadPool(nullptr)
+	, m_processing(false)
+	, m_generation(0)
+	, m_nextIndex(0)
+	, m_framesDone(0)
+	, m_framesFailed(0)
+	, m_requestsLimit(2)
+	, m_quality(-1)
+	, m_deepColor(false)
+{
+	m_ui.setupUi(this);
+	setWindowIcon(QIcon(":snapshot.png"));
+
+	createStatusBar();
+
+	m_ui.feedbackTextEdit->setName("frame_export_log");
+	m_ui.feedbackTextEdit->setSettingsManager(m_pSettingsManager);
+	m_ui.feedbackTextEdit->loadSettings();
+
+	m_ui.sourceComboBox->addItem(tr("Bookmarks"));
+	m_ui.sourceComboBox->addItem(tr("Frame list"));
+
+	QList<QByteArray> supportedFormats = QImageWriter::supportedImageFormats();
+	m_ui.formatComboBox->addItem(tr("PNG"), QString("png"));
+	if(supportedFormats.contains("webp"))
+		m_ui.formatComboBox->addItem(tr("WebP"), QString("webp"));
+	if(supportedFormats.contains("tiff"))
+		m_ui.formatComboBox->addItem(tr("TIFF"), QString("tif"));
+
+	m_ui.bitDepthComboBox->addItem(tr("8 bit"), 8);
+#ifdef FRAME_EXPORT_DEEP_COLOR
+	m_ui.bitDepthComboBox->addItem(tr("16 bit"), 16);
+#endif
+
+	m_ui.qualitySpinBox->setValue(DEFAULT_WEBP_QUALITY);
+
+	m_ui.templateEdit->setText(
+		m_pSettingsManager->getFrameExportFileNameTemplate());
+	QString directory = m_pSettingsManager->getFrameExportDirectory();
+	if(directory.isEmpty())
+	{
+		directory = QStandardPaths::writableLocation(
+			QStandardPaths::PicturesLocation);
+	}
+	m_ui.directoryEdit->setText(directory);
+
+	// The export is a batch consumer, it may keep every core busy.
+	m_pVapourSynthScriptProcessor->setFrameRequestsLimit(0);
+
+	m_pThreadPool = new QThreadPool(this);
+	m_pThreadPool->setMaxThreadCount(std::max(1,
+		std::min(QThread::idealThreadCount() / 2, MAX_EXPORT_THREADS)));
+
+	connect(m_ui.sourceComboBox, SIGNAL(currentIndexChanged(int)),
+		this, SLOT(slotSourceChanged(int)));
+	connect(m_ui.formatComboBox, SIGNAL(currentIndexChanged(int)),
+		this, SLOT(slotFormatChanged(int)));
+	connect(m_ui.browseButton, SIGNAL(clicked()),
+		this, SLOT(slotBrowseButtonPressed()));
+	connect(m_ui.startStopButton, SIGNAL(clicked()),
+		this, SLOT(slotStartStopButtonPressed()));
+
+	slotSourceChanged(m_ui.sourceComboBox->currentIndex());
+	slotFormatChanged(m_ui.formatComboBox->currentIndex());
+}
+
+// END OF FrameExportDialog::FrameExportDialog(
+//		SettingsManager * a_pSettingsManager,
+//		VSScriptLibrary * a_pVSScriptLibrary, QWidget * a_pParent)
+//==============================================================================
+
+FrameExportDialog::~FrameExportDialog()
+{
+	stopAndCleanUp();
+}
+
+// END OF FrameExportDialog::~FrameExportDialog()
+//==============================================================================
+
+bool FrameExportDialog::initialize(const QString & a_script,
+	const QString & a_scriptName)
+{
+	bool initialized =
+		VSScriptProcessorDialog::initialize(a_script, a_scriptName);
+	if(!initialized)
+		emit signalWriteLogMessage(mtCritical,
+			m_pVapourSynthScriptProcessor->error());
+	return initialized;
+}
+
+// END OF bool FrameExportDialog::initialize(const QString & a_script,
+//		const QString & a_scriptName)
+//==============================================================================
+
+void FrameExportDialog::setBookmarks(const QVector<BookmarkData> & a_bookmarks)
+{
+	if(m_processing)
+		return;
+
+	m_bookmarks = a_bookmarks;
+	std::stable_sort(m_bookmarks.begin(), m_bookmarks.end(),
+		[](const BookmarkData & a_first, const BookmarkData & a_second)
+		{
+			return a_first.frame < a_second.frame;
+		});
+}
+
+// END OF void FrameExportDialog::setBookmarks(
+//		const QVector<BookmarkData> & a_bookmarks)
+//==============================================================================
+
+void FrameExportDialog::call()
+{
+	if(m_processing)
+	{
+		show();
+		return;
+	}
+
+	if((!m_pVapourSynthScriptProcessor->isInitialized()) || m_wantToFinalize)
+		return;
+
+	Q_ASSERT(m_cpVideoInfo);
+
+	setWindowTitle(tr("Export frames: %1").arg(scriptName()));
+	m_ui.feedbackTextEdit->clear();
+	m_ui.processingProgressBar->setValue(0);
+
+	// an empty bookmark list starts with the frame list
+	if(m_bookmarks.isEmpty())
+		m_ui.sourceComboBox->setCurrentIndex(1);
+	m_ui.sourceComboBox->setItemText(0,
+		tr("Bookmarks (%1)").arg(m_bookmarks.size()));
+	if(m_ui.framesEdit->text().isEmpty())
+	{
+		m_ui.framesEdit->setText(QString("0-%1")
+			.arg(m_cpVideoInfo->numFrames - 1));
+	}
+
+	show();
+}
+
+// END OF void FrameExportDialog::call()
+//==============================================================================
+
+void FrameExportDialog::stopAndCleanUp()
+{
+	stopProcessing();
+	// tasks still hold frames of the core
+	m_pThreadPool->waitForDone();
+	VSScriptProcessorDialog::stopAndCleanUp();
+}
+
+// END OF void FrameExportDialog::stopAndCleanUp()
+//==============================================================================
+
+void FrameExportDialog::slotWriteLogMessage(int a_messageType,
+	const QString & a_message)
+{
+	QString style = vsMessageTypeToStyleName(a_messageType);
+	m_ui.feedbackTextEdit->addEntry(a_message, style);
+}
+
+// END OF void FrameExportDialog::slotWriteLogMessage(int a_messageType,
+//		const QString & a_message)
+//==============================================================================
+
+void FrameExportDialog::slotReceiveFrame(int a_frameNumber,
+	int a_outputIndex, const VSFrameRef * a_cpOutputFrameRef,
+	const VSFrameRef * a_cpPreviewFrameRef)
+{
+	(void)a_cpOutputFrameRef;
+
+	if((!m_processing) || (a_outputIndex != 0))
+		return;
+
+	std::map<int, int>::iterator it = m_framesInFlight.find(a_frameNumber);
+	if(it == m_framesInFlight.end())
+		return;
+	int index = it->second;
+	m_framesInFlight.erase(it);
+
+	Q_ASSERT(m_cpVSAPI);
+	if(!a_cpPreviewFrameRef)
+	{
+		frameDone(a_frameNumber, true);
+		return;
+	}
+
+	m_pThreadPool->start(new FrameExportTask(this, m_cpVSAPI,
+		m_cpVSAPI->cloneFrameRef(a_cpPreviewFrameRef), a_frameNumber,
+		filePath(m_frames[index], index), m_format, m_quality,
+		m_generation));
+}
+
+// END OF void FrameExportDialog::slotReceiveFrame(int a_frameNumber,
+//		int a_outputIndex, const VSFrameRef * a_cpOutputFrameRef,
+//		const VSFrameRef * a_cpPreviewFrameRef)
+//==============================================================================
+
+void FrameExportDialog::slotFrameRequestDiscarded(int a_frameNumber,
+	int a_outputIndex, const QString & a_reason)
+{
+	if((!m_processing) || (a_outputIndex != 0))
+		return;
+
+	std::map<int, int>::iterator it = m_framesInFlight.find(a_frameNumber);
+	if(it == m_framesInFlight.end())
+		return;
+	m_framesInFlight.erase(it);
+
+	m_ui.feedbackTextEdit->addEntry(tr("Frame %1 was not rendered. %2")
+		.arg(a_frameNumber).arg(a_reason), LOG_STYLE_WARNING);
+	frameDone(a_frameNumber, true);
+}
+
+// END OF void FrameExportDialog::slotFrameRequestDiscarded(int a_frameNumber,
+//		int a_outputIndex, const QString & a_reason)
+//==============================================================================
+
+void FrameExportDialog::slotFrameExported(int a_frameNumber,
+	const QString & a_filePath, const QString & a_error, int a_generation)
+{
+	if(a_generation != m_generation)
+		return;
+
+	if(!a_error.isEmpty())
+	{
+		m_ui.feedbackTextEdit->addEntry(tr("Failed to save frame %1 to %2. %3")
+			.arg(a_frameNumber).arg(a_filePath).arg(a_error),
+			LOG_STYLE_ERROR);
+	}
+
+	frameDone(a_frameNumber, !a_error.isEmpty());
+}
+
+// END OF void FrameExportDialog::slotFrameExported(int a_frameNumber,
+//		const QString & a_filePath, const QString & a_error,
+//		int a_generation)
+//==============================================================================
+
+void FrameExportDialog::slotSourceChanged(int a_index)
+{
+	m_ui.framesEdit->setEnabled(a_index == 1);
+}
+
+// END OF void FrameExportDialog::slotSourceChanged(int a_index)
+//==============================================================================
+
+void FrameExportDialog::slotFormatChanged(int a_index)
+{
+	QString extension = m_ui.formatComboBox->itemData(a_index).toString();
+	bool webp = (extension == "webp");
+	// WebP has no deep color
+	if(webp)
+		m_ui.bitDepthComboBox->setCurrentIndex(0);
+	m_ui.bitDepthComboBox->setEnabled((!webp) &&
+		(m_ui.bitDepthComboBox->count() > 1));
+	m_ui.qualitySpinBox->setEnabled(webp);
+}
+
+// END OF void FrameExportDialog::slotFormatChanged(int a_index)
+//==============================================================================
+
+void FrameExportDialog::slotBrowseButtonPressed()
+{
+	QString directory = QFileDialog::getExistingDirectory(this,
+		tr("Export frames to"), m_ui.directoryEdit->text());
+	if(!directory.isEmpty())
+		m_ui.directoryEdit->setText(QDir::toNativeSeparators(directory));
+}
+
+// END OF void FrameExportDialog::slotBrowseButtonPressed()
+//==============================================================================
+
+void FrameExportDialog::slotStartStopButtonPressed()
+{
+	if(m_processing)
+	{
+		stopProcessing();
+		return;
+	}
+
+	if((!m_pVapourSynthScriptProcessor->isInitialized()) || (!m_cpVideoInfo))
+		return;
+
+	m_template = m_ui.templateEdit->text().trimmed();
+	if((!m_template.contains("{frame}")) && (!m_template.contains("{index}")))
+	{
+		m_ui.feedbackTextEdit->addEntry(tr("The file name template needs "
+			"{frame} or {index} to tell the files apart."), LOG_STYLE_WARNING);
+		return;
+	}
+
+	m_directory = QDir::fromNativeSeparators(m_ui.directoryEdit->text());
+	if(m_directory.isEmpty() || (!QDir().mkpath(m_directory)))
+	{
+		m_ui.feedbackTextEdit->addEntry(tr("Can not write to directory "
+			"\"%1\".").arg(m_ui.directoryEdit->text()), LOG_STYLE_ERROR);
+		return;
+	}
+
+	QVector<ExportFrame> frames;
+	if(m_ui.sourceComboBox->currentIndex() == 0)
+	{
+		for(const BookmarkData & bookmark : m_bookmarks)
+			frames.append({bookmark.frame, bookmark.title});
+	}
+	else
+	{
+		QString error;
+		frames = parseFrameList(m_ui.framesEdit->text(), &error);
+		if(!error.isEmpty())
+		{
+			m_ui.feedbackTextEdit->addEntry(error, LOG_STYLE_WARNING);
+			return;
+		}
+	}
+
+	// a frame is saved once, under the first title it has
+	m_frames.clear();
+	std::set<int> listed;
+	int framesOutside = 0;
+	for(const ExportFrame & frame : frames)
+	{
+		if((frame.frameNumber < 0) ||
+			(frame.frameNumber >= m_cpVideoInfo->numFrames))
+		{
+			framesOutside++;
+			continue;
+		}
+		if(listed.insert(frame.frameNumber).second)
+			m_frames.append(frame);
+	}
+	if(framesOutside > 0)
+	{
+		m_ui.feedbackTextEdit->addEntry(tr("%1 frames are outside of the "
+			"clip and are skipped.").arg(framesOutside), LOG_STYLE_WARNING);
+	}
+	if(m_frames.isEmpty())
+	{
+		m_ui.feedbackTextEdit->addEntry(tr("There are no frames to export."),
+			LOG_STYLE_WARNING);
+		return;
+	}
+
+	m_extension = m_ui.formatComboBox->currentData().toString();
+	m_format = (m_extension == "tif") ? QByteArray("tiff") :
+		m_extension.toLatin1();
+	// PNG keeps the default compression, the lowest is too slow for batches
+	m_quality = (m_extension == "webp") ? m_ui.qualitySpinBox->value() : -1;
+	m_deepColor = (m_ui.bitDepthComboBox->currentData().toInt() > 8);
+	m_pVapourSynthScriptProcessor->setPreviewBitDepth(m_deepColor ? 16 : 8);
+
+	m_pSettingsManager->setFrameExportFileNameTemplate(m_template);
+	m_pSettingsManager->setFrameExportDirectory(m_directory);
+
+	m_generation++;
+	m_nextIndex = 0;
+	m_framesDone = 0;
+	m_framesFailed = 0;
+	m_framesInFlight.clear();
+	m_requestsLimit = std::max(2, std::min(QThread::idealThreadCount(),
+		MAX_EXPORT_FRAMES_IN_FLIGHT));
+
+	m_ui.processingProgressBar->setMaximum(m_frames.size());
+	m_ui.processingProgressBar->setValue(0);
+	m_ui.startStopButton->setText(tr("Stop"));
+	m_ui.settingsWidget->setEnabled(false);
+	m_ui.feedbackTextEdit->addEntry(tr("Exporting %1 frames to %2.")
+		.arg(m_frames.size()).arg(QDir::toNativeSeparators(m_directory)));
+
+	m_processing = true;
+	requestFrames();
+}
+
+// END OF void FrameExportDialog::slotStartStopButtonPressed()
+//==============================================================================
+
+void FrameExportDialog::stopProcessing()
+{
+	if(!m_processing)
+		return;
+
+	m_processing = false;
+	// tasks already queued still save their frames, the results are dropped
+	m_generation++;
+	m_pVapourSynthScriptProcessor->flushFrameTicketsQueue();
+	m_framesInFlight.clear();
+
+	if(m_framesDone < m_frames.size())
+	{
+		m_ui.feedbackTextEdit->addEntry(tr("Stopped after %1 of %2 frames.")
+			.arg(m_framesDone).arg(m_frames.size()));
+	}
+	else
+	{
+		QString message = tr("Saved %1 frames.")
+			.arg(m_framesDone - m_framesFailed);
+		if(m_framesFailed > 0)
+			message += " " + tr("%1 frames failed.").arg(m_framesFailed);
+		m_ui.feedbackTextEdit->addEntry(message, (m_framesFailed > 0) ?
+			LOG_STYLE_WARNING : LOG_STYLE_DEFAULT);
+	}
+
+	m_ui.startStopButton->setText(tr("Export"));
+	m_ui.settingsWidget->setEnabled(true);
+	setWindowTitle(tr("Export frames: %1").arg(scriptName()));
+}
+
+// END OF void FrameExportDialog::stopProcessing()
+//==============================================================================
+
+void FrameExportDialog::requestFrames()
+{
+	while(m_processing && (m_nextIndex < m_frames.size()) &&
+		(m_nextIndex - m_framesDone < m_requestsLimit))
+	{
+		int index = m_nextIndex++;
+		int frameNumber = m_frames[index].frameNumber;
+		m_framesInFlight[frameNumber] = index;
+		if(!m_pVapourSynthScriptProcessor->requestFrameAsync(frameNumber, 0,
+			true))
+		{
+			m_framesInFlight.erase(frameNumber);
+			m_ui.feedbackTextEdit->addEntry(tr("Frame %1 was not requested. "
+				"%2").arg(frameNumber)
+				.arg(m_pVapourSynthScriptProcessor->error()),
+				LOG_STYLE_WARNING);
+			m_framesDone++;
+			m_framesFailed++;
+		}
+	}
+
+	if(m_processing && (m_framesDone == m_frames.size()))
+		stopProcessing();
+}
+
+// END OF void FrameExportDialog::requestFrames()
+//==============================================================================
+
+void FrameExportDialog::frameDone(int a_frameNumber, bool a_failed)
+{
+	(void)a_frameNumber;
+
+	m_framesDone++;
+	if(a_failed)
+		m_framesFailed++;
+
+	m_ui.processingProgressBar->setValue(m_framesDone);
+	int percents = m_framesDone * 100 / m_frames.size();
+	setWindowTitle(tr("%1% Export frames: %2").arg(percents)
+		.arg(scriptName()));
+
+	requestFrames();
+}
+
+// END OF void FrameExportDialog::frameDone(int a_frameNumber, bool a_failed)
+//==============================================================================
+
+QVector<FrameExportDialog::ExportFrame> FrameExportDialog::parseFrameList(
+	const QString & a_text, QString * a_pError) const
+{
+	static const QRegularExpression itemExpression(
+		"^(\\d+)(?:\\s*-\\s*(\\d+)(?:\\s*/\\s*(\\d+))?)?$");
+
+	QVector<ExportFrame> frames;
+	for(const QString & item : a_text.split(',', QString::SkipEmptyParts))
+	{
+		QString trimmed = item.trimmed();
+		QRegularExpressionMatch match = itemExpression.match(trimmed);
+		if(!match.hasMatch())
+		{
+			*a_pError = tr("Can not read \"%1\" of the frame list. Use frame "
+				"numbers and ranges like 0-100 or 0-100/10.").arg(trimmed);
+			return QVector<ExportFrame>();
+		}
+
+		int first = match.captured(1).toInt();
+		int last = match.captured(2).isEmpty() ? first :
+			match.captured(2).toInt();
+		int step = match.captured(3).isEmpty() ? 1 :
+			match.captured(3).toInt();
+		if((last < first) || (step < 1))
+		{
+			*a_pError = tr("Range \"%1\" of the frame list is empty.")
+				.arg(trimmed);
+			return QVector<ExportFrame>();
+		}
+
+		for(int frame = first; frame <= last; frame += step)
+			frames.append({frame, QString()});
+	}
+
+	return frames;
+}
+
+// END OF QVector<FrameExportDialog::ExportFrame>
+//		FrameExportDialog::parseFrameList(const QString & a_text,
+//		QString * a_pError) const
+//==============================================================================
+
+QString FrameExportDialog::filePath(const ExportFrame & a_frame,
+	int a_index) const
+{
+	Q_ASSERT(m_cpVideoInfo);
+
+	QString scriptBaseName = QFileInfo(scriptName()).completeBaseName();
+	if(scriptBaseName.isEmpty())
+		scriptBaseName = "clip";
+
+	// padded numbers keep the files in order
+	int frameDigits = QString::number(m_cpVideoInfo->numFrames - 1).size();
+	int indexDigits = QString::number(m_frames.size()).size();
+
+	QString fileName = m_template;
+	fileName.replace("{script}", fileNameSafe(scriptBaseName));
+	fileName.replace("{frame}", QString("%1").arg(a_frame.frameNumber,
+		frameDigits, 10, QChar('0')));
+	fileName.replace("{index}", QString("%1").arg(a_index + 1, indexDigits,
+		10, QChar('0')));
+	fileName.replace("{title}", fileNameSafe(a_frame.title));
+
+	return QDir(m_directory).filePath(fileName + "." + m_extension);
+}
+
+// END OF QString FrameExportDialog::filePath(const ExportFrame & a_frame,
+//		int a_index) const
+//==============================================================================
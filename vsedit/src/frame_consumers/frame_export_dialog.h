@@ -0,0 +1,111 @@
+#ifndef FRAME_EXPORT_DIALOG_H_INCLUDED
+#define FRAME_EXPORT_DIALOG_H_INCLUDED
+
+#include <ui_frame_export_dialog.h>
+
+#include "../vapoursynth/vs_script_processor_dialog.h"
+#include "../../../common-src/settings/settings_definitions.h"
+
+#include <QVector>
+#include <map>
+
+class QThreadPool;
+
+/// Saves a list of frames as images. Frames are rendered in parallel
+/// and encoded on a thread pool, 16 bit PNG and TIFF come from
+/// an RGB48 conversion of the output clip.
+class FrameExportDialog : public VSScriptProcessorDialog
+{
+	Q_OBJECT
+
+public:
+
+	FrameExportDialog(SettingsManager * a_pSettingsManager,
+		VSScriptLibrary * a_pVSScriptLibrary,
+		QWidget * a_pParent = nullptr);
+	virtual ~FrameExportDialog() override;
+
+	virtual bool initialize(const QString & a_script,
+		const QString & a_scriptName) override;
+
+	// bookmark titles are available to the file name template
+	void setBookmarks(const QVector<BookmarkData> & a_bookmarks);
+
+public slots:
+
+	void call();
+
+protected slots:
+
+	virtual void slotWriteLogMessage(int a_messageType,
+		const QString & a_message) override;
+
+	virtual void slotReceiveFrame(int a_frameNumber, int a_outputIndex,
+		const VSFrameRef * a_cpOutputFrameRef,
+		const VSFrameRef * a_cpPreviewFrameRef) override;
+
+	virtual void slotFrameRequestDiscarded(int a_frameNumber,
+		int a_outputIndex, const QString & a_reason) override;
+
+	void slotFrameExported(int a_frameNumber, const QString & a_filePath,
+		const QString & a_error, int a_generation);
+
+	void slotSourceChanged(int a_index);
+
+	void slotFormatChanged(int a_index);
+
+	void slotBrowseButtonPressed();
+
+	void slotStartStopButtonPressed();
+
+protected:
+
+	struct ExportFrame
+	{
+		int frameNumber;
+		QString title;
+	};
+
+	virtual void stopAndCleanUp() override;
+
+	void stopProcessing();
+
+	void requestFrames();
+
+	void frameDone(int a_frameNumber, bool a_failed);
+
+	// frames of the list edit like "0-100/10, 250", empty on error
+	QVector<ExportFrame> parseFrameList(const QString & a_text,
+		QString * a_pError) const;
+
+	QString filePath(const ExportFrame & a_frame, int a_index) const;
+
+	Ui::FrameExportDialog m_ui;
+
+	QThreadPool * m_pThreadPool;
+
+	QVector<BookmarkData> m_bookmarks;
+
+	bool m_processing;
+
+	// results of tasks from a stopped export are ignored
+	int m_generation;
+
+	QVector<ExportFrame> m_frames;
+	int m_nextIndex;
+	int m_framesDone;
+	int m_framesFailed;
+	int m_requestsLimit;
+
+	// requested frames and their index in m_frames
+	std::map<int, int> m_framesInFlight;
+
+	QString m_directory;
+	QString m_template;
+	QByteArray m_format;
+	QString m_extension;
+	int m_quality;
+	bool m_deepColor;
+};
+
+#endif // FRAME_EXPORT_DIALOG_H_INCLUDED
@@ -1,4 +1,8 @@
 #include "main_window.h"
+#include "preview/video_scopes_builder.h"
+#include "frame_consumers/clip_metrics.h"
+#include "selection_tools/region_statistics.h"
+#include "vapoursynth/vs_plugins_metadata_cache.h"
 
 #include "../../common-src/log/vs_editor_log.h"
 #include "../../common-src/kdsingleapplication/kdsingleapplication.h"
@@ -82,6 +86,11 @@ int main(int argc, char *argv[])
 
         qRegisterMetaType<const VSFrameRef *>("const VSFrameRef *");
         qRegisterMetaType<VSNodeRef *>("VSNodeRef *");
+        qRegisterMetaType<VideoScopes>("VideoScopes");
+        qRegisterMetaType<VideoScopesJob>("VideoScopesJob");
+        qRegisterMetaType<FrameMetrics>("FrameMetrics");
+        qRegisterMetaType<RegionStatistics>("RegionStatistics");
+        qRegisterMetaType<VSPluginsMetadata>("VSPluginsMetadata");
 
         if (argc >= 2) {
             QString canonicalPath = vsedit::CLIArgToLongPathName(argv[1]);
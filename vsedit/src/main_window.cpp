@@ -3,10 +3,12 @@
 #include "ui_main_window.h"
 #include "preview/script_processor.h"
 #include "preview/frame_info_dialog.h"
+#include "preview/scopes_dialog.h"
 #include "preview/preview_advanced_settings_dialog.h"
 #include "preview/frame_painter.h"
 #include "preview_filters/preview_filters_dialog.h"
 #include "selection_tools/selection_tools_dialog.h"
+#include "selection_tools/region_statistics_dialog.h"
 #include "../../common-src/qt_widgets_subclasses/collapse_expand_widget.h"
 #include "../../common-src/log/vs_editor_log.h"
 #include "../../common-src/vapoursynth/vapoursynth_script_processor.h"
@@ -17,6 +19,8 @@
 #include "settings/settings_dialog.h"
 
 #include "frame_consumers/benchmark_dialog.h"
+#include "frame_consumers/clip_metrics_dialog.h"
+#include "frame_consumers/frame_export_dialog.h"
 #include "frame_consumers/encode_dialog.h"
 #include "script_templates/templates_dialog.h"
 #include "job_server_watcher_socket.h"
@@ -42,14 +46,19 @@ MainWindow::MainWindow(QWidget *a_pParent) :
   , m_pVapourSynthPluginsManager(nullptr)  
   , m_pStatusBarWidget(nullptr)
   , m_pBenchmarkDialog(nullptr)
+  , m_pClipMetricsDialog(nullptr)
+  , m_pFrameExportDialog(nullptr)
   , m_pEncodeDialog(nullptr)
   , m_pTemplatesDialog(nullptr)
   , m_pPreviewAdvancedSettingsDialog(nullptr)
   , m_pSelectionToolsDialog(nullptr)
+  , m_pRegionStatisticsDialog(nullptr)
+  , m_pScopesDialog(nullptr)
 
   , m_pPreviewContextMenu(nullptr)
   , m_pActionFrameToClipboard(nullptr)
   , m_pActionSaveSnapshot(nullptr)
+  , m_pActionExportFrames(nullptr)
   , m_pMenuZoomModes(nullptr)
   , m_pActionGroupZoomModes(nullptr)
   , m_pActionSetZoomModeNoZoom(nullptr)
@@ -76,18 +85,16 @@ MainWindow::MainWindow(QWidget *a_pParent) :
   , m_pActionShowFrameInfoDialog(nullptr)
   , m_pActionShowPreivewFiltersDialog(nullptr)
   , m_pActionShowSelectionToolsDialog(nullptr)
+  , m_pActionShowScopesDialog(nullptr)
   , m_pActionVapourSynthVersion(nullptr)
   , m_pActionAbout(nullptr)
   , m_playing(false)
   , m_closingApp(false)
   , m_closingTab(false)
   , m_rightClickedTab(-1)
-
-  , m_pGeometrySaveTimer(nullptr)
 {
     m_ui->setupUi(this);
 
-    createGeometrySaveTimer();
     createSettingDialog();
     createBookmarkManager();
     createTemplatesDialog();
@@ -120,8 +127,12 @@ MainWindow::MainWindow(QWidget *a_pParent) :
     setUpZoomPanel();
 
     createBenchmarkDialog();
+    createClipMetricsDialog();
+    createFrameExportDialog();
+    createRegionStatisticsDialog();
     createEncodeDialog();
     createFrameInfoDialog();
+    createScopesDialog();
 
     createJobServerWatcher();
 
@@ -136,11 +147,6 @@ MainWindow::~MainWindow()
 {
     delete m_ui;
 
-    if(m_pGeometrySaveTimer->isActive())
-    {
-        m_pGeometrySaveTimer->stop();
-        slotSaveGeometry();
-    }
     qInstallMessageHandler(nullptr);
     destroyOrphanQObjects();
 }
@@ -194,6 +200,16 @@ void MainWindow::createTab(const QString & a_tabName,
     connect(ep.processor, &ScriptProcessor::signalFrameChanged, // frame change
             this, &MainWindow::slotProcessorFrameChanged);
 
+    connect(ep.processor, &ScriptProcessor::signalPlaybackStatsChanged,
+            this, &MainWindow::slotPlaybackStatsChanged);
+
+    // thumbnails and metrics under the timeline ruler
+    connect(ep.processor, &ScriptProcessor::signalTimeLineStripChanged,
+            this, &MainWindow::slotTimeLineStripChanged);
+
+    connect(ep.processor, &ScriptProcessor::signalScopesChanged,
+            this, &MainWindow::slotScopesChanged);
+
     // signal to roll back frame when a frame request is discarded, update timeline
     connect(ep.processor, &ScriptProcessor::signalRollBackFrame,
             m_ui->timeLineView, &TimeLineView::setFrame);
@@ -319,6 +335,9 @@ void MainWindow::createSettingDialog()
     m_pVapourSynthPluginsManager = new VapourSynthPluginsManager(m_pSettingsManager, this);
     m_vsPluginsList = m_pVapourSynthPluginsManager->pluginsList();
     m_vsPyScriptsList = m_pVapourSynthPluginsManager->pyScriptsList();
+    connect(m_pVapourSynthPluginsManager,
+            &VapourSynthPluginsManager::signalPluginsListChanged,
+            this, &MainWindow::slotPluginsListChanged);
 
     connect(m_pVSScriptLibrary, &VSScriptLibrary::signalWriteLogMessage,
         this, QOverload<int, const QString &>::of(&MainWindow::slotWriteLogMessage));
@@ -347,6 +366,24 @@ void MainWindow::createBenchmarkDialog()
             this, SLOT(slotWriteLogMessage(int, const QString &)));
 }
 
+void MainWindow::createClipMetricsDialog()
+{
+    m_pClipMetricsDialog = new ClipMetricsDialog(m_pSettingsManager, m_pVSScriptLibrary);
+    connect(m_pClipMetricsDialog,
+            SIGNAL(signalWriteLogMessage(int, const QString &)),
+            this, SLOT(slotWriteLogMessage(int, const QString &)));
+    connect(m_pClipMetricsDialog, &ClipMetricsDialog::signalCurvesChanged,
+            this, &MainWindow::updateClipMetricsCurves);
+}
+
+void MainWindow::createFrameExportDialog()
+{
+    m_pFrameExportDialog = new FrameExportDialog(m_pSettingsManager, m_pVSScriptLibrary);
+    connect(m_pFrameExportDialog,
+            SIGNAL(signalWriteLogMessage(int, const QString &)),
+            this, SLOT(slotWriteLogMessage(int, const QString &)));
+}
+
 void MainWindow::createEncodeDialog()
 {
     m_pEncodeDialog = new EncodeDialog(m_pSettingsManager, m_pVSScriptLibrary);
@@ -422,6 +459,43 @@ void MainWindow::createFrameInfoDialog()
             this, [=](){ m_pActionShowFrameInfoDialog->setChecked(false);});
 }
 
+void MainWindow::createScopesDialog()
+{
+    m_pScopesDialog = new ScopesDialog(m_pSettingsManager, this);
+
+    connect(m_pScopesDialog, &ScopesDialog::signalDialogShown,
+            this, &MainWindow::updateScopesEnabled);
+    connect(m_pScopesDialog, &ScopesDialog::signalDialogHidden,
+            this, [=](){
+        m_pActionShowScopesDialog->setChecked(false);
+        updateScopesEnabled();
+    });
+}
+
+void MainWindow::updateScopesEnabled()
+{
+    bool visible = m_pScopesDialog->isVisible();
+    int currentTabIndex = m_ui->scriptTabWidget->currentIndex();
+
+    for (int i = 0; i < m_pEditorPreviewVector.count(); ++i)
+        m_pEditorPreviewVector[i].processor->setScopesEnabled(
+            visible && (i == currentTabIndex));
+}
+
+void MainWindow::updateClipMetricsCurves()
+{
+    int currentTabIndex = m_ui->scriptTabWidget->currentIndex();
+    std::vector<TimeLineCurve> curves;
+
+    if ((currentTabIndex >= 0) && (currentTabIndex < m_pEditorPreviewVector.count())) {
+        QString scriptName = m_pEditorPreviewVector[currentTabIndex].scriptName;
+        if (m_pClipMetricsDialog->measuredClipIds().contains(scriptName))
+            curves = m_pClipMetricsDialog->timeLineCurves();
+    }
+
+    m_ui->timeLineView->setCurves(curves);
+}
+
 void MainWindow::createBookmarkManager()
 {
     m_pBookmarkManagerDialog = new BookmarkManagerDialog(m_pSettingsManager, this);
@@ -474,6 +548,17 @@ void MainWindow::createSelectionToolsDialog()
 
     connect(m_pSelectionToolsDialog, &SelectionToolsDialog::signalPasteSelectionPointsString,
             this, &MainWindow::slotPasteSelectionPointsToScript);
+
+    connect(m_pSelectionToolsDialog, &SelectionToolsDialog::signalRegionStatisticsRequested,
+            this, &MainWindow::slotRegionStatistics);
+}
+
+void MainWindow::createRegionStatisticsDialog()
+{
+    m_pRegionStatisticsDialog = new RegionStatisticsDialog(m_pSettingsManager, m_pVSScriptLibrary);
+    connect(m_pRegionStatisticsDialog,
+            SIGNAL(signalWriteLogMessage(int, const QString &)),
+            this, SLOT(slotWriteLogMessage(int, const QString &)));
 }
 
 void MainWindow::setTabs()
@@ -590,6 +675,8 @@ void MainWindow::createMenuActionsAndContextMenuActions()
 
         {&m_pActionBenchmark, ACTION_ID_BENCHMARK, false, QString(),
             this, SLOT(slotBenchmark())},
+        {&m_pActionClipMetrics, ACTION_ID_CLIP_METRICS, false, QString(),
+            this, SLOT(slotClipMetrics())},
         {&m_pActionEncode, ACTION_ID_CLI_ENCODE, false, QString(),
             this, SLOT(slotEncode())},
         {&m_pActionEnqueueEncodeJob, ACTION_ID_ENQUEUE_ENCODE_JOB, false, QString(),
@@ -600,6 +687,8 @@ void MainWindow::createMenuActionsAndContextMenuActions()
             this, SLOT(slotFrameToClipboard())},
         {&m_pActionSaveSnapshot, ACTION_ID_SAVE_SNAPSHOT, false, QString(),
             this, SLOT(slotSaveSnapshot())},
+        {&m_pActionExportFrames, ACTION_ID_EXPORT_FRAMES, false, QString(),
+            this, SLOT(slotExportFrames())},
         {&m_pActionShowBookmarkManager, ACTION_ID_SHOW_BOOKMARK_MANAGER, true, QString(),
             this, SLOT(slotShowBookmarkManager(bool))},
         {&m_pActionShowFrameInfoDialog, ACTION_ID_SHOW_FRAME_INFO_DIALOG, true, QString(),
@@ -608,6 +697,8 @@ void MainWindow::createMenuActionsAndContextMenuActions()
             this, SLOT(slotShowPreviewFiltersDialog(bool))},
         {&m_pActionShowSelectionToolsDialog, ACTION_ID_SHOW_SELECTION_TOOLS_DIALOG, true, QString(),
             this, SLOT(slotShowSelectionToolsDialog(bool))},
+        {&m_pActionShowScopesDialog, ACTION_ID_SHOW_SCOPES_DIALOG, true, QString(),
+            this, SLOT(slotShowScopesDialog(bool))},
 
         {&m_pActionVapourSynthVersion, ACTION_ID_VAPOURSYNTH_VERSION, false, QString(),
             this, SLOT(slotVapourSynthVersion())},
@@ -637,6 +728,16 @@ void MainWindow::createMenuActionsAndContextMenuActions()
             this, SLOT(slotCallAdvancedSettingsDialog())},
         {&m_pActionPlay, ACTION_ID_PLAY, true, QString(),
             this, SLOT(slotPlay(bool))},
+        {&m_pActionToggleTimeLineStrip, ACTION_ID_TOGGLE_TIMELINE_STRIP, true, QString(),
+            this, SLOT(slotToggleTimeLineStrip(bool))},
+        {&m_pActionToggleDropLateFrames, ACTION_ID_TOGGLE_DROP_LATE_FRAMES, true, QString(),
+            this, SLOT(slotToggleDropLateFrames(bool))},
+        {&m_pActionSetPreviewProxyOff, ACTION_ID_SET_PREVIEW_PROXY_OFF, true, QString(),
+            this, SLOT(slotPreviewProxyModeChanged())},
+        {&m_pActionSetPreviewProxyViewport, ACTION_ID_SET_PREVIEW_PROXY_VIEWPORT, true, QString(),
+            this, SLOT(slotPreviewProxyModeChanged())},
+        {&m_pActionSetPreviewProxyFraction, ACTION_ID_SET_PREVIEW_PROXY_FRACTION, true, QString(),
+            this, SLOT(slotPreviewProxyModeChanged())},
 //        {&m_pActionBookmarkCurrentFrame,
 //         ACTION_ID_TIMELINE_BOOKMARK_CURRENT_FRAME,
 //         false, SLOT(slotBookmarkCurrentFrame())},
@@ -721,6 +822,7 @@ void MainWindow::createMenuActionsAndContextMenuActions()
     pScriptMenu->addAction(m_pActionCheckScript);
     pScriptMenu->addAction(m_pActionReleaseMemory);
     pScriptMenu->addAction(m_pActionBenchmark);
+    pScriptMenu->addAction(m_pActionClipMetrics);
     pScriptMenu->addAction(m_pActionEncode);
     pScriptMenu->addAction(m_pActionEnqueueEncodeJob);
     pScriptMenu->addAction(m_pActionJobs);
@@ -730,8 +832,14 @@ void MainWindow::createMenuActionsAndContextMenuActions()
     QMenu * pVideoMenu = m_ui->menuBar->addMenu(tr("Video"));
     pVideoMenu->addAction(m_pActionPlay);
     m_pActionPlay->setChecked(false);
+    pVideoMenu->addAction(m_pActionToggleDropLateFrames);
+    m_pActionToggleDropLateFrames->blockSignals(true);
+    m_pActionToggleDropLateFrames->setChecked(
+        m_pSettingsManager->getPlaybackDropLateFrames());
+    m_pActionToggleDropLateFrames->blockSignals(false);
     pVideoMenu->addAction(m_pActionFrameToClipboard);
     pVideoMenu->addAction(m_pActionSaveSnapshot);
+    pVideoMenu->addAction(m_pActionExportFrames);
 
     //------------------------------------------------------------------------------
 
@@ -767,10 +875,53 @@ void MainWindow::createMenuActionsAndContextMenuActions()
             action.pAction->setChecked(true);
     }
 
+//------------------------------------------------------------------------------
+
+    m_pMenuPreviewProxyModes = new QMenu(pVideoMenu);
+    m_pMenuPreviewProxyModes->setTitle(tr("Scrubbing proxy"));
+    pVideoMenu->addMenu(m_pMenuPreviewProxyModes);
+
+    m_pActionGroupPreviewProxyModes = new QActionGroup(pVideoMenu);
+
+    PreviewProxyMode previewProxyMode = m_pSettingsManager->getPreviewProxyMode();
+
+    struct PreviewProxyModeAction
+    {
+        QAction * pAction;
+        PreviewProxyMode mode;
+    };
+
+    PreviewProxyModeAction previewProxyModeActions[] =
+    {
+        {m_pActionSetPreviewProxyOff, PreviewProxyMode::Off},
+        {m_pActionSetPreviewProxyViewport, PreviewProxyMode::Viewport},
+        {m_pActionSetPreviewProxyFraction, PreviewProxyMode::Fraction},
+    };
+
+    for(PreviewProxyModeAction & action : previewProxyModeActions)
+    {
+        QString id = action.pAction->data().toString();
+        action.pAction->setActionGroup(m_pActionGroupPreviewProxyModes);
+        m_pMenuPreviewProxyModes->addAction(action.pAction);
+        m_actionIDToPreviewProxyModeMap[id] = action.mode;
+        if(previewProxyMode == action.mode)
+        {
+            action.pAction->blockSignals(true);
+            action.pAction->setChecked(true);
+            action.pAction->blockSignals(false);
+        }
+    }
+
 //------------------------------------------------------------------------------
 
     pVideoMenu->addAction(m_pActionPasteShownFrameNumberIntoScript);
     pVideoMenu->addSeparator();
+    pVideoMenu->addAction(m_pActionToggleTimeLineStrip);
+    bool stripVisible = m_pSettingsManager->getTimeLineStripVisible();
+    m_pActionToggleTimeLineStrip->blockSignals(true);
+    m_pActionToggleTimeLineStrip->setChecked(stripVisible);
+    m_pActionToggleTimeLineStrip->blockSignals(false);
+    m_ui->timeLineView->setStripVisible(stripVisible);
     pVideoMenu->addAction(m_pActionAdvancedSettingsDialog);
 
 //------------------------------------------------------------------------------
@@ -798,6 +949,11 @@ void MainWindow::createMenuActionsAndContextMenuActions()
     m_ui->selectionToolsButton->setDefaultAction(m_pActionShowSelectionToolsDialog);
     m_ui->selectionToolsButton->setToolButtonStyle(Qt::ToolButtonTextOnly);
 
+    m_pActionShowScopesDialog->setIconText("SC");
+    pWindowMenu->addAction(m_pActionShowScopesDialog);
+    m_ui->scopesButton->setDefaultAction(m_pActionShowScopesDialog);
+    m_ui->scopesButton->setToolButtonStyle(Qt::ToolButtonTextOnly);
+
 //------------------------------------------------------------------------------
 
     QMenu * pHelpMenu = m_ui->menuBar->addMenu(tr("Help"));
@@ -1240,23 +1396,19 @@ double MainWindow::YCoCgValueAtPoint(size_t a_x, size_t a_y, int a_plane, const
     return value;
 }
 
-void MainWindow::createGeometrySaveTimer()
-{
-    m_pGeometrySaveTimer = new QTimer(this);
-    m_pGeometrySaveTimer->setInterval(DEFAULT_WINDOW_GEOMETRY_SAVE_DELAY);
-    connect(m_pGeometrySaveTimer, &QTimer::timeout,
-            this, &MainWindow::slotSaveGeometry);
-}
-
 void MainWindow::createGarbageCollection()
 {
     m_orphanQObjects =
     {
         reinterpret_cast<QObject **>(&m_pSettingsDialog),
         reinterpret_cast<QObject **>(&m_pBenchmarkDialog),
+        reinterpret_cast<QObject **>(&m_pClipMetricsDialog),
+        reinterpret_cast<QObject **>(&m_pFrameExportDialog),
+        reinterpret_cast<QObject **>(&m_pRegionStatisticsDialog),
         reinterpret_cast<QObject **>(&m_pEncodeDialog),
         reinterpret_cast<QObject **>(&m_pTemplatesDialog),
         reinterpret_cast<QObject **>(&m_pFrameInfoDialog),
+        reinterpret_cast<QObject **>(&m_pScopesDialog),
         reinterpret_cast<QObject **>(&m_pPreviewAdvancedSettingsDialog),
         reinterpret_cast<QObject **>(&m_pBookmarkManagerDialog)
     };
@@ -1452,6 +1604,7 @@ void MainWindow::slotChangeScriptTab(int a_index)
 
         slotSetTimeLineAndIndicator(vsVideoInfo->numFrames, vsVideoInfo->fpsNum, vsVideoInfo->fpsDen);
         m_ui->timeLineView->setZoomFactor(savedZoomRatio);
+        m_ui->timeLineView->setStrip(processor->timeLineStrip());
 
         /* resume frame zoom ratio and scroll bar position */
         PreviewArea * previewArea = m_pEditorPreviewVector[a_index].previewArea;
@@ -1487,8 +1640,18 @@ void MainWindow::slotChangeScriptTab(int a_index)
         // set satusbar to null
         m_pStatusBarWidget->hide();
         m_ui->timeLineView->setEnabled(false);
+        m_ui->timeLineView->setStrip(TimeLineStrip());
+    }
+
+    // scopes follow the frames of the current tab
+    if (m_pScopesDialog) {
+        m_pScopesDialog->clearScopes();
+        updateScopesEnabled();
     }
 
+    if (m_pClipMetricsDialog)
+        updateClipMetricsCurves();
+
     // a workaround to update tabName after a removeTab call. The issue was caused
     // by the tabchanged signal being fired before removetab function finished
     if (m_closingTab) {
@@ -1677,6 +1840,11 @@ void MainWindow::slotShowSelectionToolsDialog(bool a_visible)
     m_pSelectionToolsDialog->setVisible(a_visible);
 }
 
+void MainWindow::slotShowScopesDialog(bool a_visible)
+{
+    m_pScopesDialog->setVisible(a_visible);
+}
+
 void MainWindow::slotZoomModeChanged()
 {
     int currentIndex = m_ui->scriptTabWidget->currentIndex();
@@ -1795,6 +1963,13 @@ void MainWindow::slotPreviewAreaSizeChanged()
 {
     double ratio = currentPreviewZoomRatio();
     slotZoomRatioChanged(ratio);
+
+    // proxy frames for scrubbing are sized to the viewport
+    PreviewArea * previewArea = qobject_cast<PreviewArea *>(sender());
+    for (EditorPreview & ep : m_pEditorPreviewVector) {
+        if (ep.previewArea == previewArea)
+            ep.processor->setPreviewViewportSize(previewArea->viewport()->size());
+    }
 }
 
 void MainWindow::slotPreviewAreaMouseOverPoint(float a_normX, float a_normY)
@@ -1968,6 +2143,69 @@ void MainWindow::slotPlay(bool a_play)
     m_ui->timeLineView->setPlay(playing); // passing the flag into timeline
 }
 
+void MainWindow::slotToggleTimeLineStrip(bool a_visible)
+{
+    m_pSettingsManager->setTimeLineStripVisible(a_visible);
+
+    // builders only run while the strip is shown
+    for (EditorPreview & ep : m_pEditorPreviewVector)
+        ep.processor->setTimeLineStripEnabled(a_visible);
+
+    m_ui->timeLineView->setStripVisible(a_visible);
+}
+
+void MainWindow::slotToggleDropLateFrames(bool a_drop)
+{
+    m_pSettingsManager->setPlaybackDropLateFrames(a_drop);
+
+    for (EditorPreview & ep : m_pEditorPreviewVector)
+        ep.processor->setDropLateFrames(a_drop);
+}
+
+void MainWindow::slotPreviewProxyModeChanged()
+{
+    QAction * pSenderAction = qobject_cast<QAction *>(sender());
+    if (!pSenderAction || !pSenderAction->isChecked())
+        return;
+
+    PreviewProxyMode mode =
+        m_actionIDToPreviewProxyModeMap[pSenderAction->data().toString()];
+    m_pSettingsManager->setPreviewProxyMode(mode);
+
+    for (EditorPreview & ep : m_pEditorPreviewVector)
+        ep.processor->setPreviewProxyMode(mode);
+}
+
+void MainWindow::slotPlaybackStatsChanged(bool a_playing, double a_renderedFps,
+    double a_shownFps, int a_droppedFrames, int a_prefetchDepth)
+{
+    ScriptProcessor * processor = qobject_cast<ScriptProcessor *>(sender());
+    if (!processor) return;
+
+    int currentTabIndex = m_ui->scriptTabWidget->currentIndex();
+    if (currentTabIndex < 0 || currentTabIndex >= m_pEditorPreviewVector.count())
+        return;
+    if (m_pEditorPreviewVector[currentTabIndex].processor != processor)
+        return;
+
+    m_pStatusBarWidget->setPlaybackStats(a_playing, a_renderedFps, a_shownFps,
+        a_droppedFrames, a_prefetchDepth);
+}
+
+void MainWindow::slotTimeLineStripChanged()
+{
+    ScriptProcessor * processor = qobject_cast<ScriptProcessor *>(sender());
+    if (!processor) return;
+
+    int currentTabIndex = m_ui->scriptTabWidget->currentIndex();
+    if (currentTabIndex < 0 || currentTabIndex >= m_pEditorPreviewVector.count())
+        return;
+    if (m_pEditorPreviewVector[currentTabIndex].processor != processor)
+        return;
+
+    m_ui->timeLineView->setStrip(processor->timeLineStrip());
+}
+
 void MainWindow::slotSetPlayFPSLimit()
 {
     if (!m_ui->playFpsLimitLineEdit->isReadOnly()) {
@@ -2035,6 +2273,20 @@ void MainWindow::slotUpdateFramePropsString(const QString &a_framePropsString)
     m_pFrameInfoDialog->setFramePropsString(a_framePropsString);
 }
 
+void MainWindow::slotScopesChanged(const VideoScopes &a_scopes)
+{
+    ScriptProcessor * processor = qobject_cast<ScriptProcessor *>(sender());
+    if (!processor) return;
+
+    int currentTabIndex = m_ui->scriptTabWidget->currentIndex();
+    if (currentTabIndex < 0 || currentTabIndex >= m_pEditorPreviewVector.count())
+        return;
+    if (m_pEditorPreviewVector[currentTabIndex].processor != processor)
+        return;
+
+    m_pScopesDialog->setScopes(a_scopes);
+}
+
 void MainWindow::slotEditorUndo()
 {
     int currentTabIndex = m_ui->scriptTabWidget->currentIndex();
@@ -2441,7 +2693,36 @@ void MainWindow::slotSendPixmapToSelectionCanvas()
     QPixmap *framePixmap = previewArea->framePixmap();
     if(framePixmap->isNull()) return;
 
-    m_pSelectionToolsDialog->setFramePixmap(*framePixmap);
+    const VSVideoInfo * cpVideoInfo = processor->vsVideoInfo();
+    if (!cpVideoInfo) return;
+
+    m_pSelectionToolsDialog->setFramePixmap(*framePixmap, processor->currentFrame(),
+        QSize(cpVideoInfo->width, cpVideoInfo->height));
+}
+
+void MainWindow::slotRegionStatistics(int a_frameNumber, const QRect &a_region)
+{
+    int currentTabIndex = m_ui->scriptTabWidget->currentIndex();
+    if (currentTabIndex < 0) return;
+
+    const EditorPreview & current = m_pEditorPreviewVector[currentTabIndex];
+    if (current.processor->script().isEmpty()) return;
+
+    // the dialog keeps its own core, it is only rebuilt for another script
+    if ((m_pRegionStatisticsDialog->script() != current.processor->script()) ||
+        (m_pRegionStatisticsDialog->scriptName() != current.scriptFilePath)) {
+        if (m_pRegionStatisticsDialog->busy()) {
+            m_logView->addEntry(tr("Region statistics dialog appears busy "
+                "processing frames. Stop tracking and wait for it to finish."),
+                LOG_STYLE_WARNING);
+            return;
+        }
+        if (!m_pRegionStatisticsDialog->initialize(current.processor->script(),
+            current.scriptFilePath))
+            return;
+    }
+
+    m_pRegionStatisticsDialog->measure(a_frameNumber, a_region);
 }
 
 void MainWindow::slotPasteSelectionPointsToScript(const QString &a_pointString)
@@ -2615,6 +2896,44 @@ void MainWindow::slotBenchmark()
 // END OF void MainWindow::slotBenchmark()
 //==============================================================================
 
+void MainWindow::slotClipMetrics()
+{
+    int currentTabIndex = m_ui->scriptTabWidget->currentIndex();
+    if (currentTabIndex < 0)
+        return;
+
+    const EditorPreview & current = m_pEditorPreviewVector[currentTabIndex];
+    if (current.group < 0) {
+        m_logView->addEntry(tr("Preview the script first. Clip metrics "
+            "compare clips of the same compare group."), LOG_STYLE_WARNING);
+        return;
+    }
+
+    // compare groups are made of the previewed scripts
+    ClipMetricsSource reference = {current.scriptName, current.tabName,
+        current.processor->script(), current.scriptFilePath};
+    QVector<ClipMetricsSource> candidates;
+    for (const EditorPreview & ep : m_pEditorPreviewVector) {
+        if ((ep.group != current.group) || (ep.scriptName == current.scriptName))
+            continue;
+        candidates.append({ep.scriptName, ep.tabName, ep.processor->script(),
+            ep.scriptFilePath});
+    }
+
+    if (candidates.isEmpty()) {
+        m_logView->addEntry(tr("There are no other clips in the compare "
+            "group of %1. Preview a script with the same frame number and "
+            "size to compare it.").arg(current.tabName), LOG_STYLE_WARNING);
+        return;
+    }
+
+    m_pClipMetricsDialog->setClips(reference, candidates);
+    m_pClipMetricsDialog->call();
+}
+
+// END OF void MainWindow::slotClipMetrics()
+//==============================================================================
+
 void MainWindow::slotEncode()
 {
     if(m_pEncodeDialog->busy())
@@ -2760,6 +3079,32 @@ void MainWindow::slotSaveSnapshot()
 // END OF void MainWindow::slotFrameToClipboard()
 //==============================================================================
 
+void MainWindow::slotExportFrames()
+{
+    if(m_pFrameExportDialog->busy())
+    {
+        m_pFrameExportDialog->call();
+        return;
+    }
+
+    int currentTabIndex = m_ui->scriptTabWidget->currentIndex();
+    if(currentTabIndex < 0)
+        return;
+
+    const EditorPreview & current = m_pEditorPreviewVector[currentTabIndex];
+    if(current.editor->text().isEmpty())
+        return;
+
+    if(!m_pFrameExportDialog->initialize(current.editor->text(),
+        current.scriptFilePath))
+        return;
+    m_pFrameExportDialog->setBookmarks(current.bookmarkModel->bookmarks());
+    m_pFrameExportDialog->call();
+}
+
+// END OF void MainWindow::slotExportFrames()
+//==============================================================================
+
 void MainWindow::slotAbout()
 {
     QResource aboutResource(":readme");
@@ -2851,18 +3196,29 @@ void MainWindow::slotSettingsChanged()
         pAction->setShortcut(hotkey);
     }
 
+    // new lists arrive through slotPluginsListChanged()
     m_pVapourSynthPluginsManager->slotRefill();
 
     // update each editor with new setting
+    for (EditorPreview &item : m_pEditorPreviewVector)
+        item.editor->slotLoadSettings();
+
+    m_pTemplatesDialog->slotLoadSettings();
+
+}
+
+void MainWindow::slotPluginsListChanged()
+{
+    m_vsPluginsList = m_pVapourSynthPluginsManager->pluginsList();
+    m_vsPyScriptsList = m_pVapourSynthPluginsManager->pyScriptsList();
+
     for (EditorPreview &item : m_pEditorPreviewVector) {
         item.editor->setPluginsList(m_vsPluginsList);
         item.editor->setPyScriptsList(m_vsPyScriptsList);
-        item.editor->slotLoadSettings();
     }
 
-    m_pTemplatesDialog->setPluginsList(m_vsPluginsList);
-    m_pTemplatesDialog->slotLoadSettings();
-
+    if (m_pTemplatesDialog)
+        m_pTemplatesDialog->setPluginsList(m_vsPluginsList);
 }
 
 void MainWindow::slotScriptFileDropped(const QString &a_filePath, bool *a_pHandled)
@@ -2875,12 +3231,6 @@ void MainWindow::slotScriptFileDropped(const QString &a_filePath, bool *a_pHandl
     loadScriptFromFile(a_filePath);
 }
 
-void MainWindow::slotSaveGeometry()
-{
-    m_pGeometrySaveTimer->stop();
-    m_pSettingsManager->setMainWindowGeometry(m_windowGeometry);
-}
-
 // END OF bool MainWindow::safeToCloseFile()
 //==============================================================================
 
@@ -20,6 +20,8 @@ class MainWindow;
 class ScriptProcessor;
 class VSEditorLog;
 class ScriptBenchmarkDialog;
+class ClipMetricsDialog;
+class FrameExportDialog;
 class EncodeDialog;
 class TemplatesDialog;
 class PreviewAdvancedSettingsDialog;
@@ -27,6 +29,9 @@ class FrameInfoDialog;
 class PreviewFiltersDialog;
 class FindDialog;
 class SelectionToolsDialog;
+class RegionStatisticsDialog;
+class ScopesDialog;
+struct VideoScopes;
 class JobServerWatcherSocket;
 
 struct EditorPreview {
@@ -116,6 +121,8 @@ private:
 
     SettingsDialog * m_pSettingsDialog;
     ScriptBenchmarkDialog * m_pBenchmarkDialog;
+    ClipMetricsDialog * m_pClipMetricsDialog;
+    FrameExportDialog * m_pFrameExportDialog;
     EncodeDialog * m_pEncodeDialog;
     TemplatesDialog * m_pTemplatesDialog;
     FrameInfoDialog * m_pFrameInfoDialog;
@@ -124,6 +131,8 @@ private:
     BookmarkManagerDialog * m_pBookmarkManagerDialog;
     PreviewFiltersDialog * m_pPreviewFiltersDialog;
     SelectionToolsDialog * m_pSelectionToolsDialog;
+    RegionStatisticsDialog * m_pRegionStatisticsDialog;
+    ScopesDialog * m_pScopesDialog;
 
     JobServerWatcherSocket * m_pJobServerWatcherSocket;
 
@@ -141,6 +150,8 @@ private:
     void createAdvancedSettingsDialog();
     void createTemplatesDialog();
     void createBenchmarkDialog();
+    void createClipMetricsDialog();
+    void createFrameExportDialog();
     void createEncodeDialog();
     void createJobServerWatcher();
 
@@ -157,6 +168,14 @@ private:
     void createBookmarkManager();
     void createPreviewFilters();
     void createSelectionToolsDialog();
+    void createRegionStatisticsDialog();
+    void createScopesDialog();
+
+    // only the processor of the current tab measures frames for the scopes
+    void updateScopesEnabled();
+
+    // clip metrics curves are shown on the timeline of the measured clips
+    void updateClipMetricsCurves();
 
     void setTabs();
     void setTabSignals(); // setup signals between editor and previewArea
@@ -192,8 +211,6 @@ private:
     double YCoCgValueAtPoint(size_t a_x, size_t a_y, int a_plane,
                              const VSAPI * a_cpVSAPI, const VSFrameRef * a_cpFrameRef);
 
-    void createGeometrySaveTimer(); // obsolete?
-
     void createGarbageCollection();
     void destroyOrphanQObjects();
 
@@ -244,6 +261,7 @@ private:
     QAction * m_pActionCheckScript;
     QAction * m_pActionReleaseMemory;
     QAction * m_pActionBenchmark;
+    QAction * m_pActionClipMetrics;
     QAction * m_pActionEncode;
     QAction * m_pActionEnqueueEncodeJob;
     QAction * m_pActionJobs;
@@ -252,6 +270,7 @@ private:
     QAction * m_pActionShowFrameInfoDialog;
     QAction * m_pActionShowPreivewFiltersDialog;
     QAction * m_pActionShowSelectionToolsDialog;
+    QAction * m_pActionShowScopesDialog;
 
     QMenu * m_pAboutVapoursynth;
     QAction * m_pActionVapourSynthVersion;
@@ -268,8 +287,11 @@ private:
     QMenu * m_pPreviewContextMenu;
     QAction * m_pActionFrameToClipboard;
     QAction * m_pActionSaveSnapshot;
+    QAction * m_pActionExportFrames;
     QMenu * m_pMenuZoomModes;
     QActionGroup * m_pActionGroupZoomModes;
+    QMenu * m_pMenuPreviewProxyModes;
+    QActionGroup * m_pActionGroupPreviewProxyModes;
     QAction * m_pActionSetZoomModeNoZoom;
     QAction * m_pActionSetZoomModeFixedRatio;
     QAction * m_pActionSetZoomModeFitToFrame;
@@ -278,10 +300,16 @@ private:
     QAction * m_pActionPasteCropSnippetIntoScript;
     QAction * m_pActionAdvancedSettingsDialog;
     QAction * m_pActionPlay;
+    QAction * m_pActionToggleTimeLineStrip;
+    QAction * m_pActionToggleDropLateFrames;
+    QAction * m_pActionSetPreviewProxyOff;
+    QAction * m_pActionSetPreviewProxyViewport;
+    QAction * m_pActionSetPreviewProxyFraction;
     QAction * m_pActionBookmarkCurrentFrame;
     QAction * m_pActionPasteShownFrameNumberIntoScript;
 
     std::map<QString, ZoomMode> m_actionIDToZoomModeMap;
+    std::map<QString, PreviewProxyMode> m_actionIDToPreviewProxyModeMap;
 
 //    std::map<QString, Qt::TransformationMode> m_actionIDToZoomScaleModeMap;
 
@@ -297,9 +325,6 @@ private:
     bool m_closingTab;
     int m_rightClickedTab;
 
-    QTimer * m_pGeometrySaveTimer;
-    QByteArray m_windowGeometry;
-
     bool m_setScriptBookmarkFromBookmarkManager;
 
     /* compare group */
@@ -341,6 +366,7 @@ private slots:
     void slotShowBookmarkManager(bool a_visible);
     void slotShowPreviewFiltersDialog(bool a_visible);
     void slotShowSelectionToolsDialog(bool a_visible);
+    void slotShowScopesDialog(bool a_visible);
 
     void slotZoomModeChanged();
     void slotZoomRatioChanged(double a_zoomRatio);
@@ -358,8 +384,18 @@ private slots:
     void slotPlay(bool a_play);
     void slotSetPlayFPSLimit();
 
+    void slotToggleTimeLineStrip(bool a_visible);
+    void slotTimeLineStripChanged();
+
+    void slotToggleDropLateFrames(bool a_drop);
+    void slotPreviewProxyModeChanged();
+    void slotPlaybackStatsChanged(bool a_playing, double a_renderedFps,
+        double a_shownFps, int a_droppedFrames, int a_prefetchDepth);
+
     void slotUpdateFramePropsString(const QString & a_framePropsString);
 
+    void slotScopesChanged(const VideoScopes & a_scopes);
+
 //    void slotPreviewFiltersChanged();
 
     /* editor */
@@ -398,6 +434,7 @@ private slots:
     /* selection tool dialog */
     void slotSendPixmapToSelectionCanvas();
     void slotPasteSelectionPointsToScript(const QString&);
+    void slotRegionStatistics(int a_frameNumber, const QRect & a_region);
 
     /* slot for menu actions */
     void slotNewScript();
@@ -412,12 +449,14 @@ private slots:
     void slotCheckScript();
     void slotReleaseMemory();
     void slotBenchmark();
+    void slotClipMetrics();
     void slotEncode();
     void slotEnqueueEncodeJob();
     void slotJobs();
 
     void slotFrameToClipboard();
     void slotSaveSnapshot();
+    void slotExportFrames();
 
     void slotAbout();
     void slotVapourSynthVersion();
@@ -429,10 +468,9 @@ private slots:
     void slotOpenRecentScriptActionTriggered();
 
     void slotSettingsChanged();
+    void slotPluginsListChanged();
     void slotScriptFileDropped(const QString & a_filePath, bool * a_pHandled);
 
-    void slotSaveGeometry();
-
 signals:
 
     void signalTabNameChanged(const QString &a_oldName, const QString &a_newName);
@@ -0,0 +1,231 @@
+#include "deep_color_converter.h"
+
+#include <vapoursynth/VapourSynth.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define DEEP_COLOR_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace
+{
+
+// _Transfer frame property values
+const int64_t TRANSFER_ST2084 = 16;
+const int64_t TRANSFER_ARIB_B67 = 18;
+
+// HDR is mapped so this many nits land on SDR white
+const double SDR_WHITE_NITS = 203.0;
+const double PQ_PEAK_NITS = 10000.0;
+const double HLG_SYSTEM_GAMMA = 1.2;
+const double DISPLAY_GAMMA = 2.4;
+
+double pqToNits(double a_value)
+{
+    const double m1 = 2610.0 / 16384.0;
+    const double m2 = 2523.0 / 4096.0 * 128.0;
+    const double c1 = 3424.0 / 4096.0;
+    const double c2 = 2413.0 / 4096.0 * 32.0;
+    const double c3 = 2392.0 / 4096.0 * 32.0;
+
+    double power = std::pow(a_value, 1.0 / m2);
+    double linear = std::max(power - c1, 0.0) / (c2 - c3 * power);
+    return std::pow(linear, 1.0 / m1) * PQ_PEAK_NITS;
+}
+
+double hlgToNits(double a_value, double a_peakLuminance)
+{
+    const double a = 0.17883277;
+    const double b = 1.0 - 4.0 * a;
+    const double c = 0.5 - a * std::log(4.0 * a);
+
+    double scene = (a_value <= 0.5) ? (a_value * a_value / 3.0) :
+        ((std::exp((a_value - c) / a) + b) / 12.0);
+    // the OOTF applied per channel, good enough for a preview
+    return std::pow(scene, HLG_SYSTEM_GAMMA) * a_peakLuminance;
+}
+
+// Identity up to SDR white, so f(1) = 1 and the picture keeps its
+// brightness. The preview is SDR and has no room above white: any curve
+// rolling the peak off to 1 has to darken white itself, so highlights
+// are clipped instead.
+double tonemapNits(double a_nits)
+{
+    return std::min(std::max(a_nits / SDR_WHITE_NITS, 0.0), 1.0);
+}
+
+// Packs 16 bit RGB rows into RGB30 or RGB32 pixels with rounding.
+void packRow(const uint16_t * a_pR, const uint16_t * a_pG,
+    const uint16_t * a_pB, uint32_t * a_pOut, int a_width, int a_bitDepth)
+{
+    int shift = 16 - a_bitDepth;
+    int x = 0;
+
+#ifdef DEEP_COLOR_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rounding = _mm_set1_epi16(short(1 << (shift - 1)));
+    const __m128i alphaBits = _mm_set1_epi32((a_bitDepth == 10) ?
+        int(0xC0000000) : int(0xFF000000));
+    const __m128i shiftCount = _mm_cvtsi32_si128(shift);
+    const __m128i redShift = _mm_cvtsi32_si128(a_bitDepth * 2);
+    const __m128i greenShift = _mm_cvtsi32_si128(a_bitDepth);
+
+    for(; x + 8 <= a_width; x += 8)
+    {
+        __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a_pR + x));
+        __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a_pG + x));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a_pB + x));
+        // saturating add keeps 65535 from wrapping before the shift
+        r = _mm_srl_epi16(_mm_adds_epu16(r, rounding), shiftCount);
+        g = _mm_srl_epi16(_mm_adds_epu16(g, rounding), shiftCount);
+        b = _mm_srl_epi16(_mm_adds_epu16(b, rounding), shiftCount);
+
+        __m128i low = _mm_or_si128(_mm_or_si128(alphaBits,
+            _mm_sll_epi32(_mm_unpacklo_epi16(r, zero), redShift)),
+            _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(g, zero), greenShift),
+            _mm_unpacklo_epi16(b, zero)));
+        __m128i high = _mm_or_si128(_mm_or_si128(alphaBits,
+            _mm_sll_epi32(_mm_unpackhi_epi16(r, zero), redShift)),
+            _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(g, zero), greenShift),
+            _mm_unpackhi_epi16(b, zero)));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(a_pOut + x), low);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(a_pOut + x + 4), high);
+    }
+#endif
+
+    uint32_t alpha = (a_bitDepth == 10) ? 0xC0000000u : 0xFF000000u;
+    uint32_t maximum = (1u << a_bitDepth) - 1;
+    uint32_t half = 1u << (shift - 1);
+    for(; x < a_width; ++x)
+    {
+        uint32_t r = std::min((a_pR[x] + half) >> shift, maximum);
+        uint32_t g = std::min((a_pG[x] + half) >> shift, maximum);
+        uint32_t b = std::min((a_pB[x] + half) >> shift, maximum);
+        a_pOut[x] = alpha | (r << (a_bitDepth * 2)) |
+            (g << a_bitDepth) | b;
+    }
+}
+
+}
+
+DeepColorConverter::DeepColorConverter() :
+    m_tonemap(HdrTonemapMode::Off),
+    m_peakLuminance(DEFAULT_HDR_PEAK_LUMINANCE)
+{
+}
+
+void DeepColorConverter::setTonemap(HdrTonemapMode a_tonemap,
+    double a_peakLuminance)
+{
+    if(a_tonemap == HdrTonemapMode::Auto)
+        a_tonemap = HdrTonemapMode::Off;
+
+    if((a_tonemap == m_tonemap) && (a_peakLuminance == m_peakLuminance))
+        return;
+
+    m_tonemap = a_tonemap;
+    m_peakLuminance = a_peakLuminance;
+    buildLut();
+}
+
+HdrTonemapMode DeepColorConverter::tonemap() const
+{
+    return m_tonemap;
+}
+
+QImage DeepColorConverter::convert(const VSAPI * a_cpVSAPI,
+    const VSFrameRef * a_cpFrameRef, int a_displayBitDepth)
+{
+    const VSFormat * cpFormat = a_cpVSAPI->getFrameFormat(a_cpFrameRef);
+    if(cpFormat->id != pfRGB48)
+        return QImage();
+
+    int bitDepth = (a_displayBitDepth > 8) ? 10 : 8;
+    int width = a_cpVSAPI->getFrameWidth(a_cpFrameRef, 0);
+    int height = a_cpVSAPI->getFrameHeight(a_cpFrameRef, 0);
+    QImage image(width, height, (bitDepth == 10) ? QImage::Format_RGB30 :
+        QImage::Format_RGB32);
+    if(image.isNull())
+        return image;
+
+    const uint8_t * planes[3];
+    int strides[3];
+    for(int i = 0; i < 3; ++i)
+    {
+        planes[i] = a_cpVSAPI->getReadPtr(a_cpFrameRef, i);
+        strides[i] = a_cpVSAPI->getStride(a_cpFrameRef, i);
+    }
+
+    bool tonemap = !m_lut.empty();
+    if(tonemap)
+        m_rowBuffer.resize(size_t(width) * 3);
+
+    for(int y = 0; y < height; ++y)
+    {
+        const uint16_t * rows[3];
+        for(int i = 0; i < 3; ++i)
+        {
+            rows[i] = reinterpret_cast<const uint16_t *>(planes[i] +
+                ptrdiff_t(y) * strides[i]);
+        }
+
+        if(tonemap)
+        {
+            // the curve is a table lookup, packing stays vectorized
+            const uint16_t * pLut = m_lut.data();
+            for(int i = 0; i < 3; ++i)
+            {
+                uint16_t * pMapped = m_rowBuffer.data() + size_t(width) * i;
+                for(int x = 0; x < width; ++x)
+                    pMapped[x] = pLut[rows[i][x]];
+                rows[i] = pMapped;
+            }
+        }
+
+        packRow(rows[0], rows[1], rows[2],
+            reinterpret_cast<uint32_t *>(image.scanLine(y)), width, bitDepth);
+    }
+
+    return image;
+}
+
+HdrTonemapMode DeepColorConverter::transferOf(const VSAPI * a_cpVSAPI,
+    const VSFrameRef * a_cpFrameRef)
+{
+    if((!a_cpVSAPI) || (!a_cpFrameRef))
+        return HdrTonemapMode::Off;
+
+    const VSMap * cpProps = a_cpVSAPI->getFramePropsRO(a_cpFrameRef);
+    int error = 0;
+    int64_t transfer = a_cpVSAPI->propGetInt(cpProps, "_Transfer", 0, &error);
+    if(error)
+        return HdrTonemapMode::Off;
+    if(transfer == TRANSFER_ST2084)
+        return HdrTonemapMode::PQ;
+    if(transfer == TRANSFER_ARIB_B67)
+        return HdrTonemapMode::HLG;
+    return HdrTonemapMode::Off;
+}
+
+void DeepColorConverter::buildLut()
+{
+    m_lut.clear();
+    if(m_tonemap == HdrTonemapMode::Off)
+        return;
+
+    m_lut.resize(65536);
+    for(int code = 0; code < 65536; ++code)
+    {
+        double value = double(code) / 65535.0;
+        double nits = (m_tonemap == HdrTonemapMode::PQ) ? pqToNits(value) :
+            hlgToNits(value, m_peakLuminance);
+        double display = std::pow(tonemapNits(nits),
+            1.0 / DISPLAY_GAMMA);
+        m_lut[size_t(code)] = uint16_t(display * 65535.0 + 0.5);
+    }
+}
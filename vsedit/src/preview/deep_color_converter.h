@@ -0,0 +1,47 @@
+#ifndef DEEP_COLOR_CONVERTER_H
+#define DEEP_COLOR_CONVERTER_H
+
+#include "../../../common-src/settings/settings_definitions.h"
+
+#include <QImage>
+#include <cstdint>
+#include <vector>
+
+struct VSAPI;
+struct VSFrameRef;
+
+// Turns planar RGB48 preview frames into 10 bit (RGB30) or 8 bit images,
+// optionally through a fast per channel tonemap of PQ or HLG content.
+class DeepColorConverter
+{
+public:
+
+    DeepColorConverter();
+
+    // a_tonemap is PQ, HLG or Off, Auto is resolved by the caller
+    void setTonemap(HdrTonemapMode a_tonemap, double a_peakLuminance);
+
+    HdrTonemapMode tonemap() const;
+
+    QImage convert(const VSAPI * a_cpVSAPI, const VSFrameRef * a_cpFrameRef,
+        int a_displayBitDepth);
+
+    // PQ or HLG from the _Transfer property of a frame, Off otherwise
+    static HdrTonemapMode transferOf(const VSAPI * a_cpVSAPI,
+        const VSFrameRef * a_cpFrameRef);
+
+private:
+
+    void buildLut();
+
+    HdrTonemapMode m_tonemap;
+    double m_peakLuminance;
+
+    // 16 bit code value to 16 bit display value, empty without tonemap
+    std::vector<uint16_t> m_lut;
+
+    // tonemapped rows waiting to be packed
+    std::vector<uint16_t> m_rowBuffer;
+};
+
+#endif // DEEP_COLOR_CONVERTER_H
@@ -1,7 +1,6 @@
 #include "frame_info_dialog.h"
 #include "ui_frame_info_dialog.h"
 
-#include <QTimer>
 
 FrameInfoDialog::FrameInfoDialog(SettingsManager * a_pSettingsManager, QWidget *parent) :
     QDialog(parent),
@@ -14,11 +13,6 @@ FrameInfoDialog::FrameInfoDialog(SettingsManager * a_pSettingsManager, QWidget *
 
 FrameInfoDialog::~FrameInfoDialog()
 {
-    if(m_pGeometrySaveTimer->isActive())
-    {
-        m_pGeometrySaveTimer->stop();
-        slotSaveGeometry();
-    }
 }
 
 void FrameInfoDialog::setColorPickerString(const QString &a_string)
@@ -51,11 +45,6 @@ void FrameInfoDialog::hideEvent(QHideEvent *a_pEvent)
 
 void FrameInfoDialog::setWindowGeometry()
 {
-    m_pGeometrySaveTimer = new QTimer(this);
-    m_pGeometrySaveTimer->setInterval(DEFAULT_WINDOW_GEOMETRY_SAVE_DELAY);
-    connect(m_pGeometrySaveTimer, &QTimer::timeout,
-        this, &FrameInfoDialog::slotSaveGeometry);
-
     m_windowGeometry = m_pSettingsManager->getFrameInfoDialogGeometry();
     if(!m_windowGeometry.isEmpty())
         restoreGeometry(m_windowGeometry);
@@ -66,13 +55,8 @@ void FrameInfoDialog::saveGeometryDelayed()
     QApplication::processEvents();
     if(!isMaximized())
     {
+        // the settings manager coalesces the writes of a drag
         m_windowGeometry = saveGeometry();
-        m_pGeometrySaveTimer->start();
+        m_pSettingsManager->setFrameInfoDialogGeometry(m_windowGeometry);
     }
 }
-
-void FrameInfoDialog::slotSaveGeometry()
-{
-    m_pGeometrySaveTimer->stop();
-    m_pSettingsManager->setFrameInfoDialogGeometry(m_windowGeometry);
-}
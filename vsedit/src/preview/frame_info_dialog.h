@@ -37,12 +37,7 @@ protected:
     void setWindowGeometry();
     void saveGeometryDelayed();
 
-    QTimer * m_pGeometrySaveTimer;
     QByteArray m_windowGeometry;
-
-protected slots:
-
-    void slotSaveGeometry();
 };
 
 #endif // FRAME_INFO_DIALOG_H
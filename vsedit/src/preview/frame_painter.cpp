@@ -1,23 +1,80 @@
 #include "frame_painter.h"
 
 #include <QPainter>
+#include <QPaintEvent>
+#include <QTimer>
+
+namespace
+{
+
+// above this the frame is scaled per exposed tile instead of cached,
+// 8K zoomed in would need gigabytes otherwise
+const qint64 MAX_CACHED_PIXELS = 4096 * 4096;
+
+// a frame shown this long is not part of playback and gets smooth scaling
+const int FRAME_SETTLE_DELAY = 200;
+
+}
 
 FramePainter::FramePainter(QWidget *parent) : QWidget(parent),
-  m_ratio(1.0)
-{    
+  m_ratio(1.0),
+  m_scaledSmooth(false),
+  m_frameSettled(false),
+  m_pSettleTimer(nullptr)
+{
+    // the paint event fills every exposed pixel itself
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    m_pSettleTimer = new QTimer(this);
+    m_pSettleTimer->setInterval(FRAME_SETTLE_DELAY);
+    m_pSettleTimer->setSingleShot(true);
+    connect(m_pSettleTimer, &QTimer::timeout,
+            this, &FramePainter::slotFrameSettled);
 }
 
 void FramePainter::paintEvent(QPaintEvent *a_pEvent)
 {
     QPainter painter(this);
-    painter.scale(m_ratio, m_ratio);
-    painter.drawPixmap(0, 0, m_framePixmap.width(),m_framePixmap.height(), m_framePixmap);
-    painter.end();
+
+    if (m_framePixmap.isNull()) {
+        painter.fillRect(a_pEvent->rect(), palette().window());
+        return;
+    }
+
+    const QPixmap *pScaledPixmap = scaledPixmap();
+
+    // the widget may be larger than the frame after rounding
+    QRect frameRect(QPoint(0, 0), scaledSize());
+    QRegion exposedRegion = a_pEvent->region();
+    for (const QRect &rect : exposedRegion.subtracted(frameRect))
+        painter.fillRect(rect, palette().window());
+
+    // only the exposed region is drawn, scrolling exposes a thin strip
+    for (const QRect &rect : exposedRegion.intersected(frameRect)) {
+        if (pScaledPixmap) {
+            painter.drawPixmap(rect, *pScaledPixmap, rect);
+            continue;
+        }
+
+        // whole source pixels, so zoomed in pixels line up between tiles
+        QRectF sourceRect(rect.x() / m_ratio, rect.y() / m_ratio,
+                          rect.width() / m_ratio, rect.height() / m_ratio);
+        QRect alignedRect = sourceRect.toAlignedRect().intersected(
+            m_framePixmap.rect());
+        QRectF targetRect(alignedRect.x() * m_ratio, alignedRect.y() * m_ratio,
+                          alignedRect.width() * m_ratio,
+                          alignedRect.height() * m_ratio);
+        painter.drawPixmap(targetRect, m_framePixmap, QRectF(alignedRect));
+    }
 }
 
 void FramePainter::drawFrame(const QPixmap &a_framePixmap)
 {
     m_framePixmap = a_framePixmap;
+    m_scaledPixmap = QPixmap();
+    m_mipLevels.clear();
+    m_frameSettled = false;
+    m_pSettleTimer->start();
     update();
 }
 
@@ -25,6 +82,8 @@ void FramePainter::setRatio(const double a_ratio)
 {
     if (m_ratio == a_ratio) return;
     m_ratio = a_ratio;
+    // mip levels belong to the frame and are kept for the next zoom
+    m_scaledPixmap = QPixmap();
     update();
 }
 
@@ -33,3 +92,73 @@ QPixmap *FramePainter::pixmap()
     return &m_framePixmap;
 }
 
+void FramePainter::slotFrameSettled()
+{
+    m_frameSettled = true;
+    if ((m_ratio < 1.0) && (!m_scaledSmooth) && (!m_scaledPixmap.isNull())) {
+        m_scaledPixmap = QPixmap();
+        update();
+    }
+}
+
+QSize FramePainter::scaledSize() const
+{
+    if (m_ratio == 1.0)
+        return m_framePixmap.size();
+    return QSize(int(double(m_framePixmap.width()) * m_ratio),
+                 int(double(m_framePixmap.height()) * m_ratio));
+}
+
+const QPixmap *FramePainter::scaledPixmap()
+{
+    if (m_ratio == 1.0)
+        return &m_framePixmap;
+
+    if (!m_scaledPixmap.isNull())
+        return &m_scaledPixmap;
+
+    QSize size = scaledSize();
+    if (size.isEmpty() ||
+        (qint64(size.width()) * size.height() > MAX_CACHED_PIXELS))
+        return nullptr;
+
+    // Zoomed in pixels stay sharp, like the unscaled preview. Frames
+    // during playback are scaled the same way, the mip chain costs
+    // too much on the GUI thread for every frame.
+    m_scaledSmooth = (m_ratio < 1.0) && m_frameSettled;
+    if (m_scaledSmooth) {
+        m_scaledPixmap = QPixmap::fromImage(mipLevel(size).scaled(
+            size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    } else {
+        m_scaledPixmap = m_framePixmap.scaled(size,
+            Qt::IgnoreAspectRatio, Qt::FastTransformation);
+    }
+
+    return &m_scaledPixmap;
+}
+
+const QImage &FramePainter::mipLevel(const QSize &a_size)
+{
+    if (m_mipLevels.empty())
+        m_mipLevels.push_back(m_framePixmap.toImage());
+
+    for (;;) {
+        const QImage &lastLevel = m_mipLevels.back();
+        QSize halfSize(lastLevel.width() / 2, lastLevel.height() / 2);
+        if ((halfSize.width() < a_size.width()) ||
+            (halfSize.height() < a_size.height()))
+            break;
+        QImage halfLevel = lastLevel.scaled(halfSize, Qt::IgnoreAspectRatio,
+                                            Qt::SmoothTransformation);
+        m_mipLevels.push_back(halfLevel);
+    }
+
+    // levels built for a smaller zoom may be there already
+    for (auto it = m_mipLevels.rbegin(); it != m_mipLevels.rend(); ++it) {
+        if ((it->width() >= a_size.width()) &&
+            (it->height() >= a_size.height()))
+            return *it;
+    }
+
+    return m_mipLevels.front();
+}
@@ -3,7 +3,16 @@
 
 #include <QObject>
 #include <QWidget>
+#include <QImage>
+#include <QPixmap>
+#include <vector>
 
+class QTimer;
+
+// Paints the frame at the zoom ratio. The scaled frame is cached so
+// repaints are plain blits of the exposed region. New frames are
+// scaled fast; once a zoomed out frame stays on screen it is rescaled
+// through a chain of halved images to avoid aliasing.
 class FramePainter : public QWidget
 {
     Q_OBJECT
@@ -18,12 +27,35 @@ public:
 
     QPixmap *pixmap();
 
+private slots:
+
+    void slotFrameSettled();
+
 private:
 
+    // same rounding as the widget size set by the preview area
+    QSize scaledSize() const;
+
+    // nullptr when the scaled frame is too large to keep
+    const QPixmap *scaledPixmap();
+
+    // smallest mip level that is not smaller than the size
+    const QImage &mipLevel(const QSize &a_size);
+
     QPixmap m_framePixmap;
 
     double m_ratio;
 
+    QPixmap m_scaledPixmap;
+    bool m_scaledSmooth;
+
+    // the frame has not changed for a while, playback is not going on
+    bool m_frameSettled;
+    QTimer *m_pSettleTimer;
+
+    // halvings of the frame, built on demand
+    std::vector<QImage> m_mipLevels;
+
 signals:
 
 };
@@ -0,0 +1,137 @@
+#include "play_prefetch_ring.h"
+
+#include <vapoursynth/VapourSynth.h>
+
+#include <QtGlobal>
+#include <algorithm>
+
+PlayPrefetchRing::PlayPrefetchRing() :
+    m_cpVSAPI(nullptr),
+    m_size(0)
+{
+}
+
+// END OF PlayPrefetchRing::PlayPrefetchRing()
+//==============================================================================
+
+PlayPrefetchRing::~PlayPrefetchRing()
+{
+    clear();
+}
+
+// END OF PlayPrefetchRing::~PlayPrefetchRing()
+//==============================================================================
+
+void PlayPrefetchRing::reset(const VSAPI * a_cpVSAPI, int a_capacity)
+{
+    clear();
+    m_cpVSAPI = a_cpVSAPI;
+    m_slots.assign(size_t(std::max(a_capacity, 1)), Frame(-1, 0, nullptr));
+}
+
+// END OF void PlayPrefetchRing::reset(const VSAPI * a_cpVSAPI,
+//		int a_capacity)
+//==============================================================================
+
+int PlayPrefetchRing::capacity() const
+{
+    return int(m_slots.size());
+}
+
+// END OF int PlayPrefetchRing::capacity() const
+//==============================================================================
+
+int PlayPrefetchRing::size() const
+{
+    return m_size;
+}
+
+// END OF int PlayPrefetchRing::size() const
+//==============================================================================
+
+void PlayPrefetchRing::store(const Frame & a_frame)
+{
+    Q_ASSERT(!m_slots.empty());
+    Q_ASSERT(a_frame.number >= 0);
+
+    Frame & slot = m_slots[size_t(a_frame.number) % m_slots.size()];
+    freeSlot(slot);
+    slot = a_frame;
+    m_size++;
+}
+
+// END OF void PlayPrefetchRing::store(const Frame & a_frame)
+//==============================================================================
+
+bool PlayPrefetchRing::contains(int a_frameNumber) const
+{
+    if(m_slots.empty() || (a_frameNumber < 0))
+        return false;
+
+    const Frame & slot = m_slots[size_t(a_frameNumber) % m_slots.size()];
+    return (slot.number == a_frameNumber);
+}
+
+// END OF bool PlayPrefetchRing::contains(int a_frameNumber) const
+//==============================================================================
+
+Frame PlayPrefetchRing::take(int a_frameNumber)
+{
+    if(!contains(a_frameNumber))
+        return Frame(-1, 0, nullptr);
+
+    Frame & slot = m_slots[size_t(a_frameNumber) % m_slots.size()];
+    Frame frame = slot;
+    slot = Frame(-1, 0, nullptr);
+    m_size--;
+    return frame;
+}
+
+// END OF Frame PlayPrefetchRing::take(int a_frameNumber)
+//==============================================================================
+
+int PlayPrefetchRing::dropBefore(int a_frameNumber)
+{
+    if(m_size == 0)
+        return 0;
+
+    int dropped = 0;
+    for(Frame & slot : m_slots)
+    {
+        if((slot.number < 0) || (slot.number >= a_frameNumber))
+            continue;
+        freeSlot(slot);
+        dropped++;
+    }
+    return dropped;
+}
+
+// END OF int PlayPrefetchRing::dropBefore(int a_frameNumber)
+//==============================================================================
+
+void PlayPrefetchRing::clear()
+{
+    if(m_size == 0)
+        return;
+
+    for(Frame & slot : m_slots)
+        freeSlot(slot);
+}
+
+// END OF void PlayPrefetchRing::clear()
+//==============================================================================
+
+void PlayPrefetchRing::freeSlot(Frame & a_slot)
+{
+    if(a_slot.number < 0)
+        return;
+
+    Q_ASSERT(m_cpVSAPI);
+    m_cpVSAPI->freeFrame(a_slot.cpOutputFrameRef);
+    m_cpVSAPI->freeFrame(a_slot.cpPreviewFrameRef);
+    a_slot = Frame(-1, 0, nullptr);
+    m_size--;
+}
+
+// END OF void PlayPrefetchRing::freeSlot(Frame & a_slot)
+//==============================================================================
@@ -0,0 +1,53 @@
+#ifndef PLAY_PREFETCH_RING_H
+#define PLAY_PREFETCH_RING_H
+
+#include "../../../common-src/vapoursynth/vs_script_processor_structures.h"
+
+#include <vector>
+
+struct VSAPI;
+
+// frames rendered ahead of the playback position. A frame is stored in
+// the slot of its number modulo the capacity, so as long as only frames
+// of the window [first shown, first shown + capacity) are requested the
+// lookup is direct and no two of them share a slot.
+class PlayPrefetchRing
+{
+public:
+
+    PlayPrefetchRing();
+
+    ~PlayPrefetchRing();
+
+    // frees all frames and sets the new capacity
+    void reset(const VSAPI * a_cpVSAPI, int a_capacity);
+
+    int capacity() const;
+
+    int size() const;
+
+    // takes ownership of the frame references, a frame
+    // previously held in the same slot is freed
+    void store(const Frame & a_frame);
+
+    bool contains(int a_frameNumber) const;
+
+    // releases ownership of the frame to the caller,
+    // returns a frame with null references if it is not stored
+    Frame take(int a_frameNumber);
+
+    // frees all frames numbered below a_frameNumber, returns their count
+    int dropBefore(int a_frameNumber);
+
+    void clear();
+
+private:
+
+    void freeSlot(Frame & a_slot);
+
+    const VSAPI * m_cpVSAPI;
+    std::vector<Frame> m_slots;
+    int m_size;
+};
+
+#endif // PLAY_PREFETCH_RING_H
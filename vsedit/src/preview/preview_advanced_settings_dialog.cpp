@@ -47,6 +47,15 @@ PreviewAdvancedSettingsDialog::PreviewAdvancedSettingsDialog(
     m_ui.chromaPlacementComboBox->addItem(tr("DV"),
         int(ChromaPlacement::DV));
 
+    m_ui.displayBitDepthComboBox->addItem(tr("8 bit"), 8);
+    m_ui.displayBitDepthComboBox->addItem(tr("10 bit"), 10);
+
+    m_ui.hdrTonemapComboBox->addItem(tr("Off"), int(HdrTonemapMode::Off));
+    m_ui.hdrTonemapComboBox->addItem(tr("Auto (frame _Transfer)"),
+        int(HdrTonemapMode::Auto));
+    m_ui.hdrTonemapComboBox->addItem(tr("PQ"), int(HdrTonemapMode::PQ));
+    m_ui.hdrTonemapComboBox->addItem(tr("HLG"), int(HdrTonemapMode::HLG));
+
 	connect(m_ui.okButton, SIGNAL(clicked()), this, SLOT(slotOk()));
 	connect(m_ui.applyButton, SIGNAL(clicked()), this, SLOT(slotApply()));
 	connect(m_ui.resetToDefaultButton, SIGNAL(clicked()),
@@ -91,6 +100,19 @@ void PreviewAdvancedSettingsDialog::slotCall()
 	m_ui.lanczosFilterTapsSpinBox->setValue(
 		m_pSettingsManager->getLanczosFilterTaps());
 
+	comboIndex = m_ui.displayBitDepthComboBox->findData(
+		m_pSettingsManager->getPreviewDisplayBitDepth());
+	if(comboIndex != -1)
+		m_ui.displayBitDepthComboBox->setCurrentIndex(comboIndex);
+
+	HdrTonemapMode tonemapMode = m_pSettingsManager->getHdrTonemapMode();
+	comboIndex = m_ui.hdrTonemapComboBox->findData(int(tonemapMode));
+	if(comboIndex != -1)
+		m_ui.hdrTonemapComboBox->setCurrentIndex(comboIndex);
+
+	m_ui.hdrPeakLuminanceSpinBox->setValue(
+		m_pSettingsManager->getHdrPeakLuminance());
+
 	show();
 }
 
@@ -120,6 +142,12 @@ void PreviewAdvancedSettingsDialog::slotApply()
 		m_ui.bicubicFilterParameterCSpinBox->value());
 	m_pSettingsManager->setLanczosFilterTaps(
 		m_ui.lanczosFilterTapsSpinBox->value());
+	m_pSettingsManager->setPreviewDisplayBitDepth(
+		m_ui.displayBitDepthComboBox->currentData().toInt());
+	m_pSettingsManager->setHdrTonemapMode(HdrTonemapMode(
+		m_ui.hdrTonemapComboBox->currentData().toInt()));
+	m_pSettingsManager->setHdrPeakLuminance(
+		m_ui.hdrPeakLuminanceSpinBox->value());
 
 	emit signalSettingsChanged();
 }
@@ -150,6 +178,18 @@ void PreviewAdvancedSettingsDialog::slotResetToDefault()
 		DEFAULT_BICUBIC_FILTER_PARAMETER_C);
 	m_ui.lanczosFilterTapsSpinBox->setValue(
 		DEFAULT_LANCZOS_FILTER_TAPS);
+
+	comboIndex = m_ui.displayBitDepthComboBox->findData(
+		DEFAULT_PREVIEW_DISPLAY_BIT_DEPTH);
+	if(comboIndex != -1)
+		m_ui.displayBitDepthComboBox->setCurrentIndex(comboIndex);
+
+	comboIndex = m_ui.hdrTonemapComboBox->findData(
+		int(DEFAULT_HDR_TONEMAP_MODE));
+	if(comboIndex != -1)
+		m_ui.hdrTonemapComboBox->setCurrentIndex(comboIndex);
+
+	m_ui.hdrPeakLuminanceSpinBox->setValue(DEFAULT_HDR_PEAK_LUMINANCE);
 }
 
 // END OF void PreviewAdvancedSettingsDialog::slotResetToDefault()
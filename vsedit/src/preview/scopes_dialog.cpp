@@ -0,0 +1,87 @@
+#include "scopes_dialog.h"
+#include "ui_scopes_dialog.h"
+
+#include "video_scopes.h"
+
+#include <QPixmap>
+
+ScopesDialog::ScopesDialog(SettingsManager * a_pSettingsManager, QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::ScopesDialog),
+    m_pSettingsManager(a_pSettingsManager)
+{
+    ui->setupUi(this);
+    setWindowGeometry();
+}
+
+ScopesDialog::~ScopesDialog()
+{
+}
+
+void ScopesDialog::setScopes(const VideoScopes &a_scopes)
+{
+    if(!a_scopes.error.isEmpty())
+    {
+        clearScopes();
+        ui->statusLabel->setText(a_scopes.error);
+        return;
+    }
+
+    ui->histogramLabel->setPixmap(QPixmap::fromImage(a_scopes.histogram));
+    ui->waveformLabel->setPixmap(QPixmap::fromImage(a_scopes.waveform));
+    ui->paradeLabel->setPixmap(QPixmap::fromImage(a_scopes.parade));
+    ui->vectorscopeLabel->setPixmap(QPixmap::fromImage(a_scopes.vectorscope));
+    ui->paradeGroupBox->setTitle(tr("Parade %1").arg(a_scopes.paradeTitle));
+
+    QString status = tr("Frame %1").arg(a_scopes.frameNumber);
+    if(a_scopes.rowStep > 1)
+        status += tr(", every %1 rows measured").arg(a_scopes.rowStep);
+    ui->statusLabel->setText(status);
+}
+
+void ScopesDialog::clearScopes()
+{
+    ui->histogramLabel->clear();
+    ui->waveformLabel->clear();
+    ui->paradeLabel->clear();
+    ui->vectorscopeLabel->clear();
+    ui->paradeGroupBox->setTitle(tr("Parade"));
+    ui->statusLabel->setText("---");
+}
+
+void ScopesDialog::moveEvent(QMoveEvent *a_pEvent)
+{
+    QDialog::moveEvent(a_pEvent);
+    saveGeometryDelayed();
+}
+
+void ScopesDialog::showEvent(QShowEvent *a_pEvent)
+{
+    QDialog::showEvent(a_pEvent);
+    emit signalDialogShown();
+}
+
+void ScopesDialog::hideEvent(QHideEvent *a_pEvent)
+{
+    emit signalDialogHidden();
+    QDialog::hideEvent(a_pEvent);
+    saveGeometryDelayed();
+}
+
+void ScopesDialog::setWindowGeometry()
+{
+    m_windowGeometry = m_pSettingsManager->getScopesDialogGeometry();
+    if(!m_windowGeometry.isEmpty())
+        restoreGeometry(m_windowGeometry);
+}
+
+void ScopesDialog::saveGeometryDelayed()
+{
+    QApplication::processEvents();
+    if(!isMaximized())
+    {
+        // the settings manager coalesces the writes of a drag
+        m_windowGeometry = saveGeometry();
+        m_pSettingsManager->setScopesDialogGeometry(m_windowGeometry);
+    }
+}
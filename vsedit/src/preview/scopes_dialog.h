@@ -0,0 +1,47 @@
+#ifndef SCOPES_DIALOG_H
+#define SCOPES_DIALOG_H
+
+#include "../../common-src/settings/settings_manager.h"
+
+#include <QDialog>
+
+struct VideoScopes;
+
+namespace Ui {
+class ScopesDialog;
+}
+
+class ScopesDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit ScopesDialog(SettingsManager * a_pSettingsManager, QWidget *parent = nullptr);
+    ~ScopesDialog() override;
+
+    void setScopes(const VideoScopes & a_scopes);
+    void clearScopes();
+private:
+    Ui::ScopesDialog *ui;
+
+    SettingsManager * m_pSettingsManager;
+
+signals:
+
+    void signalDialogHidden();
+
+    void signalDialogShown();
+
+protected:
+
+    void moveEvent(QMoveEvent * a_pEvent) override;
+    void showEvent(QShowEvent * a_pEvent) override;
+    void hideEvent(QHideEvent * a_pEvent) override;
+
+    void setWindowGeometry();
+    void saveGeometryDelayed();
+
+    QByteArray m_windowGeometry;
+};
+
+#endif // SCOPES_DIALOG_H
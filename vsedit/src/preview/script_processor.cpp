@@ -1,22 +1,58 @@
 #include "script_processor.h"
+#include "timeline_strip_builder.h"
+#include "video_scopes_builder.h"
 #include "../../../common-src/vapoursynth/vapoursynth_script_processor.h"
+#include "../../../common-src/settings/settings_manager.h"
 #include "math.h"
 
 #include <vapoursynth/VapourSynth.h>
 
 #include <QTimer>
+#include <algorithm>
+
+const int MIN_PLAY_PREFETCH_DEPTH = 2;
+const int MAX_PLAY_PREFETCH_DEPTH = 64;
+// rough budget for output and preview frames rendered ahead
+const double PLAY_PREFETCH_MEMORY_LIMIT = 512.0 * 1024.0 * 1024.0;
+// playback time the frames rendered ahead should cover
+const double PLAY_PREFETCH_SECONDS = 0.5;
+const int PLAY_STATS_INTERVAL = 1000;
+// timeline requests closer than this are taken for scrubbing,
+// the shown proxy is refined when no request follows in this time
+const int PROXY_REFINE_DELAY = 250;
 
 ScriptProcessor::ScriptProcessor(SettingsManager * a_pSettingsManager,
                                  VSScriptLibrary * a_pVSScriptLibrary, QWidget * a_pParent) :
     VSScriptProcessorDialog(a_pSettingsManager, a_pVSScriptLibrary, a_pParent)
   , m_frameExpected(0)
   , m_frameShown(-1)
+  , m_frameShownIsProxy(false)
+  , m_frameRequestPending(false)
+  , m_proxyMode(DEFAULT_PREVIEW_PROXY_MODE)
+  , m_proxyFraction(DEFAULT_PREVIEW_PROXY_FRACTION)
+  , m_pProxyRefineTimer(nullptr)
   , m_lastFrameRequestedForPlay(-1)
   , m_cpFrameRef(nullptr)
   , m_playing(false)
   , m_processingPlayQueue(false)
   , m_secondsBetweenFrames(0)
   , m_pPlayTimer(nullptr)
+  , m_pStripBuilder(nullptr)
+  , m_stripEnabled(false)
+  , m_pScopesBuilder(nullptr)
+  , m_scopesEnabled(false)
+  , m_dropLateFrames(DEFAULT_PLAYBACK_DROP_LATE_FRAMES)
+  , m_idleFrameRequestsLimit(0)
+  , m_playClockFrame(-1)
+  , m_playFrameLatency(0.0)
+  , m_playRenderInterval(0.0)
+  , m_pPlayStatsTimer(nullptr)
+  , m_framesRenderedForStats(0)
+  , m_framesShownForStats(0)
+  , m_framesDropped(0)
+  , m_displayBitDepth(DEFAULT_PREVIEW_DISPLAY_BIT_DEPTH)
+  , m_tonemapMode(DEFAULT_HDR_TONEMAP_MODE)
+  , m_peakLuminance(DEFAULT_HDR_PEAK_LUMINANCE)
 //  , m_alwaysKeepCurrentFrame(DEFAULT_ALWAYS_KEEP_CURRENT_FRAME)
 {
     m_pPlayTimer = new QTimer(this);
@@ -25,6 +61,33 @@ ScriptProcessor::ScriptProcessor(SettingsManager * a_pSettingsManager,
 
     connect(m_pPlayTimer, SIGNAL(timeout()),
             this, SLOT(slotProcessPlayQueue()));
+
+    m_pPlayStatsTimer = new QTimer(this);
+    m_pPlayStatsTimer->setInterval(PLAY_STATS_INTERVAL);
+    connect(m_pPlayStatsTimer, &QTimer::timeout,
+            this, &ScriptProcessor::slotPlayStatsTimeout);
+
+    m_dropLateFrames = m_pSettingsManager->getPlaybackDropLateFrames();
+
+    m_proxyMode = m_pSettingsManager->getPreviewProxyMode();
+    m_proxyFraction = m_pSettingsManager->getPreviewProxyFraction();
+    m_pProxyRefineTimer = new QTimer(this);
+    m_pProxyRefineTimer->setSingleShot(true);
+    m_pProxyRefineTimer->setInterval(PROXY_REFINE_DELAY);
+    connect(m_pProxyRefineTimer, &QTimer::timeout,
+            this, &ScriptProcessor::slotRefineProxyFrame);
+
+    m_stripEnabled = m_pSettingsManager->getTimeLineStripVisible();
+    m_pStripBuilder = new TimeLineStripBuilder(m_pVapourSynthScriptProcessor,
+        this);
+    connect(m_pStripBuilder, &TimeLineStripBuilder::signalStripChanged,
+            this, &ScriptProcessor::signalTimeLineStripChanged);
+
+    m_pScopesBuilder = new VideoScopesBuilder(this);
+    connect(m_pScopesBuilder, &VideoScopesBuilder::signalScopesReady,
+            this, &ScriptProcessor::signalScopesChanged);
+
+    updatePreviewDepth();
 }
 
 ScriptProcessor::~ScriptProcessor()
@@ -42,12 +105,19 @@ const VSVideoInfo * ScriptProcessor::vsVideoInfo()
     return m_cpVideoInfo;
 }
 
-void ScriptProcessor::setCurrentFrame(const VSFrameRef *a_cpOutputFrameRef, const VSFrameRef *a_cpPreviewFrameRef)
+void ScriptProcessor::setCurrentFrame(const VSFrameRef *a_cpOutputFrameRef, const VSFrameRef *a_cpPreviewFrameRef,
+                                      int a_frameNumber)
 {
     Q_ASSERT(m_cpVSAPI);
     m_cpVSAPI->freeFrame(m_cpFrameRef); // free frame from last reference frame
     m_cpFrameRef = a_cpOutputFrameRef;
-    QPixmap framePixmap = pixmapFromCompatBGR32(a_cpPreviewFrameRef);
+
+    // scopes read the output frame at its own depth, not the preview
+    if(m_scopesEnabled)
+        m_pScopesBuilder->submit(m_cpVSAPI, m_cpFrameRef, a_frameNumber, m_playing);
+
+    QPixmap framePixmap = pixmapFromPreviewFrame(a_cpPreviewFrameRef,
+        m_cpFrameRef);
 
     QString framePropsString = m_pVapourSynthScriptProcessor->framePropsString(m_cpFrameRef);
 
@@ -96,6 +166,11 @@ bool ScriptProcessor::previewScript(const QString &a_script, const QString &a_sc
         m_frameExpected = lastFrameNumber;
 
     setScriptName(a_scriptName);
+    updatePreviewProxySize();
+
+    if(m_stripEnabled)
+        m_pStripBuilder->start(m_cpVSAPI, script(), scriptName(),
+            m_cpVideoInfo);
 
 //    if(m_pSettingsManager->getPreviewDialogMaximized())
 //		showMaximized();
@@ -108,7 +183,30 @@ bool ScriptProcessor::previewScript(const QString &a_script, const QString &a_sc
 
 void ScriptProcessor::showFrameFromTimeLine(int a_frameNumber)
 {
-    slotShowFrame(a_frameNumber);
+    hr_time_point now = hr_clock::now();
+    double secondsSinceLast =
+        duration_to_double(now - m_lastTimeLineRequestTime);
+    m_lastTimeLineRequestTime = now;
+
+    bool scrubbing = (!m_playing) && (m_proxyMode != PreviewProxyMode::Off) &&
+        (secondsSinceLast * 1000.0 < double(PROXY_REFINE_DELAY));
+    if(!scrubbing)
+    {
+        slotShowFrame(a_frameNumber);
+        return;
+    }
+
+    m_pProxyRefineTimer->start();
+
+    if((a_frameNumber < 0) || (a_frameNumber >= m_cpVideoInfo->numFrames))
+        return;
+
+    if(a_frameNumber == m_frameExpected)
+        return;
+
+    bool requested = requestFrame(a_frameNumber, true);
+    if(requested)
+        m_frameExpected = a_frameNumber;
 }
 
 void ScriptProcessor::showFrameFromFrameIndicator(int a_frameNumber)
@@ -121,11 +219,101 @@ bool ScriptProcessor::isPlaying()
     return m_playing;
 }
 
+const TimeLineStrip & ScriptProcessor::timeLineStrip() const
+{
+    return m_pStripBuilder->strip();
+}
+
+void ScriptProcessor::setTimeLineStripEnabled(bool a_enabled)
+{
+    if(m_stripEnabled == a_enabled)
+        return;
+    m_stripEnabled = a_enabled;
+
+    if(!m_stripEnabled)
+        m_pStripBuilder->stop();
+    else if(!script().isEmpty() && m_cpVideoInfo)
+        m_pStripBuilder->start(m_cpVSAPI, script(), scriptName(),
+            m_cpVideoInfo);
+}
+
+void ScriptProcessor::setDropLateFrames(bool a_drop)
+{
+    if(m_dropLateFrames == a_drop)
+        return;
+    m_dropLateFrames = a_drop;
+
+    if(m_playing)
+        resetPlayClock(m_frameShown, hr_clock::now());
+}
+
+void ScriptProcessor::setPreviewProxyMode(PreviewProxyMode a_mode)
+{
+    if(m_proxyMode == a_mode)
+        return;
+    m_proxyMode = a_mode;
+    updatePreviewProxySize();
+}
+
+void ScriptProcessor::setPreviewViewportSize(const QSize & a_size)
+{
+    if(m_viewportSize == a_size)
+        return;
+    m_viewportSize = a_size;
+    if(m_proxyMode == PreviewProxyMode::Viewport)
+        updatePreviewProxySize();
+}
+
+void ScriptProcessor::setScopesEnabled(bool a_enabled)
+{
+    if(m_scopesEnabled == a_enabled)
+        return;
+    m_scopesEnabled = a_enabled;
+
+    if(!m_scopesEnabled)
+        m_pScopesBuilder->stop();
+    else if(m_cpFrameRef && (m_frameShown >= 0))
+        m_pScopesBuilder->submit(m_cpVSAPI, m_cpFrameRef, m_frameShown, m_playing);
+}
+
+void ScriptProcessor::updatePreviewProxySize()
+{
+    if((!m_cpVideoInfo) || (!m_pVapourSynthScriptProcessor->isInitialized()))
+        return;
+
+    int width = m_cpVideoInfo->width;
+    int height = m_cpVideoInfo->height;
+
+    double scale = 0.0;
+    if((m_proxyMode == PreviewProxyMode::Viewport) && (width > 0) &&
+        (height > 0) && m_viewportSize.isValid())
+    {
+        scale = std::min(double(m_viewportSize.width()) / double(width),
+            double(m_viewportSize.height()) / double(height));
+    }
+    else if(m_proxyMode == PreviewProxyMode::Fraction)
+        scale = m_proxyFraction;
+
+    // nothing to gain when the proxy is not smaller than the frame
+    if((width <= 0) || (height <= 0) || (scale <= 0.0) || (scale >= 1.0))
+    {
+        m_pVapourSynthScriptProcessor->setPreviewProxySize(0, 0);
+        return;
+    }
+
+    int proxyWidth = std::max(2, int(std::lround(width * scale / 2.0)) * 2);
+    int proxyHeight = std::max(2, int(std::lround(height * scale / 2.0)) * 2);
+    m_pVapourSynthScriptProcessor->setPreviewProxySize(proxyWidth, proxyHeight);
+}
+
 void ScriptProcessor::stopAndCleanUp()
 {
     slotPlay(false);
 
+    m_pProxyRefineTimer->stop();
     m_frameShown = -1;
+    m_frameShownIsProxy = false;
+    m_frameRequestPending = false;
 
     if(m_cpFrameRef)
     {
@@ -134,22 +322,34 @@ void ScriptProcessor::stopAndCleanUp()
         m_cpFrameRef = nullptr;
     }
 
+    if(m_pStripBuilder)
+        m_pStripBuilder->stop();
+
+    // measured frames belong to the script being cleaned up
+    if(m_pScopesBuilder)
+        m_pScopesBuilder->clear();
+
     VSScriptProcessorDialog::stopAndCleanUp();
 }
 
-bool ScriptProcessor::requestFrame(int a_frameNumber)
+bool ScriptProcessor::requestFrame(int a_frameNumber, bool a_proxy)
 {
     if(!m_pVapourSynthScriptProcessor->isInitialized())
         return false;
 
-    if((m_frameShown != -1) && (m_frameShown != m_frameExpected))
-        return false;
+    // Only the newest target is kept. Queued tickets of older targets are
+    // dropped before they reach VapourSynth and the ones in process are
+    // discarded on arrival, so seeking waits for one frame render at most.
+    if(m_frameRequestPending)
+        m_pVapourSynthScriptProcessor->flushFrameTicketsQueue();
 
-    m_pVapourSynthScriptProcessor->requestFrameAsync(a_frameNumber, 0, true);
-    return true;
+    m_frameRequestPending = m_pVapourSynthScriptProcessor->requestFrameAsync(
+        a_frameNumber, 0, true, a_proxy);
+    return m_frameRequestPending;
 }
 
-QPixmap ScriptProcessor::pixmapFromCompatBGR32(const VSFrameRef *a_cpFrameRef)
+QPixmap ScriptProcessor::pixmapFromPreviewFrame(const VSFrameRef *a_cpFrameRef,
+    const VSFrameRef *a_cpOutputFrameRef)
 {
     if((!m_cpVSAPI) || (!a_cpFrameRef))
         return QPixmap();
@@ -157,26 +357,64 @@ QPixmap ScriptProcessor::pixmapFromCompatBGR32(const VSFrameRef *a_cpFrameRef)
     const VSFormat * cpFormat = m_cpVSAPI->getFrameFormat(a_cpFrameRef);
     Q_ASSERT(cpFormat);
 
-    if(cpFormat->id != pfCompatBGR32)
+    int width = m_cpVSAPI->getFrameWidth(a_cpFrameRef, 0);
+    int height = m_cpVSAPI->getFrameHeight(a_cpFrameRef, 0);
+    QImage frameImage;
+
+    if(cpFormat->id == pfCompatBGR32)
+    {
+        const void * pData = m_cpVSAPI->getReadPtr(a_cpFrameRef, 0);
+        int stride = m_cpVSAPI->getStride(a_cpFrameRef, 0);
+        frameImage = QImage(static_cast<const uchar *>(pData), width, height,
+            stride, QImage::Format_RGB32).mirrored();
+    }
+    else if(cpFormat->id == pfRGB48)
+    {
+        // Auto follows the transfer the output frame is tagged with
+        if(m_tonemapMode == HdrTonemapMode::Auto)
+        {
+            m_deepColorConverter.setTonemap(DeepColorConverter::transferOf(
+                m_cpVSAPI, a_cpOutputFrameRef), m_peakLuminance);
+        }
+        frameImage = m_deepColorConverter.convert(m_cpVSAPI, a_cpFrameRef,
+            m_displayBitDepth);
+    }
+    else
     {
         QString errorString = tr("Error forming pixmap from frame. "
-            "Expected format CompatBGR32. Instead got \'%1\'.")
+            "Expected format CompatBGR32 or RGB48. Instead got \'%1\'.")
             .arg(cpFormat->name);
         emit signalWriteLogMessage(mtCritical, errorString);
         return QPixmap();
     }
 
-    int width = m_cpVSAPI->getFrameWidth(a_cpFrameRef, 0);
-    int height = m_cpVSAPI->getFrameHeight(a_cpFrameRef, 0);
-    const void * pData = m_cpVSAPI->getReadPtr(a_cpFrameRef, 0);
-    int stride = m_cpVSAPI->getStride(a_cpFrameRef, 0);
-    QImage frameImage(static_cast<const uchar *>(pData), width, height,
-        stride, QImage::Format_RGB32);
-    QImage flippedImage = frameImage.mirrored();
-    QPixmap framePixmap = QPixmap::fromImage(flippedImage);
+    // proxy frames are stretched to the clip size to keep the preview layout
+    if(m_cpVideoInfo && (m_cpVideoInfo->width > 0) &&
+        (m_cpVideoInfo->height > 0) && ((width != m_cpVideoInfo->width) ||
+        (height != m_cpVideoInfo->height)))
+    {
+        frameImage = frameImage.scaled(m_cpVideoInfo->width,
+            m_cpVideoInfo->height, Qt::IgnoreAspectRatio,
+            Qt::FastTransformation);
+    }
+
+    QPixmap framePixmap = QPixmap::fromImage(frameImage);
     return framePixmap;
 }
 
+void ScriptProcessor::updatePreviewDepth()
+{
+    m_displayBitDepth = m_pSettingsManager->getPreviewDisplayBitDepth();
+    m_tonemapMode = m_pSettingsManager->getHdrTonemapMode();
+    m_peakLuminance = m_pSettingsManager->getHdrPeakLuminance();
+    m_deepColorConverter.setTonemap(m_tonemapMode, m_peakLuminance);
+
+    // the RGB48 preview node is only built when something needs its depth
+    bool deepColor = (m_displayBitDepth > 8) ||
+        (m_tonemapMode != HdrTonemapMode::Off);
+    m_pVapourSynthScriptProcessor->setPreviewBitDepth(deepColor ? 16 : 8);
+}
+
 void ScriptProcessor::slotReceiveFrame(int a_frameNumber, int a_outputIndex,
     const VSFrameRef * a_cpOutputFrameRef, const VSFrameRef * a_cpPreviewFrameRef)
 {
@@ -192,15 +430,68 @@ void ScriptProcessor::slotReceiveFrame(int a_frameNumber, int a_outputIndex,
 
     if(m_playing)
     {
-        Frame newFrame(a_frameNumber, a_outputIndex,
-            cpOutputFrameRef, cpPreviewFrameRef);
-        m_framesCache.push_back(newFrame);
+        hr_time_point now = hr_clock::now();
+        m_framesRenderedForStats++;
+
+        size_t threads = std::max(m_maxThreads, size_t(1));
+        auto requestIt = m_playRequestTimes.find(a_frameNumber);
+        if(requestIt != m_playRequestTimes.end())
+        {
+            // render time, without the wait for a free thread
+            hr_time_point renderStart = requestIt->second;
+            if(m_playArrivals.size() >= threads)
+                renderStart = std::max(renderStart, m_playArrivals.front());
+            double latency = duration_to_double(now - renderStart);
+            m_playFrameLatency = (m_playFrameLatency > 0.0) ?
+                (m_playFrameLatency * 0.8 + latency * 0.2) : latency;
+            m_playRequestTimes.erase(requestIt);
+        }
+        m_playArrivals.push_back(now);
+        while(m_playArrivals.size() > threads)
+            m_playArrivals.pop_front();
+
+        if(m_lastPlayFrameArrival != hr_time_point())
+        {
+            double interval = duration_to_double(now - m_lastPlayFrameArrival);
+            m_playRenderInterval = (m_playRenderInterval > 0.0) ?
+                (m_playRenderInterval * 0.8 + interval * 0.2) : interval;
+        }
+        m_lastPlayFrameArrival = now;
+
+        if((a_frameNumber <= m_frameShown) ||
+            (a_frameNumber > m_frameShown + m_playRing.capacity()))
+        {
+            // skipped as late or left from before a jump
+            m_cpVSAPI->freeFrame(cpOutputFrameRef);
+            m_cpVSAPI->freeFrame(cpPreviewFrameRef);
+        }
+        else
+        {
+            m_playRing.store(Frame(a_frameNumber, a_outputIndex,
+                cpOutputFrameRef, cpPreviewFrameRef));
+        }
+
         slotProcessPlayQueue();
     }
     else
     {
-        setCurrentFrame(cpOutputFrameRef, cpPreviewFrameRef);
+        // a request replaced by a newer one may still be delivered
+        if((a_frameNumber != m_frameExpected) && (m_frameShown != -1))
+        {
+            m_cpVSAPI->freeFrame(cpOutputFrameRef);
+            m_cpVSAPI->freeFrame(cpPreviewFrameRef);
+            return;
+        }
+
+        m_frameRequestPending = false;
+
+        bool proxy = cpPreviewFrameRef && (m_cpVideoInfo->width > 0) &&
+            (m_cpVSAPI->getFrameWidth(cpPreviewFrameRef, 0) <
+            m_cpVideoInfo->width);
+
+        setCurrentFrame(cpOutputFrameRef, cpPreviewFrameRef, a_frameNumber);
         m_frameShown = a_frameNumber;
+        m_frameShownIsProxy = proxy;
         if(m_frameShown == m_frameExpected) {
 //            m_ui.frameStatusLabel->setPixmap(m_readyPixmap);
         }
@@ -221,6 +512,8 @@ void ScriptProcessor::slotFrameRequestDiscarded(int a_frameNumber, int a_outputI
         if(a_frameNumber != m_frameExpected)
             return;
 
+        m_frameRequestPending = false;
+
         if(m_frameShown == -1)
         {
             if(m_frameExpected == 0)
@@ -245,67 +538,199 @@ void ScriptProcessor::slotProcessPlayQueue()
     if(!m_playing)
         return;
 
-    if (m_frameShown == m_cpVideoInfo->numFrames - 1) {
-        slotPlay(false); // stop playing at the end
-        return;
-    }
-
     if(m_processingPlayQueue)
         return;
 
     m_processingPlayQueue = true;
 
-    int nextFrame = (m_frameShown + 1) % m_cpVideoInfo->numFrames;
-    Frame referenceFrame(nextFrame, 0, nullptr);
+    int lastFrame = m_cpVideoInfo->numFrames - 1;
+    bool clocked = (m_secondsBetweenFrames > 0.0);
 
-    while(!m_framesCache.empty())
+    while(m_frameShown < lastFrame)
     {
-        //  find frame in frame cache by frame number
-        auto it = std::find(m_framesCache.begin(), m_framesCache.end(),
-                            referenceFrame);
-
-        if(it == m_framesCache.end())
-            break;
-
         hr_time_point now = hr_clock::now();
-        double passed = duration_to_double(now - m_lastFrameShowTime);
-        double secondsToNextFrame = m_secondsBetweenFrames - passed;
+        int nextFrame = m_frameShown + 1;
+
+        // when dropping, any frame up to the one due now may be shown
+        int latestFrame = nextFrame;
+        if(clocked && m_dropLateFrames)
+        {
+            latestFrame = std::min(std::max(nextFrame, playClockFrame(now)),
+                lastFrame);
+        }
 
-        if(secondsToNextFrame > 0)
+        int frameToShow = -1;
+        for(int i = latestFrame; i >= nextFrame; --i)
         {
-            int millisecondsToNextFrame = int(std::ceil(secondsToNextFrame * 1000));
-            m_pPlayTimer->start(millisecondsToNextFrame);
+            if(m_playRing.contains(i))
+            {
+                frameToShow = i;
+                break;
+            }
+        }
+
+        if(frameToShow < 0)
             break;
+
+        if(clocked)
+        {
+            double secondsToFrame =
+                duration_to_double(m_playClockStart - now) +
+                double(frameToShow - m_playClockFrame) * m_secondsBetweenFrames;
+
+            if(secondsToFrame > 0)
+            {
+                int millisecondsToFrame = int(std::ceil(secondsToFrame * 1000));
+                m_pPlayTimer->start(millisecondsToFrame);
+                break;
+            }
+
+            // the frame was waited for, slow down instead of catching up
+            if((!m_dropLateFrames) && (-secondsToFrame > m_secondsBetweenFrames))
+                resetPlayClock(frameToShow, now);
         }
 
-        setCurrentFrame(it->cpOutputFrameRef, it->cpPreviewFrameRef); // set pix and send to previewarea
+        m_framesDropped += frameToShow - nextFrame;
+        m_playRing.dropBefore(frameToShow);
 
-        m_lastFrameShowTime = hr_clock::now();
+        Frame frame = m_playRing.take(frameToShow);
+        setCurrentFrame(frame.cpOutputFrameRef, frame.cpPreviewFrameRef,
+                        frameToShow); // set pix and send to previewarea
 
-        m_frameShown = nextFrame;
+        m_lastFrameShowTime = now;
+        m_frameShown = frameToShow;
         m_frameExpected = m_frameShown;
+        m_framesShownForStats++;
 
         emit signalFrameChanged(m_frameExpected); // signal to change timeline slider position
+    }
+
+    m_processingPlayQueue = false;
+
+    if(m_frameShown >= lastFrame)
+    {
+        slotPlay(false); // stop playing at the end
+        return;
+    }
+
+    requestPlayFrames(m_lastFrameRequestedForPlay + 1);
+}
+
+void ScriptProcessor::slotPlayStatsTimeout()
+{
+    emitPlaybackStats();
+}
+
+void ScriptProcessor::slotRefineProxyFrame()
+{
+    if(m_playing || (m_frameExpected < 0))
+        return;
+
+    if((!m_frameShownIsProxy) && (m_frameShown == m_frameExpected))
+        return;
+
+    requestFrame(m_frameExpected);
+}
+
+int ScriptProcessor::playClockFrame(const hr_time_point & a_time) const
+{
+    if(m_secondsBetweenFrames <= 0.0)
+        return m_frameShown + 1;
+
+    double passed = duration_to_double(a_time - m_playClockStart);
+    return m_playClockFrame +
+        int(std::floor(passed / m_secondsBetweenFrames));
+}
+
+void ScriptProcessor::resetPlayClock(int a_frameNumber,
+    const hr_time_point & a_time)
+{
+    m_playClockFrame = a_frameNumber;
+    m_playClockStart = a_time;
+}
+
+int ScriptProcessor::playPrefetchDepth() const
+{
+    // keep every thread busy and cover PLAY_PREFETCH_SECONDS of playback,
+    // but no more than can be rendered in that time
+    double renderFps = (m_playRenderInterval > 0.0) ?
+        (1.0 / m_playRenderInterval) : 0.0;
+    double targetFps = (m_secondsBetweenFrames > 0.0) ?
+        (1.0 / m_secondsBetweenFrames) : renderFps;
+    if(renderFps > 0.0)
+        targetFps = std::min(targetFps, renderFps);
+
+    int depth = int(m_maxThreads) +
+        int(std::ceil(targetFps * PLAY_PREFETCH_SECONDS));
+    return std::max(MIN_PLAY_PREFETCH_DEPTH,
+        std::min(depth, m_playRing.capacity()));
+}
+
+void ScriptProcessor::requestPlayFrames(int a_firstFrame)
+{
+    int lastFrame = m_cpVideoInfo->numFrames - 1;
+    int firstFrame = a_firstFrame;
+
+    // requests must stay inside the ring window
+    int windowLastFrame = std::min(m_frameShown + m_playRing.capacity(),
+        lastFrame);
+
+    // Nothing is coming, frames requested before were dropped. Start over
+    // after the shown one, or playback would wait forever.
+    if(m_playRequestTimes.empty() && (m_playRing.size() == 0))
+        firstFrame = std::min(firstFrame, m_frameShown + 1);
 
-        m_framesCache.erase(it);
-        nextFrame = (m_frameShown + 1) % m_cpVideoInfo->numFrames;
-        referenceFrame.number = nextFrame;
+    // Frames that would only arrive after they are due are skipped, but
+    // never past the window, so there is always something to request.
+    if((m_secondsBetweenFrames > 0.0) && m_dropLateFrames)
+    {
+        int arrivalFrame = playClockFrame(hr_clock::now()) +
+            int(std::ceil(m_playFrameLatency / m_secondsBetweenFrames));
+        firstFrame = std::max(firstFrame,
+            std::min(arrivalFrame, windowLastFrame));
     }
 
-    nextFrame = (m_lastFrameRequestedForPlay + 1) %
-        m_cpVideoInfo->numFrames;
+    int depth = playPrefetchDepth();
 
-    /* request next frame to que */
-    /* capping request queue for frames, bigger number will eat up more memory */
-    while(((m_framesInQueue + m_framesInProcess) < 2) &&
-        (m_framesCache.size() <= m_cachedFramesLimit))
+    for(int frame = firstFrame; frame <= windowLastFrame; ++frame)
     {
-        m_pVapourSynthScriptProcessor->requestFrameAsync(nextFrame, 0, true);
-        m_lastFrameRequestedForPlay = nextFrame;
-        nextFrame = (nextFrame + 1) % m_cpVideoInfo->numFrames;
+        if((int(m_playRequestTimes.size()) + m_playRing.size()) >= depth)
+            break;
+
+        bool requested = m_pVapourSynthScriptProcessor->requestFrameAsync(
+            frame, 0, true);
+        if(!requested)
+            break;
+
+        m_playRequestTimes[frame] = hr_clock::now();
+        m_lastFrameRequestedForPlay = frame;
     }
+}
 
-    m_processingPlayQueue = false;
+void ScriptProcessor::emitPlaybackStats()
+{
+    hr_time_point now = hr_clock::now();
+    double passed = duration_to_double(now - m_playStatsStart);
+    double renderedFps = 0.0;
+    double shownFps = 0.0;
+    if(passed > 0.0)
+    {
+        renderedFps = double(m_framesRenderedForStats) / passed;
+        shownFps = double(m_framesShownForStats) / passed;
+    }
+
+    emit signalPlaybackStatsChanged(m_playing, renderedFps, shownFps,
+        m_framesDropped, m_playing ? playPrefetchDepth() : 0);
+
+    m_playStatsStart = now;
+    m_framesRenderedForStats = 0;
+    m_framesShownForStats = 0;
+}
+
+void ScriptProcessor::clearFramesCache()
+{
+    VSScriptProcessorDialog::clearFramesCache();
+    m_playRing.clear();
 }
 
 bool ScriptProcessor::slotPlay(bool a_play)
@@ -317,13 +742,55 @@ bool ScriptProcessor::slotPlay(bool a_play)
 
     if(m_playing)
     {
+        int capacity = MAX_PLAY_PREFETCH_DEPTH;
+        if((m_cpVideoInfo->width > 0) && (m_cpVideoInfo->height > 0))
+        {
+            // output and preview frames, assuming 4 bytes per pixel each
+            // and 6 for RGB48 previews
+            double previewBytes =
+                (m_pVapourSynthScriptProcessor->previewBitDepth() > 8) ?
+                6.0 : 4.0;
+            double frameBytes = double(m_cpVideoInfo->width) *
+                double(m_cpVideoInfo->height) * (4.0 + previewBytes);
+            capacity = int(PLAY_PREFETCH_MEMORY_LIMIT / frameBytes);
+        }
+        capacity = std::max(MIN_PLAY_PREFETCH_DEPTH,
+            std::min(capacity, MAX_PLAY_PREFETCH_DEPTH));
+        m_playRing.reset(m_cpVSAPI, capacity);
+
+        // Requests go to the core at once, so all of its threads work
+        // and the time to arrival is the render time, not a queue wait.
+        m_idleFrameRequestsLimit =
+            m_pVapourSynthScriptProcessor->frameRequestsLimit();
+        m_pVapourSynthScriptProcessor->setFrameRequestsLimit(capacity);
+
+        m_playRequestTimes.clear();
+        m_playArrivals.clear();
+        m_playFrameLatency = 0.0;
+        m_playRenderInterval = 0.0;
+        m_lastPlayFrameArrival = hr_time_point();
+        m_framesRenderedForStats = 0;
+        m_framesShownForStats = 0;
+        m_framesDropped = 0;
+
+        hr_time_point now = hr_clock::now();
+        resetPlayClock(m_frameShown, now);
+        m_playStatsStart = now;
+        m_pPlayStatsTimer->start();
+
         m_lastFrameRequestedForPlay = m_frameShown;
         slotProcessPlayQueue();
     }
     else
     {
+        m_pPlayTimer->stop();
+        m_pPlayStatsTimer->stop();
         m_pVapourSynthScriptProcessor->flushFrameTicketsQueue();
+        m_pVapourSynthScriptProcessor->setFrameRequestsLimit(
+            m_idleFrameRequestsLimit);
         clearFramesCache();
+        m_playRequestTimes.clear();
+        emitPlaybackStats();
     }
 
     return m_playing;
@@ -333,6 +800,9 @@ void ScriptProcessor::slotSetPlaySpeed(double a_secondsPerFrames)
 {
 //    if (m_secondsBetweenFrames == a_secondsPerFrames) return;
     m_secondsBetweenFrames = a_secondsPerFrames;
+
+    if(m_playing)
+        resetPlayClock(m_frameShown, hr_clock::now());
 }
 
 void ScriptProcessor::slotGotoFrame(int a_frameNumber)
@@ -346,6 +816,23 @@ void ScriptProcessor::slotGotoFrame(int a_frameNumber)
 void ScriptProcessor::slotResetSettings()
 {
     m_pVapourSynthScriptProcessor->slotResetSettings();
+
+    int previewBitDepth = m_pVapourSynthScriptProcessor->previewBitDepth();
+    HdrTonemapMode tonemapMode = m_tonemapMode;
+    double peakLuminance = m_peakLuminance;
+    int displayBitDepth = m_displayBitDepth;
+    updatePreviewDepth();
+
+    // the shown frame is converted again with the new display settings
+    bool changed = (previewBitDepth !=
+        m_pVapourSynthScriptProcessor->previewBitDepth()) ||
+        (tonemapMode != m_tonemapMode) || (peakLuminance != m_peakLuminance) ||
+        (displayBitDepth != m_displayBitDepth);
+    if(changed && (!m_playing) && (m_frameShown >= 0))
+    {
+        m_frameExpected = m_frameShown;
+        requestFrame(m_frameShown);
+    }
 }
 
 void ScriptProcessor::slotShowFrame(int a_frameNumber)
@@ -353,11 +840,17 @@ void ScriptProcessor::slotShowFrame(int a_frameNumber)
     if(m_playing)
         return;
 
-    if(m_frameShown == a_frameNumber)
+    if ((a_frameNumber >= m_cpVideoInfo->numFrames) || (a_frameNumber < 0))
         return;
 
-    if ((a_frameNumber > m_cpVideoInfo->numFrames) || (a_frameNumber < 0))
-        return;
+    // already shown in full or on its way
+    if(a_frameNumber == m_frameExpected)
+    {
+        if(m_frameRequestPending)
+            return;
+        if((m_frameShown == a_frameNumber) && (!m_frameShownIsProxy))
+            return;
+    }
 
     static bool requestingFrame = false;
     if(requestingFrame)
@@ -3,10 +3,20 @@
 
 #include "../../vsedit/src/vapoursynth/vs_script_processor_dialog.h"
 #include "../../../common-src/chrono.h"
+#include "../../../common-src/settings/settings_definitions.h"
+#include "../../../common-src/frame_timeline/timeline_strip.h"
+#include "deep_color_converter.h"
+#include "play_prefetch_ring.h"
+#include "video_scopes.h"
 
 #include <QObject>
 #include <QWidget>
+#include <QSize>
+#include <map>
+#include <deque>
 
+class TimeLineStripBuilder;
+class VideoScopesBuilder;
 
 class ScriptProcessor : public VSScriptProcessorDialog
 {
@@ -33,16 +43,55 @@ public:
 
     bool isPlaying();
 
+    const TimeLineStrip & timeLineStrip() const;
+
+    // starts or stops building thumbnails and metrics for the timeline
+    void setTimeLineStripEnabled(bool a_enabled);
+
+    // when set, playback keeps to the clock and skips frames that are
+    // not rendered in time, otherwise it slows down to wait for them
+    void setDropLateFrames(bool a_drop);
+
+    // frames dragged through on the timeline are shown from a downscaled
+    // proxy clip first and refined to full size once the cursor rests
+    void setPreviewProxyMode(PreviewProxyMode a_mode);
+
+    void setPreviewViewportSize(const QSize & a_size);
+
+    // shown frames are measured for the scopes only while enabled
+    void setScopesEnabled(bool a_enabled);
+
 protected:
 
     virtual void stopAndCleanUp() override;
 
-    bool requestFrame(int a_frameNumber);
+    // latest wins, a new request replaces the pending one
+    bool requestFrame(int a_frameNumber, bool a_proxy = false);
+
+    void updatePreviewProxySize();
 
     void setCurrentFrame(const VSFrameRef * a_cpOutputFrameRef,
-        const VSFrameRef * a_cpPreviewFrameRef);
+        const VSFrameRef * a_cpPreviewFrameRef, int a_frameNumber);
+
+    // CompatBGR32 previews are shown as they are, RGB48 ones are
+    // converted to the display depth and tonemapped if set
+    QPixmap pixmapFromPreviewFrame(const VSFrameRef * a_cpFrameRef,
+        const VSFrameRef * a_cpOutputFrameRef);
+
+    void updatePreviewDepth();
+
+    virtual void clearFramesCache() override;
+
+    // frame that is due on screen at the given time by the play clock
+    int playClockFrame(const hr_time_point & a_time) const;
+
+    void resetPlayClock(int a_frameNumber, const hr_time_point & a_time);
+
+    int playPrefetchDepth() const;
 
-    QPixmap pixmapFromCompatBGR32(const VSFrameRef * a_cpFrameRef);
+    void requestPlayFrames(int a_firstFrame);
+
+    void emitPlaybackStats();
 
     const VSFrameRef * m_cpFrameRef;
 
@@ -54,8 +103,52 @@ protected:
 
     int m_frameExpected;
     int m_frameShown;
+    bool m_frameShownIsProxy;
+    bool m_frameRequestPending;
+
+    PreviewProxyMode m_proxyMode;
+    double m_proxyFraction;
+    QSize m_viewportSize;
+    QTimer * m_pProxyRefineTimer;
+    hr_time_point m_lastTimeLineRequestTime;
     int m_lastFrameRequestedForPlay;
 
+    bool m_dropLateFrames;
+    PlayPrefetchRing m_playRing;
+    std::map<int, hr_time_point> m_playRequestTimes;
+    // last arrivals, one per core thread; a frame requested while all
+    // threads were busy starts rendering when the oldest one arrived
+    std::deque<hr_time_point> m_playArrivals;
+    // limit of the script processor to restore when playback stops
+    int m_idleFrameRequestsLimit;
+
+    // presentation clock, frame m_playClockFrame is due at m_playClockStart
+    int m_playClockFrame;
+    hr_time_point m_playClockStart;
+
+    // averaged time from request to delivery of a frame
+    // and between deliveries of consecutive frames
+    double m_playFrameLatency;
+    double m_playRenderInterval;
+    hr_time_point m_lastPlayFrameArrival;
+
+    QTimer * m_pPlayStatsTimer;
+    hr_time_point m_playStatsStart;
+    int m_framesRenderedForStats;
+    int m_framesShownForStats;
+    int m_framesDropped;
+
+    TimeLineStripBuilder * m_pStripBuilder;
+    bool m_stripEnabled;
+
+    VideoScopesBuilder * m_pScopesBuilder;
+    bool m_scopesEnabled;
+
+    int m_displayBitDepth;
+    HdrTonemapMode m_tonemapMode;
+    double m_peakLuminance;
+    DeepColorConverter m_deepColorConverter;
+
 
 protected slots:
 
@@ -68,6 +161,10 @@ protected slots:
 
     void slotProcessPlayQueue();
 
+    void slotPlayStatsTimeout();
+
+    void slotRefineProxyFrame();
+
     void slotShowFrame(int a_frameNumber);
 
 public slots:
@@ -92,6 +189,13 @@ signals:
 
     void signalUpdateFramePropsString(const QString & a_framePropsString);
 
+    void signalTimeLineStripChanged();
+
+    void signalScopesChanged(const VideoScopes & a_scopes);
+
+    void signalPlaybackStatsChanged(bool a_playing, double a_renderedFps,
+        double a_shownFps, int a_droppedFrames, int a_prefetchDepth);
+
 };
 
 #endif // PREVIEWTAB_H
@@ -0,0 +1,271 @@
+#include "timeline_strip_builder.h"
+
+#include "../../../common-src/vapoursynth/vapoursynth_script_processor.h"
+
+#include <vapoursynth/VapourSynth.h>
+
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// samples of the decimated clip, frames are skipped evenly to fit
+const int MAX_STRIP_SAMPLES = 2000;
+const int MAX_STRIP_THUMBNAILS = 300;
+// matches the thumbnails lane of the timeline
+const int STRIP_THUMBNAIL_HEIGHT = 40;
+const int STRIP_UPDATE_INTERVAL = 500;
+
+TimeLineStripBuilder::TimeLineStripBuilder(
+    VapourSynthScriptProcessor * a_pScriptProcessor, QObject * a_pParent) :
+    QObject(a_pParent),
+    m_pScriptProcessor(a_pScriptProcessor),
+    m_cpVSAPI(nullptr),
+    m_running(false),
+    m_samplesDone(0),
+    m_thumbnailWidth(0),
+    m_previousSample(-1),
+    m_pUpdateTimer(nullptr)
+{
+    Q_ASSERT(m_pScriptProcessor);
+
+    m_pUpdateTimer = new QTimer(this);
+    m_pUpdateTimer->setSingleShot(true);
+    m_pUpdateTimer->setInterval(STRIP_UPDATE_INTERVAL);
+
+    connect(m_pUpdateTimer, &QTimer::timeout,
+        this, &TimeLineStripBuilder::slotEmitStripChanged);
+    connect(m_pScriptProcessor,
+        &VapourSynthScriptProcessor::signalDistributeThumbnail,
+        this, &TimeLineStripBuilder::slotReceiveThumbnail);
+}
+
+// END OF TimeLineStripBuilder::TimeLineStripBuilder(
+//		VapourSynthScriptProcessor * a_pScriptProcessor, QObject * a_pParent)
+//==============================================================================
+
+TimeLineStripBuilder::~TimeLineStripBuilder()
+{
+}
+
+// END OF TimeLineStripBuilder::~TimeLineStripBuilder()
+//==============================================================================
+
+void TimeLineStripBuilder::start(const VSAPI * a_cpVSAPI,
+    const QString & a_script, const QString & a_scriptName,
+    const VSVideoInfo * a_cpVideoInfo)
+{
+    stop();
+
+    if ((!a_cpVSAPI) || (!a_cpVideoInfo))
+        return;
+
+    int framesNumber = a_cpVideoInfo->numFrames;
+    if ((framesNumber <= 0) || (a_cpVideoInfo->width <= 0) ||
+        (a_cpVideoInfo->height <= 0))
+        return;
+
+    m_cpVSAPI = a_cpVSAPI;
+    QString clipKey = QString("%1|%2x%3|%4|%5/%6")
+        .arg(a_cpVideoInfo->format ? a_cpVideoInfo->format->id : 0)
+        .arg(a_cpVideoInfo->width).arg(a_cpVideoInfo->height)
+        .arg(framesNumber).arg(a_cpVideoInfo->fpsNum)
+        .arg(a_cpVideoInfo->fpsDen);
+    m_cacheFilePath = TimeLineStrip::cacheFilePath(a_script, a_scriptName,
+        clipKey);
+
+    TimeLineStrip cachedStrip;
+    if (cachedStrip.load(m_cacheFilePath, framesNumber)) {
+        m_strip = cachedStrip;
+        emit signalStripChanged();
+        return;
+    }
+
+    int step = (framesNumber + MAX_STRIP_SAMPLES - 1) / MAX_STRIP_SAMPLES;
+    int samples = (framesNumber + step - 1) / step;
+    int thumbnailEvery = (samples + MAX_STRIP_THUMBNAILS - 1) /
+        MAX_STRIP_THUMBNAILS;
+
+    m_thumbnailWidth = std::max(2, int(std::lround(
+        double(STRIP_THUMBNAIL_HEIGHT) * double(a_cpVideoInfo->width) /
+        double(a_cpVideoInfo->height) / 2.0)) * 2);
+
+    bool clipCreated = m_pScriptProcessor->setThumbnailClip(step,
+        m_thumbnailWidth, STRIP_THUMBNAIL_HEIGHT);
+    if (!clipCreated)
+        return;
+
+    m_strip.reset(framesNumber, step, thumbnailEvery);
+    m_samplesDone = 0;
+    m_previousSample = -1;
+    m_previousLuma.clear();
+    m_running = true;
+
+    for (int i = 0; i < samples; i++)
+        m_pScriptProcessor->requestThumbnailAsync(i);
+
+    emit signalStripChanged();
+}
+
+// END OF void TimeLineStripBuilder::start(const VSAPI * a_cpVSAPI,
+//		const QString & a_script, const QString & a_scriptName,
+//		const VSVideoInfo * a_cpVideoInfo)
+//==============================================================================
+
+void TimeLineStripBuilder::stop()
+{
+    if (m_running)
+        m_pScriptProcessor->flushThumbnailQueue();
+
+    bool hadStrip = !m_strip.isEmpty();
+
+    m_running = false;
+    m_pUpdateTimer->stop();
+    m_strip = TimeLineStrip();
+    m_previousLuma.clear();
+    m_previousSample = -1;
+
+    if (hadStrip)
+        emit signalStripChanged();
+}
+
+// END OF void TimeLineStripBuilder::stop()
+//==============================================================================
+
+bool TimeLineStripBuilder::isRunning() const
+{
+    return m_running;
+}
+
+// END OF bool TimeLineStripBuilder::isRunning() const
+//==============================================================================
+
+const TimeLineStrip & TimeLineStripBuilder::strip() const
+{
+    return m_strip;
+}
+
+// END OF const TimeLineStrip & TimeLineStripBuilder::strip() const
+//==============================================================================
+
+void TimeLineStripBuilder::slotReceiveThumbnail(int a_sampleNumber,
+    const VSFrameRef * a_cpFrameRef)
+{
+    if (!m_running)
+        return;
+
+    if ((a_sampleNumber < 0) || (a_sampleNumber >= m_strip.samplesNumber()))
+        return;
+
+    m_samplesDone++;
+
+    QImage image = imageFromFrame(a_cpFrameRef);
+    if (image.isNull()) {
+        m_previousLuma.clear();
+        m_previousSample = -1;
+    } else {
+        // Rec. 709 weights on the gamma encoded values
+        std::vector<quint8> luma;
+        luma.reserve(size_t(image.width() * image.height()));
+        quint64 lumaSum = 0;
+        for (int y = 0; y < image.height(); y++) {
+            const QRgb * pLine =
+                reinterpret_cast<const QRgb *>(image.constScanLine(y));
+            for (int x = 0; x < image.width(); x++) {
+                int value = (54 * qRed(pLine[x]) + 183 * qGreen(pLine[x]) +
+                    19 * qBlue(pLine[x])) >> 8;
+                luma.push_back(quint8(value));
+                lumaSum += quint64(value);
+            }
+        }
+
+        size_t pixels = std::max(luma.size(), size_t(1));
+        m_strip.luma[size_t(a_sampleNumber)] =
+            float(double(lumaSum) / double(pixels) / 255.0);
+
+        float difference = 0.0f;
+        if ((m_previousSample == a_sampleNumber - 1) &&
+            (m_previousLuma.size() == luma.size())) {
+            quint64 differenceSum = 0;
+            for (size_t i = 0; i < luma.size(); i++)
+                differenceSum += quint64(std::abs(int(luma[i]) -
+                    int(m_previousLuma[i])));
+            difference = float(double(differenceSum) / double(pixels) / 255.0);
+        }
+        m_strip.difference[size_t(a_sampleNumber)] = difference;
+
+        if (a_sampleNumber % m_strip.thumbnailEvery == 0)
+            m_strip.thumbnails[size_t(a_sampleNumber /
+                m_strip.thumbnailEvery)] = image;
+
+        m_previousLuma.swap(luma);
+        m_previousSample = a_sampleNumber;
+    }
+
+    if (m_samplesDone >= m_strip.samplesNumber()) {
+        finish();
+        return;
+    }
+
+    if (!m_pUpdateTimer->isActive())
+        m_pUpdateTimer->start();
+}
+
+// END OF void TimeLineStripBuilder::slotReceiveThumbnail(int a_sampleNumber,
+//		const VSFrameRef * a_cpFrameRef)
+//==============================================================================
+
+void TimeLineStripBuilder::slotEmitStripChanged()
+{
+    emit signalStripChanged();
+}
+
+// END OF void TimeLineStripBuilder::slotEmitStripChanged()
+//==============================================================================
+
+void TimeLineStripBuilder::finish()
+{
+    m_running = false;
+    m_pUpdateTimer->stop();
+    m_previousLuma.clear();
+    m_previousSample = -1;
+
+    m_strip.save(m_cacheFilePath);
+
+    emit signalStripChanged();
+}
+
+// END OF void TimeLineStripBuilder::finish()
+//==============================================================================
+
+QImage TimeLineStripBuilder::imageFromFrame(
+    const VSFrameRef * a_cpFrameRef) const
+{
+    if ((!m_cpVSAPI) || (!a_cpFrameRef))
+        return QImage();
+
+    const VSFormat * cpFormat = m_cpVSAPI->getFrameFormat(a_cpFrameRef);
+    if ((!cpFormat) || (cpFormat->id != pfCompatBGR32))
+        return QImage();
+
+    int width = m_cpVSAPI->getFrameWidth(a_cpFrameRef, 0);
+    int height = m_cpVSAPI->getFrameHeight(a_cpFrameRef, 0);
+    const void * pData = m_cpVSAPI->getReadPtr(a_cpFrameRef, 0);
+    int stride = m_cpVSAPI->getStride(a_cpFrameRef, 0);
+    QImage frameImage(static_cast<const uchar *>(pData), width, height,
+        stride, QImage::Format_RGB32);
+
+    // mirrored() makes a deep copy, the frame is freed after the signal
+    QImage image = frameImage.mirrored();
+    if ((image.width() != m_thumbnailWidth) ||
+        (image.height() != STRIP_THUMBNAIL_HEIGHT)) {
+        image = image.scaled(m_thumbnailWidth, STRIP_THUMBNAIL_HEIGHT,
+            Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    return image;
+}
+
+// END OF QImage TimeLineStripBuilder::imageFromFrame(
+//		const VSFrameRef * a_cpFrameRef) const
+//==============================================================================
@@ -0,0 +1,72 @@
+#ifndef TIMELINE_STRIP_BUILDER_H
+#define TIMELINE_STRIP_BUILDER_H
+
+#include "../../../common-src/frame_timeline/timeline_strip.h"
+
+#include <QObject>
+#include <vector>
+
+class QTimer;
+class VapourSynthScriptProcessor;
+struct VSAPI;
+struct VSVideoInfo;
+struct VSFrameRef;
+
+/// Fills the timeline strip from a decimated, downscaled clip requested
+/// through the script processor at low priority. Finished strips are
+/// kept in an on-disk cache keyed by the script, the output clip and
+/// the source files.
+class TimeLineStripBuilder : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    TimeLineStripBuilder(VapourSynthScriptProcessor * a_pScriptProcessor,
+        QObject * a_pParent = nullptr);
+
+    virtual ~TimeLineStripBuilder() override;
+
+    void start(const VSAPI * a_cpVSAPI, const QString & a_script,
+        const QString & a_scriptName, const VSVideoInfo * a_cpVideoInfo);
+
+    void stop();
+
+    bool isRunning() const;
+
+    const TimeLineStrip & strip() const;
+
+signals:
+
+    void signalStripChanged();
+
+private slots:
+
+    void slotReceiveThumbnail(int a_sampleNumber,
+        const VSFrameRef * a_cpFrameRef);
+
+    void slotEmitStripChanged();
+
+private:
+
+    void finish();
+
+    QImage imageFromFrame(const VSFrameRef * a_cpFrameRef) const;
+
+    VapourSynthScriptProcessor * m_pScriptProcessor;
+    const VSAPI * m_cpVSAPI;
+
+    TimeLineStrip m_strip;
+    QString m_cacheFilePath;
+    bool m_running;
+    int m_samplesDone;
+    int m_thumbnailWidth;
+
+    // luma of the previous sample for the frame difference
+    std::vector<quint8> m_previousLuma;
+    int m_previousSample;
+
+    QTimer * m_pUpdateTimer;
+};
+
+#endif // TIMELINE_STRIP_BUILDER_H
@@ -0,0 +1,528 @@
+#include "video_scopes.h"
+
+#include <vapoursynth/VapourSynth.h>
+
+#include <QObject>
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define VIDEO_SCOPES_SSE2
+    #include <emmintrin.h>
+#endif
+
+// samples of every depth are binned to 8 bit levels for display
+const int SCOPE_LEVELS = 256;
+const int WAVEFORM_MAX_WIDTH = 512;
+const int PARADE_PLANE_WIDTH = 256;
+const int HISTOGRAM_HEIGHT = 128;
+const int VECTORSCOPE_SIZE = 256;
+
+namespace
+{
+
+struct PlaneLevels
+{
+    int bytesPerSample;
+    bool isFloat;
+    // bits above 8 of integer samples
+    int shift;
+    // moves float chroma from -0.5..0.5 to 0..1
+    float floatOffset;
+};
+
+// Converts one row of native samples to 8 bit levels.
+void rowToLevels(const uint8_t * a_pSource, int a_width,
+    const PlaneLevels & a_levels, uint8_t * a_pLevels)
+{
+    int x = 0;
+
+    if(a_levels.isFloat)
+    {
+        const float * pSource = reinterpret_cast<const float *>(a_pSource);
+#ifdef VIDEO_SCOPES_SSE2
+        __m128 offset = _mm_set1_ps(a_levels.floatOffset);
+        __m128 scale = _mm_set1_ps(255.0f);
+        for(; x + 8 <= a_width; x += 8)
+        {
+            __m128 low = _mm_loadu_ps(pSource + x);
+            __m128 high = _mm_loadu_ps(pSource + x + 4);
+            __m128i lowLevels = _mm_cvtps_epi32(
+                _mm_mul_ps(_mm_add_ps(low, offset), scale));
+            __m128i highLevels = _mm_cvtps_epi32(
+                _mm_mul_ps(_mm_add_ps(high, offset), scale));
+            __m128i words = _mm_packs_epi32(lowLevels, highLevels);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(a_pLevels + x),
+                _mm_packus_epi16(words, words));
+        }
+#endif
+        for(; x < a_width; ++x)
+        {
+            float level = (pSource[x] + a_levels.floatOffset) * 255.0f;
+            if(!(level > 0.0f))
+                a_pLevels[x] = 0;
+            else if(level >= 255.0f)
+                a_pLevels[x] = 255;
+            else
+                a_pLevels[x] = uint8_t(level + 0.5f);
+        }
+        return;
+    }
+
+    if(a_levels.bytesPerSample == 1)
+    {
+        memcpy(a_pLevels, a_pSource, size_t(a_width));
+        return;
+    }
+
+    const uint16_t * pSource = reinterpret_cast<const uint16_t *>(a_pSource);
+#ifdef VIDEO_SCOPES_SSE2
+    __m128i shift = _mm_cvtsi32_si128(a_levels.shift);
+    for(; x + 16 <= a_width; x += 16)
+    {
+        __m128i low = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(pSource + x));
+        __m128i high = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(pSource + x + 8));
+        low = _mm_srl_epi16(low, shift);
+        high = _mm_srl_epi16(high, shift);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(a_pLevels + x),
+            _mm_packus_epi16(low, high));
+    }
+#endif
+    for(; x < a_width; ++x)
+        a_pLevels[x] = uint8_t(std::min(pSource[x] >> a_levels.shift, 255));
+}
+
+// BT.709 luma and chroma of 8 bit RGB levels. Chroma is offset so that
+// every intermediate stays within 16 unsigned bits.
+void rgbToLumaChroma(const uint8_t * a_pR, const uint8_t * a_pG,
+    const uint8_t * a_pB, int a_width, uint8_t * a_pY, uint8_t * a_pCb,
+    uint8_t * a_pCr)
+{
+    int x = 0;
+
+#ifdef VIDEO_SCOPES_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i chromaOffset = _mm_set1_epi16(short(0x807F - 0x10000));
+    for(; x + 8 <= a_width; x += 8)
+    {
+        __m128i r = _mm_unpacklo_epi8(_mm_loadl_epi64(
+            reinterpret_cast<const __m128i *>(a_pR + x)), zero);
+        __m128i g = _mm_unpacklo_epi8(_mm_loadl_epi64(
+            reinterpret_cast<const __m128i *>(a_pG + x)), zero);
+        __m128i b = _mm_unpacklo_epi8(_mm_loadl_epi64(
+            reinterpret_cast<const __m128i *>(a_pB + x)), zero);
+
+        __m128i y = _mm_add_epi16(
+            _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(54)),
+                _mm_mullo_epi16(g, _mm_set1_epi16(183))),
+            _mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(19)),
+                _mm_set1_epi16(128)));
+        __m128i cb = _mm_sub_epi16(
+            _mm_add_epi16(chromaOffset, _mm_slli_epi16(b, 7)),
+            _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(29)),
+                _mm_mullo_epi16(g, _mm_set1_epi16(99))));
+        __m128i cr = _mm_sub_epi16(
+            _mm_add_epi16(chromaOffset, _mm_slli_epi16(r, 7)),
+            _mm_add_epi16(_mm_mullo_epi16(g, _mm_set1_epi16(116)),
+                _mm_mullo_epi16(b, _mm_set1_epi16(12))));
+
+        y = _mm_srli_epi16(y, 8);
+        cb = _mm_srli_epi16(cb, 8);
+        cr = _mm_srli_epi16(cr, 8);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(a_pY + x),
+            _mm_packus_epi16(y, y));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(a_pCb + x),
+            _mm_packus_epi16(cb, cb));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(a_pCr + x),
+            _mm_packus_epi16(cr, cr));
+    }
+#endif
+    for(; x < a_width; ++x)
+    {
+        int r = a_pR[x];
+        int g = a_pG[x];
+        int b = a_pB[x];
+        a_pY[x] = uint8_t((54 * r + 183 * g + 19 * b + 128) >> 8);
+        a_pCb[x] = uint8_t((0x807F + 128 * b - 29 * r - 99 * g) >> 8);
+        a_pCr[x] = uint8_t((0x807F + 128 * r - 116 * g - 12 * b) >> 8);
+    }
+}
+
+void accumulateHistogram(const uint8_t * a_pLevels, int a_width,
+    uint32_t * a_pHistogram)
+{
+    for(int x = 0; x < a_width; ++x)
+        a_pHistogram[a_pLevels[x]]++;
+}
+
+// Counts are stored top row first, level 255 at the top.
+void accumulateWaveform(const uint8_t * a_pLevels, int a_width,
+    const int * a_pColumns, int a_imageWidth, uint32_t * a_pCounts)
+{
+    for(int x = 0; x < a_width; ++x)
+    {
+        int row = SCOPE_LEVELS - 1 - a_pLevels[x];
+        a_pCounts[row * a_imageWidth + a_pColumns[x]]++;
+    }
+}
+
+void accumulateVectorscope(const uint8_t * a_pU, const uint8_t * a_pV,
+    int a_width, uint32_t * a_pCounts)
+{
+    for(int x = 0; x < a_width; ++x)
+    {
+        int row = VECTORSCOPE_SIZE - 1 - a_pV[x];
+        a_pCounts[row * VECTORSCOPE_SIZE + a_pU[x]]++;
+    }
+}
+
+std::vector<int> columnsMap(int a_sourceWidth, int a_imageWidth,
+    int a_firstColumn)
+{
+    std::vector<int> columns(size_t(a_sourceWidth));
+    for(int x = 0; x < a_sourceWidth; ++x)
+    {
+        columns[size_t(x)] = a_firstColumn +
+            int(int64_t(x) * a_imageWidth / a_sourceWidth);
+    }
+    return columns;
+}
+
+// Log scaled density, any hit stays visible. Tints are applied to
+// consecutive column bands of equal width.
+QImage renderDensity(const std::vector<uint32_t> & a_counts, int a_width,
+    int a_height, const std::vector<QRgb> & a_tints)
+{
+    QImage image(a_width, a_height, QImage::Format_RGB32);
+
+    uint32_t maxCount = 0;
+    for(uint32_t count : a_counts)
+        maxCount = std::max(maxCount, count);
+    double logMax = std::log1p(double(std::max(maxCount, 1u)));
+
+    int bandWidth = std::max(a_width / std::max(int(a_tints.size()), 1), 1);
+    for(int y = 0; y < a_height; ++y)
+    {
+        QRgb * pLine = reinterpret_cast<QRgb *>(image.scanLine(y));
+        const uint32_t * pCounts = a_counts.data() + size_t(y) * a_width;
+        for(int x = 0; x < a_width; ++x)
+        {
+            uint32_t count = pCounts[x];
+            if(count == 0)
+            {
+                pLine[x] = qRgb(0, 0, 0);
+                continue;
+            }
+            double value = 0.25 + 0.75 * std::log1p(double(count)) / logMax;
+            QRgb tint = a_tints[size_t(std::min(x / bandWidth,
+                int(a_tints.size()) - 1))];
+            pLine[x] = qRgb(int(qRed(tint) * value), int(qGreen(tint) * value),
+                int(qBlue(tint) * value));
+        }
+    }
+
+    return image;
+}
+
+void drawLevelGraticule(QImage & a_image)
+{
+    QPainter painter(&a_image);
+    painter.setPen(QColor(255, 255, 255, 48));
+    // limited range black, middle grey and white
+    for(int level : {16, 128, 235})
+    {
+        int y = SCOPE_LEVELS - 1 - level;
+        painter.drawLine(0, y, a_image.width() - 1, y);
+    }
+}
+
+void drawVectorscopeGraticule(QImage & a_image)
+{
+    QPainter painter(&a_image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QColor(255, 255, 255, 48));
+    int centre = VECTORSCOPE_SIZE / 2;
+    painter.drawLine(centre, 0, centre, VECTORSCOPE_SIZE - 1);
+    painter.drawLine(0, centre, VECTORSCOPE_SIZE - 1, centre);
+    // limited range chroma reaches 112 levels from the centre
+    painter.drawEllipse(QPoint(centre, centre), 112, 112);
+}
+
+// Bars of the channels are OR-ed so that overlaps mix additively.
+QImage renderHistogram(const std::vector<uint32_t> * a_pHistograms,
+    const std::vector<QRgb> & a_tints)
+{
+    QImage image(SCOPE_LEVELS, HISTOGRAM_HEIGHT, QImage::Format_RGB32);
+    image.fill(qRgb(0, 0, 0));
+
+    uint32_t maxCount = 0;
+    for(size_t c = 0; c < a_tints.size(); ++c)
+    {
+        for(uint32_t count : a_pHistograms[c])
+            maxCount = std::max(maxCount, count);
+    }
+    if(maxCount == 0)
+        return image;
+
+    for(size_t c = 0; c < a_tints.size(); ++c)
+    {
+        for(int x = 0; x < SCOPE_LEVELS; ++x)
+        {
+            int height = int(uint64_t(a_pHistograms[c][size_t(x)]) *
+                HISTOGRAM_HEIGHT / maxCount);
+            for(int y = HISTOGRAM_HEIGHT - height; y < HISTOGRAM_HEIGHT; ++y)
+            {
+                QRgb * pLine = reinterpret_cast<QRgb *>(image.scanLine(y));
+                pLine[x] |= a_tints[c];
+            }
+        }
+    }
+
+    return image;
+}
+
+} // namespace
+
+//==============================================================================
+
+VideoScopes::VideoScopes() :
+    frameNumber(-1),
+    rowStep(1)
+{
+}
+
+// END OF VideoScopes::VideoScopes()
+//==============================================================================
+
+bool VideoScopes::isNull() const
+{
+    return (frameNumber < 0);
+}
+
+// END OF bool VideoScopes::isNull() const
+//==============================================================================
+
+VideoScopes VideoScopes::compute(const VSAPI * a_cpVSAPI,
+    const VSFrameRef * a_cpFrameRef, int a_frameNumber, int a_rowStep)
+{
+    VideoScopes scopes;
+    scopes.frameNumber = a_frameNumber;
+    scopes.rowStep = std::max(a_rowStep, 1);
+
+    if((!a_cpVSAPI) || (!a_cpFrameRef))
+    {
+        scopes.error = QObject::tr("No frame.");
+        return scopes;
+    }
+
+    const VSFormat * cpFormat = a_cpVSAPI->getFrameFormat(a_cpFrameRef);
+    if(!cpFormat)
+    {
+        scopes.error = QObject::tr("The frame has no format.");
+        return scopes;
+    }
+
+    // packed BGRA is read bottom-up and split into planes
+    bool compatBGR = (cpFormat->id == pfCompatBGR32);
+    bool supported = compatBGR ||
+        ((cpFormat->colorFamily != cmCompat) &&
+        (((cpFormat->sampleType == stInteger) &&
+        (cpFormat->bytesPerSample <= 2)) ||
+        ((cpFormat->sampleType == stFloat) &&
+        (cpFormat->bytesPerSample == 4))));
+    if(!supported)
+    {
+        scopes.error = QObject::tr("Scopes are not available for %1.")
+            .arg(cpFormat->name);
+        return scopes;
+    }
+
+    bool isRGB = compatBGR || (cpFormat->colorFamily == cmRGB);
+    int planes = compatBGR ? 3 : std::min(cpFormat->numPlanes, 3);
+    int width = a_cpVSAPI->getFrameWidth(a_cpFrameRef, 0);
+    int height = a_cpVSAPI->getFrameHeight(a_cpFrameRef, 0);
+    if((width <= 0) || (height <= 0))
+    {
+        scopes.error = QObject::tr("The frame is empty.");
+        return scopes;
+    }
+
+    if(isRGB)
+        scopes.paradeTitle = QObject::tr("R G B");
+    else if(cpFormat->colorFamily == cmYCoCg)
+        scopes.paradeTitle = QObject::tr("Y Co Cg");
+    else if(planes == 3)
+        scopes.paradeTitle = QObject::tr("Y U V");
+    else
+        scopes.paradeTitle = QObject::tr("Y");
+
+    // keep subsampled chroma rows aligned to the measured luma rows
+    int subSamplingH = compatBGR ? 0 : cpFormat->subSamplingH;
+    int rowStep = scopes.rowStep;
+    if((rowStep > 1) && (subSamplingH > 0))
+    {
+        int alignment = 1 << subSamplingH;
+        rowStep = (rowStep + alignment - 1) / alignment * alignment;
+    }
+
+    int planeWidth[3] = {width, width, width};
+    const uint8_t * planeData[3] = {nullptr, nullptr, nullptr};
+    int planeStride[3] = {0, 0, 0};
+    PlaneLevels planeLevels[3];
+    for(int p = 0; p < planes; ++p)
+    {
+        planeLevels[p].bytesPerSample = 1;
+        planeLevels[p].isFloat = false;
+        planeLevels[p].shift = 0;
+        planeLevels[p].floatOffset = 0.0f;
+
+        if(compatBGR)
+            continue;
+
+        planeWidth[p] = a_cpVSAPI->getFrameWidth(a_cpFrameRef, p);
+        planeData[p] = a_cpVSAPI->getReadPtr(a_cpFrameRef, p);
+        planeStride[p] = a_cpVSAPI->getStride(a_cpFrameRef, p);
+        planeLevels[p].bytesPerSample = cpFormat->bytesPerSample;
+        planeLevels[p].isFloat = (cpFormat->sampleType == stFloat);
+        planeLevels[p].shift = std::max(cpFormat->bitsPerSample - 8, 0);
+        if((!isRGB) && (p > 0))
+            planeLevels[p].floatOffset = 0.5f;
+    }
+
+    const uint8_t * pPackedData = nullptr;
+    int packedStride = 0;
+    if(compatBGR)
+    {
+        pPackedData = a_cpVSAPI->getReadPtr(a_cpFrameRef, 0);
+        packedStride = a_cpVSAPI->getStride(a_cpFrameRef, 0);
+    }
+
+    int waveformWidth = std::min(width, WAVEFORM_MAX_WIDTH);
+    int paradeWidth = PARADE_PLANE_WIDTH * planes;
+
+    std::vector<uint32_t> histograms[3];
+    std::vector<uint8_t> levels[3];
+    std::vector<int> paradeColumns[3];
+    for(int p = 0; p < planes; ++p)
+    {
+        histograms[p].assign(SCOPE_LEVELS, 0);
+        levels[p].resize(size_t(planeWidth[p]) + 16);
+        paradeColumns[p] = columnsMap(planeWidth[p], PARADE_PLANE_WIDTH,
+            p * PARADE_PLANE_WIDTH);
+    }
+    std::vector<int> waveformColumns = columnsMap(width, waveformWidth, 0);
+
+    std::vector<uint32_t> waveform(size_t(waveformWidth) * SCOPE_LEVELS, 0);
+    std::vector<uint32_t> parade(size_t(paradeWidth) * SCOPE_LEVELS, 0);
+    std::vector<uint32_t> vectorscope(
+        size_t(VECTORSCOPE_SIZE) * VECTORSCOPE_SIZE, 0);
+
+    std::vector<uint8_t> lumaRow;
+    std::vector<uint8_t> cbRow;
+    std::vector<uint8_t> crRow;
+    if(isRGB)
+    {
+        lumaRow.resize(size_t(width) + 16);
+        cbRow.resize(size_t(width) + 16);
+        crRow.resize(size_t(width) + 16);
+    }
+
+    for(int y = 0; y < height; y += rowStep)
+    {
+        bool chromaRow = ((y & ((1 << subSamplingH) - 1)) == 0);
+
+        if(compatBGR)
+        {
+            const uint8_t * pRow =
+                pPackedData + ptrdiff_t(packedStride) * (height - 1 - y);
+            for(int x = 0; x < width; ++x)
+            {
+                levels[2][size_t(x)] = pRow[x * 4];
+                levels[1][size_t(x)] = pRow[x * 4 + 1];
+                levels[0][size_t(x)] = pRow[x * 4 + 2];
+            }
+        }
+
+        for(int p = 0; p < planes; ++p)
+        {
+            if((p > 0) && (!chromaRow))
+                continue;
+
+            if(!compatBGR)
+            {
+                int planeRow = (p > 0) ? (y >> subSamplingH) : y;
+                rowToLevels(planeData[p] + ptrdiff_t(planeStride[p]) * planeRow,
+                    planeWidth[p], planeLevels[p], levels[p].data());
+            }
+
+            accumulateHistogram(levels[p].data(), planeWidth[p],
+                histograms[p].data());
+            accumulateWaveform(levels[p].data(), planeWidth[p],
+                paradeColumns[p].data(), paradeWidth, parade.data());
+        }
+
+        if(isRGB)
+        {
+            rgbToLumaChroma(levels[0].data(), levels[1].data(),
+                levels[2].data(), width, lumaRow.data(), cbRow.data(),
+                crRow.data());
+            accumulateWaveform(lumaRow.data(), width, waveformColumns.data(),
+                waveformWidth, waveform.data());
+            accumulateVectorscope(cbRow.data(), crRow.data(), width,
+                vectorscope.data());
+        }
+        else
+        {
+            accumulateWaveform(levels[0].data(), width,
+                waveformColumns.data(), waveformWidth, waveform.data());
+            if((planes == 3) && chromaRow)
+            {
+                accumulateVectorscope(levels[1].data(), levels[2].data(),
+                    planeWidth[1], vectorscope.data());
+            }
+        }
+    }
+
+    std::vector<QRgb> paradeTints;
+    std::vector<QRgb> histogramTints;
+    if(isRGB)
+    {
+        paradeTints = {qRgb(255, 96, 96), qRgb(96, 255, 96),
+            qRgb(112, 144, 255)};
+        histogramTints = {qRgb(255, 0, 0), qRgb(0, 255, 0), qRgb(0, 0, 255)};
+    }
+    else
+    {
+        paradeTints = {qRgb(224, 224, 224), qRgb(112, 144, 255),
+            qRgb(255, 112, 112)};
+        paradeTints.resize(size_t(planes));
+        histogramTints = {qRgb(224, 224, 224)};
+    }
+
+    scopes.histogram = renderHistogram(histograms, histogramTints);
+
+    scopes.waveform = renderDensity(waveform, waveformWidth, SCOPE_LEVELS,
+        {qRgb(128, 255, 160)});
+    drawLevelGraticule(scopes.waveform);
+
+    scopes.parade = renderDensity(parade, paradeWidth, SCOPE_LEVELS,
+        paradeTints);
+    drawLevelGraticule(scopes.parade);
+
+    scopes.vectorscope = renderDensity(vectorscope, VECTORSCOPE_SIZE,
+        VECTORSCOPE_SIZE, {qRgb(160, 255, 160)});
+    drawVectorscopeGraticule(scopes.vectorscope);
+
+    return scopes;
+}
+
+// END OF VideoScopes VideoScopes::compute(const VSAPI * a_cpVSAPI,
+//		const VSFrameRef * a_cpFrameRef, int a_frameNumber, int a_rowStep)
+//==============================================================================
@@ -0,0 +1,42 @@
+#ifndef VIDEO_SCOPES_H
+#define VIDEO_SCOPES_H
+
+#include <QImage>
+#include <QMetaType>
+#include <QString>
+
+struct VSAPI;
+struct VSFrameRef;
+
+// histogram, luma waveform, parade and vectorscope of one output frame,
+// rendered as images ready to be shown
+struct VideoScopes
+{
+    int frameNumber;
+
+    // every n-th row of the frame was measured, 1 for the full frame
+    int rowStep;
+
+    // names of the parade planes, "R G B" or "Y U V"
+    QString paradeTitle;
+
+    QImage histogram;
+    QImage waveform;
+    QImage parade;
+    QImage vectorscope;
+
+    // empty when the frame format could be measured
+    QString error;
+
+    VideoScopes();
+
+    bool isNull() const;
+
+    // measures the planes of the frame as they are, at their own bit depth
+    static VideoScopes compute(const VSAPI * a_cpVSAPI,
+        const VSFrameRef * a_cpFrameRef, int a_frameNumber, int a_rowStep);
+};
+
+Q_DECLARE_METATYPE(VideoScopes)
+
+#endif // VIDEO_SCOPES_H
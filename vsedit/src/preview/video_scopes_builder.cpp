@@ -0,0 +1,203 @@
+#include "video_scopes_builder.h"
+
+#include <vapoursynth/VapourSynth.h>
+
+#include <QCoreApplication>
+#include <QThread>
+#include <algorithm>
+
+// rows measured during playback, enough for the scopes resolution
+const int SCOPES_PLAYBACK_ROWS = 270;
+// in kilobytes of scope images
+const int SCOPES_CACHE_SIZE = 64 * 1024;
+
+VideoScopesJob::VideoScopesJob() :
+    cpVSAPI(nullptr),
+    cpFrameRef(nullptr),
+    frameNumber(-1),
+    rowStep(1),
+    generation(0)
+{
+}
+
+// END OF VideoScopesJob::VideoScopesJob()
+//==============================================================================
+
+VideoScopesWorker::VideoScopesWorker(QObject * a_pParent) :
+    QObject(a_pParent)
+{
+}
+
+// END OF VideoScopesWorker::VideoScopesWorker(QObject * a_pParent)
+//==============================================================================
+
+void VideoScopesWorker::slotCompute(const VideoScopesJob & a_job)
+{
+    VideoScopes scopes = VideoScopes::compute(a_job.cpVSAPI,
+        a_job.cpFrameRef, a_job.frameNumber, a_job.rowStep);
+    emit signalComputed(a_job, scopes);
+}
+
+// END OF void VideoScopesWorker::slotCompute(const VideoScopesJob & a_job)
+//==============================================================================
+
+VideoScopesBuilder::VideoScopesBuilder(QObject * a_pParent) :
+    QObject(a_pParent),
+    m_pThread(nullptr),
+    m_pWorker(nullptr),
+    m_busy(false),
+    m_generation(0),
+    m_cache(SCOPES_CACHE_SIZE)
+{
+    m_pThread = new QThread(this);
+    m_pWorker = new VideoScopesWorker();
+    m_pWorker->moveToThread(m_pThread);
+
+    connect(m_pWorker, &VideoScopesWorker::signalComputed,
+        this, &VideoScopesBuilder::slotComputed);
+}
+
+// END OF VideoScopesBuilder::VideoScopesBuilder(QObject * a_pParent)
+//==============================================================================
+
+VideoScopesBuilder::~VideoScopesBuilder()
+{
+    stop();
+    m_pThread->quit();
+    m_pThread->wait();
+    delete m_pWorker;
+}
+
+// END OF VideoScopesBuilder::~VideoScopesBuilder()
+//==============================================================================
+
+void VideoScopesBuilder::submit(const VSAPI * a_cpVSAPI,
+    const VSFrameRef * a_cpFrameRef, int a_frameNumber, bool a_playing)
+{
+    if((!a_cpVSAPI) || (!a_cpFrameRef) || (a_frameNumber < 0))
+        return;
+
+    int rowStep = 1;
+    if(a_playing)
+    {
+        int height = a_cpVSAPI->getFrameHeight(a_cpFrameRef, 0);
+        rowStep = std::max(height / SCOPES_PLAYBACK_ROWS, 1);
+    }
+
+    // the frame moved on, whatever waited is not wanted anymore
+    freeJob(m_pendingJob);
+
+    VideoScopes * pCached = m_cache.object(a_frameNumber);
+    if(pCached && (pCached->rowStep <= rowStep))
+    {
+        emit signalScopesReady(*pCached);
+        return;
+    }
+
+    VideoScopesJob job;
+    job.cpVSAPI = a_cpVSAPI;
+    job.cpFrameRef = a_cpVSAPI->cloneFrameRef(a_cpFrameRef);
+    job.frameNumber = a_frameNumber;
+    job.rowStep = rowStep;
+    job.generation = m_generation;
+
+    if(m_busy)
+        m_pendingJob = job;
+    else
+        dispatch(job);
+}
+
+// END OF void VideoScopesBuilder::submit(const VSAPI * a_cpVSAPI,
+//		const VSFrameRef * a_cpFrameRef, int a_frameNumber, bool a_playing)
+//==============================================================================
+
+void VideoScopesBuilder::stop()
+{
+    m_generation++;
+    freeJob(m_pendingJob);
+
+    if(!m_busy)
+        return;
+
+    // A measurement can not be interrupted. Let it finish and make sure
+    // a job that did not start yet never does.
+    m_pThread->quit();
+    m_pThread->wait();
+    QCoreApplication::removePostedEvents(m_pWorker);
+
+    freeJob(m_runningJob);
+    m_busy = false;
+}
+
+// END OF void VideoScopesBuilder::stop()
+//==============================================================================
+
+void VideoScopesBuilder::clear()
+{
+    stop();
+    m_cache.clear();
+}
+
+// END OF void VideoScopesBuilder::clear()
+//==============================================================================
+
+void VideoScopesBuilder::slotComputed(const VideoScopesJob & a_job,
+    const VideoScopes & a_scopes)
+{
+    if(a_job.generation != m_generation)
+        return;
+
+    freeJob(m_runningJob);
+    m_busy = false;
+
+    int cost = 0;
+    for(const QImage * pImage : {&a_scopes.histogram, &a_scopes.waveform,
+        &a_scopes.parade, &a_scopes.vectorscope})
+        cost += pImage->bytesPerLine() * pImage->height() / 1024;
+    VideoScopes * pCached = m_cache.object(a_scopes.frameNumber);
+    if((!pCached) || (pCached->rowStep > a_scopes.rowStep))
+    {
+        m_cache.insert(a_scopes.frameNumber, new VideoScopes(a_scopes),
+            std::max(cost, 1));
+    }
+
+    emit signalScopesReady(a_scopes);
+
+    if(m_pendingJob.cpFrameRef)
+    {
+        VideoScopesJob job = m_pendingJob;
+        m_pendingJob = VideoScopesJob();
+        dispatch(job);
+    }
+}
+
+// END OF void VideoScopesBuilder::slotComputed(const VideoScopesJob & a_job,
+//		const VideoScopes & a_scopes)
+//==============================================================================
+
+void VideoScopesBuilder::dispatch(const VideoScopesJob & a_job)
+{
+    if(!m_pThread->isRunning())
+        m_pThread->start(QThread::LowPriority);
+
+    m_runningJob = a_job;
+    m_busy = true;
+    QMetaObject::invokeMethod(m_pWorker, "slotCompute", Qt::QueuedConnection,
+        Q_ARG(VideoScopesJob, a_job));
+}
+
+// END OF void VideoScopesBuilder::dispatch(const VideoScopesJob & a_job)
+//==============================================================================
+
+void VideoScopesBuilder::freeJob(VideoScopesJob & a_job)
+{
+    if(a_job.cpFrameRef)
+    {
+        Q_ASSERT(a_job.cpVSAPI);
+        a_job.cpVSAPI->freeFrame(a_job.cpFrameRef);
+    }
+    a_job = VideoScopesJob();
+}
+
+// END OF void VideoScopesBuilder::freeJob(VideoScopesJob & a_job)
+//==============================================================================
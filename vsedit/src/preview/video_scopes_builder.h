@@ -0,0 +1,96 @@
+#ifndef VIDEO_SCOPES_BUILDER_H
+#define VIDEO_SCOPES_BUILDER_H
+
+#include "video_scopes.h"
+
+#include <QCache>
+#include <QObject>
+
+class QThread;
+struct VSAPI;
+struct VSFrameRef;
+
+// frame handed to the worker thread, the builder holds the reference
+struct VideoScopesJob
+{
+    const VSAPI * cpVSAPI;
+    const VSFrameRef * cpFrameRef;
+    int frameNumber;
+    int rowStep;
+    int generation;
+
+    VideoScopesJob();
+};
+
+Q_DECLARE_METATYPE(VideoScopesJob)
+
+class VideoScopesWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit VideoScopesWorker(QObject * a_pParent = nullptr);
+
+public slots:
+
+    void slotCompute(const VideoScopesJob & a_job);
+
+signals:
+
+    void signalComputed(const VideoScopesJob & a_job,
+        const VideoScopes & a_scopes);
+};
+
+/// Measures shown frames on a low priority thread. Only the newest
+/// frame waits while another one is measured, results are cached by
+/// frame number.
+class VideoScopesBuilder : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit VideoScopesBuilder(QObject * a_pParent = nullptr);
+
+    virtual ~VideoScopesBuilder() override;
+
+    // the frame is cloned, during playback only some rows are measured
+    void submit(const VSAPI * a_cpVSAPI, const VSFrameRef * a_cpFrameRef,
+        int a_frameNumber, bool a_playing);
+
+    // drops the waiting frame and waits for the one being measured
+    void stop();
+
+    // stops and forgets the cached scopes
+    void clear();
+
+signals:
+
+    void signalScopesReady(const VideoScopes & a_scopes);
+
+private slots:
+
+    void slotComputed(const VideoScopesJob & a_job,
+        const VideoScopes & a_scopes);
+
+private:
+
+    void dispatch(const VideoScopesJob & a_job);
+
+    void freeJob(VideoScopesJob & a_job);
+
+    QThread * m_pThread;
+    VideoScopesWorker * m_pWorker;
+
+    bool m_busy;
+    VideoScopesJob m_runningJob;
+    VideoScopesJob m_pendingJob;
+
+    // results of jobs sent before the last stop are ignored
+    int m_generation;
+
+    QCache<int, VideoScopes> m_cache;
+};
+
+#endif // VIDEO_SCOPES_BUILDER_H
@@ -2,7 +2,6 @@
 #include "ui_preview_filters_dialog.h"
 #include "../../common-src/settings/settings_manager.h"
 
-#include <QTimer>
 #include <QDebug>
 
 PreviewFiltersDialog::PreviewFiltersDialog(SettingsManager * a_pSettingsManager,
@@ -61,18 +60,14 @@ void PreviewFiltersDialog::saveGeometryDelayed()
     QApplication::processEvents();
     if(!isMaximized())
     {
+        // the settings manager coalesces the writes of a drag
         m_windowGeometry = saveGeometry();
-        m_pGeometrySaveTimer->start();
+        m_pSettingsManager->setPreviewFiltersDialogGeometry(m_windowGeometry);
     }
 }
 
 void PreviewFiltersDialog::setWindowGeometry()
 {
-    m_pGeometrySaveTimer = new QTimer(this);
-    m_pGeometrySaveTimer->setInterval(DEFAULT_WINDOW_GEOMETRY_SAVE_DELAY);
-    connect(m_pGeometrySaveTimer, &QTimer::timeout,
-        this, &PreviewFiltersDialog::slotSaveGeometry);
-
     m_windowGeometry = m_pSettingsManager->getPreviewFiltersDialogGeometry();
     if(!m_windowGeometry.isEmpty())
         restoreGeometry(m_windowGeometry);
@@ -99,9 +94,3 @@ void PreviewFiltersDialog::slotUpdateChannels(int a_id)
     m_previewFiltersMap["channels"] = a_id;
     slotSendPreviewFiltersMapSignal();
 }
-
-void PreviewFiltersDialog::slotSaveGeometry()
-{
-    m_pGeometrySaveTimer->stop();
-    m_pSettingsManager->setPreviewFiltersDialogGeometry(m_windowGeometry);
-}
@@ -39,7 +39,6 @@ protected:
     void saveGeometryDelayed();
     void setWindowGeometry();
 
-    QTimer * m_pGeometrySaveTimer;
     QByteArray m_windowGeometry;
 
 signals:
@@ -56,10 +55,6 @@ public slots:
 private slots:
 
     void slotUpdateChannels(int);
-
-protected slots:
-
-    void slotSaveGeometry();
 };
 
 #endif // PREVIEW_FILTERS_DIALOG_H
@@ -842,6 +842,11 @@ void ScriptEditor::slotUpdateSideBox(const QRect & a_rect, int a_dy)
 		m_pSideBox->scroll(0, a_dy);
 	else
 		m_pSideBox->update(0, a_rect.y(), m_pSideBox->width(), a_rect.height());
+
+	QTextBlock lastVisibleBlock =
+		cursorForPosition(QPoint(0, viewport()->height() - 1)).block();
+	m_pSyntaxHighlighter->setVisibleBlocks(firstVisibleBlock().blockNumber(),
+		lastVisibleBlock.blockNumber());
 }
 
 // END OF void ScriptEditor::slotUpdateSideBox(const QRect & a_rect, int a_dy)
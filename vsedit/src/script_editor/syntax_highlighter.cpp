@@ -3,6 +3,10 @@
 #include "number_matcher.h"
 #include "../../../common-src/settings/settings_manager.h"
 
+#include <QTextDocument>
+#include <QTextBlock>
+#include <QTimer>
+#include <QElapsedTimer>
 #include <vector>
 #include <algorithm>
 
@@ -19,6 +23,19 @@ enum class BlockState : int
 	LongStringDoubleMiddle
 };
 
+// Documents up to this size are highlighted synchronously.
+const int EAGER_DOCUMENT_BLOCKS = 2000;
+// Blocks around the viewport that are highlighted with it.
+const int VISIBLE_BLOCKS_MARGIN = 100;
+// Milliseconds of deferred highlighting per event loop pass.
+const int IDLE_HIGHLIGHT_SLICE = 10;
+
+// Marks a block whose highlighting was put off. It keeps its old
+// state, so a cascade of state changes stops at this block.
+class DeferredBlockData : public QTextBlockUserData
+{
+};
+
 enum class TokenType
 {
 	Undecided,
@@ -32,24 +49,49 @@ enum class TokenType
 	VSFunction,
 };
 
+// The text refers to the block being highlighted, no copy per token.
 struct Token
 {
-	QString text;
+	QStringRef text;
 	int start;
 	int length;
 	TokenType type;
 
-	Token(const QString & a_text, int a_start, int a_length, TokenType a_type):
+	Token(const QStringRef & a_text, int a_start, int a_length,
+		TokenType a_type):
 		text(a_text), start(a_start), length(a_length), type(a_type){}
 };
 
+bool matchesAt(const QString & a_text, int a_position,
+	const QLatin1String & a_pattern)
+{
+	return (a_text.midRef(a_position, a_pattern.size()) == a_pattern);
+}
+
+// String prefix like r' or u", case insensitive.
+bool prefixedQuoteAt(const QString & a_text, int a_position, QChar a_quote)
+{
+	if(a_position + 1 >= a_text.length())
+		return false;
+	QChar prefix = a_text[a_position].toLower();
+	return (((prefix == 'r') || (prefix == 'u')) &&
+		(a_text[a_position + 1] == a_quote));
+}
+
 //==============================================================================
 
 SyntaxHighlighter::SyntaxHighlighter(QTextDocument * a_pDocument,
 	VSPluginsList a_pluginsList) : QSyntaxHighlighter(a_pDocument)
 	, m_pSettingsManager(nullptr)
 	, m_coreName("core")
+	, m_firstVisibleBlock(0)
+	, m_lastVisibleBlock(0)
+	, m_forcedBlock(-1)
+	, m_deferredCursor()
+	, m_pIdleTimer(nullptr)
 	, m_pluginsList(a_pluginsList)
+	, m_vsNamespaces()
+	, m_vsFunctions()
 	, m_keywordsList()
 	, m_operatorsList()
 	, m_keywordFormat()
@@ -81,6 +123,14 @@ SyntaxHighlighter::SyntaxHighlighter(QTextDocument * a_pDocument,
 		{
 			return (a_first.length() > a_second.length());
 		});
+
+	indexPluginsList();
+
+	m_pIdleTimer = new QTimer(this);
+	m_pIdleTimer->setInterval(0);
+	m_pIdleTimer->setSingleShot(true);
+	connect(m_pIdleTimer, SIGNAL(timeout()),
+		this, SLOT(slotHighlightDeferredBlocks()));
 }
 
 // END OF SyntaxHighlighter::SyntaxHighlighter(QTextDocument * a_pDocument,
@@ -120,11 +170,38 @@ void SyntaxHighlighter::setCoreName(const QString & a_coreName)
 void SyntaxHighlighter::setPluginsList(VSPluginsList a_pluginsList)
 {
 	m_pluginsList = a_pluginsList;
+
+	QSet<QString> oldNamespaces = m_vsNamespaces;
+	QSet<QString> oldFunctions = m_vsFunctions;
+	indexPluginsList();
+
+	// the list may arrive after the text, from the background scan
+	if(((oldNamespaces != m_vsNamespaces) ||
+		(oldFunctions != m_vsFunctions)) && document() &&
+		(!document()->isEmpty()))
+		rehighlight();
 }
 
 // END OF void SyntaxHighlighter::setPluginsList(VSPluginsList a_pluginsList)
 //==============================================================================
 
+void SyntaxHighlighter::indexPluginsList()
+{
+	m_vsNamespaces.clear();
+	m_vsFunctions.clear();
+
+	for(const VSData::Plugin & plugin : m_pluginsList)
+	{
+		m_vsNamespaces.insert(plugin.pluginNamespace);
+		QString prefix = plugin.pluginNamespace + '.';
+		for(const VSData::Function & function : plugin.functions)
+			m_vsFunctions.insert(prefix + function.name);
+	}
+}
+
+// END OF void SyntaxHighlighter::indexPluginsList()
+//==============================================================================
+
 void SyntaxHighlighter::slotLoadSettings()
 {
 	m_keywordFormat = m_pSettingsManager->getTextFormat(
@@ -151,8 +228,127 @@ void SyntaxHighlighter::slotLoadSettings()
 // END OF void SyntaxHighlighter::slotLoadSettings()
 //==============================================================================
 
+void SyntaxHighlighter::setVisibleBlocks(int a_firstBlock, int a_lastBlock)
+{
+	if((a_firstBlock == m_firstVisibleBlock) &&
+		(a_lastBlock == m_lastVisibleBlock))
+		return;
+
+	m_firstVisibleBlock = a_firstBlock;
+	m_lastVisibleBlock = a_lastBlock;
+
+	if(m_deferredCursor.isNull() || (!document()))
+		return;
+
+	// catch up on the blocks scrolled into view before the idle pass
+	QTextBlock block = document()->findBlockByNumber(
+		std::max(a_firstBlock - VISIBLE_BLOCKS_MARGIN, 0));
+	int lastBlock = a_lastBlock + VISIBLE_BLOCKS_MARGIN;
+	while(block.isValid() && (block.blockNumber() <= lastBlock))
+	{
+		if(dynamic_cast<DeferredBlockData *>(block.userData()))
+			highlightNow(block);
+		block = block.next();
+	}
+}
+
+// END OF void SyntaxHighlighter::setVisibleBlocks(int a_firstBlock,
+//		int a_lastBlock)
+//==============================================================================
+
+void SyntaxHighlighter::slotHighlightDeferredBlocks()
+{
+	if(m_deferredCursor.isNull())
+		return;
+
+	QElapsedTimer elapsedTimer;
+	elapsedTimer.start();
+
+	// Highlighting a deferred block may defer the next one when its
+	// state changes, the scan picks it up on the following step.
+	QTextBlock block = m_deferredCursor.block();
+	while(block.isValid() &&
+		(elapsedTimer.elapsed() < IDLE_HIGHLIGHT_SLICE))
+	{
+		if(dynamic_cast<DeferredBlockData *>(block.userData()))
+			highlightNow(block);
+		block = block.next();
+	}
+
+	if(!block.isValid())
+	{
+		m_deferredCursor = QTextCursor();
+		return;
+	}
+
+	m_deferredCursor.setPosition(block.position());
+	m_pIdleTimer->start();
+}
+
+// END OF void SyntaxHighlighter::slotHighlightDeferredBlocks()
+//==============================================================================
+
+bool SyntaxHighlighter::isEager(const QTextBlock & a_block) const
+{
+	if(document()->blockCount() <= EAGER_DOCUMENT_BLOCKS)
+		return true;
+
+	int blockNumber = a_block.blockNumber();
+	if(blockNumber == m_forcedBlock)
+		return true;
+
+	return ((blockNumber >= m_firstVisibleBlock - VISIBLE_BLOCKS_MARGIN) &&
+		(blockNumber <= m_lastVisibleBlock + VISIBLE_BLOCKS_MARGIN));
+}
+
+// END OF bool SyntaxHighlighter::isEager(const QTextBlock & a_block) const
+//==============================================================================
+
+void SyntaxHighlighter::deferCurrentBlock()
+{
+	// The block state is left as it was so the cascade stops here.
+	// Formats are cleared by QSyntaxHighlighter until the idle pass,
+	// which is fine for a block out of view.
+	if(!dynamic_cast<DeferredBlockData *>(currentBlockUserData()))
+		setCurrentBlockUserData(new DeferredBlockData);
+
+	int position = currentBlock().position();
+	if(m_deferredCursor.isNull())
+		m_deferredCursor = QTextCursor(document());
+	else if(m_deferredCursor.position() <= position)
+	{
+		m_pIdleTimer->start();
+		return;
+	}
+
+	m_deferredCursor.setPosition(position);
+	m_pIdleTimer->start();
+}
+
+// END OF void SyntaxHighlighter::deferCurrentBlock()
+//==============================================================================
+
+void SyntaxHighlighter::highlightNow(const QTextBlock & a_block)
+{
+	m_forcedBlock = a_block.blockNumber();
+	rehighlightBlock(a_block);
+	m_forcedBlock = -1;
+}
+
+// END OF void SyntaxHighlighter::highlightNow(const QTextBlock & a_block)
+//==============================================================================
+
 void SyntaxHighlighter::highlightBlock(const QString & a_text)
 {
+	if(!isEager(currentBlock()))
+	{
+		deferCurrentBlock();
+		return;
+	}
+
+	if(dynamic_cast<DeferredBlockData *>(currentBlockUserData()))
+		setCurrentBlockUserData(nullptr);
+
 	setCurrentBlockState(0);
 	std::vector<Token> tokens;
 
@@ -172,7 +368,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 			bool foundMatchingQuotes = false;
 			for(j = i; j < textLength - 2; ++j)
 			{
-				if((a_text.mid(j, 3) == "'''") &&
+				if(matchesAt(a_text, j, QLatin1String("'''")) &&
 					((j == 0) || ((j != 0) && (a_text[j - 1] != '\\'))))
 				{
 					foundMatchingQuotes = true;
@@ -183,7 +379,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 			if(foundMatchingQuotes)
 			{
 				j += 3;
-				Token newToken(a_text.mid(i, j-i), i, j, TokenType::String);
+				Token newToken(a_text.midRef(i, j-i), i, j, TokenType::String);
 				tokens.push_back(newToken);
 				i = j;
 				continue;
@@ -205,7 +401,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 			bool foundMatchingQuotes = false;
 			for(j = i; j < textLength - 2; ++j)
 			{
-				if((a_text.mid(j, 3) == "\"\"\"") &&
+				if(matchesAt(a_text, j, QLatin1String("\"\"\"")) &&
 					((j == 0) || ((j != 0) && (a_text[j - 1] != '\\'))))
 				{
 					foundMatchingQuotes = true;
@@ -216,7 +412,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 			if(foundMatchingQuotes)
 			{
 				j += 3;
-				Token newToken(a_text.mid(i, j-i), i, j - i, TokenType::String);
+				Token newToken(a_text.midRef(i, j-i), i, j - i, TokenType::String);
 				tokens.push_back(newToken);
 				i = j;
 				continue;
@@ -232,7 +428,8 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 //------Long string, single quotes.---------------------------------------------
 
 		if((((a_text[i].toLower() == 'r') || (a_text[i].toLower() == 'u')) &&
-			(a_text.mid(i + 1, 3) == "'''")) || (a_text.mid(i, 3) == "'''"))
+			matchesAt(a_text, i + 1, QLatin1String("'''"))) ||
+			matchesAt(a_text, i, QLatin1String("'''")))
 		{
 			if(a_text[i] == '\'')
 				j = i + 3;
@@ -242,7 +439,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 			bool foundMatchingQuotes = false;
 			for(; j < textLength - 2; ++j)
 			{
-				if((a_text.mid(j, 3) == "'''") &&
+				if(matchesAt(a_text, j, QLatin1String("'''")) &&
 					((j == 0) || ((j != 0) && (a_text[j - 1] != '\\'))))
 				{
 					foundMatchingQuotes = true;
@@ -253,7 +450,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 			if(foundMatchingQuotes)
 			{
 				j += 3 - i;
-				Token newToken(a_text.mid(i, j), i, j, TokenType::String);
+				Token newToken(a_text.midRef(i, j), i, j, TokenType::String);
 				tokens.push_back(newToken);
 				i += j;
 				continue;
@@ -261,7 +458,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 			else
 			{
 				j = textLength - i;
-				Token newToken(a_text.mid(i, j), i, j, TokenType::String);
+				Token newToken(a_text.midRef(i, j), i, j, TokenType::String);
 				tokens.push_back(newToken);
                 setCurrentBlockState(int(BlockState::LongStringSingleStart));
 				break;
@@ -271,8 +468,8 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 //------Long string, double quotes----------------------------------------------
 
 		if((((a_text[i].toLower() == 'r') || (a_text[i].toLower() == 'u')) &&
-			(a_text.mid(i + 1, 3) == "\"\"\"")) ||
-			(a_text.mid(i, 3) == "\"\"\""))
+			matchesAt(a_text, i + 1, QLatin1String("\"\"\""))) ||
+			matchesAt(a_text, i, QLatin1String("\"\"\"")))
 		{
 			if(a_text[i] == '\"')
 				j = i + 3;
@@ -282,7 +479,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 			bool foundMatchingQuotes = false;
 			for(; j < textLength - 2; ++j)
 			{
-				if((a_text.mid(j, 3) == "\"\"\"") &&
+				if(matchesAt(a_text, j, QLatin1String("\"\"\"")) &&
 					((j == 0) || ((j != 0) && (a_text[j - 1] != '\\'))))
 				{
 					foundMatchingQuotes = true;
@@ -293,7 +490,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 			if(foundMatchingQuotes)
 			{
 				j += 3 - i;
-				Token newToken(a_text.mid(i, j), i, j, TokenType::String);
+				Token newToken(a_text.midRef(i, j), i, j, TokenType::String);
 				tokens.push_back(newToken);
 				i += j;
 				continue;
@@ -301,7 +498,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 			else
 			{
 				j = textLength - i;
-				Token newToken(a_text.mid(i, j), i, j, TokenType::String);
+				Token newToken(a_text.midRef(i, j), i, j, TokenType::String);
 				tokens.push_back(newToken);
                 setCurrentBlockState(int(BlockState::LongStringDoubleStart));
 				break;
@@ -310,8 +507,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 
 //------Short string, single quotes---------------------------------------------
 
-		if((a_text[i] == '\'') || (a_text.mid(i, 2).toLower() == "r'") ||
-			(a_text.mid(i, 2).toLower() == "u'"))
+		if((a_text[i] == '\'') || prefixedQuoteAt(a_text, i, '\''))
 		{
 			if(a_text[i] == '\'')
 				j = i + 1;
@@ -326,7 +522,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 			}
 
 			j += 1 - i;
-			Token newToken(a_text.mid(i, j), i, j, TokenType::String);
+			Token newToken(a_text.midRef(i, j), i, j, TokenType::String);
 			tokens.push_back(newToken);
 			i += j;
 			continue;
@@ -334,8 +530,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 
 //------Short string, double quotes---------------------------------------------
 
-		if((a_text[i] == '\"') || (a_text.mid(i, 2).toLower() == "r\"") ||
-			(a_text.mid(i, 2).toLower() == "u\""))
+		if((a_text[i] == '\"') || prefixedQuoteAt(a_text, i, '\"'))
 		{
 			if(a_text[i] == '\"')
 				j = i + 1;
@@ -350,7 +545,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 			}
 
 			j += 1 - i;
-			Token newToken(a_text.mid(i, j), i, j, TokenType::String);
+			Token newToken(a_text.midRef(i, j), i, j, TokenType::String);
 			tokens.push_back(newToken);
 			i += j;
 			continue;
@@ -361,7 +556,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 		if(a_text[i] == '#')
 		{
 			j = a_text.length();
-			Token newToken(a_text.mid(i, j-i), i, j, TokenType::Comment);
+			Token newToken(a_text.midRef(i, j-i), i, j, TokenType::Comment);
 			tokens.push_back(newToken);
 			break;
 		}
@@ -377,7 +572,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 			}
 
 			j = j - i;
-			QString word = a_text.mid(i, j);
+			QStringRef word = a_text.midRef(i, j);
 			Token newToken(word, i, j , TokenType::Undecided);
 			for(const QString & keyword : m_keywordsList)
 			{
@@ -398,7 +593,7 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 		if(matcher.beginsWithNumber(a_text, i))
 		{
 			j = matcher.matchedLength();
-			Token newToken(a_text.mid(i, j), i, j, TokenType::Number);
+			Token newToken(a_text.midRef(i, j), i, j, TokenType::Number);
 			tokens.push_back(newToken);
 			i += j;
 			continue;
@@ -412,8 +607,11 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 			if(goToNextToken)
 				break;
 
+			if(operatorString[0] != a_text[i])
+				continue;
+
 			j = operatorString.length();
-			QString substring = a_text.mid(i, j);
+			QStringRef substring = a_text.midRef(i, j);
 			if(substring == operatorString)
 			{
 				Token newToken(substring, i, j, TokenType::Operator);
@@ -441,42 +639,24 @@ void SyntaxHighlighter::highlightBlock(const QString & a_text)
 
 		if(token.text == m_coreName)
 			token.type = TokenType::VSCore;
-		else if((k > 1) && (tokens[k - 1].text == ".") &&
+		else if((k > 1) && (tokens[k - 1].text == QLatin1String(".")) &&
 			(tokens[k - 2].type == TokenType::VSCore))
 		{
-			for(const VSData::Plugin & plugin : m_pluginsList)
-			{
-				if(token.text == plugin.pluginNamespace)
-				{
-					token.type = TokenType::VSNamespace;
-					break;
-				}
-			}
+			// only words after "core." are looked up, the rest of
+			// the tokens never leave the block text
+			if(m_vsNamespaces.contains(token.text.toString()))
+				token.type = TokenType::VSNamespace;
 		}
-		else if((k > 3) && (tokens[k - 1].text == ".") &&
+		else if((k > 3) && (tokens[k - 1].text == QLatin1String(".")) &&
 			(tokens[k - 2].type == TokenType::VSNamespace) &&
-			(tokens[k - 3].text == ".") &&
+			(tokens[k - 3].text == QLatin1String(".")) &&
 			(tokens[k - 4].type == TokenType::VSCore))
 		{
-			bool foundFunction = false;
-			for(const VSData::Plugin & plugin : m_pluginsList)
-			{
-				foundFunction = false;
-				if(tokens[k - 2].text == plugin.pluginNamespace)
-				{
-					for(const VSData::Function & function : plugin.functions)
-					{
-						if(token.text == function.name)
-						{
-							token.type = TokenType::VSFunction;
-							foundFunction = true;
-							break;
-						}
-					}
-					if(foundFunction)
-						break;
-				}
-			}
+			QString functionKey = tokens[k - 2].text.toString();
+			functionKey += '.';
+			functionKey += token.text;
+			if(m_vsFunctions.contains(functionKey))
+				token.type = TokenType::VSFunction;
 		}
 
 		if(token.type == TokenType::Keyword)
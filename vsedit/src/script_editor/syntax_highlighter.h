@@ -6,8 +6,11 @@
 #include <QSyntaxHighlighter>
 #include <QTextCharFormat>
 #include <QStringList>
+#include <QSet>
+#include <QTextCursor>
 
 class SettingsManager;
+class QTimer;
 
 class SyntaxHighlighter : public QSyntaxHighlighter
 {
@@ -25,22 +28,54 @@ public:
 
 	void setPluginsList(VSPluginsList a_pluginsList);
 
+	// Blocks around the visible ones are highlighted right away,
+	// the rest of a large document is finished in idle time.
+	void setVisibleBlocks(int a_firstBlock, int a_lastBlock);
+
 public slots:
 
 	void slotLoadSettings();
 
+private slots:
+
+	void slotHighlightDeferredBlocks();
+
 protected:
 
     void highlightBlock(const QString & a_text) override;
 
 private:
 
+	void indexPluginsList();
+
+	bool isEager(const QTextBlock & a_block) const;
+
+	void deferCurrentBlock();
+
+	void highlightNow(const QTextBlock & a_block);
+
 	SettingsManager * m_pSettingsManager;
 
 	QString m_coreName;
 
+	int m_firstVisibleBlock;
+	int m_lastVisibleBlock;
+
+	// block highlighted on request, -1 when none
+	int m_forcedBlock;
+
+	// earliest deferred block, null when there is nothing left
+	QTextCursor m_deferredCursor;
+
+	QTimer * m_pIdleTimer;
+
 	VSPluginsList m_pluginsList;
 
+	// lookup sets built from the plugins list, "namespace.function"
+	// for functions, so highlighting does not walk the list
+	QSet<QString> m_vsNamespaces;
+	QSet<QString> m_vsFunctions;
+
 	QStringList m_keywordsList;
 	QStringList m_operatorsList;
 
@@ -17,6 +17,8 @@ ScriptStatusBarWidget::ScriptStatusBarWidget(QWidget * a_pParent) :
 //	m_ui.colorPickerLabel->clear();
 	m_ui.scriptProcessorQueueLabel->clear();
 	m_ui.videoInfoLabel->clear();
+	m_ui.playbackStatsLabel->clear();
+	m_ui.playbackStatsLabel->setVisible(false);
 
 	m_ui.scriptProcessorQueueIconLabel->setPixmap(m_readyPixmap);
 	setQueueState(0, 0, 0);
@@ -59,3 +61,22 @@ void ScriptStatusBarWidget::setVideoInfo(const VSVideoInfo * a_cpVideoInfo)
 // END OF void ScriptStatusBarWidget::setVideoInfo(
 //		const VSVideoInfo * a_cpVideoInfo)
 //==============================================================================
+
+void ScriptStatusBarWidget::setPlaybackStats(bool a_playing,
+	double a_renderedFps, double a_shownFps, int a_droppedFrames,
+	int a_prefetchDepth)
+{
+	m_ui.playbackStatsLabel->setVisible(a_playing);
+	if(!a_playing)
+		return;
+
+	m_ui.playbackStatsLabel->setText(
+		tr("Rendered: %1 fps, shown: %2 fps, dropped: %3, prefetch: %4")
+		.arg(a_renderedFps, 0, 'f', 1).arg(a_shownFps, 0, 'f', 1)
+		.arg(a_droppedFrames).arg(a_prefetchDepth));
+}
+
+// END OF void ScriptStatusBarWidget::setPlaybackStats(bool a_playing,
+//		double a_renderedFps, double a_shownFps, int a_droppedFrames,
+//		int a_prefetchDepth)
+//==============================================================================
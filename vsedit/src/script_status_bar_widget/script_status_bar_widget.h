@@ -30,6 +30,9 @@ public slots:
 
     virtual void setVideoInfo(const VSVideoInfo * a_cpVideoInfo);
 
+    virtual void setPlaybackStats(bool a_playing, double a_renderedFps,
+        double a_shownFps, int a_droppedFrames, int a_prefetchDepth);
+
 protected:
 
 	Ui::ScriptStatusBarWidget m_ui;
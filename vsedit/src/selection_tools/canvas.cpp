@@ -69,3 +69,17 @@ QString Canvas::selectionXYToString()
                 .arg(convertedMaxX).arg(convertedMaxY);
     }
 }
+
+QRectF Canvas::selectionRect()
+{
+    auto rectXY = m_pLinePainter->selectionRectXY();
+    if (rectXY == QVector({0.0,0.0,0.0,0.0})) return QRectF();
+
+    return QRectF(QPointF(rectXY[0], rectXY[1]) / m_zoomRatio,
+                  QPointF(rectXY[2], rectXY[3]) / m_zoomRatio).normalized();
+}
+
+QSize Canvas::framePixmapSize() const
+{
+    return m_framePixmap.size();
+}
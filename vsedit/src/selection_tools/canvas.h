@@ -22,6 +22,9 @@ public:
 
     void drawFrame(const QPixmap&);
     QString selectionXYToString();
+    // selection in frame pixmap coordinates, empty when nothing is selected
+    QRectF selectionRect();
+    QSize framePixmapSize() const;
 
 protected:
 
@@ -0,0 +1,192 @@
+#include "region_statistics.h"
+
+#include <vapoursynth/VapourSynth.h>
+
+#include <QObject>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace
+{
+
+// Integer samples are summed exactly, the histogram bin is the sample
+// shifted down to 8 bits.
+template<typename T>
+void measureIntegerPlane(const uint8_t * a_pData, int a_stride,
+    const QRect & a_region, int a_bitsPerSample, PlaneStatistics & a_plane)
+{
+    int shift = std::max(a_bitsPerSample - 8, 0);
+    uint32_t minimum = std::numeric_limits<uint32_t>::max();
+    uint32_t maximum = 0;
+    uint64_t sum = 0;
+    uint64_t squareSum = 0;
+    a_plane.histogram.assign(size_t(REGION_HISTOGRAM_BINS), 0);
+    quint32 * pHistogram = a_plane.histogram.data();
+
+    for (int y = a_region.top(); y <= a_region.bottom(); y++) {
+        const T * pRow = reinterpret_cast<const T *>(a_pData +
+            ptrdiff_t(y) * a_stride) + a_region.left();
+        // a row fits 32 bit sums, squares of 16 bit samples do not
+        uint32_t rowSum = 0;
+        uint64_t rowSquareSum = 0;
+        for (int x = 0; x < a_region.width(); x++) {
+            uint32_t value = pRow[x];
+            minimum = std::min(minimum, value);
+            maximum = std::max(maximum, value);
+            rowSum += value;
+            rowSquareSum += uint64_t(value) * value;
+            pHistogram[std::min(value >> shift,
+                uint32_t(REGION_HISTOGRAM_BINS - 1))]++;
+        }
+        sum += rowSum;
+        squareSum += rowSquareSum;
+    }
+
+    double samples = double(a_region.width()) * double(a_region.height());
+    a_plane.minimum = minimum;
+    a_plane.maximum = maximum;
+    a_plane.mean = double(sum) / samples;
+    double variance = double(squareSum) / samples - a_plane.mean * a_plane.mean;
+    a_plane.standardDeviation = std::sqrt(std::max(variance, 0.0));
+    a_plane.histogramLow = 0.0;
+    a_plane.histogramHigh = double((1 << a_bitsPerSample) - 1);
+}
+
+void measureFloatPlane(const uint8_t * a_pData, int a_stride,
+    const QRect & a_region, bool a_chroma, PlaneStatistics & a_plane)
+{
+    double low = a_chroma ? -0.5 : 0.0;
+    double minimum = std::numeric_limits<double>::max();
+    double maximum = std::numeric_limits<double>::lowest();
+    double sum = 0.0;
+    double squareSum = 0.0;
+    a_plane.histogram.assign(size_t(REGION_HISTOGRAM_BINS), 0);
+    quint32 * pHistogram = a_plane.histogram.data();
+
+    for (int y = a_region.top(); y <= a_region.bottom(); y++) {
+        const float * pRow = reinterpret_cast<const float *>(a_pData +
+            ptrdiff_t(y) * a_stride) + a_region.left();
+        double rowSum = 0.0;
+        double rowSquareSum = 0.0;
+        for (int x = 0; x < a_region.width(); x++) {
+            double value = double(pRow[x]);
+            minimum = std::min(minimum, value);
+            maximum = std::max(maximum, value);
+            rowSum += value;
+            rowSquareSum += value * value;
+            int bin = int((value - low) * REGION_HISTOGRAM_BINS);
+            pHistogram[std::max(0, std::min(bin, REGION_HISTOGRAM_BINS - 1))]++;
+        }
+        sum += rowSum;
+        squareSum += rowSquareSum;
+    }
+
+    double samples = double(a_region.width()) * double(a_region.height());
+    a_plane.minimum = minimum;
+    a_plane.maximum = maximum;
+    a_plane.mean = sum / samples;
+    double variance = squareSum / samples - a_plane.mean * a_plane.mean;
+    a_plane.standardDeviation = std::sqrt(std::max(variance, 0.0));
+    a_plane.histogramLow = low;
+    a_plane.histogramHigh = low + 1.0;
+}
+
+}
+
+PlaneStatistics::PlaneStatistics() :
+    minimum(0.0),
+    maximum(0.0),
+    mean(0.0),
+    standardDeviation(0.0),
+    histogramLow(0.0),
+    histogramHigh(0.0)
+{
+}
+
+RegionStatistics::RegionStatistics() :
+    frameNumber(-1),
+    bitsPerSample(0),
+    isFloat(false)
+{
+}
+
+bool RegionStatistics::isValid() const
+{
+    return (frameNumber >= 0) && error.isEmpty() && (!planes.empty());
+}
+
+RegionStatistics RegionStatistics::compute(const VSAPI * a_cpVSAPI,
+    const VSFrameRef * a_cpFrameRef, int a_frameNumber, const QRect & a_region)
+{
+    RegionStatistics statistics;
+    statistics.frameNumber = a_frameNumber;
+
+    Q_ASSERT(a_cpVSAPI);
+    Q_ASSERT(a_cpFrameRef);
+
+    const VSFormat * cpFormat = a_cpVSAPI->getFrameFormat(a_cpFrameRef);
+    if (cpFormat->colorFamily == cmCompat) {
+        statistics.error = QObject::tr("Format %1 can not be measured.")
+            .arg(cpFormat->name);
+        return statistics;
+    }
+    if ((cpFormat->sampleType == stFloat) && (cpFormat->bytesPerSample != 4)) {
+        statistics.error = QObject::tr("Half precision samples can not be "
+            "measured.");
+        return statistics;
+    }
+
+    QRect frameRect(0, 0, a_cpVSAPI->getFrameWidth(a_cpFrameRef, 0),
+        a_cpVSAPI->getFrameHeight(a_cpFrameRef, 0));
+    statistics.region = a_region.normalized().intersected(frameRect);
+    if (statistics.region.isEmpty()) {
+        statistics.error = QObject::tr("The region is outside the frame.");
+        return statistics;
+    }
+
+    statistics.bitsPerSample = cpFormat->bitsPerSample;
+    statistics.isFloat = (cpFormat->sampleType == stFloat);
+
+    const char * planeNames[3] = {"Y", "U", "V"};
+    if (cpFormat->colorFamily == cmRGB) {
+        planeNames[0] = "R";
+        planeNames[1] = "G";
+        planeNames[2] = "B";
+    } else if (cpFormat->colorFamily == cmYCoCg) {
+        planeNames[1] = "Co";
+        planeNames[2] = "Cg";
+    }
+
+    for (int i = 0; i < cpFormat->numPlanes; i++) {
+        PlaneStatistics plane;
+        plane.name = planeNames[i];
+
+        // chroma planes cover the region rounded outwards
+        int shiftW = (i == 0) ? 0 : cpFormat->subSamplingW;
+        int shiftH = (i == 0) ? 0 : cpFormat->subSamplingH;
+        int left = statistics.region.left() >> shiftW;
+        int top = statistics.region.top() >> shiftH;
+        int right = statistics.region.right() >> shiftW;
+        int bottom = statistics.region.bottom() >> shiftH;
+        plane.region = QRect(QPoint(left, top), QPoint(right, bottom));
+
+        const uint8_t * pData = a_cpVSAPI->getReadPtr(a_cpFrameRef, i);
+        int stride = a_cpVSAPI->getStride(a_cpFrameRef, i);
+        bool chroma = (i > 0) && (cpFormat->colorFamily != cmRGB);
+
+        if (statistics.isFloat)
+            measureFloatPlane(pData, stride, plane.region, chroma, plane);
+        else if (cpFormat->bytesPerSample == 1)
+            measureIntegerPlane<uint8_t>(pData, stride, plane.region,
+                cpFormat->bitsPerSample, plane);
+        else
+            measureIntegerPlane<uint16_t>(pData, stride, plane.region,
+                cpFormat->bitsPerSample, plane);
+
+        statistics.planes.push_back(plane);
+    }
+
+    return statistics;
+}
@@ -0,0 +1,58 @@
+#ifndef REGION_STATISTICS_H
+#define REGION_STATISTICS_H
+
+#include <QMetaType>
+#include <QRect>
+#include <QString>
+#include <vector>
+
+struct VSAPI;
+struct VSFrameRef;
+
+// histogram bins spread over the nominal range of the plane
+const int REGION_HISTOGRAM_BINS = 256;
+
+struct PlaneStatistics
+{
+    QString name;
+    // region of the plane after chroma subsampling
+    QRect region;
+    // in native sample values, floats as they are
+    double minimum;
+    double maximum;
+    double mean;
+    double standardDeviation;
+    // native values at the edges of the histogram range
+    double histogramLow;
+    double histogramHigh;
+    std::vector<quint32> histogram;
+
+    PlaneStatistics();
+};
+
+// statistics of a frame rectangle, measured on the planes of the output
+// frame at their own bit depth
+struct RegionStatistics
+{
+    int frameNumber;
+    // in luma samples
+    QRect region;
+    int bitsPerSample;
+    bool isFloat;
+    std::vector<PlaneStatistics> planes;
+
+    // empty when the region could be measured
+    QString error;
+
+    RegionStatistics();
+
+    bool isValid() const;
+
+    static RegionStatistics compute(const VSAPI * a_cpVSAPI,
+        const VSFrameRef * a_cpFrameRef, int a_frameNumber,
+        const QRect & a_region);
+};
+
+Q_DECLARE_METATYPE(RegionStatistics)
+
+#endif // REGION_STATISTICS_H
@@ -0,0 +1,500 @@
+#include "region_statistics_dialog.h"
+
+#include "../../../common-src/helpers.h"
+#include "../../../common-src/vapoursynth/vapoursynth_script_processor.h"
+
+#include <vapoursynth/VapourSynth.h>
+
+#include <QPainter>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+
+// frames requested and not measured yet while tracking
+const int MAX_TRACKED_FRAMES_IN_FLIGHT = 8;
+const int MAX_STATISTICS_THREADS = 4;
+
+const int HISTOGRAM_IMAGE_HEIGHT = 96;
+
+namespace
+{
+
+// Measures a frame and frees it, the result is queued back to the dialog.
+class RegionStatisticsTask : public QRunnable
+{
+public:
+
+    RegionStatisticsTask(QObject * a_pReceiver, const VSAPI * a_cpVSAPI,
+        const VSFrameRef * a_cpFrameRef, int a_frameNumber,
+        const QRect & a_region, int a_generation) :
+        m_pReceiver(a_pReceiver),
+        m_cpVSAPI(a_cpVSAPI),
+        m_cpFrameRef(a_cpFrameRef),
+        m_frameNumber(a_frameNumber),
+        m_region(a_region),
+        m_generation(a_generation)
+    {
+    }
+
+    virtual void run() override
+    {
+        RegionStatistics statistics = RegionStatistics::compute(m_cpVSAPI,
+            m_cpFrameRef, m_frameNumber, m_region);
+        m_cpVSAPI->freeFrame(m_cpFrameRef);
+        QMetaObject::invokeMethod(m_pReceiver, "slotRegionStatisticsReady",
+            Qt::QueuedConnection, Q_ARG(RegionStatistics, statistics),
+            Q_ARG(int, m_generation));
+    }
+
+private:
+
+    QObject * m_pReceiver;
+    const VSAPI * m_cpVSAPI;
+    const VSFrameRef * m_cpFrameRef;
+    int m_frameNumber;
+    QRect m_region;
+    int m_generation;
+};
+
+// planes drawn over each other, each scaled to its own highest bin
+QImage histogramImage(const RegionStatistics & a_statistics)
+{
+    QImage image(REGION_HISTOGRAM_BINS, HISTOGRAM_IMAGE_HEIGHT,
+        QImage::Format_ARGB32_Premultiplied);
+    image.fill(QColor(24, 24, 24));
+
+    const QColor yuvColors[3] = {QColor(220, 220, 220),
+        QColor(80, 140, 255), QColor(255, 90, 80)};
+    const QColor rgbColors[3] = {QColor(255, 70, 70),
+        QColor(70, 220, 70), QColor(80, 120, 255)};
+    bool rgb = (!a_statistics.planes.empty()) &&
+        (a_statistics.planes[0].name == "R");
+
+    QPainter painter(&image);
+    painter.setCompositionMode(QPainter::CompositionMode_Plus);
+    for (size_t i = 0; i < a_statistics.planes.size() && i < 3; i++) {
+        const std::vector<quint32> & histogram = a_statistics.planes[i].histogram;
+        quint32 highest = *std::max_element(histogram.begin(), histogram.end());
+        if (highest == 0)
+            continue;
+
+        QColor color = rgb ? rgbColors[i] : yuvColors[i];
+        color.setAlpha(160);
+        for (int bin = 0; bin < REGION_HISTOGRAM_BINS; bin++) {
+            int height = int(double(histogram[size_t(bin)]) /
+                double(highest) * HISTOGRAM_IMAGE_HEIGHT + 0.5);
+            if (height > 0)
+                painter.fillRect(bin, HISTOGRAM_IMAGE_HEIGHT - height, 1,
+                    height, color);
+        }
+    }
+    painter.end();
+
+    return image;
+}
+
+}
+
+RegionStatisticsDialog::TrackSummary::TrackSummary() :
+    meanSum(0.0),
+    deviationSum(0.0),
+    minimumDeviation(0.0),
+    maximumDeviation(0.0),
+    minimumDeviationFrame(-1),
+    maximumDeviationFrame(-1)
+{
+}
+
+RegionStatisticsDialog::RegionStatisticsDialog(
+    SettingsManager * a_pSettingsManager, VSScriptLibrary * a_pVSScriptLibrary,
+    QWidget * a_pParent) :
+    VSScriptProcessorDialog(a_pSettingsManager, a_pVSScriptLibrary, a_pParent),
+    m_pThreadPool(nullptr),
+    m_pendingFrame(-1),
+    m_generation(0),
+    m_tracking(false),
+    m_firstFrame(0),
+    m_lastFrame(-1),
+    m_nextFrame(0),
+    m_requestsLimit(2),
+    m_framesFailed(0),
+    m_isFloat(false)
+{
+    m_ui.setupUi(this);
+
+    createStatusBar();
+
+    m_ui.feedbackTextEdit->setName("region_statistics_log");
+    m_ui.feedbackTextEdit->setSettingsManager(m_pSettingsManager);
+    m_ui.feedbackTextEdit->loadSettings();
+
+    // tracking a range is a batch job, it may keep every core busy
+    m_pVapourSynthScriptProcessor->setFrameRequestsLimit(0);
+
+    m_pThreadPool = new QThreadPool(this);
+    m_pThreadPool->setMaxThreadCount(std::max(1,
+        std::min(QThread::idealThreadCount() / 2, MAX_STATISTICS_THREADS)));
+
+    connect(m_ui.wholeVideoButton, &QPushButton::clicked,
+        this, &RegionStatisticsDialog::slotWholeVideoButtonPressed);
+    connect(m_ui.startStopButton, &QPushButton::clicked,
+        this, &RegionStatisticsDialog::slotStartStopButtonPressed);
+}
+
+RegionStatisticsDialog::~RegionStatisticsDialog()
+{
+    stopAndCleanUp();
+}
+
+bool RegionStatisticsDialog::initialize(const QString & a_script,
+    const QString & a_scriptName)
+{
+    bool initialized =
+        VSScriptProcessorDialog::initialize(a_script, a_scriptName);
+    if (!initialized) {
+        emit signalWriteLogMessage(mtCritical,
+            m_pVapourSynthScriptProcessor->error());
+        return false;
+    }
+
+    int lastFrame = m_cpVideoInfo->numFrames - 1;
+    m_ui.fromFrameSpinBox->setMaximum(lastFrame);
+    m_ui.toFrameSpinBox->setMaximum(lastFrame);
+    m_ui.trackTable->setRowCount(0);
+    m_ui.trackSummaryEdit->clear();
+    m_ui.trackProgressBar->setValue(0);
+    return true;
+}
+
+void RegionStatisticsDialog::measure(int a_frameNumber, const QRect & a_region)
+{
+    if ((!m_pVapourSynthScriptProcessor->isInitialized()) || (!m_cpVideoInfo))
+        return;
+
+    // results for the same region stay valid, tracking goes on
+    if (a_region != m_region) {
+        stopTracking();
+        m_generation++;
+        m_ui.trackTable->setRowCount(0);
+        m_ui.trackSummaryEdit->clear();
+        m_ui.trackProgressBar->setValue(0);
+    }
+
+    m_region = a_region;
+    m_pendingFrame = a_frameNumber;
+
+    setWindowTitle(tr("Region statistics: %1").arg(scriptName()));
+    m_ui.regionLabel->setText(tr("Region %1, %2 - %3x%4 on frame %5")
+        .arg(m_region.left()).arg(m_region.top()).arg(m_region.width())
+        .arg(m_region.height()).arg(a_frameNumber));
+    m_ui.statisticsTable->setRowCount(0);
+    m_ui.histogramLabel->clear();
+
+    if (!m_tracking) {
+        m_ui.fromFrameSpinBox->setValue(a_frameNumber);
+        m_ui.toFrameSpinBox->setValue(m_cpVideoInfo->numFrames - 1);
+    }
+
+    m_pVapourSynthScriptProcessor->requestFrameAsync(a_frameNumber);
+
+    show();
+    raise();
+}
+
+void RegionStatisticsDialog::slotWriteLogMessage(int a_messageType,
+    const QString & a_message)
+{
+    QString style = vsMessageTypeToStyleName(a_messageType);
+    m_ui.feedbackTextEdit->addEntry(a_message, style);
+}
+
+void RegionStatisticsDialog::slotReceiveFrame(int a_frameNumber,
+    int a_outputIndex, const VSFrameRef * a_cpOutputFrameRef,
+    const VSFrameRef * a_cpPreviewFrameRef)
+{
+    (void)a_cpPreviewFrameRef;
+
+    if (a_outputIndex != 0)
+        return;
+    if ((a_frameNumber != m_pendingFrame) && (!isTracked(a_frameNumber)))
+        return;
+
+    Q_ASSERT(m_cpVSAPI);
+    m_pThreadPool->start(new RegionStatisticsTask(this, m_cpVSAPI,
+        m_cpVSAPI->cloneFrameRef(a_cpOutputFrameRef), a_frameNumber,
+        m_region, m_generation));
+}
+
+void RegionStatisticsDialog::slotFrameRequestDiscarded(int a_frameNumber,
+    int a_outputIndex, const QString & a_reason)
+{
+    if (a_outputIndex != 0)
+        return;
+
+    if (a_frameNumber == m_pendingFrame) {
+        m_pendingFrame = -1;
+        m_ui.feedbackTextEdit->addEntry(tr("Frame %1 could not be "
+            "rendered. %2").arg(a_frameNumber).arg(a_reason),
+            LOG_STYLE_WARNING);
+    }
+
+    if (isTracked(a_frameNumber)) {
+        m_framesFailed++;
+        frameTracked(a_frameNumber);
+    }
+}
+
+void RegionStatisticsDialog::slotRegionStatisticsReady(
+    const RegionStatistics & a_statistics, int a_generation)
+{
+    if (a_generation != m_generation)
+        return;
+
+    int frameNumber = a_statistics.frameNumber;
+
+    if (!a_statistics.isValid()) {
+        m_ui.feedbackTextEdit->addEntry(tr("Frame %1: %2").arg(frameNumber)
+            .arg(a_statistics.error), LOG_STYLE_WARNING);
+    }
+
+    if (frameNumber == m_pendingFrame) {
+        m_pendingFrame = -1;
+        if (a_statistics.isValid())
+            showStatistics(a_statistics);
+    }
+
+    if (isTracked(frameNumber)) {
+        if (a_statistics.isValid())
+            addTrackedStatistics(a_statistics);
+        else
+            m_framesFailed++;
+        frameTracked(frameNumber);
+    }
+}
+
+void RegionStatisticsDialog::slotWholeVideoButtonPressed()
+{
+    if (!m_cpVideoInfo)
+        return;
+    m_ui.fromFrameSpinBox->setValue(0);
+    m_ui.toFrameSpinBox->setValue(m_cpVideoInfo->numFrames - 1);
+}
+
+void RegionStatisticsDialog::slotStartStopButtonPressed()
+{
+    if (m_tracking) {
+        stopTracking();
+        return;
+    }
+
+    if ((!m_pVapourSynthScriptProcessor->isInitialized()) ||
+        (!m_cpVideoInfo) || m_region.isEmpty())
+        return;
+
+    int firstFrame = m_ui.fromFrameSpinBox->value();
+    int lastFrame = m_ui.toFrameSpinBox->value();
+    if (firstFrame > lastFrame) {
+        m_ui.feedbackTextEdit->addEntry(tr(
+            "First frame number is larger than the last frame number."),
+            LOG_STYLE_WARNING);
+        return;
+    }
+
+    m_generation++;
+    // the panel frame request belongs to the old generation now
+    if (m_pendingFrame >= 0)
+        m_pVapourSynthScriptProcessor->requestFrameAsync(m_pendingFrame);
+
+    m_firstFrame = firstFrame;
+    m_lastFrame = lastFrame;
+    m_nextFrame = firstFrame;
+    m_framesFailed = 0;
+    m_trackedFrames.clear();
+    m_planeNames.clear();
+    m_trackSummary.clear();
+    m_requestsLimit = std::max(2, std::min(QThread::idealThreadCount(),
+        MAX_TRACKED_FRAMES_IN_FLIGHT));
+
+    // rows are filled in as frames arrive, in any order
+    m_ui.trackTable->clear();
+    m_ui.trackTable->setColumnCount(1);
+    m_ui.trackTable->setHorizontalHeaderLabels({tr("Frame")});
+    m_ui.trackTable->setRowCount(lastFrame - firstFrame + 1);
+    m_ui.trackSummaryEdit->clear();
+    m_ui.trackProgressBar->setMaximum(lastFrame - firstFrame + 1);
+    m_ui.trackProgressBar->setValue(0);
+    m_ui.startStopButton->setText(tr("Stop"));
+
+    m_tracking = true;
+    requestFrames();
+}
+
+void RegionStatisticsDialog::stopAndCleanUp()
+{
+    stopTracking();
+    m_pendingFrame = -1;
+    m_generation++;
+    // tasks still hold frames of the core
+    m_pThreadPool->waitForDone();
+    VSScriptProcessorDialog::stopAndCleanUp();
+}
+
+void RegionStatisticsDialog::stopTracking()
+{
+    if (!m_tracking)
+        return;
+
+    m_tracking = false;
+    m_pVapourSynthScriptProcessor->flushFrameTicketsQueue();
+    // a flushed panel frame is not coming back
+    m_pendingFrame = -1;
+    m_ui.startStopButton->setText(tr("Track"));
+
+    int framesTotal = m_lastFrame - m_firstFrame + 1;
+    int framesDone = int(m_trackedFrames.size());
+    if (framesDone < framesTotal) {
+        m_ui.feedbackTextEdit->addEntry(tr("Stopped after %1 of %2 frames.")
+            .arg(framesDone).arg(framesTotal));
+    }
+}
+
+void RegionStatisticsDialog::requestFrames()
+{
+    while (m_tracking && (m_nextFrame <= m_lastFrame) &&
+        (m_nextFrame - m_firstFrame - int(m_trackedFrames.size()) <
+        m_requestsLimit)) {
+        int frameNumber = m_nextFrame++;
+        if (!m_pVapourSynthScriptProcessor->requestFrameAsync(frameNumber)) {
+            m_framesFailed++;
+            m_trackedFrames.insert(frameNumber);
+        }
+    }
+
+    if (m_tracking &&
+        (int(m_trackedFrames.size()) == m_lastFrame - m_firstFrame + 1))
+        stopTracking();
+}
+
+bool RegionStatisticsDialog::isTracked(int a_frameNumber) const
+{
+    return m_tracking && (a_frameNumber >= m_firstFrame) &&
+        (a_frameNumber < m_nextFrame) &&
+        (m_trackedFrames.find(a_frameNumber) == m_trackedFrames.end());
+}
+
+void RegionStatisticsDialog::frameTracked(int a_frameNumber)
+{
+    m_trackedFrames.insert(a_frameNumber);
+    m_ui.trackProgressBar->setValue(int(m_trackedFrames.size()));
+    updateTrackSummary();
+    requestFrames();
+}
+
+void RegionStatisticsDialog::showStatistics(
+    const RegionStatistics & a_statistics)
+{
+    m_isFloat = a_statistics.isFloat;
+
+    m_ui.statisticsTable->setRowCount(int(a_statistics.planes.size()));
+    for (size_t i = 0; i < a_statistics.planes.size(); i++) {
+        const PlaneStatistics & plane = a_statistics.planes[i];
+        QStringList cells = {plane.name,
+            sampleToString(plane.minimum, true),
+            sampleToString(plane.maximum, true),
+            sampleToString(plane.mean, false),
+            sampleToString(plane.standardDeviation, false)};
+        for (int column = 0; column < cells.size(); column++) {
+            m_ui.statisticsTable->setItem(int(i), column,
+                new QTableWidgetItem(cells[column]));
+        }
+    }
+
+    QString depth = a_statistics.isFloat ? tr("float") :
+        tr("%1 bit").arg(a_statistics.bitsPerSample);
+    m_ui.regionLabel->setText(tr("Region %1, %2 - %3x%4 on frame %5, %6")
+        .arg(a_statistics.region.left()).arg(a_statistics.region.top())
+        .arg(a_statistics.region.width()).arg(a_statistics.region.height())
+        .arg(a_statistics.frameNumber).arg(depth));
+    m_ui.histogramLabel->setPixmap(
+        QPixmap::fromImage(histogramImage(a_statistics)));
+}
+
+void RegionStatisticsDialog::addTrackedStatistics(
+    const RegionStatistics & a_statistics)
+{
+    m_isFloat = a_statistics.isFloat;
+
+    if (m_planeNames.isEmpty()) {
+        QStringList headers = {tr("Frame")};
+        for (const PlaneStatistics & plane : a_statistics.planes) {
+            m_planeNames << plane.name;
+            headers << tr("%1 mean").arg(plane.name)
+                << tr("%1 std dev").arg(plane.name);
+        }
+        m_ui.trackTable->setColumnCount(headers.size());
+        m_ui.trackTable->setHorizontalHeaderLabels(headers);
+        m_trackSummary.assign(a_statistics.planes.size(), TrackSummary());
+    }
+
+    int row = a_statistics.frameNumber - m_firstFrame;
+    m_ui.trackTable->setItem(row, 0, new QTableWidgetItem(
+        QString::number(a_statistics.frameNumber)));
+
+    size_t planes = std::min(a_statistics.planes.size(), m_trackSummary.size());
+    for (size_t i = 0; i < planes; i++) {
+        const PlaneStatistics & plane = a_statistics.planes[i];
+        m_ui.trackTable->setItem(row, int(i) * 2 + 1, new QTableWidgetItem(
+            sampleToString(plane.mean, false)));
+        m_ui.trackTable->setItem(row, int(i) * 2 + 2, new QTableWidgetItem(
+            sampleToString(plane.standardDeviation, false)));
+
+        TrackSummary & summary = m_trackSummary[i];
+        summary.meanSum += plane.mean;
+        summary.deviationSum += plane.standardDeviation;
+        if ((summary.minimumDeviationFrame < 0) ||
+            (plane.standardDeviation < summary.minimumDeviation)) {
+            summary.minimumDeviation = plane.standardDeviation;
+            summary.minimumDeviationFrame = a_statistics.frameNumber;
+        }
+        if ((summary.maximumDeviationFrame < 0) ||
+            (plane.standardDeviation > summary.maximumDeviation)) {
+            summary.maximumDeviation = plane.standardDeviation;
+            summary.maximumDeviationFrame = a_statistics.frameNumber;
+        }
+    }
+}
+
+void RegionStatisticsDialog::updateTrackSummary()
+{
+    int measured = int(m_trackedFrames.size()) - m_framesFailed;
+    if (measured <= 0)
+        return;
+
+    QStringList parts;
+    for (int i = 0; i < m_planeNames.size(); i++) {
+        const TrackSummary & summary = m_trackSummary[size_t(i)];
+        parts << tr("%1 mean %2, std dev %3 (%4 at %5 - %6 at %7)")
+            .arg(m_planeNames[i])
+            .arg(sampleToString(summary.meanSum / measured, false))
+            .arg(sampleToString(summary.deviationSum / measured, false))
+            .arg(sampleToString(summary.minimumDeviation, false))
+            .arg(summary.minimumDeviationFrame)
+            .arg(sampleToString(summary.maximumDeviation, false))
+            .arg(summary.maximumDeviationFrame);
+    }
+    if (m_framesFailed > 0)
+        parts << tr("%1 frames failed").arg(m_framesFailed);
+
+    m_ui.trackSummaryEdit->setPlainText(parts.join("\n"));
+}
+
+QString RegionStatisticsDialog::sampleToString(double a_value,
+    bool a_native) const
+{
+    if (m_isFloat)
+        return QString::number(a_value, 'f', 5);
+    if (a_native)
+        return QString::number(qint64(a_value));
+    return QString::number(a_value, 'f', 2);
+}
@@ -0,0 +1,110 @@
+#ifndef REGION_STATISTICS_DIALOG_H
+#define REGION_STATISTICS_DIALOG_H
+
+#include <ui_region_statistics_dialog.h>
+
+#include "region_statistics.h"
+#include "../vapoursynth/vs_script_processor_dialog.h"
+
+#include <QRect>
+#include <set>
+#include <vector>
+
+class QThreadPool;
+
+// Statistics of a selected rectangle on the frame it was selected on,
+// optionally tracked over a frame range. Frames are rendered and
+// measured in parallel.
+class RegionStatisticsDialog : public VSScriptProcessorDialog
+{
+    Q_OBJECT
+
+public:
+
+    RegionStatisticsDialog(SettingsManager * a_pSettingsManager,
+        VSScriptLibrary * a_pVSScriptLibrary, QWidget * a_pParent = nullptr);
+    virtual ~RegionStatisticsDialog() override;
+
+    virtual bool initialize(const QString & a_script,
+        const QString & a_scriptName) override;
+
+    // the region is in luma samples of the output frame
+    void measure(int a_frameNumber, const QRect & a_region);
+
+protected slots:
+
+    virtual void slotWriteLogMessage(int a_messageType,
+        const QString & a_message) override;
+
+    virtual void slotReceiveFrame(int a_frameNumber, int a_outputIndex,
+        const VSFrameRef * a_cpOutputFrameRef,
+        const VSFrameRef * a_cpPreviewFrameRef) override;
+
+    virtual void slotFrameRequestDiscarded(int a_frameNumber,
+        int a_outputIndex, const QString & a_reason) override;
+
+    void slotRegionStatisticsReady(const RegionStatistics & a_statistics,
+        int a_generation);
+
+    void slotWholeVideoButtonPressed();
+
+    void slotStartStopButtonPressed();
+
+protected:
+
+    // per plane totals of the tracked frames
+    struct TrackSummary
+    {
+        double meanSum;
+        double deviationSum;
+        double minimumDeviation;
+        double maximumDeviation;
+        int minimumDeviationFrame;
+        int maximumDeviationFrame;
+
+        TrackSummary();
+    };
+
+    virtual void stopAndCleanUp() override;
+
+    void stopTracking();
+
+    void requestFrames();
+
+    bool isTracked(int a_frameNumber) const;
+
+    void frameTracked(int a_frameNumber);
+
+    void showStatistics(const RegionStatistics & a_statistics);
+
+    void addTrackedStatistics(const RegionStatistics & a_statistics);
+
+    void updateTrackSummary();
+
+    QString sampleToString(double a_value, bool a_native) const;
+
+    Ui::RegionStatisticsDialog m_ui;
+
+    QThreadPool * m_pThreadPool;
+
+    QRect m_region;
+    // frame requested for the statistics panel, -1 when none
+    int m_pendingFrame;
+
+    // results of tasks for an old region or range are ignored
+    int m_generation;
+
+    bool m_tracking;
+    int m_firstFrame;
+    int m_lastFrame;
+    int m_nextFrame;
+    int m_requestsLimit;
+    int m_framesFailed;
+    std::set<int> m_trackedFrames;
+
+    bool m_isFloat;
+    QStringList m_planeNames;
+    std::vector<TrackSummary> m_trackSummary;
+};
+
+#endif // REGION_STATISTICS_DIALOG_H
@@ -6,7 +6,8 @@
 
 SelectionToolsDialog::SelectionToolsDialog(QWidget *parent) :
     QDialog(parent),
-    ui(new Ui::SelectionToolsDialog)
+    ui(new Ui::SelectionToolsDialog),
+    m_frameNumber(-1)
 {
     ui->setupUi(this);
 
@@ -21,6 +22,9 @@ SelectionToolsDialog::SelectionToolsDialog(QWidget *parent) :
 
     connect(ui->pasteButton, &QPushButton::clicked,
         this, &SelectionToolsDialog::slotSendSignalPastePointsToScript);
+
+    connect(ui->statisticsButton, &QPushButton::clicked,
+        this, &SelectionToolsDialog::slotRequestRegionStatistics);
 }
 
 SelectionToolsDialog::~SelectionToolsDialog()
@@ -28,8 +32,11 @@ SelectionToolsDialog::~SelectionToolsDialog()
     delete ui;
 }
 
-void SelectionToolsDialog::setFramePixmap(const QPixmap &a_framePixmap)
+void SelectionToolsDialog::setFramePixmap(const QPixmap &a_framePixmap,
+    int a_frameNumber, const QSize &a_frameSize)
 {
+    m_frameNumber = a_frameNumber;
+    m_frameSize = a_frameSize;
     ui->canvas->drawFrame(a_framePixmap);
 }
 
@@ -49,3 +56,23 @@ void SelectionToolsDialog::slotSendSignalPastePointsToScript()
     QString pointsString = ui->canvas->selectionXYToString();
     emit signalPasteSelectionPointsString(pointsString);
 }
+
+void SelectionToolsDialog::slotRequestRegionStatistics()
+{
+    QRectF selection = ui->canvas->selectionRect();
+    if (selection.isEmpty() || (m_frameNumber < 0) || m_frameSize.isEmpty())
+        return;
+
+    // the preview pixmap may be scaled, statistics are taken on the frame
+    QSizeF pixmapSize = ui->canvas->framePixmapSize();
+    double scaleX = double(m_frameSize.width()) / pixmapSize.width();
+    double scaleY = double(m_frameSize.height()) / pixmapSize.height();
+    int left = int(selection.left() * scaleX);
+    int top = int(selection.top() * scaleY);
+    QRect region(left, top,
+                 qMax(int(selection.right() * scaleX + 0.5) - left, 1),
+                 qMax(int(selection.bottom() * scaleY + 0.5) - top, 1));
+
+    emit signalRegionStatisticsRequested(m_frameNumber,
+        region.intersected(QRect(QPoint(0, 0), m_frameSize)));
+}
@@ -4,6 +4,8 @@
 //#include "canvas.h"
 #include <QDialog>
 #include <QGraphicsScene>
+#include <QRect>
+#include <QSize>
 
 namespace Ui {
 class SelectionToolsDialog;
@@ -22,7 +24,9 @@ public:
     explicit SelectionToolsDialog(QWidget *a_pParent = nullptr);
     ~SelectionToolsDialog() override;
 
-    void setFramePixmap(const QPixmap&);
+    // a_frameSize is the size of the output frame the pixmap shows
+    void setFramePixmap(const QPixmap&, int a_frameNumber,
+                        const QSize & a_frameSize);
 
 protected:
     void hideEvent(QHideEvent * a_pEvent) override;
@@ -32,16 +36,22 @@ private:
 
     SelectionTools m_selectionTool;
 
+    int m_frameNumber;
+    QSize m_frameSize;
+
 
 signals:
     void signalLoadPixmapRequested();
     void signalDialogHidden();
     void signalPasteSelectionPointsString(const QString &);
+    void signalRegionStatisticsRequested(int a_frameNumber,
+                                         const QRect & a_region);
 
 public slots:
 
     void slotCloseDialog();
     void slotSendSignalPastePointsToScript();
+    void slotRequestRegionStatistics();
 
 };
 
@@ -5,18 +5,203 @@
 
 #include <QDir>
 #include <QLibrary>
+#include <QFile>
+#include <QFileInfo>
 #include <QFileInfoList>
+#include <QMap>
 #include <QSettings>
+#include <QProcess>
 #include <QProcessEnvironment>
 #include <QDirIterator>
+#include <QRegularExpression>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QStandardPaths>
 #include <algorithm>
 
+#ifdef Q_OS_WIN
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <dlfcn.h>
+#endif
+
 //==============================================================================
 
 const char CORE_PLUGINS_FILEPATH[] = "core";
 
+const char PLUGINS_CACHE_FILE_NAME[] = "/vsedit2_plugins.cache";
+
 //==============================================================================
 
+namespace
+{
+
+// Runs "vsrepo.py paths" once and returns its "Key: path" lines.
+QMap<QString, QString> vsRepoPaths(const QString & a_vsRepoPath)
+{
+	QMap<QString, QString> paths;
+	if(a_vsRepoPath.isEmpty())
+		return paths;
+
+	QProcess process;
+	process.start("python", QStringList() << a_vsRepoPath << "paths");
+	process.waitForFinished();
+	process.setReadChannel(QProcess::StandardOutput);
+
+	while(process.canReadLine())
+	{
+		// e.g. "Binaries: C:\VS\plugins"
+		QString line = QString::fromLocal8Bit(process.readLine()).trimmed();
+		int separator = line.indexOf(": ");
+		if(separator > 0)
+			paths[line.left(separator)] = line.mid(separator + 2).trimmed();
+	}
+
+	return paths;
+}
+
+// The file a function was loaded from. QLibrary only knows the name it
+// was asked for, a bare "vapoursynth" when found in the system paths.
+QString libraryPathFromAddress(void * a_pAddress)
+{
+#ifdef Q_OS_WIN
+	HMODULE hModule = nullptr;
+	if(!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+		GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+		reinterpret_cast<LPCWSTR>(a_pAddress), &hModule))
+		return QString();
+
+	wchar_t path[MAX_PATH * 4];
+	DWORD length = GetModuleFileNameW(hModule, path,
+		DWORD(sizeof(path) / sizeof(path[0])));
+	if((length == 0) || (length >= DWORD(sizeof(path) / sizeof(path[0]))))
+		return QString();
+	return QDir::fromNativeSeparators(QString::fromWCharArray(path,
+		int(length)));
+#else
+	Dl_info info;
+	if((dladdr(a_pAddress, &info) == 0) || (!info.dli_fname))
+		return QString();
+	return QFileInfo(QFile::decodeName(info.dli_fname)).absoluteFilePath();
+#endif
+}
+
+#ifndef Q_OS_WIN
+QString vapourSynthConfigPath()
+{
+	return QStandardPaths::writableLocation(
+		QStandardPaths::GenericConfigLocation) +
+		"/vapoursynth/vapoursynth.conf";
+}
+#endif
+
+// Directories VapourSynth autoloads plugins from. They are watched even
+// when empty, the first plugin put into one must trigger a rescan.
+QStringList autoloadDirs(const QString & a_libraryPath)
+{
+	QStringList dirs;
+
+#ifdef Q_OS_WIN
+	(void)a_libraryPath;
+
+	QSettings settings("HKEY_LOCAL_MACHINE\\SOFTWARE",
+		QSettings::NativeFormat);
+	QString appData =
+		QProcessEnvironment::systemEnvironment().value("APPDATA");
+#ifdef Q_OS_WIN64
+	dirs << settings.value("VapourSynth/Plugins").toString();
+	if(!appData.isEmpty())
+		dirs << appData + "/VapourSynth/plugins64";
+#else
+	dirs << settings.value("VapourSynth/Plugins32").toString();
+	if(!appData.isEmpty())
+		dirs << appData + "/VapourSynth/plugins32";
+#endif // Q_OS_WIN64
+#else
+	QSettings config(vapourSynthConfigPath(), QSettings::IniFormat);
+	dirs << config.value("UserPluginDir").toString();
+	QString systemDir = config.value("SystemPluginDir").toString();
+	QFileInfo libraryInfo(a_libraryPath);
+	if(systemDir.isEmpty() && libraryInfo.isAbsolute())
+		systemDir = libraryInfo.absolutePath() + "/vapoursynth";
+	dirs << systemDir;
+#endif // Q_OS_WIN
+
+	dirs.removeAll(QString());
+	for(QString & dir : dirs)
+		dir = QDir::cleanPath(QDir::fromNativeSeparators(dir));
+	return dirs;
+}
+
+void sortPluginsList(VSPluginsList & a_pluginsList)
+{
+	std::stable_sort(a_pluginsList.begin(), a_pluginsList.end());
+	for(VSData::Plugin & plugin : a_pluginsList)
+		std::stable_sort(plugin.functions.begin(), plugin.functions.end());
+}
+
+// What a scan needs from the settings, copied on the GUI thread.
+struct PluginsScanInput
+{
+	QStringList libraryPaths;
+	QStringList pluginsPaths;
+	QString vsRepoPath;
+
+	// the cached state, a matching fingerprint skips the scan
+	QString libraryPath;
+	QStringList pluginsDirs;
+	QStringList fingerprint;
+
+	bool force;
+};
+
+// Gathers the plugins metadata off the GUI thread. Loading the library
+// with every autoloaded plugin and running vsrepo take seconds.
+class PluginsScanTask : public QRunnable
+{
+public:
+
+	PluginsScanTask(VapourSynthPluginsManager * a_pManager,
+		const PluginsScanInput & a_input, int a_generation);
+
+	void run() override;
+
+	void configPlugin(const char * a_identifier,
+		const char * a_defaultNamespace, const char * a_name);
+
+	void registerFunction(const char * a_name, const char * a_args);
+
+private:
+
+	void getCorePlugins();
+
+	void pollPaths();
+
+	void getPyScripts(const QString & a_definitionsPath,
+		const QString & a_scriptsPath);
+
+	QStringList fingerprint(const QString & a_libraryPath,
+		const QStringList & a_pluginsDirs,
+		const QMap<QString, QString> & a_vsRepoPaths) const;
+
+	void log(int a_messageType, const QString & a_message);
+
+	VapourSynthPluginsManager * m_pManager;
+
+	PluginsScanInput m_input;
+
+	int m_generation;
+
+	VSPluginsMetadata m_metadata;
+
+	QString m_currentPluginPath;
+
+	bool m_pluginAlreadyLoaded;
+};
+
 void VS_CC fakeConfigPlugin(const char * a_identifier,
 	const char * a_defaultNamespace, const char * a_name, int a_apiVersion,
 	int a_readonly, VSPlugin * a_pPlugin)
@@ -25,25 +210,8 @@ void VS_CC fakeConfigPlugin(const char * a_identifier,
 	(void)a_readonly;
 
 	// Dirty hack encouraged by Myrsloik himself.
-	VapourSynthPluginsManager * pManager =
-        reinterpret_cast<VapourSynthPluginsManager *>(a_pPlugin);
-
-	QString id(a_identifier);
-	for(const VSData::Plugin & plugin : pManager->m_pluginsList)
-	{
-		if(plugin.id == id)
-		{
-			pManager->m_pluginAlreadyLoaded = true;
-			return;
-		}
-	}
-
-	pManager->m_pluginsList.emplace_back();
-	pManager->m_pluginsList.back().filepath = pManager->m_currentPluginPath;
-	pManager->m_pluginsList.back().id = id;
-	pManager->m_pluginsList.back().pluginNamespace =
-		QString(a_defaultNamespace);
-	pManager->m_pluginsList.back().name = QString(a_name);
+	PluginsScanTask * pTask = reinterpret_cast<PluginsScanTask *>(a_pPlugin);
+	pTask->configPlugin(a_identifier, a_defaultNamespace, a_name);
 }
 
 // END OF void VS_CC fakeConfigPlugin(const char * a_identifier,
@@ -58,15 +226,8 @@ void VS_CC fakeRegisterFunction(const char * a_name, const char * a_args,
     (void)a_pFunctionData;
 
     // Dirty hack encouraged by Myrsloik himself.
-	VapourSynthPluginsManager * pManager =
-        reinterpret_cast<VapourSynthPluginsManager *>(a_pPlugin);
-
-	if(pManager->m_pluginAlreadyLoaded)
-		return;
-
-	VSData::Function function =
-		VapourSynthPluginsManager::parseFunctionSignature(a_name, a_args);
-	pManager->m_pluginsList.back().functions.push_back(function);
+	PluginsScanTask * pTask = reinterpret_cast<PluginsScanTask *>(a_pPlugin);
+	pTask->registerFunction(a_name, a_args);
 }
 
 // END OF void VS_CC fakeRegisterFunction(const char * a_name,
@@ -74,40 +235,91 @@ void VS_CC fakeRegisterFunction(const char * a_name, const char * a_args,
 //		void * a_pFunctionData, VSPlugin * a_pPlugin)
 //==============================================================================
 
-VapourSynthPluginsManager::VapourSynthPluginsManager(
-	SettingsManager * a_pSettingsManager, QObject * a_pParent):
-	QObject(a_pParent)
-	, m_pluginsList()
-    , m_pyScriptsList()
+}
+
+//==============================================================================
+
+PluginsScanTask::PluginsScanTask(VapourSynthPluginsManager * a_pManager,
+	const PluginsScanInput & a_input, int a_generation) :
+	  m_pManager(a_pManager)
+	, m_input(a_input)
+	, m_generation(a_generation)
+	, m_metadata()
 	, m_currentPluginPath()
 	, m_pluginAlreadyLoaded(false)
-	, m_pSettingsManager(a_pSettingsManager)
-    , m_vsRepoPath()
 {
-	if(a_pParent)
+}
+
+// END OF PluginsScanTask::PluginsScanTask(
+//		VapourSynthPluginsManager * a_pManager,
+//		const PluginsScanInput & a_input, int a_generation)
+//==============================================================================
+
+void PluginsScanTask::run()
+{
+	QMap<QString, QString> repoPaths = vsRepoPaths(m_input.vsRepoPath);
+
+	if((!m_input.force) && (!m_input.fingerprint.isEmpty()) &&
+		(fingerprint(m_input.libraryPath, m_input.pluginsDirs, repoPaths) ==
+		m_input.fingerprint))
+		return;
+
+	getCorePlugins();
+	pollPaths();
+	getPyScripts(repoPaths.value("Definitions"), repoPaths.value("Scripts"));
+	sortPluginsList(m_metadata.pluginsList);
+	m_metadata.fingerprint = fingerprint(m_metadata.libraryPath,
+		m_metadata.pluginsDirs, repoPaths);
+
+	QMetaObject::invokeMethod(m_pManager, "slotMetadataReady",
+		Qt::QueuedConnection, Q_ARG(VSPluginsMetadata, m_metadata),
+		Q_ARG(int, m_generation));
+}
+
+// END OF void PluginsScanTask::run()
+//==============================================================================
+
+void PluginsScanTask::configPlugin(const char * a_identifier,
+	const char * a_defaultNamespace, const char * a_name)
+{
+	QString id(a_identifier);
+	for(const VSData::Plugin & plugin : m_metadata.pluginsList)
 	{
-		connect(this, SIGNAL(signalWriteLogMessage(int, const QString &)),
-		a_pParent, SLOT(slotWriteLogMessage(int, const QString &)));
+		if(plugin.id == id)
+		{
+			m_pluginAlreadyLoaded = true;
+			return;
+		}
 	}
 
-    loadVSRepoPath();
-    getPyScripts();
-	slotRefill();
+	m_metadata.pluginsList.emplace_back();
+	m_metadata.pluginsList.back().filepath = m_currentPluginPath;
+	m_metadata.pluginsList.back().id = id;
+	m_metadata.pluginsList.back().pluginNamespace =
+		QString(a_defaultNamespace);
+	m_metadata.pluginsList.back().name = QString(a_name);
 }
 
-// END OF VapourSynthPluginsManager::VapourSynthPluginsManager(
-//		SettingsManager * a_pSettingsManager, QObject * a_pParent)
+// END OF void PluginsScanTask::configPlugin(const char * a_identifier,
+//		const char * a_defaultNamespace, const char * a_name)
 //==============================================================================
 
-VapourSynthPluginsManager::~VapourSynthPluginsManager()
+void PluginsScanTask::registerFunction(const char * a_name,
+	const char * a_args)
 {
-	slotClear();
+	if(m_pluginAlreadyLoaded)
+		return;
+
+	VSData::Function function =
+		VapourSynthPluginsManager::parseFunctionSignature(a_name, a_args);
+	m_metadata.pluginsList.back().functions.push_back(function);
 }
 
-// END OF VapourSynthPluginsManager::~VapourSynthPluginsManager()
+// END OF void PluginsScanTask::registerFunction(const char * a_name,
+//		const char * a_args)
 //==============================================================================
 
-void VapourSynthPluginsManager::getCorePlugins()
+void PluginsScanTask::getCorePlugins()
 {
 	QString libraryName("vapoursynth");
 	QString libraryFullPath;
@@ -156,7 +368,7 @@ void VapourSynthPluginsManager::getCorePlugins()
 	if(!loaded)
 	{
 		QStringList librarySearchPaths =
-			m_pSettingsManager->getVapourSynthLibraryPaths();
+			m_input.libraryPaths;
 		for(const QString & path : librarySearchPaths)
 		{
 			libraryFullPath = vsedit::resolvePathFromApplication(path) +
@@ -170,7 +382,7 @@ void VapourSynthPluginsManager::getCorePlugins()
 
 	if(!loaded)
 	{
-		emit signalWriteLogMessage(mtCritical, "VapourSynth plugins manager: "
+		log(mtCritical, "VapourSynth plugins manager: "
 			"Failed to load vapoursynth library!\n"
 			"Please set up the library search paths in settings.");
 		return;
@@ -185,7 +397,7 @@ void VapourSynthPluginsManager::getCorePlugins()
 	}
 	if(!getVapourSynthAPI)
 	{
-		emit signalWriteLogMessage(mtCritical, "VapourSynth plugins manager: "
+		log(mtCritical, "VapourSynth plugins manager: "
 			"Failed to get entry in vapoursynth library!");
 		vsLibrary.unload();
 		return;
@@ -195,7 +407,7 @@ void VapourSynthPluginsManager::getCorePlugins()
 	const VSAPI * cpVSAPI = getVapourSynthAPI((3 << 16) | 4);
 	if(!cpVSAPI)
 	{
-		emit signalWriteLogMessage(mtCritical, "VapourSynth plugins manager: "
+		log(mtCritical, "VapourSynth plugins manager: "
 			"Failed to get VapourSynth API!");
 		vsLibrary.unload();
 		return;
@@ -205,7 +417,7 @@ void VapourSynthPluginsManager::getCorePlugins()
 	VSCore * pCore = cpVSAPI->createCore(CORE_THREADS_NUMBER);
 	if(!pCore)
 	{
-		emit signalWriteLogMessage(mtCritical, "VapourSynth plugins manager: "
+		log(mtCritical, "VapourSynth plugins manager: "
 			"Failed to create VapourSynth core!");
 		vsLibrary.unload();
 		return;
@@ -214,7 +426,7 @@ void VapourSynthPluginsManager::getCorePlugins()
 	VSMap * pPluginsMap = cpVSAPI->getPlugins(pCore);
 	if(!pPluginsMap)
 	{
-		emit signalWriteLogMessage(mtCritical, "VapourSynth plugins manager: "
+		log(mtCritical, "VapourSynth plugins manager: "
 			"Failed to get core plugins!");
 		cpVSAPI->freeCore(pCore);
 		vsLibrary.unload();
@@ -229,7 +441,7 @@ void VapourSynthPluginsManager::getCorePlugins()
         const char * pluginKey = cpVSAPI->propGetKey(pPluginsMap, i);
         if(!pluginKey)
 		{
-			emit signalWriteLogMessage(mtCritical, QString("VapourSynth "
+			log(mtCritical, QString("VapourSynth "
 				"plugins manager: Failed to get ID for the plugin number %1.")
 				.arg(i));
 			continue;
@@ -239,7 +451,7 @@ void VapourSynthPluginsManager::getCorePlugins()
 			pluginKey, 0, nullptr);
         if(!pluginStr)
         {
-            emit signalWriteLogMessage(mtCritical, QString("VapourSynth "
+            log(mtCritical, QString("VapourSynth "
                 "plugins manager: Failed to get ID for the plugin number %1.")
                 .arg(i));
             continue;
@@ -248,7 +460,7 @@ void VapourSynthPluginsManager::getCorePlugins()
         QString id(QString::fromUtf8(pluginStr).split(';')[1]);
         QByteArray pluginID(id.toUtf8());
 
-		for(const VSData::Plugin & existingPluginData : m_pluginsList)
+		for(const VSData::Plugin & existingPluginData : m_metadata.pluginsList)
 		{
 			if(existingPluginData.id == id)
 				continue;
@@ -257,7 +469,7 @@ void VapourSynthPluginsManager::getCorePlugins()
         VSPlugin * pPlugin = cpVSAPI->getPluginById(pluginID, pCore);
 		if(!pPlugin)
 		{
-			emit signalWriteLogMessage(mtCritical, QString("VapourSynth "
+			log(mtCritical, QString("VapourSynth "
 				"plugins manager: Failed to get pointer to the plugin %1!")
 				.arg(id));
 			continue;
@@ -272,19 +484,29 @@ void VapourSynthPluginsManager::getCorePlugins()
 			QString logString = QString("VapourSynth plugins manager: "
 				"failed to get  information for the plugin ID %1.\nError: %2")
 				.arg(id).arg(errorString);
-			emit signalWriteLogMessage(mtCritical, logString);
+			log(mtCritical, logString);
 			continue;
 		}
 		QString pluginInfoString(pluginInfo);
 
-		m_pluginsList.emplace_back();
-		VSData::Plugin & pluginData = m_pluginsList.back();
+		m_metadata.pluginsList.emplace_back();
+		VSData::Plugin & pluginData = m_metadata.pluginsList.back();
 		pluginData.filepath = filepath;
 		pluginData.id = id;
 		QStringList parsedPluginInfo = pluginInfoString.split(';');
 		pluginData.pluginNamespace = parsedPluginInfo[0];
 		pluginData.name = parsedPluginInfo[2];
 
+		// empty for the plugins built into the core
+		const char * pluginPath = cpVSAPI->getPluginPath(pPlugin);
+		if(pluginPath && (pluginPath[0] != '\0'))
+		{
+			QString pluginDir = QDir::cleanPath(QFileInfo(
+				QString::fromUtf8(pluginPath)).absolutePath());
+			if(!m_metadata.pluginsDirs.contains(pluginDir))
+				m_metadata.pluginsDirs << pluginDir;
+		}
+
 		// Get functions from the plugin.
 		VSMap * pFunctionsMap = cpVSAPI->getFunctions(pPlugin);
 
@@ -297,7 +519,7 @@ void VapourSynthPluginsManager::getCorePlugins()
 				QString logString = QString("VapourSynth plugins manager: "
 					"failed to get information for the function number %1 "
 					"in plugin %2.").arg(j).arg(id);
-				emit signalWriteLogMessage(mtCritical, logString);
+				log(mtCritical, logString);
 				continue;
 			}
 			error = 0;
@@ -310,11 +532,11 @@ void VapourSynthPluginsManager::getCorePlugins()
 					"failed to get information for the function %1.%2()\n"
 					"Error: %3").arg(pluginData.pluginNamespace)
 					.arg(functionName).arg(errorString);
-				emit signalWriteLogMessage(mtCritical, logString);
+				log(mtCritical, logString);
 				continue;
 			}
-			VSData::Function function = parseFunctionSignature(functionName,
-				functionInfo);
+			VSData::Function function = VapourSynthPluginsManager::parseFunctionSignature(
+				functionName, functionInfo);
 			pluginData.functions.push_back(function);
 		}
 
@@ -323,16 +545,57 @@ void VapourSynthPluginsManager::getCorePlugins()
 
 	cpVSAPI->freeMap(pPluginsMap);
 	cpVSAPI->freeCore(pCore);
+	m_metadata.pluginsDirs.sort();
+	m_metadata.libraryPath = libraryPathFromAddress(
+		reinterpret_cast<void *>(getVapourSynthAPI));
+	if(m_metadata.libraryPath.isEmpty())
+		m_metadata.libraryPath = vsLibrary.fileName();
     vsLibrary.unload();
 }
 
-// END OF void VapourSynthPluginsManager::getCorePlugins()
+// END OF void PluginsScanTask::getCorePlugins()
 //==============================================================================
 
-void VapourSynthPluginsManager::getPyScripts()
+void PluginsScanTask::pollPaths()
 {
-    // get vsrepo path, then get the definition path
-    QString definitionPath = definitionsPath();
+	for(const QString & dirPath : m_input.pluginsPaths)
+	{
+		QString absolutePath = vsedit::resolvePathFromApplication(dirPath);
+		QFileInfoList fileInfoList = QDir(absolutePath).entryInfoList();
+		for(const QFileInfo & fileInfo : fileInfoList)
+		{
+			QString filePath = fileInfo.absoluteFilePath();
+			QLibrary plugin(filePath);
+			VSInitPlugin initVSPlugin =
+                VSInitPlugin(plugin.resolve("VapourSynthPluginInit"));
+			if(!initVSPlugin)
+			{ // Win32 fallback
+				initVSPlugin =
+                    VSInitPlugin(plugin.resolve("_VapourSynthPluginInit@12"));
+			}
+			if(!initVSPlugin)
+				continue;
+			m_currentPluginPath = filePath;
+			// Dirty hack encouraged by Myrsloik himself.
+			initVSPlugin(fakeConfigPlugin, fakeRegisterFunction,
+                reinterpret_cast<VSPlugin *>(this));
+			plugin.unload();
+			m_pluginAlreadyLoaded = false;
+		}
+	}
+}
+
+
+// END OF void PluginsScanTask::pollPaths()
+//==============================================================================
+
+void PluginsScanTask::getPyScripts(const QString & a_definitionsPath,
+	const QString & a_scriptsPath)
+{
+    if (a_definitionsPath.isEmpty() || a_scriptsPath.isEmpty())
+        return;
+
+    QString definitionPath = a_definitionsPath;
 
     // parse the definition file, store package info for type "pyscript",
     QFile inFile(definitionPath);
@@ -368,7 +631,7 @@ void VapourSynthPluginsManager::getPyScripts()
     }
 
     // use the list to look for py file in the script folder
-    QString scriptsPath = pyScriptsPath();
+    QString scriptsPath = a_scriptsPath;
     QString in;
     QDirIterator it(scriptsPath, {"*.py"}, QDir::Files);
 
@@ -416,12 +679,123 @@ void VapourSynthPluginsManager::getPyScripts()
 
                 pyScriptData.functions.push_back(function);
             }
-            m_pyScriptsList.push_back(pyScriptData);
+            m_metadata.pyScriptsList.push_back(pyScriptData);
         }
     }
 }
 
-// END OF void VapourSynthPluginsManager::getPyScripts()
+
+// END OF void PluginsScanTask::getPyScripts(const QString & a_definitionsPath,
+//		const QString & a_scriptsPath)
+//==============================================================================
+
+QStringList PluginsScanTask::fingerprint(const QString & a_libraryPath,
+	const QStringList & a_pluginsDirs,
+	const QMap<QString, QString> & a_vsRepoPaths) const
+{
+	QStringList entries;
+
+	// the search settings are part of the key, changing them rescans
+	entries << m_input.libraryPaths.join(';') << m_input.pluginsPaths.join(';');
+
+	if(!a_libraryPath.isEmpty())
+		entries << VSPluginsMetadataCache::fileEntry(a_libraryPath);
+
+#ifndef Q_OS_WIN
+	// it names the user and system plugin directories
+	entries << VSPluginsMetadataCache::fileEntry(vapourSynthConfigPath());
+#endif
+
+	QStringList pluginsDirs = a_pluginsDirs;
+	for(const QString & dirPath : autoloadDirs(a_libraryPath))
+	{
+		if(!pluginsDirs.contains(dirPath))
+			pluginsDirs << dirPath;
+	}
+	for(const QString & dirPath : pluginsDirs)
+		entries << VSPluginsMetadataCache::directoryEntries(dirPath);
+
+	for(const QString & dirPath : m_input.pluginsPaths)
+	{
+		entries << VSPluginsMetadataCache::directoryEntries(
+			vsedit::resolvePathFromApplication(dirPath));
+	}
+
+	entries << VSPluginsMetadataCache::directoryEntries(
+		a_vsRepoPaths.value("Binaries"));
+	entries << VSPluginsMetadataCache::directoryEntries(
+		a_vsRepoPaths.value("Scripts"), QStringList() << "*.py");
+
+	QString definitionsPath = a_vsRepoPaths.value("Definitions");
+	if(!definitionsPath.isEmpty())
+		entries << VSPluginsMetadataCache::fileEntry(definitionsPath);
+
+	return entries;
+}
+
+// END OF QStringList PluginsScanTask::fingerprint(
+//		const QString & a_libraryPath, const QStringList & a_pluginsDirs,
+//		const QMap<QString, QString> & a_vsRepoPaths) const
+//==============================================================================
+
+void PluginsScanTask::log(int a_messageType, const QString & a_message)
+{
+	// queued to the log, the manager outlives its tasks
+	emit m_pManager->signalWriteLogMessage(a_messageType, a_message);
+}
+
+// END OF void PluginsScanTask::log(int a_messageType,
+//		const QString & a_message)
+//==============================================================================
+
+VapourSynthPluginsManager::VapourSynthPluginsManager(
+	SettingsManager * a_pSettingsManager, QObject * a_pParent):
+	QObject(a_pParent)
+	, m_pluginsList()
+    , m_pyScriptsList()
+	, m_pSettingsManager(a_pSettingsManager)
+    , m_vsRepoPath()
+	, m_pThreadPool(nullptr)
+	, m_generation(0)
+{
+	if(a_pParent)
+	{
+		connect(this, SIGNAL(signalWriteLogMessage(int, const QString &)),
+		a_pParent, SLOT(slotWriteLogMessage(int, const QString &)));
+	}
+
+	m_pThreadPool = new QThreadPool(this);
+	m_pThreadPool->setMaxThreadCount(1);
+
+    loadVSRepoPath();
+
+	// the cached lists are used at once, the scan only confirms them
+	// or replaces them and emits signalPluginsListChanged()
+	VSPluginsMetadata metadata;
+	if(VSPluginsMetadataCache::load(cacheFilePath(), &metadata))
+	{
+		m_pluginsList = std::move(metadata.pluginsList);
+		m_pyScriptsList = std::move(metadata.pyScriptsList);
+		m_libraryPath = metadata.libraryPath;
+		m_pluginsDirs = metadata.pluginsDirs;
+		m_fingerprint = metadata.fingerprint;
+	}
+
+	startScan(false);
+}
+
+// END OF VapourSynthPluginsManager::VapourSynthPluginsManager(
+//		SettingsManager * a_pSettingsManager, QObject * a_pParent)
+//==============================================================================
+
+VapourSynthPluginsManager::~VapourSynthPluginsManager()
+{
+	m_pThreadPool->clear();
+	m_pThreadPool->waitForDone();
+	slotClear();
+}
+
+// END OF VapourSynthPluginsManager::~VapourSynthPluginsManager()
 //==============================================================================
 
 QString VapourSynthPluginsManager::vSRepoPath()
@@ -456,39 +830,6 @@ QString VapourSynthPluginsManager::definitionsPath()
 // END OF void VapourSynthPluginsManager::DefinitionsPath()
 //==============================================================================
 
-void VapourSynthPluginsManager::pollPaths(const QStringList & a_pluginsPaths)
-{
-	for(const QString & dirPath : a_pluginsPaths)
-	{
-		QString absolutePath = vsedit::resolvePathFromApplication(dirPath);
-		QFileInfoList fileInfoList = QDir(absolutePath).entryInfoList();
-		for(const QFileInfo & fileInfo : fileInfoList)
-		{
-			QString filePath = fileInfo.absoluteFilePath();
-			QLibrary plugin(filePath);
-			VSInitPlugin initVSPlugin =
-                VSInitPlugin(plugin.resolve("VapourSynthPluginInit"));
-			if(!initVSPlugin)
-			{ // Win32 fallback
-				initVSPlugin =
-                    VSInitPlugin(plugin.resolve("_VapourSynthPluginInit@12"));
-			}
-			if(!initVSPlugin)
-				continue;
-			m_currentPluginPath = filePath;
-			// Dirty hack encouraged by Myrsloik himself.
-			initVSPlugin(fakeConfigPlugin, fakeRegisterFunction,
-                reinterpret_cast<VSPlugin *>(this));
-			plugin.unload();
-			m_pluginAlreadyLoaded = false;
-		}
-	}
-}
-
-// END OF void VapourSynthPluginsManager::pollPaths(
-//		const QStringList & a_pluginsPaths)
-//==============================================================================
-
 QStringList VapourSynthPluginsManager::functions() const
 {
 	QStringList functionsList;
@@ -572,9 +913,7 @@ void VapourSynthPluginsManager::slotClear()
 
 void VapourSynthPluginsManager::slotSort()
 {
-	std::stable_sort(m_pluginsList.begin(), m_pluginsList.end());
-	for(VSData::Plugin & plugin : m_pluginsList)
-		std::stable_sort(plugin.functions.begin(), plugin.functions.end());
+	sortPluginsList(m_pluginsList);
 }
 
 // END OF void VapourSynthPluginsManager::slotSort()
@@ -582,16 +921,79 @@ void VapourSynthPluginsManager::slotSort()
 
 void VapourSynthPluginsManager::slotRefill()
 {
-	slotClear();
-	getCorePlugins();
-	QStringList pluginsPaths = m_pSettingsManager->getVapourSynthPluginsPaths();
-	pollPaths(pluginsPaths);
-    slotSort();
+	// the current lists stay until the new ones arrive
+	startScan(true);
 }
 
 // END OF void VapourSynthPluginsManager::slotRefill()
 //==============================================================================
 
+void VapourSynthPluginsManager::slotMetadataReady(
+	const VSPluginsMetadata & a_metadata, int a_generation)
+{
+	if(a_generation != m_generation)
+		return;
+
+	// without the library the core plugins are missing,
+	// such a result is shown but not cached
+	if(!a_metadata.libraryPath.isEmpty())
+	{
+		m_libraryPath = a_metadata.libraryPath;
+		m_pluginsDirs = a_metadata.pluginsDirs;
+		m_fingerprint = a_metadata.fingerprint;
+		QString filePath = cacheFilePath();
+		if(!VSPluginsMetadataCache::save(filePath, a_metadata))
+		{
+			emit signalWriteLogMessage(mtWarning, QString("VapourSynth "
+				"plugins manager: Failed to write the plugins cache %1.")
+				.arg(filePath));
+		}
+	}
+
+	QByteArray currentLists = VSPluginsMetadataCache::serializeLists(
+		m_pluginsList, m_pyScriptsList);
+	QByteArray newLists = VSPluginsMetadataCache::serializeLists(
+		a_metadata.pluginsList, a_metadata.pyScriptsList);
+	if(currentLists == newLists)
+		return;
+
+	m_pluginsList = a_metadata.pluginsList;
+	m_pyScriptsList = a_metadata.pyScriptsList;
+	emit signalPluginsListChanged();
+}
+
+// END OF void VapourSynthPluginsManager::slotMetadataReady(
+//		const VSPluginsMetadata & a_metadata, int a_generation)
+//==============================================================================
+
+void VapourSynthPluginsManager::startScan(bool a_force)
+{
+	PluginsScanInput input;
+	input.libraryPaths = m_pSettingsManager->getVapourSynthLibraryPaths();
+	input.pluginsPaths = m_pSettingsManager->getVapourSynthPluginsPaths();
+	input.vsRepoPath = m_vsRepoPath;
+	input.libraryPath = m_libraryPath;
+	input.pluginsDirs = m_pluginsDirs;
+	input.fingerprint = m_fingerprint;
+	input.force = a_force;
+
+	// a newer scan makes the queued and running ones obsolete
+	m_pThreadPool->clear();
+	++m_generation;
+	m_pThreadPool->start(new PluginsScanTask(this, input, m_generation));
+}
+
+// END OF void VapourSynthPluginsManager::startScan(bool a_force)
+//==============================================================================
+
+QString VapourSynthPluginsManager::cacheFilePath()
+{
+	return m_pSettingsManager->getSettingsFileDir() + PLUGINS_CACHE_FILE_NAME;
+}
+
+// END OF QString VapourSynthPluginsManager::cacheFilePath()
+//==============================================================================
+
 void VapourSynthPluginsManager::loadVSRepoPath()
 {
     QString vsRepoName("vsrepo.py");
@@ -638,24 +1040,7 @@ void VapourSynthPluginsManager::loadVSRepoPath()
 
 QString VapourSynthPluginsManager::getPathsByVSRepo(const QString &a_key)
 {
-    QProcess * process = new QProcess(this);
-    QStringList args;
-    args << m_vsRepoPath << "paths";
-
-    process->start("python", args);
-    process->waitForFinished();
-    process->setReadChannel(QProcess::StandardOutput);
-
-    QString resultPath;
-    while (process->canReadLine()) {
-        QString line = process->readLine().trimmed();
-        if (line.contains(a_key, Qt::CaseSensitive)) {
-            resultPath= line.split(" ")[1]; // e.g. "Binaries: C:\VS\plugins"
-            break;
-        }
-    }
-    process->close();
-    return resultPath;
+    return vsRepoPaths(m_vsRepoPath).value(a_key);
 }
 
 // END OF void VapourSynthPluginsManager::loadVSRepoPath()
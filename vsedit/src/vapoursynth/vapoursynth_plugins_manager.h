@@ -2,6 +2,7 @@
 #define VAPOURSYNTHPLUGINSMANAGER_H
 
 #include "vs_plugin_data.h"
+#include "vs_plugins_metadata_cache.h"
 
 #include <vapoursynth/VapourSynth.h>
 
@@ -9,7 +10,11 @@
 #include <QStringList>
 
 class SettingsManager;
+class QThreadPool;
 
+/// Plugin and function signatures for the editor. They come from a disk
+/// cache at start and are rescanned in the background; the lists only
+/// change when signalPluginsListChanged() is emitted.
 class VapourSynthPluginsManager : public QObject
 {
 	Q_OBJECT
@@ -21,10 +26,6 @@ public:
 
     virtual ~VapourSynthPluginsManager() override;
 
-    void getCorePlugins();
-
-    void getPyScripts();
-
     QString vSRepoPath();
 
     QString pluginsPath();
@@ -33,8 +34,6 @@ public:
 
     QString definitionsPath();
 
-	void pollPaths(const QStringList & a_pluginsPaths);
-
 	QStringList functions() const;
 
 	VSPluginsList pluginsList() const;
@@ -44,20 +43,13 @@ public:
 	static VSData::Function parseFunctionSignature(const QString & a_name,
 		const QString & a_arguments);
 
-	friend void VS_CC fakeConfigPlugin(const char * a_identifier,
-		const char * a_defaultNamespace, const char * a_name,
-		int a_apiVersion, int a_readonly, VSPlugin * a_pPlugin);
-
-	friend void VS_CC fakeRegisterFunction(const char * a_name,
-		const char * a_args, VSPublicFunction a_argsFunc,
-		void * a_pFunctionData, VSPlugin * a_pPlugin);
-
 public slots:
 
 	void slotClear();
 
 	void slotSort();
 
+	// rescans ignoring the cache, the result arrives asynchronously
 	void slotRefill();
 
 signals:
@@ -65,23 +57,40 @@ signals:
 	void signalWriteLogMessage(int a_messageType,
 		const QString & a_message);
 
+	void signalPluginsListChanged();
+
+protected slots:
+
+	void slotMetadataReady(const VSPluginsMetadata & a_metadata,
+		int a_generation);
+
 private:
 
     void loadVSRepoPath();
 
     QString getPathsByVSRepo(const QString &a_key);
 
-	VSPluginsList m_pluginsList;
+	void startScan(bool a_force);
 
-    VSPyScriptsList m_pyScriptsList;
+	QString cacheFilePath();
 
-	QString m_currentPluginPath;
+	VSPluginsList m_pluginsList;
 
-	bool m_pluginAlreadyLoaded;
+    VSPyScriptsList m_pyScriptsList;
 
 	SettingsManager * m_pSettingsManager;
 
     QString m_vsRepoPath;
+
+	QThreadPool * m_pThreadPool;
+
+	// results of superseded scans are dropped
+	int m_generation;
+
+	// state of the files the lists were read from
+	QString m_libraryPath;
+	QStringList m_pluginsDirs;
+	QStringList m_fingerprint;
 };
 
 #endif // VAPOURSYNTHPLUGINSMANAGER_H
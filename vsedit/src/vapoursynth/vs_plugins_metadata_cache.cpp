@@ -0,0 +1,220 @@
+#include "vs_plugins_metadata_cache.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+//==============================================================================
+
+namespace
+{
+
+const quint32 CACHE_MAGIC = 0x56534D43; // "VSMC"
+// bump when the layout below changes, old caches are then ignored
+const quint32 CACHE_VERSION = 2;
+
+void writeFunctions(QDataStream & a_stream,
+	const std::vector<VSData::Function> & a_functions)
+{
+	a_stream << quint32(a_functions.size());
+	for(const VSData::Function & function : a_functions)
+	{
+		a_stream << function.name << quint32(function.arguments.size());
+		for(const VSData::FunctionArgument & argument : function.arguments)
+		{
+			a_stream << argument.name << argument.type << argument.value
+				<< argument.optional << argument.empty;
+		}
+	}
+}
+
+bool readFunctions(QDataStream & a_stream,
+	std::vector<VSData::Function> & a_functions)
+{
+	quint32 functionsCount = 0;
+	a_stream >> functionsCount;
+	for(quint32 i = 0; (i < functionsCount) &&
+		(a_stream.status() == QDataStream::Ok); ++i)
+	{
+		a_functions.emplace_back();
+		VSData::Function & function = a_functions.back();
+		quint32 argumentsCount = 0;
+		a_stream >> function.name >> argumentsCount;
+		for(quint32 j = 0; (j < argumentsCount) &&
+			(a_stream.status() == QDataStream::Ok); ++j)
+		{
+			function.arguments.emplace_back();
+			VSData::FunctionArgument & argument = function.arguments.back();
+			a_stream >> argument.name >> argument.type >> argument.value
+				>> argument.optional >> argument.empty;
+		}
+	}
+	return (a_stream.status() == QDataStream::Ok);
+}
+
+void writeLists(QDataStream & a_stream, const VSPluginsList & a_pluginsList,
+	const VSPyScriptsList & a_pyScriptsList)
+{
+	a_stream << quint32(a_pluginsList.size());
+	for(const VSData::Plugin & plugin : a_pluginsList)
+	{
+		a_stream << plugin.filepath << plugin.id << plugin.pluginNamespace
+			<< plugin.name;
+		writeFunctions(a_stream, plugin.functions);
+	}
+
+	a_stream << quint32(a_pyScriptsList.size());
+	for(const VSData::PyScript & pyScript : a_pyScriptsList)
+	{
+		a_stream << pyScript.id << pyScript.moduleName << pyScript.name;
+		writeFunctions(a_stream, pyScript.functions);
+	}
+}
+
+bool readLists(QDataStream & a_stream, VSPluginsList & a_pluginsList,
+	VSPyScriptsList & a_pyScriptsList)
+{
+	quint32 pluginsCount = 0;
+	a_stream >> pluginsCount;
+	for(quint32 i = 0; (i < pluginsCount) &&
+		(a_stream.status() == QDataStream::Ok); ++i)
+	{
+		a_pluginsList.emplace_back();
+		VSData::Plugin & plugin = a_pluginsList.back();
+		a_stream >> plugin.filepath >> plugin.id >> plugin.pluginNamespace
+			>> plugin.name;
+		readFunctions(a_stream, plugin.functions);
+	}
+
+	quint32 pyScriptsCount = 0;
+	a_stream >> pyScriptsCount;
+	for(quint32 i = 0; (i < pyScriptsCount) &&
+		(a_stream.status() == QDataStream::Ok); ++i)
+	{
+		a_pyScriptsList.emplace_back();
+		VSData::PyScript & pyScript = a_pyScriptsList.back();
+		a_stream >> pyScript.id >> pyScript.moduleName >> pyScript.name;
+		readFunctions(a_stream, pyScript.functions);
+	}
+
+	return (a_stream.status() == QDataStream::Ok);
+}
+
+}
+
+//==============================================================================
+
+bool VSPluginsMetadataCache::load(const QString & a_filePath,
+	VSPluginsMetadata * a_pMetadata)
+{
+	Q_ASSERT(a_pMetadata);
+
+	QFile file(a_filePath);
+	if(!file.open(QIODevice::ReadOnly))
+		return false;
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_0);
+
+	quint32 magic = 0;
+	quint32 version = 0;
+	stream >> magic >> version;
+	if((magic != CACHE_MAGIC) || (version != CACHE_VERSION))
+		return false;
+
+	VSPluginsMetadata metadata;
+	stream >> metadata.libraryPath >> metadata.pluginsDirs
+		>> metadata.fingerprint;
+	if(!readLists(stream, metadata.pluginsList, metadata.pyScriptsList))
+		return false;
+
+	*a_pMetadata = std::move(metadata);
+	return true;
+}
+
+// END OF bool VSPluginsMetadataCache::load(const QString & a_filePath,
+//		VSPluginsMetadata * a_pMetadata)
+//==============================================================================
+
+bool VSPluginsMetadataCache::save(const QString & a_filePath,
+	const VSPluginsMetadata & a_metadata)
+{
+	// an interrupted write must not leave a truncated cache behind
+	QSaveFile file(a_filePath);
+	if(!file.open(QIODevice::WriteOnly))
+		return false;
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream << CACHE_MAGIC << CACHE_VERSION;
+	stream << a_metadata.libraryPath << a_metadata.pluginsDirs
+		<< a_metadata.fingerprint;
+	writeLists(stream, a_metadata.pluginsList, a_metadata.pyScriptsList);
+
+	if(stream.status() != QDataStream::Ok)
+	{
+		file.cancelWriting();
+		return false;
+	}
+
+	return file.commit();
+}
+
+// END OF bool VSPluginsMetadataCache::save(const QString & a_filePath,
+//		const VSPluginsMetadata & a_metadata)
+//==============================================================================
+
+QByteArray VSPluginsMetadataCache::serializeLists(
+	const VSPluginsList & a_pluginsList,
+	const VSPyScriptsList & a_pyScriptsList)
+{
+	QByteArray data;
+	QDataStream stream(&data, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_5_0);
+	writeLists(stream, a_pluginsList, a_pyScriptsList);
+	return data;
+}
+
+// END OF QByteArray VSPluginsMetadataCache::serializeLists(
+//		const VSPluginsList & a_pluginsList,
+//		const VSPyScriptsList & a_pyScriptsList)
+//==============================================================================
+
+QString VSPluginsMetadataCache::fileEntry(const QString & a_filePath)
+{
+	QFileInfo fileInfo(a_filePath);
+	if(!fileInfo.exists())
+		return a_filePath + "|-";
+
+	return QString("%1|%2|%3").arg(fileInfo.absoluteFilePath())
+		.arg(fileInfo.size())
+		.arg(fileInfo.lastModified().toMSecsSinceEpoch());
+}
+
+// END OF QString VSPluginsMetadataCache::fileEntry(const QString & a_filePath)
+//==============================================================================
+
+QStringList VSPluginsMetadataCache::directoryEntries(const QString & a_dirPath,
+	const QStringList & a_nameFilters)
+{
+	QStringList entries;
+	if(a_dirPath.isEmpty())
+		return entries;
+
+	QDir dir(a_dirPath);
+	if(!dir.exists())
+		return entries;
+
+	QFileInfoList fileInfoList = dir.entryInfoList(a_nameFilters,
+		QDir::Files, QDir::Name);
+	for(const QFileInfo & fileInfo : fileInfoList)
+		entries << fileEntry(fileInfo.absoluteFilePath());
+	return entries;
+}
+
+// END OF QStringList VSPluginsMetadataCache::directoryEntries(
+//		const QString & a_dirPath, const QStringList & a_nameFilters)
+//==============================================================================
@@ -0,0 +1,49 @@
+#ifndef VS_PLUGINS_METADATA_CACHE_H_INCLUDED
+#define VS_PLUGINS_METADATA_CACHE_H_INCLUDED
+
+#include "vs_plugin_data.h"
+
+#include <QByteArray>
+#include <QMetaType>
+#include <QStringList>
+
+/// Everything the plugins manager gathers, along with the state of the
+/// files it was gathered from so a later start can tell if it still holds.
+struct VSPluginsMetadata
+{
+	VSPluginsList pluginsList;
+	VSPyScriptsList pyScriptsList;
+
+	// the VapourSynth library the core plugins were read from
+	QString libraryPath;
+
+	// directories the autoloaded plugins were found in
+	QStringList pluginsDirs;
+
+	// "path|size|mtime" of every file the lists depend on
+	QStringList fingerprint;
+};
+
+Q_DECLARE_METATYPE(VSPluginsMetadata)
+
+/// Binary disk cache of the plugins metadata.
+namespace VSPluginsMetadataCache
+{
+
+bool load(const QString & a_filePath, VSPluginsMetadata * a_pMetadata);
+
+bool save(const QString & a_filePath, const VSPluginsMetadata & a_metadata);
+
+// the lists alone, equal bytes mean the editor has nothing to update
+QByteArray serializeLists(const VSPluginsList & a_pluginsList,
+	const VSPyScriptsList & a_pyScriptsList);
+
+// entries for the fingerprint
+QString fileEntry(const QString & a_filePath);
+
+QStringList directoryEntries(const QString & a_dirPath,
+	const QStringList & a_nameFilters = QStringList());
+
+}
+
+#endif // VS_PLUGINS_METADATA_CACHE_H_INCLUDED